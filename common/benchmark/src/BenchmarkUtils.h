@@ -20,7 +20,10 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
+#include <cstdio>
 #include <string>
+#include <utility>
 
 #ifdef __GNUC__
 #define TB_NOINLINE __attribute__((noinline))
@@ -41,3 +44,22 @@ TB_NOINLINE static void timeLambda(L&& lambda, const std::string& message)
     message.c_str(),
     std::chrono::duration<double>(end - start).count() * 1000.0);
 }
+
+/**
+ * Returns the number of heap allocations made by the benchmark executable so far.
+ */
+size_t allocationCount();
+
+/**
+ * Runs the given lambda and prints its running time and the number of heap allocations
+ * it made.
+ */
+template <class L>
+static void timeAndCountAllocations(L&& lambda, const std::string& message)
+{
+  const auto allocationCountBefore = allocationCount();
+  timeLambda(std::forward<L>(lambda), message);
+  const auto allocations = allocationCount() - allocationCountBefore;
+
+  printf("Allocations for '%s': %zu\n", message.c_str(), allocations);
+}
@@ -0,0 +1,124 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "octree.h"
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <random>
+#include <vector>
+
+namespace tb
+{
+namespace
+{
+
+constexpr size_t NumNodes = 200'000;
+constexpr size_t NumRays = 1'000;
+constexpr double WorldSize = 16384.0;
+
+auto makeBounds(std::mt19937& rng)
+{
+  auto position =
+    std::uniform_real_distribution<double>{-WorldSize / 2.0, WorldSize / 2.0};
+  auto size = std::uniform_real_distribution<double>{8.0, 256.0};
+
+  auto result = std::vector<vm::bbox3d>{};
+  result.reserve(NumNodes);
+  for (size_t i = 0; i < NumNodes; ++i)
+  {
+    const auto min = vm::vec3d{position(rng), position(rng), position(rng)};
+    result.emplace_back(min, min + vm::vec3d{size(rng), size(rng), size(rng)});
+  }
+  return result;
+}
+
+auto makeRays(std::mt19937& rng)
+{
+  auto position =
+    std::uniform_real_distribution<double>{-WorldSize / 2.0, WorldSize / 2.0};
+  auto direction = std::uniform_real_distribution<double>{-1.0, 1.0};
+
+  auto result = std::vector<vm::ray3d>{};
+  result.reserve(NumRays);
+  for (size_t i = 0; i < NumRays; ++i)
+  {
+    const auto origin = vm::vec3d{position(rng), position(rng), position(rng)};
+    const auto dir = vm::normalize(vm::vec3d{direction(rng), direction(rng), 1.0});
+    result.emplace_back(origin, dir);
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("OctreeBenchmark.insertUpdatePick")
+{
+  auto rng = std::mt19937{0};
+  const auto bounds = makeBounds(rng);
+  const auto rays = makeRays(rng);
+
+  auto tree = octree<double, size_t>{64.0};
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < bounds.size(); ++i)
+      {
+        tree.insert(bounds[i], i);
+      }
+    },
+    fmt::format("insert {} nodes", bounds.size()));
+
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < bounds.size(); ++i)
+      {
+        tree.update(bounds[i].translate(vm::vec3d{16.0, 16.0, 16.0}), i);
+      }
+    },
+    fmt::format("update {} nodes", bounds.size()));
+
+  auto singleResults = std::vector<std::vector<size_t>>{};
+  timeLambda(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        singleResults.push_back(tree.find_intersectors(ray));
+      }
+    },
+    fmt::format("pick {} nodes with {} single rays", bounds.size(), rays.size()));
+
+  auto batchedResults = std::vector<std::vector<size_t>>{};
+  timeLambda(
+    [&]() { batchedResults = tree.find_intersectors(rays); },
+    fmt::format("pick {} nodes with {} batched rays", bounds.size(), rays.size()));
+
+  REQUIRE(batchedResults.size() == singleResults.size());
+  for (size_t i = 0; i < singleResults.size(); ++i)
+  {
+    CHECK_THAT(batchedResults[i], Catch::UnorderedEquals(singleResults[i]));
+  }
+}
+
+} // namespace tb
@@ -0,0 +1,210 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+
+#include "kdl/task_manager.h"
+
+#include <fmt/format.h>
+
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+namespace tb
+{
+namespace
+{
+
+constexpr size_t NumTasks = 100'000;
+constexpr size_t NumIndices = 10'000'000;
+
+/**
+ * The previous implementation of kdl::task_manager, which uses a single queue that is
+ * shared by all workers. Kept here as a baseline.
+ */
+class locked_queue_task_manager
+{
+private:
+  std::vector<std::thread> m_workers;
+
+  std::mutex m_pending_tasks_mutex;
+  std::condition_variable m_pending_tasks_cv;
+  std::queue<std::function<void()>> m_pending_tasks;
+  bool m_running = true;
+
+public:
+  explicit locked_queue_task_manager(const size_t max_concurrent_tasks)
+  {
+    for (size_t i = 0; i < max_concurrent_tasks; ++i)
+    {
+      m_workers.emplace_back([&] {
+        while (true)
+        {
+          auto lock = std::unique_lock{m_pending_tasks_mutex};
+          m_pending_tasks_cv.wait(
+            lock, [&] { return !m_running || !m_pending_tasks.empty(); });
+
+          if (!m_running)
+          {
+            break;
+          }
+
+          auto task = std::move(m_pending_tasks.front());
+          m_pending_tasks.pop();
+          lock.unlock();
+
+          task();
+        }
+      });
+    }
+  }
+
+  ~locked_queue_task_manager()
+  {
+    {
+      auto lock = std::lock_guard{m_pending_tasks_mutex};
+      m_running = false;
+    }
+
+    m_pending_tasks_cv.notify_all();
+    for (auto& worker : m_workers)
+    {
+      worker.join();
+    }
+  }
+
+  template <typename task_result>
+  auto run_task(std::function<task_result()> task)
+  {
+    auto promise = std::make_shared<std::promise<task_result>>();
+    auto future = promise->get_future();
+
+    {
+      auto lock = std::lock_guard{m_pending_tasks_mutex};
+      m_pending_tasks.push([task_ = std::move(task), promise_ = std::move(promise)]() {
+        promise_->set_value(task_());
+      });
+    }
+    m_pending_tasks_cv.notify_one();
+
+    return future;
+  }
+
+  template <std::ranges::range range>
+  auto run_tasks_and_wait(range tasks)
+  {
+    auto futures = std::vector<std::future<double>>{};
+    for (auto task : tasks)
+    {
+      futures.push_back(run_task(std::move(task)));
+    }
+
+    auto results = std::vector<double>{};
+    for (auto& future : futures)
+    {
+      results.push_back(future.get());
+    }
+    return results;
+  }
+};
+
+auto makeTasks()
+{
+  return std::views::iota(size_t(0), NumTasks) | std::views::transform([](auto i) {
+           return std::function<double()>{[i]() { return std::sqrt(double(i)); }};
+         });
+}
+
+} // namespace
+
+TEST_CASE("TaskManagerBenchmark.runTasksAndWait")
+{
+  const auto workerCount = size_t(std::thread::hardware_concurrency());
+
+  auto lockedQueueResults = std::vector<double>{};
+  {
+    auto taskManager = locked_queue_task_manager{workerCount};
+    timeLambda(
+      [&]() { lockedQueueResults = taskManager.run_tasks_and_wait(makeTasks()); },
+      fmt::format(
+        "run {} small tasks on {} workers using a single locked queue",
+        NumTasks,
+        workerCount));
+  }
+
+  auto workStealingResults = std::vector<double>{};
+  {
+    auto taskManager = kdl::task_manager{workerCount};
+    timeLambda(
+      [&]() { workStealingResults = taskManager.run_tasks_and_wait(makeTasks()); },
+      fmt::format(
+        "run {} small tasks on {} workers using kdl::task_manager",
+        NumTasks,
+        workerCount));
+  }
+
+  CHECK(workStealingResults == lockedQueueResults);
+}
+
+TEST_CASE("TaskManagerBenchmark.parallelFor")
+{
+  const auto workerCount = size_t(std::thread::hardware_concurrency());
+  auto taskManager = kdl::task_manager{workerCount};
+
+  auto values = std::vector<double>(NumIndices);
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < values.size(); ++i)
+      {
+        values[i] = std::sqrt(double(i));
+      }
+    },
+    fmt::format("compute {} values sequentially", NumIndices));
+
+  timeLambda(
+    [&]() {
+      taskManager.parallel_for(
+        values.size(), [&](const size_t i) { values[i] = std::sqrt(double(i)); });
+    },
+    fmt::format("compute {} values using parallel_for", NumIndices));
+
+  timeLambda(
+    [&]() {
+      const auto outer = size_t(64);
+      taskManager.parallel_for(outer, [&](const size_t i) {
+        const auto chunkSize = values.size() / outer;
+        taskManager.parallel_for(chunkSize, [&](const size_t j) {
+          const auto k = i * chunkSize + j;
+          values[k] = std::sqrt(double(k));
+        });
+      });
+    },
+    fmt::format("compute {} values using nested parallel_for", NumIndices));
+}
+
+} // namespace tb
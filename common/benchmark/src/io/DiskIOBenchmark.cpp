@@ -0,0 +1,164 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "io/DiskIO.h"
+
+#include "kdl/path_utils.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace tb::io
+{
+namespace
+{
+
+constexpr auto Directories = std::array{"Models", "sprites", "SOUND", "maps", "Gfx"};
+constexpr size_t SubDirectoriesPerDirectory = 10;
+constexpr size_t FilesPerSubDirectory = 1'000;
+constexpr size_t LookupStride = 10;
+
+/**
+ * Creates a mod directory with 50k files with mixed case names, and returns the paths
+ * of every tenth file.
+ */
+std::vector<std::filesystem::path> makeModDirectory(const std::filesystem::path& root)
+{
+  auto result = std::vector<std::filesystem::path>{};
+  for (const auto* directory : Directories)
+  {
+    for (size_t i = 0; i < SubDirectoriesPerDirectory; ++i)
+    {
+      const auto subDirectory = root / directory / fmt::format("Sub{:02}", i);
+      std::filesystem::create_directories(subDirectory);
+
+      for (size_t j = 0; j < FilesPerSubDirectory; ++j)
+      {
+        const auto path = subDirectory / fmt::format("File_{:04}.Dat", j);
+        std::ofstream{path};
+
+        if (j % LookupStride == 0)
+        {
+          result.push_back(path);
+        }
+      }
+    }
+  }
+  return result;
+}
+
+/**
+ * The previous implementation of fixing the case of a path, which scans every directory
+ * on the path. Kept here as a baseline.
+ */
+std::filesystem::path fixCaseByScanning(const std::filesystem::path& path)
+{
+  auto result = kdl::path_front(kdl::path_to_lower(path));
+  auto remainder = kdl::path_pop_front(kdl::path_to_lower(path));
+
+  while (!remainder.empty())
+  {
+    const auto nameToFind = kdl::path_front(remainder);
+    const auto entryIt = std::find_if(
+      std::filesystem::directory_iterator{result},
+      std::filesystem::directory_iterator{},
+      [&](const auto& entry) {
+        return nameToFind == kdl::path_to_lower(entry.path().filename());
+      });
+
+    if (entryIt == std::filesystem::directory_iterator{})
+    {
+      return path;
+    }
+
+    result = result / entryIt->path().filename();
+    remainder = kdl::path_pop_front(remainder);
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("DiskIOBenchmark.fixPath")
+{
+  if (!Disk::isCaseSensitive())
+  {
+    return;
+  }
+
+  const auto root = std::filesystem::temp_directory_path() / "TrenchBroomDiskIOBenchmark";
+  std::filesystem::remove_all(root);
+
+  const auto paths = makeModDirectory(root);
+
+  auto lowerPaths = std::vector<std::filesystem::path>{};
+  lowerPaths.reserve(paths.size());
+  for (const auto& path : paths)
+  {
+    lowerPaths.push_back(root / kdl::path_to_lower(path.lexically_relative(root)));
+  }
+
+  auto scannedPaths = std::vector<std::filesystem::path>{};
+  timeLambda(
+    [&]() {
+      for (const auto& lowerPath : lowerPaths)
+      {
+        scannedPaths.push_back(fixCaseByScanning(lowerPath));
+      }
+    },
+    fmt::format("fix {} paths by scanning directories", lowerPaths.size()));
+
+  Disk::invalidateCaseIndex(root);
+
+  auto coldPaths = std::vector<std::filesystem::path>{};
+  timeLambda(
+    [&]() {
+      for (const auto& lowerPath : lowerPaths)
+      {
+        coldPaths.push_back(Disk::fixPath(lowerPath));
+      }
+    },
+    fmt::format("fix {} paths while indexing directories", lowerPaths.size()));
+
+  auto warmPaths = std::vector<std::filesystem::path>{};
+  timeLambda(
+    [&]() {
+      for (const auto& lowerPath : lowerPaths)
+      {
+        warmPaths.push_back(Disk::fixPath(lowerPath));
+      }
+    },
+    fmt::format("fix {} paths using indexed directories", lowerPaths.size()));
+
+  std::filesystem::remove_all(root);
+
+  CHECK(scannedPaths == paths);
+  CHECK(coldPaths == paths);
+  CHECK(warmPaths == paths);
+}
+
+} // namespace tb::io
@@ -0,0 +1,326 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "io/MapCache.h"
+#include "io/NodeWriter.h"
+#include "io/TestParserStatus.h"
+#include "io/WorldReader.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EditorContext.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/MapFormat.h"
+#include "mdl/NodeQueries.h"
+#include "mdl/PickResult.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/result.h"
+#include "kdl/task_manager.h"
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <array>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace tb::io
+{
+namespace
+{
+
+constexpr auto BrushCounts = std::array<size_t, 3>{1'000, 10'000, 100'000};
+constexpr size_t NumRays = 1'000;
+
+// brushes are placed in a grid of cells, and the brushes of every tenth group of four
+// brushes belong to a brush entity
+constexpr size_t GridSize = 100;
+constexpr double CellSize = 80.0;
+constexpr size_t BrushesPerEntity = 4;
+constexpr size_t BrushesPerLight = 16;
+
+const auto WorldBounds = vm::bbox3d{8192.0};
+
+constexpr auto Materials = std::array{
+  "+0~GENERIC65",
+  "{BLUE",
+  "!WATERBLUE",
+  "CRETE3_FLR01",
+  "C1A0_LABW1",
+  "OUT_GRND1",
+  "LAB1_DOOR2A",
+  "SKY"};
+
+constexpr auto BrushEntityClassnames =
+  std::array{"func_wall", "func_door", "func_illusionary", "func_breakable"};
+
+vm::bbox3d makeBrushBounds(const size_t index, std::mt19937& rng)
+{
+  auto size = std::uniform_int_distribution<int>{2, 8};
+
+  const auto cell = vm::vec3d{
+    double(index % GridSize),
+    double(index / GridSize % GridSize),
+    double(index / (GridSize * GridSize))};
+  const auto min = cell * CellSize - vm::vec3d{4000.0, 4000.0, 0.0};
+  const auto extents = vm::vec3d{double(size(rng)), double(size(rng)), double(size(rng))};
+  return {min, min + extents * 8.0};
+}
+
+void appendBrush(std::string& str, const vm::bbox3d& bounds, std::mt19937& rng)
+{
+  auto material = std::uniform_int_distribution<size_t>{0, Materials.size() - 1};
+  auto offset = std::uniform_int_distribution<int>{0, 15};
+
+  const auto x0 = bounds.min.x();
+  const auto y0 = bounds.min.y();
+  const auto z0 = bounds.min.z();
+  const auto x1 = bounds.max.x();
+  const auto y1 = bounds.max.y();
+  const auto z1 = bounds.max.z();
+  const auto appendFace = [&](
+                            const vm::vec3d& p1,
+                            const vm::vec3d& p2,
+                            const vm::vec3d& p3,
+                            const char* uAxis,
+                            const char* vAxis) {
+    fmt::format_to(
+      std::back_inserter(str),
+      "( {} {} {} ) ( {} {} {} ) ( {} {} {} ) {} [ {} {} ] [ {} {} ] 0 1 1\n",
+      p1.x(),
+      p1.y(),
+      p1.z(),
+      p2.x(),
+      p2.y(),
+      p2.z(),
+      p3.x(),
+      p3.y(),
+      p3.z(),
+      Materials[material(rng)],
+      uAxis,
+      offset(rng) * 4,
+      vAxis,
+      offset(rng) * 4);
+  };
+
+  str += "{\n";
+  appendFace({x0, y1, z1}, {x1, y1, z1}, {x1, y0, z1}, "1 0 0", "0 -1 0");
+  appendFace({x0, y1, z1}, {x0, y0, z1}, {x0, y0, z0}, "0 1 0", "0 0 -1");
+  appendFace({x1, y0, z1}, {x1, y1, z1}, {x1, y1, z0}, "0 1 0", "0 0 -1");
+  appendFace({x1, y1, z1}, {x0, y1, z1}, {x0, y1, z0}, "1 0 0", "0 0 -1");
+  appendFace({x0, y0, z1}, {x1, y0, z1}, {x1, y0, z0}, "1 0 0", "0 0 -1");
+  appendFace({x0, y0, z0}, {x1, y0, z0}, {x1, y1, z0}, "1 0 0", "0 -1 0");
+  str += "}\n";
+}
+
+bool isEntityBrush(const size_t index)
+{
+  return index / BrushesPerEntity % 10 == 0;
+}
+
+/**
+ * Generates a Half-Life map in Valve 220 format with the given number of brushes. The
+ * generated map only depends on the brush count.
+ */
+std::string makeMap(const size_t brushCount)
+{
+  auto rng = std::mt19937{0};
+  auto str = std::string{};
+
+  str += R"({
+"classname" "worldspawn"
+"mapversion" "220"
+"wad" "\half-life\valve\halflife.wad;\half-life\valve\liquids.wad"
+"skyname" "desert"
+)";
+  for (size_t i = 0; i < brushCount; ++i)
+  {
+    if (!isEntityBrush(i))
+    {
+      appendBrush(str, makeBrushBounds(i, rng), rng);
+    }
+  }
+  str += "}\n";
+
+  str += R"({
+"classname" "info_player_start"
+"origin" "0 0 1024"
+"angles" "0 90 0"
+}
+)";
+
+  for (size_t i = 0; i < brushCount; i += BrushesPerEntity)
+  {
+    if (isEntityBrush(i))
+    {
+      const auto entityIndex = i / BrushesPerEntity;
+      fmt::format_to(
+        std::back_inserter(str),
+        "{{\n\"classname\" \"{}\"\n\"targetname\" \"target{}\"\n\"rendermode\" "
+        "\"4\"\n",
+        BrushEntityClassnames[entityIndex % BrushEntityClassnames.size()],
+        entityIndex);
+      for (size_t j = i; j < std::min(i + BrushesPerEntity, brushCount); ++j)
+      {
+        appendBrush(str, makeBrushBounds(j, rng), rng);
+      }
+      str += "}\n";
+    }
+  }
+
+  for (size_t i = 0; i < brushCount; i += BrushesPerLight)
+  {
+    const auto origin = makeBrushBounds(i, rng).center() + vm::vec3d{0, 0, 48};
+    fmt::format_to(
+      std::back_inserter(str),
+      "{{\n\"classname\" \"light\"\n\"origin\" \"{} {} {}\"\n\"_light\" \"255 255 "
+      "128 200\"\n}}\n",
+      origin.x(),
+      origin.y(),
+      origin.z());
+  }
+
+  return str;
+}
+
+auto makeRays(std::mt19937& rng)
+{
+  const auto extent = double(GridSize) * CellSize / 2.0;
+  auto position = std::uniform_real_distribution<double>{-extent, extent};
+  auto height = std::uniform_real_distribution<double>{0.0, 1024.0};
+  auto direction = std::uniform_real_distribution<double>{-1.0, 1.0};
+
+  auto result = std::vector<vm::ray3d>{};
+  result.reserve(NumRays);
+  for (size_t i = 0; i < NumRays; ++i)
+  {
+    const auto origin = vm::vec3d{position(rng), position(rng), height(rng)};
+    result.emplace_back(
+      origin,
+      vm::normalize(vm::vec3d{direction(rng), direction(rng), direction(rng)}));
+  }
+  return result;
+}
+
+size_t countBrushes(mdl::WorldNode& worldNode)
+{
+  return mdl::collectDescendants(
+           std::vector<mdl::Node*>{&worldNode},
+           [](const mdl::BrushNode*) { return true; })
+    .size();
+}
+
+} // namespace
+
+TEST_CASE("MapBenchmark.loadAndSave")
+{
+  auto taskManager = kdl::task_manager{};
+  const auto entityPropertyConfig = mdl::EntityPropertyConfig{};
+
+  for (const auto brushCount : BrushCounts)
+  {
+    auto map = std::string{};
+    timeAndCountAllocations(
+      [&]() { map = makeMap(brushCount); },
+      fmt::format("generate map with {} brushes", brushCount));
+
+    auto worldNode = std::unique_ptr<mdl::WorldNode>{};
+    timeAndCountAllocations(
+      [&]() {
+        auto status = TestParserStatus{};
+        auto reader = WorldReader{map, mdl::MapFormat::Valve, entityPropertyConfig};
+        worldNode = reader.read(WorldBounds, status, taskManager) | kdl::value();
+      },
+      fmt::format("parse map and create nodes for {} brushes", brushCount));
+
+    REQUIRE(worldNode);
+    CHECK(countBrushes(*worldNode) == brushCount);
+
+    // record the parsed objects to measure node creation separately
+    auto mapCache = MapCache{};
+    {
+      auto status = TestParserStatus{};
+      auto reader = WorldReader{map, mdl::MapFormat::Valve, entityPropertyConfig};
+      reader.read(
+        WorldBounds,
+        status,
+        taskManager,
+        [&](const auto mapFormat, const auto& objectInfos) {
+          mapCache = MapCache{mapFormat, objectInfos};
+        })
+        | kdl::value();
+    }
+
+    auto cachedWorldNode = std::unique_ptr<mdl::WorldNode>{};
+    timeAndCountAllocations(
+      [&]() {
+        auto status = TestParserStatus{};
+        cachedWorldNode = WorldReader::readFromCache(
+          std::move(mapCache), WorldBounds, entityPropertyConfig, status, taskManager);
+      },
+      fmt::format("create nodes for {} parsed brushes", brushCount));
+
+    REQUIRE(cachedWorldNode);
+    CHECK(countBrushes(*cachedWorldNode) == brushCount);
+
+    timeAndCountAllocations(
+      [&]() { worldNode->rebuildNodeTree(); },
+      fmt::format("build node tree for {} brushes", brushCount));
+
+    auto savedMap = std::string{};
+    timeAndCountAllocations(
+      [&]() {
+        auto stream = std::stringstream{};
+        auto writer = NodeWriter{*worldNode, stream};
+        writer.writeMap(taskManager);
+        savedMap = stream.str();
+      },
+      fmt::format("save map with {} brushes", brushCount));
+
+    CHECK(!savedMap.empty());
+
+    auto rng = std::mt19937{0};
+    const auto rays = makeRays(rng);
+    const auto editorContext = mdl::EditorContext{};
+
+    auto hitCount = size_t(0);
+    timeAndCountAllocations(
+      [&]() {
+        for (const auto& ray : rays)
+        {
+          auto pickResult = mdl::PickResult{};
+          worldNode->pick(editorContext, ray, pickResult);
+          hitCount += pickResult.size();
+        }
+      },
+      fmt::format("pick {} brushes with {} rays", brushCount, rays.size()));
+
+    CHECK(hitCount > 0);
+  }
+}
+
+} // namespace tb::io
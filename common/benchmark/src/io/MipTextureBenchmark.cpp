@@ -0,0 +1,248 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "io/File.h"
+#include "io/ImageFileSystem.h"
+#include "io/MaterialUtils.h"
+#include "io/ReadMipTexture.h"
+#include "io/Reader.h"
+#include "io/WadFileSystem.h"
+#include "mdl/Texture.h"
+#include "mdl/TextureBuffer.h"
+
+#include "kdl/result.h"
+#include "kdl/task_manager.h"
+
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tb::io
+{
+namespace
+{
+
+constexpr size_t NumTextures = 4000;
+constexpr size_t TextureSize = 128;
+constexpr size_t MipLevels = 4;
+
+// name, width, height and mip offsets
+constexpr size_t HeaderSize = 16 + 2 * sizeof(int32_t) + MipLevels * sizeof(int32_t);
+
+struct Wad
+{
+  std::shared_ptr<File> file;
+  std::vector<std::filesystem::path> texturePaths;
+  std::vector<unsigned char> palette;
+};
+
+void append(std::vector<char>& data, const int32_t value)
+{
+  char bytes[sizeof(value)];
+  std::memcpy(bytes, &value, sizeof(value));
+  data.insert(data.end(), bytes, bytes + sizeof(value));
+}
+
+void appendName(std::vector<char>& data, const std::string& name)
+{
+  auto bytes = std::vector<char>(16, 0);
+  std::memcpy(bytes.data(), name.data(), std::min(name.size(), size_t(15)));
+  data.insert(data.end(), bytes.begin(), bytes.end());
+}
+
+/**
+ * Creates a WAD3 file in memory. Every texture has its own 256 color palette, and every
+ * fourth texture has a '{' name, so that its last palette index is transparent.
+ */
+Wad makeWad()
+{
+  auto palette = std::vector<unsigned char>(256 * 3);
+  for (size_t i = 0; i < palette.size(); ++i)
+  {
+    palette[i] = static_cast<unsigned char>(i * 7);
+  }
+
+  auto data = std::vector<char>{'W', 'A', 'D', '3'};
+  append(data, int32_t(NumTextures));
+  append(data, 0); // directory offset, patched below
+
+  auto names = std::vector<std::string>{};
+  auto entries = std::vector<std::pair<int32_t, int32_t>>{};
+  for (size_t t = 0; t < NumTextures; ++t)
+  {
+    const auto name = fmt::format("{}tex{:04}", t % 4 == 0 ? "{" : "", t);
+    const auto start = int32_t(data.size());
+
+    appendName(data, name);
+    append(data, int32_t(TextureSize));
+    append(data, int32_t(TextureSize));
+
+    auto offset = int32_t(HeaderSize);
+    for (size_t level = 0; level < MipLevels; ++level)
+    {
+      append(data, offset);
+      offset += int32_t((TextureSize >> level) * (TextureSize >> level));
+    }
+
+    for (size_t level = 0; level < MipLevels; ++level)
+    {
+      const auto pixelCount = (TextureSize >> level) * (TextureSize >> level);
+      for (size_t i = 0; i < pixelCount; ++i)
+      {
+        data.push_back(static_cast<char>((i * 31 + t) % 256));
+      }
+    }
+
+    data.push_back(char(0));
+    data.push_back(char(1)); // 256 colors
+    data.insert(data.end(), palette.begin(), palette.end());
+    data.push_back(char(0));
+    data.push_back(char(0));
+
+    names.push_back(name);
+    entries.emplace_back(start, int32_t(data.size()) - start);
+  }
+
+  const auto directoryOffset = int32_t(data.size());
+  std::memcpy(data.data() + 8, &directoryOffset, sizeof(directoryOffset));
+
+  auto texturePaths = std::vector<std::filesystem::path>{};
+  for (size_t t = 0; t < NumTextures; ++t)
+  {
+    const auto [address, size] = entries[t];
+    append(data, address);
+    append(data, size);
+    append(data, size);
+    data.push_back('C');
+    data.push_back(char(0));
+    data.push_back(char(0));
+    data.push_back(char(0));
+    appendName(data, names[t]);
+
+    texturePaths.emplace_back(names[t] + ".C");
+  }
+
+  auto buffer = std::make_unique<char[]>(data.size());
+  std::memcpy(buffer.get(), data.data(), data.size());
+
+  return {
+    std::make_shared<OwningBufferFile>(std::move(buffer), data.size()),
+    std::move(texturePaths),
+    std::move(palette)};
+}
+
+size_t decodeTexture(const FileSystem& fs, const std::filesystem::path& path)
+{
+  return fs.openFile(path) | kdl::and_then([&](auto file) {
+           auto reader = file->reader().buffer();
+           return readHlMipTexture(
+             reader, getTextureMaskFromName(path.stem().string()));
+         })
+         | kdl::transform([](const auto& texture) { return texture.width(); })
+         | kdl::value();
+}
+
+/**
+ * The previous palette expansion, which reads every index from the reader separately.
+ * Kept here as a baseline.
+ */
+void expandPixelByPixel(
+  Reader& reader,
+  const std::vector<unsigned char>& palette,
+  const size_t pixelCount,
+  mdl::TextureBuffer& buffer)
+{
+  auto* const rgbaData = buffer.data();
+  for (size_t i = 0; i < pixelCount; ++i)
+  {
+    const auto index = size_t(reader.readInt<unsigned char>());
+    rgbaData[i * 4 + 0] = palette[index * 3 + 0];
+    rgbaData[i * 4 + 1] = palette[index * 3 + 1];
+    rgbaData[i * 4 + 2] = palette[index * 3 + 2];
+    rgbaData[i * 4 + 3] = 0xFF;
+  }
+}
+
+} // namespace
+
+TEST_CASE("MipTextureBenchmark.decodeWad")
+{
+  const auto wad = makeWad();
+  const auto fs = createImageFileSystem<WadFileSystem>(wad.file) | kdl::value();
+
+  auto baselinePixelCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& path : wad.texturePaths)
+      {
+        auto file = fs->openFile(path) | kdl::value();
+        auto reader = file->reader().buffer();
+        reader.seekFromBegin(HeaderSize);
+        for (size_t level = 0; level < MipLevels; ++level)
+        {
+          const auto pixelCount = (TextureSize >> level) * (TextureSize >> level);
+          auto buffer = mdl::TextureBuffer{4 * pixelCount};
+          expandPixelByPixel(reader, wad.palette, pixelCount, buffer);
+          baselinePixelCount += pixelCount;
+        }
+      }
+    },
+    fmt::format("expand {} textures pixel by pixel", wad.texturePaths.size()));
+
+  auto serialWidths = std::vector<size_t>{};
+  timeLambda(
+    [&]() {
+      for (const auto& path : wad.texturePaths)
+      {
+        serialWidths.push_back(decodeTexture(*fs, path));
+      }
+    },
+    fmt::format("decode {} textures on one thread", wad.texturePaths.size()));
+
+  auto taskManager = kdl::task_manager{};
+  auto parallelWidths = std::vector<size_t>{};
+  timeLambda(
+    [&]() {
+      auto tasks = std::vector<std::function<size_t()>>{};
+      tasks.reserve(wad.texturePaths.size());
+      for (const auto& path : wad.texturePaths)
+      {
+        tasks.emplace_back([&]() { return decodeTexture(*fs, path); });
+      }
+      parallelWidths = taskManager.run_tasks_and_wait(std::move(tasks));
+    },
+    fmt::format(
+      "decode {} textures on {} workers",
+      wad.texturePaths.size(),
+      taskManager.worker_count()));
+
+  CHECK(baselinePixelCount > 0);
+  CHECK(serialWidths == std::vector<size_t>(NumTextures, TextureSize));
+  CHECK(parallelWidths == serialWidths);
+}
+
+} // namespace tb::io
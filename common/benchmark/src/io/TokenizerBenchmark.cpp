@@ -0,0 +1,161 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "io/StandardMapParser.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <string>
+
+namespace tb::io
+{
+namespace
+{
+
+constexpr size_t MapSize = 50 * 1024 * 1024;
+
+/**
+ * Generates a Valve 220 map with a large worldspawn made of cuboids and a few point
+ * entities.
+ */
+std::string makeValveMap()
+{
+  auto result = std::string{};
+  result.reserve(MapSize + 4096);
+
+  result += R"(// Game: Quake
+// Format: Valve
+// entity 0
+{
+"classname" "worldspawn"
+"wad" "/quake/id1/gfx.wad"
+"mapversion" "220"
+)";
+
+  auto brushNo = size_t(0);
+  while (result.size() < MapSize)
+  {
+    const auto x = double(brushNo % 64) * 64.0 - 2048.0;
+    const auto y = double((brushNo / 64) % 64) * 64.0 - 2048.0;
+    const auto z = double(brushNo / 4096) * 64.0 + 0.5;
+
+    result += fmt::format(
+      R"(// brush {0}
+{{
+( {1} {2} {3} ) ( {1} {5} {3} ) ( {1} {2} {6} ) wbrick1_5 [ 0 -1 0 -0 ] [ -0 -0 -1 16 ] 0 1 1
+( {1} {2} {3} ) ( {1} {2} {6} ) ( {4} {2} {3} ) wbrick1_5 [ 1 0 -0 -0 ] [ -0 -0 -1 16 ] 0 1 1
+( {1} {2} {3} ) ( {4} {2} {3} ) ( {1} {5} {3} ) wbrick1_5 [ -1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1
+( {4} {5} {6} ) ( {1} {5} {6} ) ( {4} {2} {6} ) wbrick1_5 [ 1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1
+( {4} {5} {6} ) ( {4} {2} {6} ) ( {4} {5} {3} ) wbrick1_5 [ 0 1 0 -0 ] [ 0 0 -1 16 ] 0 1 1
+( {4} {5} {6} ) ( {4} {5} {3} ) ( {1} {5} {6} ) wbrick1_5 [ -1 0 0 0 ] [ 0 0 -1 16 ] 0 1 1
+}}
+)",
+      brushNo,
+      x,
+      y,
+      z,
+      x + 64.0,
+      y + 64.0,
+      z + 64.0);
+    ++brushNo;
+  }
+  result += "}\n";
+
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    result += fmt::format(
+      R"(// entity {}
+{{
+"classname" "light"
+"origin" "{} {} 128"
+"_color" "1 0.5 0.25"
+"message" "a \"quoted\" message"
+}}
+)",
+      i + 1,
+      double(i % 32) * 128.0,
+      double(i / 32) * 128.0);
+  }
+
+  return result;
+}
+
+/**
+ * Generates a map consisting of point entities with long comments and property values.
+ */
+std::string makeCommentedMap()
+{
+  const auto comment = std::string(200, 'c');
+  const auto message = std::string(200, 'm');
+
+  auto result = std::string{};
+  result.reserve(MapSize + 4096);
+
+  auto entityNo = size_t(0);
+  while (result.size() < MapSize)
+  {
+    result += fmt::format(
+      R"(// entity {0} {1}
+{{
+"classname" "info_notnull"
+"message" "{2}"
+}}
+)",
+      entityNo,
+      comment,
+      message);
+    ++entityNo;
+  }
+
+  return result;
+}
+
+size_t tokenize(const std::string& map, const std::string& name)
+{
+  auto tokenizer = QuakeMapTokenizer{map};
+  auto tokenCount = size_t(0);
+  timeLambda(
+    [&]() {
+      while (tokenizer.nextToken().type() != QuakeMapToken::Eof)
+      {
+        ++tokenCount;
+      }
+    },
+    fmt::format("tokenize {} MB {}", map.size() / (1024 * 1024), name));
+
+  CHECK(tokenizer.line() == size_t(std::ranges::count(map, '\n')) + 1);
+  return tokenCount;
+}
+
+} // namespace
+
+TEST_CASE("TokenizerBenchmark.tokenizeValveMap")
+{
+  CHECK(tokenize(makeValveMap(), "Valve 220 map") > 0);
+}
+
+TEST_CASE("TokenizerBenchmark.tokenizeCommentedMap")
+{
+  CHECK(tokenize(makeCommentedMap(), "map with long comments and strings") > 0);
+}
+
+} // namespace tb::io
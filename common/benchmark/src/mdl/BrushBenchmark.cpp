@@ -0,0 +1,135 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushFaceAttributes.h"
+#include "mdl/CircleShape.h"
+#include "mdl/MapFormat.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/mat_ext.h"
+#include "vm/scalar.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <string>
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t NumBrushes = 10'000;
+const auto WorldBounds = vm::bbox3d{8192.0};
+
+auto makeBrushes()
+{
+  const auto builder = BrushBuilder{MapFormat::Valve, WorldBounds};
+
+  auto result = std::vector<Brush>{};
+  result.reserve(NumBrushes);
+  for (size_t i = 0; i < NumBrushes; ++i)
+  {
+    const auto min = vm::vec3d{double(i % 100), double(i / 100), 0.0} * 128.0
+                     - vm::vec3d{6400.0, 6400.0, 0.0};
+    const auto bounds = vm::bbox3d{min, min + vm::vec3d{96.0, 96.0, 128.0}};
+    result.push_back(
+      builder.createCylinder(bounds, EdgeAlignedCircle{16}, vm::axis::z, "material")
+      | kdl::value());
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("BrushBenchmark.copy")
+{
+  const auto brushes = makeBrushes();
+
+  auto copies = std::vector<Brush>{};
+  copies.reserve(brushes.size());
+
+  timeAndCountAllocations(
+    [&]() {
+      for (const auto& brush : brushes)
+      {
+        copies.push_back(brush);
+      }
+    },
+    fmt::format("copy {} brushes", brushes.size()));
+
+  CHECK(copies == brushes);
+}
+
+TEST_CASE("BrushBenchmark.transform")
+{
+  auto brushes = makeBrushes();
+  const auto transformation =
+    vm::rotation_matrix(vm::vec3d{0, 0, 1}, vm::to_radians(90.0))
+    * vm::translation_matrix(vm::vec3d{16, 8, 4});
+
+  timeAndCountAllocations(
+    [&]() {
+      for (auto& brush : brushes)
+      {
+        brush.transform(WorldBounds, transformation, false)
+          | kdl::transform_error([](auto e) { FAIL(e.msg); });
+      }
+    },
+    fmt::format("transform {} brushes", brushes.size()));
+
+  CHECK(brushes.front().faceCount() == 18u);
+}
+
+TEST_CASE("BrushBenchmark.clip")
+{
+  auto brushes = makeBrushes();
+
+  timeAndCountAllocations(
+    [&]() {
+      for (auto& brush : brushes)
+      {
+        const auto center = brush.bounds().center();
+        BrushFace::create(
+          center,
+          center + vm::vec3d{0, 1, 0.25},
+          center + vm::vec3d{1, 0, 0.25},
+          BrushFaceAttributes{"material"},
+          MapFormat::Valve)
+          | kdl::and_then(
+            [&](auto face) { return brush.clip(WorldBounds, std::move(face)); })
+          | kdl::transform_error([](auto e) { FAIL(e.msg); });
+      }
+    },
+    fmt::format("clip {} brushes", brushes.size()));
+
+  // the clip face replaces the bottom face
+  CHECK(brushes.front().faceCount() == 18u);
+  CHECK(brushes.front().bounds().size().z() < 128.0);
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,216 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/EntityNodeIndex.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/InternedString.h"
+
+#include <fmt/format.h>
+
+#include <array>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t NumEntities = 30'000;
+
+constexpr auto Classnames = std::array{
+  "light",
+  "func_door",
+  "func_button",
+  "func_wall",
+  "func_breakable",
+  "trigger_multiple",
+  "trigger_once",
+  "env_sprite",
+  "env_glow",
+  "ambient_generic",
+  "monster_scientist",
+  "monster_barney",
+  "path_corner",
+  "info_node",
+  "multi_manager",
+  "weapon_9mmhandgun",
+};
+
+// mimics the properties of a Half-Life map, where many keys and values repeat
+auto makeProperties()
+{
+  auto result = std::vector<std::vector<std::string>>{};
+  result.reserve(NumEntities);
+
+  for (size_t i = 0; i < NumEntities; ++i)
+  {
+    auto& properties = result.emplace_back();
+    properties.emplace_back("classname");
+    properties.emplace_back(Classnames[i % Classnames.size()]);
+    properties.emplace_back("origin");
+    const auto n = int(i);
+    properties.emplace_back(fmt::format(
+      "{} {} {}", (n * 37) % 4096 - 2048, (n * 91) % 4096 - 2048, (n * 13) % 512));
+    properties.emplace_back("angles");
+    properties.emplace_back(fmt::format("0 {} 0", (i % 8) * 45));
+
+    if (i % 3 == 0)
+    {
+      properties.emplace_back("targetname");
+      properties.emplace_back(fmt::format("target_{}", i / 3));
+    }
+    if (i % 3 == 1)
+    {
+      properties.emplace_back("target");
+      properties.emplace_back(fmt::format("target_{}", i / 3));
+    }
+    if (i % 2 == 0)
+    {
+      properties.emplace_back("model");
+      properties.emplace_back(fmt::format("*{}", i / 2));
+      properties.emplace_back("rendermode");
+      properties.emplace_back(std::to_string(i % 6));
+      properties.emplace_back("renderamt");
+      properties.emplace_back(i % 4 == 0 ? "255" : "150");
+      properties.emplace_back("rendercolor");
+      properties.emplace_back("0 0 0");
+    }
+  }
+
+  return result;
+}
+
+size_t memoryUsage(const std::string& str)
+{
+  // copies of the string only allocate a buffer if it doesn't fit into the string
+  const auto copy = str;
+  return sizeof(std::string)
+         + (copy.capacity() > std::string{}.capacity() ? copy.capacity() + 1 : 0);
+}
+
+} // namespace
+
+TEST_CASE("EntityPropertiesBenchmark.memoryUsage")
+{
+  const auto strings = makeProperties();
+
+  auto numProperties = size_t(0);
+  auto stringMemoryUsage = size_t(0);
+  for (const auto& properties : strings)
+  {
+    numProperties += properties.size() / 2;
+    for (const auto& str : properties)
+    {
+      stringMemoryUsage += memoryUsage(str);
+    }
+  }
+
+  const auto statsBefore = InternedString::stats();
+
+  auto entities = std::vector<Entity>{};
+  entities.reserve(NumEntities);
+  timeLambda(
+    [&]() {
+      for (const auto& properties : strings)
+      {
+        auto entityProperties = std::vector<EntityProperty>{};
+        entityProperties.reserve(properties.size() / 2);
+        for (size_t i = 0; i < properties.size(); i += 2)
+        {
+          entityProperties.emplace_back(properties[i], properties[i + 1]);
+        }
+        entities.emplace_back(std::move(entityProperties));
+      }
+    },
+    fmt::format("create {} entities with {} properties", NumEntities, numProperties));
+
+  const auto statsAfter = InternedString::stats();
+  const auto numStrings = statsAfter.count - statsBefore.count;
+  const auto internedMemoryUsage =
+    numProperties * sizeof(EntityProperty) + statsAfter.bytes - statsBefore.bytes;
+
+  printf(
+    "Memory used by the keys and values of %zu properties: %zu bytes as strings, %zu "
+    "bytes as %zu interned strings, %zu bytes saved\n",
+    numProperties,
+    stringMemoryUsage,
+    internedMemoryUsage,
+    numStrings,
+    stringMemoryUsage - internedMemoryUsage);
+
+  CHECK(internedMemoryUsage < stringMemoryUsage);
+
+  const auto copies = entities;
+  auto numEqual = size_t(0);
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < entities.size(); ++i)
+      {
+        if (entities[i].properties() == copies[i].properties())
+        {
+          ++numEqual;
+        }
+      }
+    },
+    fmt::format("compare {} entities", NumEntities));
+
+  CHECK(numEqual == NumEntities);
+
+  auto entityNodes = std::vector<std::unique_ptr<EntityNode>>{};
+  entityNodes.reserve(NumEntities);
+  for (const auto& entity : entities)
+  {
+    entityNodes.push_back(std::make_unique<EntityNode>(entity));
+  }
+
+  auto index = EntityNodeIndex{};
+  timeLambda(
+    [&]() {
+      for (const auto& entityNode : entityNodes)
+      {
+        index.addEntityNode(entityNode.get());
+      }
+    },
+    fmt::format("add {} entities to EntityNodeIndex", NumEntities));
+
+  auto numFound = size_t(0);
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumEntities / 3; ++i)
+      {
+        numFound += index
+                      .findEntityNodes(
+                        EntityNodeIndexQuery::exact("targetname"),
+                        fmt::format("target_{}", i))
+                      .size();
+      }
+    },
+    fmt::format("find {} entities by targetname", NumEntities / 3));
+
+  CHECK(numFound == NumEntities / 3);
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,242 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EditorContext.h"
+#include "mdl/LayerNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/PickResult.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/intersection.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t GridSize = 24;
+constexpr double GridSpacing = 96.0;
+constexpr size_t NumRays = 1'000;
+constexpr size_t NumPackets = 100'000;
+
+auto makeBrushes()
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto result = std::vector<BrushNode*>{};
+  for (size_t x = 0; x < GridSize; ++x)
+  {
+    for (size_t y = 0; y < GridSize; ++y)
+    {
+      for (size_t z = 0; z < GridSize; ++z)
+      {
+        const auto min = vm::vec3d{double(x), double(y), double(z)} * GridSpacing
+                         - vm::vec3d::fill(double(GridSize) * GridSpacing / 2.0);
+        const auto bounds = vm::bbox3d{min, min + vm::vec3d::fill(64.0)};
+        result.push_back(
+          new BrushNode{builder.createCuboid(bounds, "material") | kdl::value()});
+      }
+    }
+  }
+  return result;
+}
+
+auto makeRays(std::mt19937& rng)
+{
+  const auto extent = double(GridSize) * GridSpacing;
+  auto position = std::uniform_real_distribution<double>{-extent, extent};
+  auto direction = std::uniform_real_distribution<double>{-1.0, 1.0};
+
+  auto result = std::vector<vm::ray3d>{};
+  for (size_t i = 0; i < NumRays; ++i)
+  {
+    const auto origin = vm::vec3d{position(rng), position(rng), position(rng)};
+    result.emplace_back(
+      origin,
+      vm::normalize(vm::vec3d{direction(rng), direction(rng), direction(rng)}));
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("PickBenchmark.intersectRayBboxPacket")
+{
+  auto rng = std::mt19937{0};
+  auto position = std::uniform_real_distribution<double>{-1024.0, 1024.0};
+  auto size = std::uniform_real_distribution<double>{8.0, 512.0};
+
+  auto packets = std::vector<vm::bbox_packet<double, 8>>(NumPackets);
+  for (auto& packet : packets)
+  {
+    for (size_t i = 0; i < 8; ++i)
+    {
+      const auto min = vm::vec3d{position(rng), position(rng), position(rng)};
+      packet.set(i, vm::bbox3d{min, min + vm::vec3d{size(rng), size(rng), size(rng)}});
+    }
+  }
+
+  const auto ray =
+    vm::ray3d{{-2048.0, -1024.0, -512.0}, vm::normalize(vm::vec3d{4, 2, 1})};
+
+  auto scalarMasks = std::vector<std::uint32_t>{};
+  timeLambda(
+    [&]() {
+      for (const auto& packet : packets)
+      {
+        auto mask = std::uint32_t(0);
+        for (size_t i = 0; i < 8; ++i)
+        {
+          const auto bounds = packet.get(i);
+          if (bounds.contains(ray.origin) || vm::intersect_ray_bbox(ray, bounds))
+          {
+            mask |= std::uint32_t(1) << i;
+          }
+        }
+        scalarMasks.push_back(mask);
+      }
+    },
+    fmt::format("intersect ray with {} boxes one by one", NumPackets * 8));
+
+  auto packetMasks = std::vector<std::uint32_t>{};
+  timeLambda(
+    [&]() {
+      for (const auto& packet : packets)
+      {
+        packetMasks.push_back(vm::intersect_ray_bbox_packet(ray, packet));
+      }
+    },
+    fmt::format("intersect ray with {} boxes in packets of 8", NumPackets * 8));
+
+  CHECK(packetMasks == scalarMasks);
+}
+
+TEST_CASE("PickBenchmark.pickBrushes")
+{
+  auto rng = std::mt19937{0};
+  const auto rays = makeRays(rng);
+
+  auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+  const auto brushNodes = makeBrushes();
+  for (auto* brushNode : brushNodes)
+  {
+    worldNode.defaultLayer()->addChild(brushNode);
+  }
+
+  auto polygonHits = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        for (auto* node : worldNode.defaultLayer()->children())
+        {
+          const auto& brush = static_cast<BrushNode*>(node)->brush();
+          if (vm::intersect_ray_bbox(ray, brush.bounds()))
+          {
+            for (const auto& face : brush.faces())
+            {
+              const auto vertices = face.vertexPositions();
+              if (
+                vm::dot(face.boundary().normal, ray.direction) < 0.0
+                && vm::intersect_ray_polygon(
+                  ray, face.boundary(), vertices.begin(), vertices.end()))
+              {
+                ++polygonHits;
+                break;
+              }
+            }
+          }
+        }
+      }
+    },
+    fmt::format(
+      "pick {} brushes with {} rays using the general polygon test",
+      brushNodes.size(),
+      rays.size()));
+
+  auto convexPolygonHits = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        for (auto* node : worldNode.defaultLayer()->children())
+        {
+          const auto& brush = static_cast<BrushNode*>(node)->brush();
+          if (vm::intersect_ray_bbox(ray, brush.bounds()))
+          {
+            for (const auto& face : brush.faces())
+            {
+              const auto vertices = face.vertexPositions();
+              if (
+                vm::dot(face.boundary().normal, ray.direction) < 0.0
+                && vm::intersect_ray_convex_polygon(
+                  ray, face.boundary(), vertices.begin(), vertices.end()))
+              {
+                ++convexPolygonHits;
+                break;
+              }
+            }
+          }
+        }
+      }
+    },
+    fmt::format(
+      "pick {} brushes with {} rays using the convex polygon test",
+      brushNodes.size(),
+      rays.size()));
+
+  CHECK(convexPolygonHits == polygonHits);
+
+  const auto editorContext = EditorContext{};
+  auto treeHits = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& ray : rays)
+      {
+        auto pickResult = PickResult{};
+        worldNode.pick(editorContext, ray, pickResult);
+        treeHits += pickResult.size();
+      }
+    },
+    fmt::format(
+      "pick {} brushes with {} rays using WorldNode::pick",
+      brushNodes.size(),
+      rays.size()));
+
+  CHECK(treeHits == polygonHits);
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,140 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/MapFormat.h"
+#include "render/EntityDecalIndex.h"
+
+#include "kdl/result.h"
+
+#include <fmt/format.h>
+
+#include <memory>
+#include <vector>
+
+namespace tb::render
+{
+namespace
+{
+
+constexpr size_t GridSize = 32;
+constexpr double GridSpacing = 128.0;
+constexpr size_t NumBrushes = 1'000;
+
+auto makeDecalEntities()
+{
+  // place the decals on a regular grid in the XY plane
+  auto result = std::vector<std::unique_ptr<mdl::EntityNode>>{};
+  for (size_t x = 0; x < GridSize; ++x)
+  {
+    for (size_t y = 0; y < GridSize; ++y)
+    {
+      const auto origin = fmt::format(
+        "{} {} 0",
+        (double(x) - double(GridSize) / 2.0) * GridSpacing,
+        (double(y) - double(GridSize) / 2.0) * GridSpacing);
+      result.push_back(
+        std::make_unique<mdl::EntityNode>(mdl::Entity{{{"origin", origin}}}));
+    }
+  }
+  return result;
+}
+
+auto makeBrushes()
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = mdl::BrushBuilder{mdl::MapFormat::Standard, worldBounds};
+
+  // spread small brushes across the grid so that each one touches only a few decals
+  auto result = std::vector<std::unique_ptr<mdl::BrushNode>>{};
+  for (size_t i = 0; i < NumBrushes; ++i)
+  {
+    const auto x = (double(i % GridSize) - double(GridSize) / 2.0) * GridSpacing;
+    const auto y =
+      (double((i / GridSize) % GridSize) - double(GridSize) / 2.0) * GridSpacing;
+    const auto bounds =
+      vm::bbox3d{{x - 32.0, y - 32.0, -32.0}, {x + 32.0, y + 32.0, 32.0}};
+    result.push_back(std::make_unique<mdl::BrushNode>(
+      builder.createCuboid(bounds, "material") | kdl::value()));
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("EntityDecalIndexBenchmark.findAffectedEntities")
+{
+  const auto entityNodes = makeDecalEntities();
+  const auto brushNodes = makeBrushes();
+
+  auto index = EntityDecalIndex{};
+  timeLambda(
+    [&]() {
+      for (const auto& entityNode : entityNodes)
+      {
+        index.addOrUpdateEntity(entityNode.get());
+      }
+    },
+    fmt::format("add {} decal entities to EntityDecalIndex", entityNodes.size()));
+
+  auto linearCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& brushNode : brushNodes)
+      {
+        for (const auto& entityNode : entityNodes)
+        {
+          if (brushNode->intersects(entityNode.get()))
+          {
+            ++linearCount;
+          }
+        }
+      }
+    },
+    fmt::format(
+      "find decals intersecting {} brushes by visiting {} decals",
+      brushNodes.size(),
+      entityNodes.size()));
+
+  auto indexedCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& brushNode : brushNodes)
+      {
+        for (const auto* entityNode : index.findAffectedEntities(brushNode.get()))
+        {
+          if (brushNode->intersects(entityNode))
+          {
+            ++indexedCount;
+          }
+        }
+      }
+    },
+    fmt::format(
+      "find decals intersecting {} brushes using EntityDecalIndex", brushNodes.size()));
+
+  CHECK(indexedCount == linearCount);
+}
+
+} // namespace tb::render
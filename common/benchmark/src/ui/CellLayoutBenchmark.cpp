@@ -0,0 +1,185 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "ui/CellLayout.h"
+
+#include <fmt/format.h>
+
+#include <string>
+#include <vector>
+
+namespace tb::ui
+{
+namespace
+{
+
+constexpr size_t NumGroups = 16;
+constexpr size_t NumItemsPerGroup = 500;
+constexpr size_t NumQueries = 10'000;
+
+struct Item
+{
+  std::string title;
+  float width;
+  float height;
+};
+
+auto makeItems()
+{
+  // vary the item sizes like a material collection with mixed texture sizes
+  auto result = std::vector<std::vector<Item>>{};
+  for (size_t i = 0; i < NumGroups; ++i)
+  {
+    auto& items = result.emplace_back();
+    for (size_t j = 0; j < NumItemsPerGroup; ++j)
+    {
+      const auto width = float(16 << (j % 4));
+      const auto height = float(16 << ((j / 4) % 4));
+      items.push_back(Item{fmt::format("material_{}_{}", i, j), width, height});
+    }
+  }
+  return result;
+}
+
+auto makeLayout(const float width)
+{
+  auto layout = CellLayout{};
+  layout.setCellWidth(64.0f, 64.0f);
+  layout.setCellHeight(64.0f, 128.0f);
+  layout.setCellMargin(12.0f);
+  layout.setTitleMargin(4.0f);
+  layout.setRowMargin(12.0f);
+  layout.setGroupMargin(8.0f);
+  layout.setOuterMargin(12.0f);
+  layout.setWidth(width);
+  return layout;
+}
+
+void addItems(CellLayout& layout, const std::vector<Item>& items, const size_t first = 0)
+{
+  for (auto i = first; i < items.size(); ++i)
+  {
+    const auto& item = items[i];
+    layout.addItem(i, item.title, item.width, item.height, 64.0f, 14.0f);
+  }
+}
+
+void addGroups(CellLayout& layout, const std::vector<std::vector<Item>>& groups)
+{
+  for (size_t i = 0; i < groups.size(); ++i)
+  {
+    layout.addGroup(fmt::format("collection_{}", i), 16.0f);
+    addItems(layout, groups[i]);
+  }
+}
+
+} // namespace
+
+TEST_CASE("CellLayoutBenchmark.update")
+{
+  const auto groups = makeItems();
+  const auto numItems = NumGroups * NumItemsPerGroup;
+
+  auto layout = makeLayout(1024.0f);
+  timeLambda(
+    [&]() { addGroups(layout, groups); }, fmt::format("lay out {} cells", numItems));
+
+  // change an item in the last group, e.g. because its texture was loaded
+  auto changedGroups = groups;
+  changedGroups.back()[NumItemsPerGroup / 2].height = 256.0f;
+
+  auto fullLayout = makeLayout(1024.0f);
+  timeLambda(
+    [&]() {
+      fullLayout.clear();
+      addGroups(fullLayout, changedGroups);
+    },
+    fmt::format("lay out {} cells after changing one cell", numItems));
+
+  timeLambda(
+    [&]() {
+      const auto firstItem = layout.truncate(NumGroups - 1, NumItemsPerGroup / 2);
+      addItems(layout, changedGroups.back(), firstItem);
+    },
+    "update the layout after changing one cell");
+
+  CHECK(layout.height() == fullLayout.height());
+
+  timeLambda(
+    [&]() {
+      layout.setWidth(800.0f);
+      layout.height();
+    },
+    fmt::format("lay out {} cells after changing the width", numItems));
+}
+
+TEST_CASE("CellLayoutBenchmark.visibleRows")
+{
+  auto layout = makeLayout(1024.0f);
+  addGroups(layout, makeItems());
+
+  const auto viewHeight = 600.0f;
+  const auto maxY = layout.height() - viewHeight;
+
+  auto linearCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumQueries; ++i)
+      {
+        const auto y = maxY * float(i) / float(NumQueries);
+        for (const auto& group : layout.groups())
+        {
+          for (const auto& row : group.rows())
+          {
+            if (row.intersectsY(y, viewHeight))
+            {
+              linearCount += row.cells().size();
+            }
+          }
+        }
+      }
+    },
+    fmt::format("find visible cells {} times by visiting all rows", NumQueries));
+
+  auto searchCount = size_t(0);
+  timeLambda(
+    [&]() {
+      for (size_t i = 0; i < NumQueries; ++i)
+      {
+        const auto y = maxY * float(i) / float(NumQueries);
+        for (const auto& group : layout.groups())
+        {
+          if (group.intersectsY(y, viewHeight))
+          {
+            for (const auto& row : group.rowsIntersectingY(y, viewHeight))
+            {
+              searchCount += row.cells().size();
+            }
+          }
+        }
+      }
+    },
+    fmt::format("find visible cells {} times using rowsIntersectingY", NumQueries));
+
+  CHECK(searchCount == linearCount);
+}
+
+} // namespace tb::ui
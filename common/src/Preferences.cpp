@@ -189,6 +189,8 @@ Preference<bool> EnableMSAA("render/Enable multisampling", true);
 
 Preference<bool> AlignmentLock("Editor/Texture lock", true);
 Preference<bool> UVLock("Editor/UV lock", false);
+Preference<bool> UseMapCache("Editor/Use map cache", false);
+Preference<int> UndoMemoryBudget("Editor/Undo memory budget", 1024);
 
 Preference<std::filesystem::path>& RendererFontPath()
 {
@@ -383,6 +385,8 @@ const std::vector<PreferenceBase*>& staticPreferences()
     &TextureMagFilter,
     &AlignmentLock,
     &UVLock,
+    &UseMapCache,
+    &UndoMemoryBudget,
     &RendererFontPath(),
     &RendererFontSize,
     &BrowserFontSize,
@@ -133,6 +133,8 @@ extern Preference<bool> EnableMSAA;
 
 extern Preference<bool> AlignmentLock;
 extern Preference<bool> UVLock;
+extern Preference<bool> UseMapCache;
+extern Preference<int> UndoMemoryBudget;
 
 Preference<std::filesystem::path>& RendererFontPath();
 extern Preference<int> RendererFontSize;
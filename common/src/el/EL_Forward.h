@@ -25,6 +25,8 @@ class Value;
 enum class ValueType;
 
 class ExpressionNode;
+template <typename T>
+class ExpressionCache;
 
 class EvaluationContext;
 class EvaluationTrace;
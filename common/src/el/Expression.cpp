@@ -1408,6 +1408,46 @@ ExpressionNode ExpressionNode::optimize(EvaluationContext& context) const
     m_location};
 }
 
+std::vector<std::string> ExpressionNode::variableNames() const
+{
+  auto result = std::vector<std::string>{};
+  accept(kdl::overload(
+    [](const LiteralExpression&) {},
+    [&](const VariableExpression& expression) {
+      result.push_back(expression.variableName);
+    },
+    [](const auto& thisLambda, const ArrayExpression& expression) {
+      for (const auto& element : expression.elements)
+      {
+        element.accept(thisLambda);
+      }
+    },
+    [](const auto& thisLambda, const MapExpression& expression) {
+      for (const auto& [key, element] : expression.elements)
+      {
+        element.accept(thisLambda);
+      }
+    },
+    [](const auto& thisLambda, const UnaryExpression& expression) {
+      expression.operand.accept(thisLambda);
+    },
+    [](const auto& thisLambda, const BinaryExpression& expression) {
+      expression.leftOperand.accept(thisLambda);
+      expression.rightOperand.accept(thisLambda);
+    },
+    [](const auto& thisLambda, const SubscriptExpression& expression) {
+      expression.leftOperand.accept(thisLambda);
+      expression.rightOperand.accept(thisLambda);
+    },
+    [](const auto& thisLambda, const SwitchExpression& expression) {
+      for (const auto& caseExpression : expression.cases)
+      {
+        caseExpression.accept(thisLambda);
+      }
+    }));
+  return kdl::vec_sort_and_remove_duplicates(std::move(result));
+}
+
 const std::optional<FileLocation>& ExpressionNode::location() const
 {
   return m_location;
@@ -1422,7 +1462,7 @@ std::string ExpressionNode::asString() const
 
 bool operator==(const ExpressionNode& lhs, const ExpressionNode& rhs)
 {
-  return *lhs.m_expression == *rhs.m_expression;
+  return lhs.m_expression == rhs.m_expression || *lhs.m_expression == *rhs.m_expression;
 }
 
 bool operator!=(const ExpressionNode& lhs, const ExpressionNode& rhs)
@@ -122,6 +122,12 @@ public:
 
   ExpressionNode optimize(EvaluationContext& context) const;
 
+  /**
+   * Returns the names of the variables referenced by this expression, sorted and without
+   * duplicates.
+   */
+  std::vector<std::string> variableNames() const;
+
   const std::optional<FileLocation>& location() const;
 
   std::string asString() const;
@@ -0,0 +1,141 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "el/Types.h"
+#include "el/Value.h"
+#include "el/VariableStore.h"
+
+#include "kdl/hash_utils.h"
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tb::el
+{
+
+/**
+ * Memoizes the results of evaluating an expression.
+ *
+ * The names of the variables referenced by the expression are passed when the cache is
+ * created. Results are stored per tuple of the values of these variables, so evaluating
+ * the expression again with the same variable values only costs a lookup. Only string
+ * values are used as keys. If a variable has a value of another type, the result is not
+ * cached.
+ *
+ * The cache is cleared when it grows too large, and it can be used from multiple
+ * threads.
+ */
+template <typename T>
+class ExpressionCache
+{
+private:
+  static constexpr size_t MaxSize = 1 << 14;
+
+  using Key = std::vector<std::string>;
+
+  struct KeyHash
+  {
+    size_t operator()(const Key& key) const
+    {
+      auto result = size_t(0);
+      for (const auto& value : key)
+      {
+        result = kdl::combine_hash(result, kdl::hash(value));
+      }
+      return result;
+    }
+  };
+
+  std::vector<std::string> m_variableNames;
+  std::mutex m_mutex;
+  std::unordered_map<Key, T, KeyHash> m_results;
+
+public:
+  explicit ExpressionCache(std::vector<std::string> variableNames)
+    : m_variableNames{std::move(variableNames)}
+  {
+  }
+
+  /**
+   * Returns the cached result for the values of the variables in the given store, or
+   * calls the given function to evaluate the expression and caches its result.
+   */
+  template <typename F>
+  T getOrEvaluate(const VariableStore& variableStore, const F& evaluate)
+  {
+    auto key = makeKey(variableStore);
+    if (!key)
+    {
+      return evaluate();
+    }
+
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      if (const auto it = m_results.find(*key); it != m_results.end())
+      {
+        return it->second;
+      }
+    }
+
+    auto result = evaluate();
+
+    const auto lock = std::lock_guard{m_mutex};
+    if (m_results.size() >= MaxSize)
+    {
+      m_results.clear();
+    }
+    m_results.emplace(std::move(*key), result);
+    return result;
+  }
+
+  /**
+   * Returns the number of cached results.
+   */
+  size_t size()
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    return m_results.size();
+  }
+
+private:
+  std::optional<Key> makeKey(const VariableStore& variableStore) const
+  {
+    auto key = Key{};
+    key.reserve(m_variableNames.size());
+
+    for (const auto& variableName : m_variableNames)
+    {
+      const auto value = variableStore.value(variableName);
+      if (value.type() != ValueType::String)
+      {
+        return std::nullopt;
+      }
+      key.push_back(value.asString());
+    }
+
+    return key;
+  }
+};
+
+} // namespace tb::el
@@ -65,7 +65,7 @@ AseTokenizer::AseTokenizer(const std::string_view str)
 {
 }
 
-const std::string AseTokenizer::WordDelims = " \t\n\r:";
+const CharClass AseTokenizer::WordDelims = " \t\n\r:";
 
 Tokenizer<unsigned int>::Token AseTokenizer::emitToken()
 {
@@ -65,7 +65,7 @@ using LoadMaterialFunc = std::function<mdl::Material(const std::filesystem::path
 class AseTokenizer : public Tokenizer<AseToken::Type>
 {
 private:
-  static const std::string WordDelims;
+  static const CharClass WordDelims;
 
 public:
   explicit AseTokenizer(std::string_view str);
@@ -0,0 +1,58 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "io/ParserStatus.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace tb::io
+{
+
+/**
+ * Collects the messages logged to it instead of logging them immediately. The messages
+ * are formatted like the given target status would format them, and they are passed on
+ * to the target status when flush is called.
+ *
+ * This allows parsing independent parts of a file on different threads while still
+ * reporting the messages in file order.
+ */
+class BufferedParserStatus : public ParserStatus
+{
+private:
+  ParserStatus& m_target;
+  std::vector<std::tuple<LogLevel, std::string>> m_messages;
+
+public:
+  explicit BufferedParserStatus(ParserStatus& target);
+
+  /**
+   * Passes all collected messages on to the target status and clears them.
+   */
+  void flush();
+
+private:
+  void doProgress(double progress) override;
+  void doLog(LogLevel level, const std::string& str) override;
+};
+
+} // namespace tb::io
@@ -0,0 +1,180 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TB_CHAR_CLASS_SSE2
+#endif
+
+namespace tb::io
+{
+
+/**
+ * A set of characters such as the delimiters or whitespace characters of a tokenizer.
+ *
+ * Membership is tested using a bitmap with one bit for each of the 256 byte values. If
+ * the set is small, long ranges of characters are additionally scanned 16 bytes at a
+ * time using SSE2 instructions where available.
+ */
+class CharClass
+{
+private:
+  static constexpr size_t MaxSimdChars = 16;
+
+  std::array<std::uint64_t, 4> m_bits{};
+  std::array<char, MaxSimdChars> m_chars{};
+  size_t m_charCount = 0;
+
+public:
+  constexpr CharClass() = default;
+
+  // these constructors are implicit so that strings can be passed as character classes
+  constexpr CharClass(const std::string_view chars)
+  {
+    for (const auto c : chars)
+    {
+      add(c);
+    }
+  }
+
+  constexpr CharClass(const char* chars)
+    : CharClass{std::string_view{chars}}
+  {
+  }
+
+  CharClass(const std::string& chars)
+    : CharClass{std::string_view{chars}}
+  {
+  }
+
+  constexpr bool contains(const char c) const
+  {
+    const auto b = static_cast<unsigned char>(c);
+    return (m_bits[b >> 6] >> (b & 63)) & 1;
+  }
+
+  /**
+   * Returns the union of the given character classes.
+   */
+  friend constexpr CharClass operator|(CharClass lhs, const CharClass& rhs)
+  {
+    for (size_t i = 0; i < 256; ++i)
+    {
+      if (rhs.contains(char(i)))
+      {
+        lhs.add(char(i));
+      }
+    }
+    return lhs;
+  }
+
+  /**
+   * Returns a pointer to the first character in the range [cur, end) that is contained
+   * in this set, or end if there is no such character.
+   */
+  const char* findFirstOf(const char* cur, const char* const end) const
+  {
+    return find<true>(cur, end);
+  }
+
+  /**
+   * Returns a pointer to the first character in the range [cur, end) that is not
+   * contained in this set, or end if there is no such character.
+   */
+  const char* findFirstNotOf(const char* cur, const char* const end) const
+  {
+    return find<false>(cur, end);
+  }
+
+private:
+  constexpr void add(const char c)
+  {
+    if (!contains(c))
+    {
+      const auto b = static_cast<unsigned char>(c);
+      m_bits[b >> 6] |= std::uint64_t(1) << (b & 63);
+      if (m_charCount < MaxSimdChars)
+      {
+        m_chars[m_charCount] = c;
+      }
+      ++m_charCount;
+    }
+  }
+
+  template <bool Contained>
+  const char* find(const char* cur, const char* const end) const
+  {
+    // most runs are short, so check the first block character by character
+    const auto* blockEnd = cur + std::min(end - cur, std::ptrdiff_t(16));
+    while (cur != blockEnd)
+    {
+      if (contains(*cur) == Contained)
+      {
+        return cur;
+      }
+      ++cur;
+    }
+
+#ifdef TB_CHAR_CLASS_SSE2
+    if (m_charCount <= MaxSimdChars)
+    {
+      while (end - cur >= 16)
+      {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+        auto matches = _mm_setzero_si128();
+        for (size_t i = 0; i < m_charCount; ++i)
+        {
+          matches =
+            _mm_or_si128(matches, _mm_cmpeq_epi8(block, _mm_set1_epi8(m_chars[i])));
+        }
+
+        auto mask = static_cast<unsigned int>(_mm_movemask_epi8(matches));
+        if constexpr (!Contained)
+        {
+          mask = ~mask & 0xFFFF;
+        }
+
+        if (mask != 0)
+        {
+          return cur + std::countr_zero(mask);
+        }
+        cur += 16;
+      }
+    }
+#endif
+
+    while (cur != end && contains(*cur) != Contained)
+    {
+      ++cur;
+    }
+    return cur;
+  }
+};
+
+} // namespace tb::io
@@ -72,7 +72,7 @@ DefTokenizer::DefTokenizer(const std::string_view str)
 {
 }
 
-const std::string DefTokenizer::WordDelims = " \t\n\r()[]{};,=";
+const CharClass DefTokenizer::WordDelims = " \t\n\r()[]{};,=";
 
 DefTokenizer::Token DefTokenizer::emitToken()
 {
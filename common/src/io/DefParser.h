@@ -63,7 +63,7 @@ public:
   explicit DefTokenizer(std::string_view str);
 
 private:
-  static const std::string WordDelims;
+  static const CharClass WordDelims;
   Token emitToken() override;
 };
 
@@ -87,9 +87,7 @@ Result<std::vector<std::filesystem::path>> DiskFileSystem::doFind(
 Result<std::shared_ptr<File>> DiskFileSystem::doOpenFile(
   const std::filesystem::path& path) const
 {
-  return makeAbsolute(path) | kdl::and_then(Disk::openFile)
-         | kdl::transform(
-           [](auto cFile) { return std::static_pointer_cast<File>(cFile); });
+  return makeAbsolute(path) | kdl::and_then(Disk::openFile);
 }
 
 WritableDiskFileSystem::WritableDiskFileSystem(const std::filesystem::path& root)
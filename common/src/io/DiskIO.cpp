@@ -23,14 +23,21 @@
 #include "Macros.h"
 #include "io/File.h"
 #include "io/PathInfo.h"
+#include "io/ReaderException.h"
 #include "io/TraversalMode.h"
 
+#include "kdl/path_hash.h"
 #include "kdl/path_utils.h"
 #include "kdl/string_format.h"
 
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
 namespace tb::io::Disk
 {
 namespace
@@ -45,40 +52,155 @@ bool doCheckCaseSensitive()
          || !std::filesystem::exists(kdl::str_to_upper(cwd.string()));
 }
 
-std::filesystem::path fixCase(const std::filesystem::path& path)
+Result<std::shared_ptr<File>> openFixedPath(const std::filesystem::path& fixedPath)
 {
-  try
+  return createCFile(fixedPath)
+         | kdl::and_then([](auto file) -> Result<std::shared_ptr<File>> {
+             const auto size = file->size();
+             if (size >= MinMappedFileSize)
+             {
+               return std::static_pointer_cast<File>(file);
+             }
+
+             try
+             {
+               auto buffer = std::make_unique<char[]>(size);
+               file->reader().read(buffer.get(), size);
+               return std::static_pointer_cast<File>(
+                 std::make_shared<OwningBufferFile>(std::move(buffer), size));
+             }
+             catch (const ReaderException& e)
+             {
+               return Error{e.what()};
+             }
+           });
+}
+
+std::filesystem::file_time_type lastWriteTime(const std::filesystem::path& path)
+{
+  auto error = std::error_code{};
+  return std::filesystem::last_write_time(path, error);
+}
+
+/**
+ * Maps lower cased paths to actual paths on a case sensitive file system.
+ *
+ * The contents of a directory are indexed when a path in it is looked up for the first
+ * time. If a lookup fails, the directories whose last write time has changed since they
+ * were indexed are indexed again before the lookup is retried.
+ */
+class CaseIndex
+{
+private:
+  struct Directory
   {
-    if (
-      path.empty() || !path.is_absolute() || !isCaseSensitive()
-      || std::filesystem::exists(path))
+    std::filesystem::file_time_type lastWriteTime;
+    // maps the lower cased names of the directory entries to their actual names
+    std::unordered_map<std::filesystem::path, std::filesystem::path, kdl::path_hash>
+      entries;
+  };
+
+  std::mutex m_mutex;
+  // maps the lower cased paths of the indexed directories to their contents
+  std::unordered_map<std::filesystem::path, Directory, kdl::path_hash> m_directories;
+
+public:
+  std::optional<std::filesystem::path> find(const std::filesystem::path& path)
+  {
+    const auto lock = std::lock_guard{m_mutex};
+
+    auto error = std::error_code{};
+    if (auto result = find(path, false);
+        result && std::filesystem::exists(*result, error))
     {
-      return path;
+      return result;
     }
+    return find(path, true);
+  }
 
-    auto result = kdl::path_front(kdl::path_to_lower(path));
-    auto remainder = kdl::path_pop_front(kdl::path_to_lower(path));
+  void invalidate(const std::filesystem::path& path)
+  {
+    const auto lock = std::lock_guard{m_mutex};
+
+    // the parent directory lists the path, and the path may be an indexed directory
+    const auto lowerPath = kdl::path_to_lower(path);
+    const auto lowerParentPath = lowerPath.parent_path();
+    std::erase_if(m_directories, [&](const auto& entry) {
+      return entry.first == lowerParentPath
+             || kdl::path_has_prefix(entry.first, lowerPath);
+    });
+  }
 
-    while (!remainder.empty())
+private:
+  std::optional<std::filesystem::path> find(
+    const std::filesystem::path& path, const bool refresh)
+  {
+    const auto lowerPath = kdl::path_to_lower(path);
+
+    auto result = kdl::path_front(lowerPath);
+    auto lowerDirectoryPath = result;
+    for (auto it = std::next(lowerPath.begin()); it != lowerPath.end(); ++it)
     {
-      const auto nameToFind = kdl::path_front(remainder);
-      const auto entryIt = std::find_if(
-        std::filesystem::directory_iterator{result},
-        std::filesystem::directory_iterator{},
-        [&](const auto& entry) {
-          return nameToFind == kdl::path_to_lower(entry.path().filename());
-        });
-
-      if (entryIt == std::filesystem::directory_iterator{})
+      const auto& directory = indexDirectory(lowerDirectoryPath, result, refresh);
+      const auto entryIt = directory.entries.find(*it);
+      if (entryIt == directory.entries.end())
       {
-        return path;
+        return std::nullopt;
       }
 
-      result = result / entryIt->path().filename();
-      remainder = kdl::path_pop_front(remainder);
+      result = result / entryIt->second;
+      lowerDirectoryPath = lowerDirectoryPath / *it;
     }
     return result;
   }
+
+  const Directory& indexDirectory(
+    const std::filesystem::path& lowerPath,
+    const std::filesystem::path& path,
+    const bool refresh)
+  {
+    if (const auto it = m_directories.find(lowerPath); it != m_directories.end())
+    {
+      if (!refresh || it->second.lastWriteTime == lastWriteTime(path))
+      {
+        return it->second;
+      }
+    }
+
+    auto directory = Directory{lastWriteTime(path), {}};
+
+    auto error = std::error_code{};
+    for (auto it = std::filesystem::directory_iterator{path, error};
+         !error && it != std::filesystem::directory_iterator{};
+         it.increment(error))
+    {
+      const auto name = it->path().filename();
+      directory.entries.try_emplace(kdl::path_to_lower(name), name);
+    }
+
+    return m_directories.insert_or_assign(lowerPath, std::move(directory)).first->second;
+  }
+};
+
+CaseIndex& caseIndex()
+{
+  static auto instance = CaseIndex{};
+  return instance;
+}
+
+std::filesystem::path fixCase(const std::filesystem::path& path)
+{
+  try
+  {
+    if (
+      path.empty() || !path.is_absolute() || !isCaseSensitive()
+      || std::filesystem::exists(path))
+    {
+      return path;
+    }
+
+    return caseIndex().find(path).value_or(path);
+  }
   catch (const std::filesystem::filesystem_error&)
   {
     return path;
@@ -107,6 +229,11 @@ std::filesystem::path fixPath(const std::filesystem::path& path)
   return fixCase(path.lexically_normal());
 }
 
+void invalidateCaseIndex(const std::filesystem::path& path)
+{
+  caseIndex().invalidate(path.lexically_normal());
+}
+
 PathInfo pathInfo(const std::filesystem::path& path)
 {
   return pathInfoForFixedPath(fixPath(path));
@@ -157,7 +284,7 @@ Result<std::vector<std::filesystem::path>> find(
   return result;
 }
 
-Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path)
+Result<std::shared_ptr<File>> openFile(const std::filesystem::path& path)
 {
   const auto fixedPath = fixPath(path);
   if (pathInfoForFixedPath(fixedPath) != PathInfo::File)
@@ -165,7 +292,29 @@ Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path)
     return Error{fmt::format("Failed to open {}: path does not denote a file", path)};
   }
 
-  return createCFile(fixedPath);
+  return openFixedPath(fixedPath);
+}
+
+Result<std::shared_ptr<File>> openArchive(const std::filesystem::path& path)
+{
+  const auto fixedPath = fixPath(path);
+  if (pathInfoForFixedPath(fixedPath) != PathInfo::File)
+  {
+    return Error{fmt::format("Failed to open {}: path does not denote a file", path)};
+  }
+
+  auto error = std::error_code{};
+  const auto size = std::filesystem::file_size(fixedPath, error);
+  if (error || size < MinMappedFileSize)
+  {
+    return openFixedPath(fixedPath);
+  }
+
+  // Fall back to reading through a C file if the file cannot be mapped, e.g. because it
+  // resides on a file system that doesn't support it.
+  return createMappedFile(fixedPath)
+         | kdl::transform([](auto file) { return std::static_pointer_cast<File>(file); })
+         | kdl::or_else([&](auto) { return openFixedPath(fixedPath); });
 }
 
 Result<bool> createDirectory(const std::filesystem::path& path)
@@ -180,6 +329,7 @@ Result<bool> createDirectory(const std::filesystem::path& path)
   case PathInfo::Unknown: {
     auto error = std::error_code{};
     const auto created = std::filesystem::create_directories(fixedPath, error);
+    invalidateCaseIndex(fixedPath);
     if (!error)
     {
       return created;
@@ -199,7 +349,9 @@ Result<bool> deleteFile(const std::filesystem::path& path)
     return Error{fmt::format("Failed to delete {}: path denotes a directory", path)};
   case PathInfo::File: {
     auto error = std::error_code{};
-    if (std::filesystem::remove(fixedPath, error) && !error)
+    const auto removed = std::filesystem::remove(fixedPath, error);
+    invalidateCaseIndex(fixedPath);
+    if (removed && !error)
     {
       return true;
     }
@@ -232,13 +384,13 @@ Result<void> copyFile(
   }
 
   auto error = std::error_code{};
-  if (
-    !std::filesystem::copy_file(
-      fixedSourcePath,
-      fixedDestPath,
-      std::filesystem::copy_options::overwrite_existing,
-      error)
-    || error)
+  const auto copied = std::filesystem::copy_file(
+    fixedSourcePath,
+    fixedDestPath,
+    std::filesystem::copy_options::overwrite_existing,
+    error);
+  invalidateCaseIndex(fixedDestPath);
+  if (!copied || error)
   {
     return Error{
       fmt::format("Failed to copy {} to {}: {}", sourcePath, destPath, error.message())};
@@ -265,6 +417,8 @@ Result<void> moveFile(
 
   auto error = std::error_code{};
   std::filesystem::rename(fixedSourcePath, fixedDestPath, error);
+  invalidateCaseIndex(fixedSourcePath);
+  invalidateCaseIndex(fixedDestPath);
   if (error)
   {
     return Error{
@@ -293,6 +447,8 @@ Result<void> renameDirectory(
 
   auto error = std::error_code{};
   std::filesystem::rename(fixedSourcePath, fixedDestPath, error);
+  invalidateCaseIndex(fixedSourcePath);
+  invalidateCaseIndex(fixedDestPath);
   if (error)
   {
     return Error{fmt::format(
@@ -41,8 +41,22 @@ namespace Disk
 {
 bool isCaseSensitive();
 
+/**
+ * Normalizes the given path and, on a case sensitive file system, fixes the case of its
+ * components if the path does not exist as given.
+ *
+ * The case of a path is fixed using an index of the contents of the directories visited
+ * so far. The index is shared by all callers.
+ */
 std::filesystem::path fixPath(const std::filesystem::path& path);
 
+/**
+ * Discards the indexed contents of the parent directory of the given path and of all
+ * directories below the given path. Must be called after the given path was created,
+ * removed or renamed.
+ */
+void invalidateCaseIndex(const std::filesystem::path& path);
+
 PathInfo pathInfo(const std::filesystem::path& path);
 
 Result<std::vector<std::filesystem::path>> find(
@@ -50,7 +64,25 @@ Result<std::vector<std::filesystem::path>> find(
   const TraversalMode& traversalMode,
   const PathMatcher& pathMatcher = matchAnyPath);
 
-Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path);
+/**
+ * Files smaller than this are read into memory when opened. Larger files are read on
+ * demand, and larger archives are memory mapped.
+ */
+constexpr auto MinMappedFileSize = size_t(16 * 1024 * 1024);
+
+/**
+ * Opens the file at the given path for reading. Small files are read into memory, larger
+ * files are read on demand.
+ */
+Result<std::shared_ptr<File>> openFile(const std::filesystem::path& path);
+
+/**
+ * Opens the archive file at the given path for reading. Large archives are memory mapped
+ * if possible, all other archives are opened like openFile does.
+ *
+ * A memory mapped archive must not be truncated while it is open, see MappedFile.
+ */
+Result<std::shared_ptr<File>> openArchive(const std::filesystem::path& path);
 
 template <typename Stream, typename F>
 auto withStream(
@@ -76,13 +108,15 @@ template <typename F>
 auto withOutputStream(
   const std::filesystem::path& path, const std::ios::openmode mode, const F& function)
 {
-  return withStream<std::ofstream>(path, mode, function);
+  auto result = withStream<std::ofstream>(path, mode, function);
+  invalidateCaseIndex(path);
+  return result;
 }
 
 template <typename F>
 auto withOutputStream(const std::filesystem::path& path, const F& function)
 {
-  return withStream<std::ofstream>(path, std::ios_base::out, function);
+  return withOutputStream(path, std::ios_base::out, function);
 }
 
 Result<bool> createDirectory(const std::filesystem::path& path);
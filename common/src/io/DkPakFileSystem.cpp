@@ -138,7 +138,9 @@ Result<void> DkPakFileSystem::doReadDirectory()
           entryPath,
           [entryFile = std::move(entryFile_),
            uncompressedSize]() -> Result<std::shared_ptr<File>> {
-            return decompress(entryFile, uncompressedSize)
+            return entryFile->validate() | kdl::and_then([&]() {
+                     return decompress(entryFile, uncompressedSize);
+                   })
                    | kdl::transform([&](auto data) {
                        return std::static_pointer_cast<File>(
                          std::make_shared<OwningBufferFile>(
@@ -148,7 +150,13 @@ Result<void> DkPakFileSystem::doReadDirectory()
       }
       else
       {
-        addFile(entryPath, [entryFile = std::move(entryFile_)]() { return entryFile; });
+        addFile(
+          entryPath,
+          [entryFile = std::move(entryFile_)]() -> Result<std::shared_ptr<File>> {
+            return entryFile->validate() | kdl::transform([&]() {
+                     return std::static_pointer_cast<File>(entryFile);
+                   });
+          });
       }
     }
     return kdl::void_success;
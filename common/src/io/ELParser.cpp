@@ -83,15 +83,15 @@ auto tokenNames()
 }
 } // namespace
 
-const std::string& ELTokenizer::NumberDelim() const
+const CharClass& ELTokenizer::NumberDelim() const
 {
-  static const auto Delim = Whitespace() + "(){}[],:+-*/%";
+  static const auto Delim = Whitespace() | CharClass{"(){}[],:+-*/%"};
   return Delim;
 }
 
-const std::string& ELTokenizer::IntegerDelim() const
+const CharClass& ELTokenizer::IntegerDelim() const
 {
-  static const auto Delim = NumberDelim() + ".";
+  static const auto Delim = NumberDelim() | CharClass{"."};
   return Delim;
 }
 
@@ -84,8 +84,8 @@ constexpr auto CompoundTerm =
 class ELTokenizer : public Tokenizer<ELToken::Type>
 {
 private:
-  const std::string& NumberDelim() const;
-  const std::string& IntegerDelim() const;
+  const CharClass& NumberDelim() const;
+  const CharClass& IntegerDelim() const;
 
 public:
   ELTokenizer(std::string_view str, size_t line, size_t column);
@@ -0,0 +1,107 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "EntityTextCache.h"
+
+#include "mdl/Node.h"
+
+#include <utility>
+
+namespace tb::io
+{
+
+const EntityTextCache::Entry* EntityTextCache::find(const mdl::Node* node) const
+{
+  const auto it = m_entries.find(node);
+  return it != m_entries.end()
+             && it->second.entry.modificationCount == node->modificationCount()
+           ? &it->second.entry
+           : nullptr;
+}
+
+const EntityTextCache::Entry* EntityTextCache::use(
+  const mdl::Node* node,
+  const std::vector<mdl::EntityProperty>& properties,
+  const std::vector<mdl::EntityProperty>& extraProperties)
+{
+  const auto it = m_entries.find(node);
+  if (
+    it == m_entries.end()
+    || it->second.entry.modificationCount != node->modificationCount()
+    || it->second.entry.properties != properties
+    || it->second.entry.extraProperties != extraProperties)
+  {
+    return nullptr;
+  }
+
+  it->second.generation = m_generation;
+  return &it->second.entry;
+}
+
+void EntityTextCache::put(const mdl::Node* node, Entry entry)
+{
+  m_entries.insert_or_assign(node, CachedEntry{std::move(entry), m_generation});
+}
+
+const EntityTextCache::PropertiesEntry* EntityTextCache::useProperties(
+  const mdl::Node* node,
+  const std::vector<mdl::EntityProperty>& properties,
+  const std::vector<mdl::EntityProperty>& extraProperties)
+{
+  const auto it = m_propertiesEntries.find(node);
+  if (
+    it == m_propertiesEntries.end() || it->second.entry.properties != properties
+    || it->second.entry.extraProperties != extraProperties)
+  {
+    return nullptr;
+  }
+
+  it->second.generation = m_generation;
+  return &it->second.entry;
+}
+
+const EntityTextCache::PropertiesEntry& EntityTextCache::putProperties(
+  const mdl::Node* node, PropertiesEntry entry)
+{
+  return m_propertiesEntries
+    .insert_or_assign(node, CachedPropertiesEntry{std::move(entry), m_generation})
+    .first->second.entry;
+}
+
+void EntityTextCache::beginWrite()
+{
+  ++m_generation;
+}
+
+void EntityTextCache::endWrite()
+{
+  const auto isUnused = [&](const auto& pair) {
+    return pair.second.generation != m_generation;
+  };
+  std::erase_if(m_entries, isUnused);
+  std::erase_if(m_propertiesEntries, isUnused);
+}
+
+size_t EntityTextCache::size() const
+{
+  return m_entries.size() + m_propertiesEntries.size();
+}
+
+} // namespace tb::io
@@ -0,0 +1,148 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "mdl/EntityProperties.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace tb::mdl
+{
+class Node;
+}
+
+namespace tb::io
+{
+
+/**
+ * Keeps the serialized text of entities between several runs of a MapFileSerializer so
+ * that entities which haven't changed since they were last written can be copied instead
+ * of being serialized again.
+ *
+ * Entries are keyed by the node that contains the brushes and patches of an entity, and
+ * an entry is only reused if the modification count of that node and the properties of
+ * the entity are unchanged.
+ *
+ * Layers, including the default layer that holds the worldspawn brushes, contain most of
+ * the brushes of a map, so any brush edit would invalidate their entries. Therefore only
+ * the serialized properties of layer entities are cached. They are keyed by the entity
+ * node and reused as long as the properties are unchanged, and their brushes are written
+ * from the serialized faces that every brush node caches until it changes.
+ *
+ * A cache must only be used with serializers for a single map format.
+ */
+class EntityTextCache
+{
+public:
+  struct Entry
+  {
+    size_t modificationCount;
+    std::vector<mdl::EntityProperty> properties;
+    std::vector<mdl::EntityProperty> extraProperties;
+
+    /** The serialized entity, excluding the preceding entity number comment. */
+    std::string text;
+    size_t lineCount;
+  };
+
+  struct PropertiesEntry
+  {
+    std::vector<mdl::EntityProperty> properties;
+    std::vector<mdl::EntityProperty> extraProperties;
+
+    /** The serialized properties. */
+    std::string text;
+    size_t lineCount;
+  };
+
+private:
+  struct CachedEntry
+  {
+    Entry entry;
+    size_t generation;
+  };
+
+  struct CachedPropertiesEntry
+  {
+    PropertiesEntry entry;
+    size_t generation;
+  };
+
+  std::unordered_map<const mdl::Node*, CachedEntry> m_entries;
+  std::unordered_map<const mdl::Node*, CachedPropertiesEntry> m_propertiesEntries;
+  size_t m_generation = 0;
+
+public:
+  /**
+   * Returns the entry for the given node if its modification count matches.
+   */
+  const Entry* find(const mdl::Node* node) const;
+
+  /**
+   * Returns the entry for the given node if its modification count and the given
+   * properties match, and marks it as used for the current write.
+   */
+  const Entry* use(
+    const mdl::Node* node,
+    const std::vector<mdl::EntityProperty>& properties,
+    const std::vector<mdl::EntityProperty>& extraProperties);
+
+  /**
+   * Adds or replaces the entry for the given node and marks it as used for the current
+   * write.
+   */
+  void put(const mdl::Node* node, Entry entry);
+
+  /**
+   * Returns the properties entry for the given entity node if the given properties match,
+   * and marks it as used for the current write.
+   */
+  const PropertiesEntry* useProperties(
+    const mdl::Node* node,
+    const std::vector<mdl::EntityProperty>& properties,
+    const std::vector<mdl::EntityProperty>& extraProperties);
+
+  /**
+   * Adds or replaces the properties entry for the given entity node, marks it as used for
+   * the current write and returns it.
+   */
+  const PropertiesEntry& putProperties(const mdl::Node* node, PropertiesEntry entry);
+
+  /**
+   * Must be called before the cache is used for writing a map.
+   */
+  void beginWrite();
+
+  /**
+   * Must be called after a map was written. Removes every entry that was not used while
+   * writing the map, e.g. because its node was deleted.
+   */
+  void endWrite();
+
+  /**
+   * Returns the number of entries, including properties entries.
+   */
+  size_t size() const;
+};
+
+} // namespace tb::io
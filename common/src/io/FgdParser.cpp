@@ -77,7 +77,7 @@ FgdTokenizer::FgdTokenizer(const std::string_view str)
 {
 }
 
-const std::string FgdTokenizer::WordDelims = " \t\n\r()[]?;:,=";
+const CharClass FgdTokenizer::WordDelims = " \t\n\r()[]?;:,=";
 
 FgdTokenizer::Token FgdTokenizer::emitToken()
 {
@@ -75,7 +75,7 @@ public:
   explicit FgdTokenizer(std::string_view str);
 
 private:
-  static const std::string WordDelims;
+  static const CharClass WordDelims;
   Token emitToken() override;
 };
 
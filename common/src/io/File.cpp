@@ -26,6 +26,17 @@
 
 #include <cstdio>
 #include <cstring>
+#include <system_error>
+#include <tuple>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace tb::io
 {
@@ -34,6 +45,11 @@ File::File() = default;
 
 File::~File() = default;
 
+Result<void> File::validate() const
+{
+  return kdl::void_success;
+}
+
 OwningBufferFile::OwningBufferFile(std::unique_ptr<char[]> buffer, const size_t size)
   : m_buffer{std::move(buffer)}
   , m_size{size}
@@ -102,6 +118,94 @@ Result<size_t> fileSize(std::FILE* file)
 
   return static_cast<size_t>(size);
 }
+
+#ifdef _WIN32
+Result<std::tuple<CFile::BufferType, size_t>> mapPath(const std::filesystem::path& path)
+{
+  // Allow the file to be deleted or replaced while it is mapped.
+  auto* fileHandle = CreateFileW(
+    path.wstring().c_str(),
+    GENERIC_READ,
+    FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+    nullptr,
+    OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL,
+    nullptr);
+  if (fileHandle == INVALID_HANDLE_VALUE)
+  {
+    return Error{fmt::format("Failed to open '{}': error {}", path, GetLastError())};
+  }
+
+  auto file = kdl::resource{fileHandle, [](auto handle) { CloseHandle(handle); }};
+
+  auto size = LARGE_INTEGER{};
+  if (!GetFileSizeEx(*file, &size))
+  {
+    return Error{fmt::format("Failed to stat '{}': error {}", path, GetLastError())};
+  }
+
+  if (size.QuadPart == 0)
+  {
+    // empty files cannot be mapped
+    return std::tuple{CFile::BufferType{}, size_t(0)};
+  }
+
+  auto* mappingHandle = CreateFileMappingW(*file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mappingHandle)
+  {
+    return Error{fmt::format("Failed to map '{}': error {}", path, GetLastError())};
+  }
+
+  auto mapping = kdl::resource{mappingHandle, [](auto handle) { CloseHandle(handle); }};
+  auto* view = static_cast<char*>(MapViewOfFile(*mapping, FILE_MAP_READ, 0, 0, 0));
+  if (!view)
+  {
+    return Error{fmt::format("Failed to map '{}': error {}", path, GetLastError())};
+  }
+
+  // The view keeps the mapping and the file alive, so both handles can be closed now.
+  return std::tuple{
+    CFile::BufferType{view, [](char* begin) { UnmapViewOfFile(begin); }},
+    static_cast<size_t>(size.QuadPart)};
+}
+#else
+Result<std::tuple<CFile::BufferType, size_t>> mapPath(const std::filesystem::path& path)
+{
+  const auto fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+  {
+    return Error{fmt::format("Failed to open '{}': {}", path, std::strerror(errno))};
+  }
+
+  auto file = kdl::resource{fd, [](const int fd_) { close(fd_); }};
+
+  struct stat stat;
+  if (fstat(*file, &stat) != 0)
+  {
+    return Error{fmt::format("Failed to stat '{}': {}", path, std::strerror(errno))};
+  }
+
+  const auto size = static_cast<size_t>(stat.st_size);
+  if (size == 0)
+  {
+    // empty files cannot be mapped
+    return std::tuple{CFile::BufferType{}, size};
+  }
+
+  auto* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, *file, 0);
+  if (view == MAP_FAILED)
+  {
+    return Error{fmt::format("Failed to map '{}': {}", path, std::strerror(errno))};
+  }
+
+  // The mapping remains valid after the file descriptor is closed.
+  return std::tuple{
+    CFile::BufferType{
+      static_cast<char*>(view), [size](char* begin) { munmap(begin, size); }},
+    size};
+}
+#endif
+
 } // namespace
 
 CFile::CFile(kdl::resource<std::FILE*> file, const size_t size)
@@ -125,22 +229,6 @@ std::FILE* CFile::file() const
   return *m_file;
 }
 
-std::unique_ptr<OwningBufferFile> CFile::buffer() const
-{
-  if (std::fseek(file(), 0, SEEK_SET))
-  {
-    return nullptr;
-  }
-
-  auto buffer = std::make_unique<char[]>(size());
-  if (std::fread(buffer.get(), 1, size(), file()) != size())
-  {
-    return nullptr;
-  }
-
-  return std::make_unique<OwningBufferFile>(std::move(buffer), size());
-}
-
 Result<void> CFile::read(char* val, const size_t position, const size_t size) const
 {
   auto guard = std::lock_guard{m_mutex};
@@ -195,6 +283,80 @@ Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path)
          });
 }
 
+MappedFile::MappedFile(
+  CFile::BufferType mapping,
+  const size_t size,
+  std::filesystem::path path,
+  const std::filesystem::file_time_type modificationTime)
+  : m_mapping{std::move(mapping)}
+  , m_size{size}
+  , m_path{std::move(path)}
+  , m_modificationTime{modificationTime}
+{
+}
+
+Reader MappedFile::reader() const
+{
+  return Reader::from(*this);
+}
+
+size_t MappedFile::size() const
+{
+  return m_size;
+}
+
+Result<void> MappedFile::validate() const
+{
+  auto error = std::error_code{};
+  const auto size = std::filesystem::file_size(m_path, error);
+  if (error)
+  {
+    return Error{fmt::format("Failed to stat '{}': {}", m_path, error.message())};
+  }
+
+  const auto modificationTime = std::filesystem::last_write_time(m_path, error);
+  if (error)
+  {
+    return Error{fmt::format("Failed to stat '{}': {}", m_path, error.message())};
+  }
+
+  if (size != m_size || modificationTime != m_modificationTime)
+  {
+    return Error{fmt::format("'{}' was modified since it was opened", m_path)};
+  }
+
+  return kdl::void_success;
+}
+
+const char* MappedFile::begin() const
+{
+  return m_mapping.get();
+}
+
+const char* MappedFile::end() const
+{
+  return begin() + m_size;
+}
+
+Result<std::shared_ptr<MappedFile>> createMappedFile(const std::filesystem::path& path)
+{
+  // Get the modification time before mapping the file. If the file is modified while it
+  // is being mapped, validating the mapped file will fail.
+  auto error = std::error_code{};
+  const auto modificationTime = std::filesystem::last_write_time(path, error);
+  if (error)
+  {
+    return Error{fmt::format("Failed to stat '{}': {}", path, error.message())};
+  }
+
+  return mapPath(path) | kdl::transform([&](auto mappingAndSize) {
+           auto [mapping, size] = std::move(mappingAndSize);
+           // NOLINTNEXTLINE
+           return std::shared_ptr<MappedFile>{
+             new MappedFile{std::move(mapping), size, path, modificationTime}};
+         });
+}
+
 FileView::FileView(std::shared_ptr<File> file, const size_t offset, const size_t length)
   : m_file{std::move(file)}
   , m_offset{offset}
@@ -212,4 +374,9 @@ size_t FileView::size() const
   return m_length;
 }
 
+Result<void> FileView::validate() const
+{
+  return m_file->validate();
+}
+
 } // namespace tb::io
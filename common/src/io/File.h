@@ -52,6 +52,12 @@ public:
    * Returns the size of this file in bytes.
    */
   virtual size_t size() const = 0;
+
+  /**
+   * Checks whether this file can still be read safely. Returns an error if the underlying
+   * physical file was changed in a way that would make reading from this file crash.
+   */
+  virtual Result<void> validate() const;
 };
 
 /**
@@ -111,8 +117,6 @@ public:
    */
   std::FILE* file() const;
 
-  std::unique_ptr<OwningBufferFile> buffer() const;
-
 private:
   friend class FileReaderSource;
 
@@ -124,6 +128,68 @@ private:
 
 Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path);
 
+/**
+ * A file that is backed by a read only memory mapping of a physical file on the disk.
+ * Readers access the mapped memory directly, so reading neither copies the file contents
+ * nor serializes concurrent readers. The mapping is released when the file and all
+ * readers created from it have been destroyed.
+ *
+ * If the physical file is truncated while it is mapped, accessing the mapped memory
+ * beyond the new end of the file raises SIGBUS and crashes the application instead of
+ * reporting a read error. Therefore, only large archives that are not expected to change
+ * while they are open should be mapped, see Disk::openArchive. Before handing out a
+ * portion of a mapped file, call validate() to check that the file on disk still has the
+ * size and modification time it had when it was mapped. This does not rule out that the
+ * file is truncated while the portion is read, but it prevents reading from a file that
+ * was changed since it was mapped.
+ */
+class MappedFile : public File
+{
+private:
+  CFile::BufferType m_mapping;
+  size_t m_size;
+  std::filesystem::path m_path;
+  std::filesystem::file_time_type m_modificationTime;
+
+  /**
+   * Creates a new file with the given mapped memory region and size in bytes. The given
+   * path and modification time are used to validate the file.
+   */
+  MappedFile(
+    CFile::BufferType mapping,
+    size_t size,
+    std::filesystem::path path,
+    std::filesystem::file_time_type modificationTime);
+
+public:
+  friend Result<std::shared_ptr<MappedFile>> createMappedFile(
+    const std::filesystem::path& path);
+
+  Reader reader() const override;
+  size_t size() const override;
+
+  /**
+   * Returns an error if the size or the modification time of the mapped file on disk
+   * differs from when it was mapped.
+   */
+  Result<void> validate() const override;
+
+  /**
+   * Returns the beginning of the mapped memory region.
+   */
+  const char* begin() const;
+
+  /**
+   * Returns the end of the mapped memory region.
+   */
+  const char* end() const;
+
+private:
+  friend class Reader;
+};
+
+Result<std::shared_ptr<MappedFile>> createMappedFile(const std::filesystem::path& path);
+
 /**
  * A file that is backed by a portion of a physical file.
  */
@@ -146,6 +212,7 @@ public:
 
   Reader reader() const override;
   size_t size() const override;
+  Result<void> validate() const override;
 };
 
 } // namespace tb::io
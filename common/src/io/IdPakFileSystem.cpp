@@ -65,7 +65,7 @@ Result<void> IdPakFileSystem::doReadDirectory()
       addFile(
         entryPath,
         [entryFile = std::move(entryFile_)]() -> Result<std::shared_ptr<File>> {
-          return entryFile;
+          return entryFile->validate() | kdl::transform([&]() { return entryFile; });
         });
     }
 
@@ -24,9 +24,9 @@
 
 namespace tb::io
 {
-class CFile;
+class File;
 
-class IdPakFileSystem : public ImageFileSystem<CFile>
+class IdPakFileSystem : public ImageFileSystem<File>
 {
 public:
   using ImageFileSystem::ImageFileSystem;
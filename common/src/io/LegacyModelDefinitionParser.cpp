@@ -60,7 +60,7 @@ LegacyModelDefinitionTokenizer::LegacyModelDefinitionTokenizer(
 {
 }
 
-const std::string LegacyModelDefinitionTokenizer::WordDelims = " \t\n\r()[]{};,=";
+const CharClass LegacyModelDefinitionTokenizer::WordDelims = " \t\n\r()[]{};,=";
 
 LegacyModelDefinitionTokenizer::Token LegacyModelDefinitionTokenizer::emitToken()
 {
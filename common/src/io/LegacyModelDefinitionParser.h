@@ -48,7 +48,7 @@ public:
   LegacyModelDefinitionTokenizer(std::string_view str, size_t line, size_t column);
 
 private:
-  static const std::string WordDelims;
+  static const CharClass WordDelims;
   Token emitToken() override;
 };
 
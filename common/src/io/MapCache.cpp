@@ -0,0 +1,457 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapCache.h"
+
+#include "Color.h"
+#include "io/Reader.h"
+#include "io/ReaderException.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushFaceAttributes.h"
+#include "mdl/EntityProperties.h"
+#include "mdl/GameConfig.h"
+#include "mdl/ParallelUVCoordSystem.h"
+#include "mdl/ParaxialUVCoordSystem.h"
+
+#include "kdl/overload.h"
+#include "kdl/result.h"
+
+#include <fmt/format.h>
+
+#include <ostream>
+#include <sstream>
+
+namespace tb::io
+{
+namespace
+{
+
+/*
+ * Layout of a map cache file, all values are stored in native byte order:
+ *
+ * - magic number "TBMC", cache version (uint32)
+ * - key: content hash (uint64), game config hash (uint64), requested map format (int32)
+ * - parsed map format (int32)
+ * - object count (uint64), followed by the objects
+ *
+ * Strings are stored as their length (uint64) followed by their characters. Optional
+ * values are stored as a flag (uint8) followed by the value if the flag is set.
+ */
+constexpr auto Magic = std::string_view{"TBMC"};
+
+/**
+ * Must be incremented whenever the layout of the cache or the way objects are created
+ * from the map file changes.
+ */
+constexpr auto Version = uint32_t(2);
+
+enum class ObjectType : uint8_t
+{
+  Entity,
+  Brush,
+  Patch,
+};
+
+uint64_t hashContents(const std::string_view str)
+{
+  // 64 bit FNV-1a
+  auto hash = uint64_t(14695981039346656037ull);
+  for (const auto c : str)
+  {
+    hash ^= uint64_t(static_cast<unsigned char>(c));
+    hash *= uint64_t(1099511628211ull);
+  }
+  return hash;
+}
+
+template <typename T>
+void write(std::ostream& stream, const T value)
+{
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeSize(std::ostream& stream, const size_t size)
+{
+  write(stream, uint64_t(size));
+}
+
+void writeString(std::ostream& stream, const std::string_view str)
+{
+  writeSize(stream, str.size());
+  stream.write(str.data(), std::streamsize(str.size()));
+}
+
+void writeMapFormat(std::ostream& stream, const mdl::MapFormat mapFormat)
+{
+  write(stream, int32_t(mapFormat));
+}
+
+template <typename T, size_t S>
+void writeVec(std::ostream& stream, const vm::vec<T, S>& vec)
+{
+  for (size_t i = 0; i < S; ++i)
+  {
+    write(stream, vec[i]);
+  }
+}
+
+template <typename T, typename F>
+void writeOptional(
+  std::ostream& stream, const std::optional<T>& value, const F& writeValue)
+{
+  write(stream, uint8_t(value ? 1 : 0));
+  if (value)
+  {
+    writeValue(stream, *value);
+  }
+}
+
+void writeLocation(std::ostream& stream, const FileLocation& location)
+{
+  writeSize(stream, location.line);
+  writeOptional(stream, location.column, writeSize);
+}
+
+void writeParentIndex(std::ostream& stream, const std::optional<size_t>& parentIndex)
+{
+  writeOptional(stream, parentIndex, writeSize);
+}
+
+void writeAttributes(std::ostream& stream, const mdl::BrushFaceAttributes& attributes)
+{
+  writeString(stream, attributes.materialName());
+  writeVec(stream, attributes.offset());
+  writeVec(stream, attributes.scale());
+  write(stream, attributes.rotation());
+  writeOptional(stream, attributes.surfaceContents(), write<int32_t>);
+  writeOptional(stream, attributes.surfaceFlags(), write<int32_t>);
+  writeOptional(stream, attributes.surfaceValue(), write<float>);
+  writeOptional(stream, attributes.color(), writeVec<float, 4>);
+}
+
+void writeBrushFace(std::ostream& stream, const mdl::BrushFace& face)
+{
+  for (const auto& point : face.points())
+  {
+    writeVec(stream, point);
+  }
+  writeAttributes(stream, face.attributes());
+  writeVec(stream, face.uAxis());
+  writeVec(stream, face.vAxis());
+  writeSize(stream, face.lineNumber());
+}
+
+void writeObjectInfo(std::ostream& stream, const MapReader::ObjectInfo& objectInfo)
+{
+  std::visit(
+    kdl::overload(
+      [&](const MapReader::EntityInfo& entityInfo) {
+        write(stream, ObjectType::Entity);
+        writeSize(stream, entityInfo.properties.size());
+        for (const auto& property : entityInfo.properties)
+        {
+          writeString(stream, property.key());
+          writeString(stream, property.value());
+        }
+        writeLocation(stream, entityInfo.startLocation);
+        writeOptional(stream, entityInfo.endLocation, writeLocation);
+      },
+      [&](const MapReader::BrushInfo& brushInfo) {
+        write(stream, ObjectType::Brush);
+        writeSize(stream, brushInfo.faces.size());
+        for (const auto& face : brushInfo.faces)
+        {
+          writeBrushFace(stream, face);
+        }
+        writeLocation(stream, brushInfo.startLocation);
+        writeOptional(stream, brushInfo.endLocation, writeLocation);
+        writeParentIndex(stream, brushInfo.parentIndex);
+      },
+      [&](const MapReader::PatchInfo& patchInfo) {
+        write(stream, ObjectType::Patch);
+        writeSize(stream, patchInfo.rowCount);
+        writeSize(stream, patchInfo.columnCount);
+        writeSize(stream, patchInfo.controlPoints.size());
+        for (const auto& controlPoint : patchInfo.controlPoints)
+        {
+          writeVec(stream, controlPoint);
+        }
+        writeString(stream, patchInfo.materialName);
+        writeLocation(stream, patchInfo.startLocation);
+        writeOptional(stream, patchInfo.endLocation, writeLocation);
+        writeParentIndex(stream, patchInfo.parentIndex);
+      }),
+    objectInfo);
+}
+
+size_t readSize(Reader& reader)
+{
+  return reader.read<uint64_t, size_t>();
+}
+
+std::string readString(Reader& reader)
+{
+  const auto size = readSize(reader);
+  if (!reader.canRead(size))
+  {
+    throw ReaderException{fmt::format("Invalid string length {}", size)};
+  }
+  return reader.readString(size);
+}
+
+mdl::MapFormat readMapFormat(Reader& reader)
+{
+  const auto value = reader.read<int32_t, int32_t>();
+  if (value < int32_t(mdl::MapFormat::Unknown) || value > int32_t(mdl::MapFormat::Quake3))
+  {
+    throw ReaderException{fmt::format("Invalid map format {}", value)};
+  }
+  return mdl::MapFormat(value);
+}
+
+template <typename T, size_t S>
+vm::vec<T, S> readVec(Reader& reader)
+{
+  return reader.readVec<T, S>();
+}
+
+template <typename T, typename F>
+std::optional<T> readOptional(Reader& reader, const F& readValue)
+{
+  return reader.read<uint8_t, uint8_t>() != 0 ? std::optional<T>{readValue(reader)}
+                                               : std::nullopt;
+}
+
+FileLocation readLocation(Reader& reader)
+{
+  const auto line = readSize(reader);
+  const auto column = readOptional<size_t>(reader, readSize);
+  return {line, column};
+}
+
+std::optional<size_t> readParentIndex(Reader& reader)
+{
+  return readOptional<size_t>(reader, readSize);
+}
+
+mdl::BrushFaceAttributes readAttributes(Reader& reader)
+{
+  auto attributes = mdl::BrushFaceAttributes{readString(reader)};
+  attributes.setOffset(readVec<float, 2>(reader));
+  attributes.setScale(readVec<float, 2>(reader));
+  attributes.setRotation(reader.read<float, float>());
+  attributes.setSurfaceContents(
+    readOptional<int>(reader, [](auto& r) { return r.template read<int32_t, int>(); }));
+  attributes.setSurfaceFlags(
+    readOptional<int>(reader, [](auto& r) { return r.template read<int32_t, int>(); }));
+  attributes.setSurfaceValue(
+    readOptional<float>(reader, [](auto& r) { return r.template read<float, float>(); }));
+  attributes.setColor(readOptional<Color>(
+    reader, [](auto& r) { return Color{r.template readVec<float, 4>()}; }));
+  return attributes;
+}
+
+mdl::BrushFace readBrushFace(Reader& reader, const mdl::MapFormat mapFormat)
+{
+  const auto point0 = readVec<double, 3>(reader);
+  const auto point1 = readVec<double, 3>(reader);
+  const auto point2 = readVec<double, 3>(reader);
+  const auto attributes = readAttributes(reader);
+  const auto uAxis = readVec<double, 3>(reader);
+  const auto vAxis = readVec<double, 3>(reader);
+  const auto lineNumber = readSize(reader);
+
+  // the face was already converted to the target format when the map file was parsed,
+  // so we restore its UV coordinate system directly
+  auto uvCoordSystem =
+    mdl::isParallelUVCoordSystem(mapFormat)
+      ? std::unique_ptr<mdl::UVCoordSystem>{std::make_unique<mdl::ParallelUVCoordSystem>(
+          uAxis, vAxis)}
+      : std::unique_ptr<mdl::UVCoordSystem>{std::make_unique<mdl::ParaxialUVCoordSystem>(
+          point0, point1, point2, attributes)};
+
+  return mdl::BrushFace::create(
+           point0, point1, point2, attributes, std::move(uvCoordSystem))
+         | kdl::transform([&](auto face) {
+             face.setFilePosition(lineNumber, 1);
+             return face;
+           })
+         | kdl::if_error([](const auto& e) {
+             throw ReaderException{fmt::format("Invalid brush face: {}", e.msg)};
+           })
+         | kdl::value();
+}
+
+MapReader::ObjectInfo readObjectInfo(Reader& reader, const mdl::MapFormat mapFormat)
+{
+  const auto type = reader.read<uint8_t, uint8_t>();
+  switch (ObjectType(type))
+  {
+  case ObjectType::Entity: {
+    auto properties = std::vector<mdl::EntityProperty>{};
+    const auto propertyCount = readSize(reader);
+    for (size_t i = 0; i < propertyCount; ++i)
+    {
+      auto key = readString(reader);
+      auto value = readString(reader);
+      properties.emplace_back(std::move(key), std::move(value));
+    }
+    const auto startLocation = readLocation(reader);
+    const auto endLocation = readOptional<FileLocation>(reader, readLocation);
+    return MapReader::EntityInfo{std::move(properties), startLocation, endLocation};
+  }
+  case ObjectType::Brush: {
+    auto faces = std::vector<mdl::BrushFace>{};
+    const auto faceCount = readSize(reader);
+    for (size_t i = 0; i < faceCount; ++i)
+    {
+      faces.push_back(readBrushFace(reader, mapFormat));
+    }
+    const auto startLocation = readLocation(reader);
+    const auto endLocation = readOptional<FileLocation>(reader, readLocation);
+    const auto parentIndex = readParentIndex(reader);
+    return MapReader::BrushInfo{
+      std::move(faces), startLocation, endLocation, parentIndex};
+  }
+  case ObjectType::Patch: {
+    const auto rowCount = readSize(reader);
+    const auto columnCount = readSize(reader);
+    auto controlPoints = std::vector<mdl::BezierPatch::Point>{};
+    const auto controlPointCount = readSize(reader);
+    for (size_t i = 0; i < controlPointCount; ++i)
+    {
+      controlPoints.push_back(readVec<double, 5>(reader));
+    }
+    auto materialName = readString(reader);
+    const auto startLocation = readLocation(reader);
+    const auto endLocation = readOptional<FileLocation>(reader, readLocation);
+    const auto parentIndex = readParentIndex(reader);
+    return MapReader::PatchInfo{
+      rowCount,
+      columnCount,
+      std::move(controlPoints),
+      std::move(materialName),
+      startLocation,
+      endLocation,
+      parentIndex};
+  }
+  }
+
+  throw ReaderException{fmt::format("Invalid object type {}", type)};
+}
+
+} // namespace
+
+MapCacheKey makeMapCacheKey(
+  const std::string_view mapFileContents,
+  const mdl::GameConfig& gameConfig,
+  const mdl::MapFormat mapFormat)
+{
+  // hash everything that was loaded from the game config files
+  auto gameConfigStr = std::ostringstream{};
+  gameConfigStr << gameConfig;
+
+  return {hashContents(mapFileContents), hashContents(gameConfigStr.str()), mapFormat};
+}
+
+std::filesystem::path mapCachePath(const std::filesystem::path& mapFilePath)
+{
+  auto result = mapFilePath;
+  result += ".tbcache";
+  return result;
+}
+
+Result<void> writeMapCache(
+  std::ostream& stream,
+  const MapCacheKey& key,
+  const mdl::MapFormat mapFormat,
+  const std::vector<MapReader::ObjectInfo>& objectInfos)
+{
+  stream.write(Magic.data(), std::streamsize(Magic.size()));
+  write(stream, Version);
+
+  write(stream, key.contentHash);
+  write(stream, key.gameConfigHash);
+  writeMapFormat(stream, key.mapFormat);
+
+  writeMapFormat(stream, mapFormat);
+  writeSize(stream, objectInfos.size());
+  for (const auto& objectInfo : objectInfos)
+  {
+    writeObjectInfo(stream, objectInfo);
+  }
+
+  if (!stream)
+  {
+    return Error{"Failed to write map cache"};
+  }
+  return Result<void>{};
+}
+
+Result<MapCache> readMapCache(Reader reader, const MapCacheKey& key)
+{
+  try
+  {
+    if (!reader.canRead(Magic.size()) || reader.readString(Magic.size()) != Magic)
+    {
+      return Error{"Not a map cache"};
+    }
+
+    if (const auto version = reader.read<uint32_t, uint32_t>(); version != Version)
+    {
+      return Error{fmt::format("Unsupported map cache version {}", version)};
+    }
+
+    const auto contentHash = reader.read<uint64_t, uint64_t>();
+    const auto gameConfigHash = reader.read<uint64_t, uint64_t>();
+    const auto requestedMapFormat = readMapFormat(reader);
+    if (
+      contentHash != key.contentHash || gameConfigHash != key.gameConfigHash
+      || requestedMapFormat != key.mapFormat)
+    {
+      return Error{"Map cache is out of date"};
+    }
+
+    const auto mapFormat = readMapFormat(reader);
+    if (mapFormat == mdl::MapFormat::Unknown)
+    {
+      return Error{"Invalid map format in map cache"};
+    }
+
+    auto objectInfos = std::vector<MapReader::ObjectInfo>{};
+    const auto objectCount = readSize(reader);
+    for (size_t i = 0; i < objectCount; ++i)
+    {
+      objectInfos.push_back(readObjectInfo(reader, mapFormat));
+    }
+
+    if (!reader.eof())
+    {
+      return Error{"Unexpected data at end of map cache"};
+    }
+
+    return MapCache{mapFormat, std::move(objectInfos)};
+  }
+  catch (const ReaderException& e)
+  {
+    return Error{fmt::format("Invalid map cache: {}", e.what())};
+  }
+}
+
+} // namespace tb::io
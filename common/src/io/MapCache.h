@@ -0,0 +1,101 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Result.h"
+#include "io/MapReader.h"
+#include "mdl/MapFormat.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tb::mdl
+{
+struct GameConfig;
+}
+
+namespace tb::io
+{
+class Reader;
+
+/**
+ * Identifies the map file that a map cache was created for. A map cache is only valid
+ * if its key matches the key of the map file that is being loaded.
+ */
+struct MapCacheKey
+{
+  /** A hash of the contents of the map file. */
+  uint64_t contentHash;
+  /** A hash of the game config used to load the map file. */
+  uint64_t gameConfigHash;
+  /** The map format requested when loading the map file, may be Unknown. */
+  mdl::MapFormat mapFormat;
+};
+
+/**
+ * The contents of a map cache.
+ */
+struct MapCache
+{
+  /** The format that the map file was parsed as. */
+  mdl::MapFormat mapFormat;
+  /** The objects that were recorded when the map file was parsed. */
+  std::vector<MapReader::ObjectInfo> objectInfos;
+};
+
+/**
+ * Computes the cache key of a map file with the given contents. Any change to the given
+ * game config changes the key.
+ */
+MapCacheKey makeMapCacheKey(
+  std::string_view mapFileContents,
+  const mdl::GameConfig& gameConfig,
+  mdl::MapFormat mapFormat);
+
+/**
+ * Returns the path of the cache file for the map file at the given path.
+ */
+std::filesystem::path mapCachePath(const std::filesystem::path& mapFilePath);
+
+/**
+ * Writes the given objects to the given stream in a compact binary format. The stream
+ * must be opened in binary mode.
+ *
+ * Returns an error if the stream is in a bad state after writing.
+ */
+Result<void> writeMapCache(
+  std::ostream& stream,
+  const MapCacheKey& key,
+  mdl::MapFormat mapFormat,
+  const std::vector<MapReader::ObjectInfo>& objectInfos);
+
+/**
+ * Reads a map cache that was written by writeMapCache.
+ *
+ * Returns an error if the cache is corrupt, if it was written by an incompatible version,
+ * or if its key doesn't match the given key.
+ */
+Result<MapCache> readMapCache(Reader reader, const MapCacheKey& key);
+
+} // namespace tb::io
@@ -22,6 +22,7 @@
 #include "Ensure.h"
 #include "Exceptions.h"
 #include "Macros.h"
+#include "io/EntityTextCache.h"
 #include "mdl/BezierPatch.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
@@ -42,7 +43,6 @@
 #include <memory>
 #include <sstream>
 #include <utility>
-#include <variant>
 #include <vector>
 
 namespace tb::io
@@ -51,8 +51,8 @@ namespace tb::io
 class QuakeFileSerializer : public MapFileSerializer
 {
 public:
-  explicit QuakeFileSerializer(std::ostream& stream)
-    : MapFileSerializer(stream)
+  QuakeFileSerializer(const mdl::MapFormat mapFormat, std::ostream& stream)
+    : MapFileSerializer(mapFormat, stream)
   {
   }
 
@@ -145,8 +145,8 @@ protected:
 class Quake2FileSerializer : public QuakeFileSerializer
 {
 public:
-  explicit Quake2FileSerializer(std::ostream& stream)
-    : QuakeFileSerializer(stream)
+  Quake2FileSerializer(const mdl::MapFormat mapFormat, std::ostream& stream)
+    : QuakeFileSerializer(mapFormat, stream)
   {
   }
 
@@ -179,8 +179,8 @@ protected:
 class Quake2ValveFileSerializer : public Quake2FileSerializer
 {
 public:
-  explicit Quake2ValveFileSerializer(std::ostream& stream)
-    : Quake2FileSerializer(stream)
+  Quake2ValveFileSerializer(const mdl::MapFormat mapFormat, std::ostream& stream)
+    : Quake2FileSerializer(mapFormat, stream)
   {
   }
 
@@ -205,8 +205,8 @@ private:
   std::string SurfaceColorFormat;
 
 public:
-  explicit DaikatanaFileSerializer(std::ostream& stream)
-    : Quake2FileSerializer(stream)
+  DaikatanaFileSerializer(const mdl::MapFormat mapFormat, std::ostream& stream)
+    : Quake2FileSerializer(mapFormat, stream)
     , SurfaceColorFormat(" %d %d %d")
   {
   }
@@ -244,8 +244,8 @@ protected:
 class Hexen2FileSerializer : public QuakeFileSerializer
 {
 public:
-  explicit Hexen2FileSerializer(std::ostream& stream)
-    : QuakeFileSerializer(stream)
+  Hexen2FileSerializer(const mdl::MapFormat mapFormat, std::ostream& stream)
+    : QuakeFileSerializer(mapFormat, stream)
   {
   }
 
@@ -262,8 +262,8 @@ private:
 class ValveFileSerializer : public QuakeFileSerializer
 {
 public:
-  explicit ValveFileSerializer(std::ostream& stream)
-    : QuakeFileSerializer(stream)
+  ValveFileSerializer(const mdl::MapFormat mapFormat, std::ostream& stream)
+    : QuakeFileSerializer(mapFormat, stream)
   {
   }
 
@@ -278,33 +278,49 @@ private:
 
 std::unique_ptr<NodeSerializer> MapFileSerializer::create(
   const mdl::MapFormat format, std::ostream& stream)
+{
+  return createSerializer(format, stream);
+}
+
+std::unique_ptr<NodeSerializer> MapFileSerializer::create(
+  const mdl::MapFormat format, std::ostream& stream, EntityTextCache& entityTextCache)
+{
+  auto serializer = createSerializer(format, stream);
+  serializer->m_entityTextCache = &entityTextCache;
+  return serializer;
+}
+
+std::unique_ptr<MapFileSerializer> MapFileSerializer::createSerializer(
+  const mdl::MapFormat format, std::ostream& stream)
 {
   switch (format)
   {
   case mdl::MapFormat::Standard:
-    return std::make_unique<QuakeFileSerializer>(stream);
+    return std::make_unique<QuakeFileSerializer>(format, stream);
   case mdl::MapFormat::Quake2:
     // TODO 2427: Implement Quake3 serializers and use them
   case mdl::MapFormat::Quake3:
   case mdl::MapFormat::Quake3_Legacy:
-    return std::make_unique<Quake2FileSerializer>(stream);
+    return std::make_unique<Quake2FileSerializer>(format, stream);
   case mdl::MapFormat::Quake2_Valve:
   case mdl::MapFormat::Quake3_Valve:
-    return std::make_unique<Quake2ValveFileSerializer>(stream);
+    return std::make_unique<Quake2ValveFileSerializer>(format, stream);
   case mdl::MapFormat::Daikatana:
-    return std::make_unique<DaikatanaFileSerializer>(stream);
+    return std::make_unique<DaikatanaFileSerializer>(format, stream);
   case mdl::MapFormat::Valve:
-    return std::make_unique<ValveFileSerializer>(stream);
+    return std::make_unique<ValveFileSerializer>(format, stream);
   case mdl::MapFormat::Hexen2:
-    return std::make_unique<Hexen2FileSerializer>(stream);
+    return std::make_unique<Hexen2FileSerializer>(format, stream);
   case mdl::MapFormat::Unknown:
     throw FileFormatException("Unknown map file format");
     switchDefault();
   }
 }
 
-MapFileSerializer::MapFileSerializer(std::ostream& stream)
-  : m_line(1)
+MapFileSerializer::MapFileSerializer(
+  const mdl::MapFormat mapFormat, std::ostream& stream)
+  : m_mapFormat(mapFormat)
+  , m_line(1)
   , m_stream(stream)
 {
 }
@@ -314,10 +330,19 @@ void MapFileSerializer::doBeginFile(
 {
   ensure(m_nodeToPrecomputedString.empty(), "MapFileSerializer may not be reused");
 
+  if (m_entityTextCache)
+  {
+    m_entityTextCache->beginWrite();
+  }
+
+  // brushes and patches of cached entities will be copied from the cache
+  const auto isCached = [&](const mdl::Node* node) {
+    return m_entityTextCache && m_entityTextCache->find(node->parent()) != nullptr;
+  };
+
   // collect nodes
-  std::vector<std::variant<const mdl::BrushNode*, const mdl::PatchNode*>>
-    nodesToSerialize;
-  nodesToSerialize.reserve(rootNodes.size());
+  auto brushesToSerialize = std::vector<const mdl::BrushNode*>{};
+  auto patchesToSerialize = std::vector<const mdl::PatchNode*>{};
 
   mdl::Node::visitAll(
     rootNodes,
@@ -334,24 +359,31 @@ void MapFileSerializer::doBeginFile(
       [](auto&& thisLambda, const mdl::EntityNode* entity) {
         entity->visitChildren(thisLambda);
       },
-      [&](const mdl::BrushNode* brush) { nodesToSerialize.emplace_back(brush); },
+      [&](const mdl::BrushNode* brushNode) {
+        // brush nodes keep their serialized faces until the brush changes
+        if (!isCached(brushNode) && !brushNode->serializedFaces(m_mapFormat))
+        {
+          brushesToSerialize.push_back(brushNode);
+        }
+      },
       [&](const mdl::PatchNode* patchNode) {
-        nodesToSerialize.emplace_back(patchNode);
+        if (!isCached(patchNode))
+        {
+          patchesToSerialize.push_back(patchNode);
+        }
       }));
 
-  // serialize brushes to strings in parallel
+  // serialize brushes to strings in parallel and cache them in the brush nodes
+  taskManager.parallel_for(brushesToSerialize.size(), [&](const size_t i) {
+    const auto* brushNode = brushesToSerialize[i];
+    brushNode->setSerializedFaces(writeBrushFaces(brushNode->brush()));
+  });
+
+  // serialize patches to strings in parallel
   using Entry = std::pair<const mdl::Node*, PrecomputedString>;
-  auto tasks = nodesToSerialize | std::views::transform([&](const auto& node) {
-                 return std::function{[&]() {
-                   return std::visit(
-                     kdl::overload(
-                       [&](const mdl::BrushNode* brushNode) {
-                         return Entry{brushNode, writeBrushFaces(brushNode->brush())};
-                       },
-                       [&](const mdl::PatchNode* patchNode) {
-                         return Entry{patchNode, writePatch(patchNode->patch())};
-                       }),
-                     node);
+  auto tasks = patchesToSerialize | std::views::transform([&](const auto* patchNode) {
+                 return std::function{[&, patchNode]() {
+                   return Entry{patchNode, writePatch(patchNode->patch())};
                  }};
                });
 
@@ -362,52 +394,164 @@ void MapFileSerializer::doBeginFile(
   }
 }
 
-void MapFileSerializer::doEndFile() {}
+void MapFileSerializer::doEndFile()
+{
+  if (m_entityTextCache)
+  {
+    m_entityTextCache->endWrite();
+  }
+}
+
+bool MapFileSerializer::doWriteCachedEntity(
+  const mdl::Node* node,
+  const std::vector<mdl::EntityProperty>& properties,
+  const std::vector<mdl::EntityProperty>& extraProperties,
+  const mdl::Node* brushParent)
+{
+  if (!m_entityTextCache || dynamic_cast<const mdl::LayerNode*>(brushParent))
+  {
+    // only the properties of layer entities are cached, see EntityTextCache
+    return false;
+  }
+
+  const auto* entry = m_entityTextCache->use(brushParent, properties, extraProperties);
+  if (!entry)
+  {
+    // serialize the entity normally and record its text in doEndEntity
+    m_recordedEntity = RecordedEntity{brushParent, properties, extraProperties, 0};
+    return false;
+  }
+
+  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "// entity {}\n", entityNo());
+  ++m_line;
+  m_stream << entry->text;
+
+  if (node->lineNumber() != m_line)
+  {
+    // Move the file positions of the entity and its brushes to where the text is now. The
+    // positions may have been set by another writer since the text was cached, so they
+    // are moved relative to the current position of the entity.
+    const auto entityLineNumber = node->lineNumber();
+    const auto updateFilePosition = [&](const auto& nodeOrFace) {
+      nodeOrFace.setFilePosition(
+        nodeOrFace.lineNumber() - entityLineNumber + m_line, nodeOrFace.lineCount());
+    };
+
+    updateFilePosition(*node);
+    brushParent->visitChildren(kdl::overload(
+      [](const mdl::WorldNode*) {},
+      [](const mdl::LayerNode*) {},
+      [](const mdl::GroupNode*) {},
+      [](const mdl::EntityNode*) {},
+      [&](const mdl::BrushNode* brushNode) {
+        updateFilePosition(*brushNode);
+        for (const auto& face : brushNode->brush().faces())
+        {
+          updateFilePosition(face);
+        }
+      },
+      [&](const mdl::PatchNode* patchNode) { updateFilePosition(*patchNode); }));
+  }
+
+  m_line += entry->lineCount;
+  return true;
+}
+
+bool MapFileSerializer::doWriteCachedEntityProperties(
+  const mdl::Node* node,
+  const std::vector<mdl::EntityProperty>& properties,
+  const std::vector<mdl::EntityProperty>& extraProperties)
+{
+  if (!m_entityTextCache || m_recordedEntity)
+  {
+    // the properties of recorded entities are part of the recorded text
+    return false;
+  }
+
+  const auto* entry = m_entityTextCache->useProperties(node, properties, extraProperties);
+  if (!entry)
+  {
+    auto str = std::ostringstream{};
+    for (const auto& property : properties)
+    {
+      writeEntityProperty(str, property);
+    }
+    for (const auto& property : extraProperties)
+    {
+      writeEntityProperty(str, property);
+    }
+
+    entry = &m_entityTextCache->putProperties(
+      node,
+      {properties,
+       extraProperties,
+       str.str(),
+       properties.size() + extraProperties.size()});
+  }
+
+  m_stream << entry->text;
+  m_line += entry->lineCount;
+  return true;
+}
 
 void MapFileSerializer::doBeginEntity(const mdl::Node* /* node */)
 {
   fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "// entity {}\n", entityNo());
   ++m_line;
+  if (m_recordedEntity)
+  {
+    m_recordedEntity->lineNumber = m_line;
+    m_entityStream.str({});
+  }
   m_startLineStack.push_back(m_line);
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "{{\n");
+  fmt::format_to(std::ostreambuf_iterator<char>(stream()), "{{\n");
   ++m_line;
 }
 
 void MapFileSerializer::doEndEntity(const mdl::Node* node)
 {
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "}}\n");
+  fmt::format_to(std::ostreambuf_iterator<char>(stream()), "}}\n");
   ++m_line;
   setFilePosition(node);
+
+  if (m_recordedEntity)
+  {
+    auto text = m_entityStream.str();
+    m_stream << text;
+
+    auto recordedEntity = std::move(*m_recordedEntity);
+    m_recordedEntity = std::nullopt;
+
+    m_entityTextCache->put(
+      recordedEntity.brushParent,
+      {recordedEntity.brushParent->modificationCount(),
+       std::move(recordedEntity.properties),
+       std::move(recordedEntity.extraProperties),
+       std::move(text),
+       m_line - recordedEntity.lineNumber});
+  }
 }
 
 void MapFileSerializer::doEntityProperty(const mdl::EntityProperty& attribute)
 {
-  fmt::format_to(
-    std::ostreambuf_iterator<char>(m_stream),
-    "\"{}\" \"{}\"\n",
-    escapeEntityProperties(attribute.key()),
-    escapeEntityProperties(attribute.value()));
+  writeEntityProperty(stream(), attribute);
   ++m_line;
 }
 
 void MapFileSerializer::doBrush(const mdl::BrushNode* brush)
 {
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "// brush {}\n", brushNo());
+  fmt::format_to(std::ostreambuf_iterator<char>(stream()), "// brush {}\n", brushNo());
   ++m_line;
   m_startLineStack.push_back(m_line);
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "{{\n");
+  fmt::format_to(std::ostreambuf_iterator<char>(stream()), "{{\n");
   ++m_line;
 
   // write pre-serialized brush faces
-  auto it = m_nodeToPrecomputedString.find(brush);
-  ensure(
-    it != std::end(m_nodeToPrecomputedString),
-    "attempted to serialize a brush which was not passed to doBeginFile");
-  const PrecomputedString& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
+  const auto& faces = serializedFaces(brush);
+  stream() << faces.text;
+  m_line += faces.lineCount;
 
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "}}\n");
+  fmt::format_to(std::ostreambuf_iterator<char>(stream()), "}}\n");
   ++m_line;
   setFilePosition(brush);
 }
@@ -415,27 +559,59 @@ void MapFileSerializer::doBrush(const mdl::BrushNode* brush)
 void MapFileSerializer::doBrushFace(const mdl::BrushFace& face)
 {
   const size_t lines = 1u;
-  doWriteBrushFace(m_stream, face);
+  doWriteBrushFace(stream(), face);
   face.setFilePosition(m_line, lines);
   m_line += lines;
 }
 
 void MapFileSerializer::doPatch(const mdl::PatchNode* patchNode)
 {
-  fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "// brush {}\n", brushNo());
+  fmt::format_to(std::ostreambuf_iterator<char>(stream()), "// brush {}\n", brushNo());
   ++m_line;
   m_startLineStack.push_back(m_line);
 
   // write pre-serialized patch
+  const auto& patchString = precomputedString(patchNode);
+  stream() << patchString.string;
+  m_line += patchString.lineCount;
+
+  setFilePosition(patchNode);
+}
+
+std::ostream& MapFileSerializer::stream()
+{
+  return m_recordedEntity ? m_entityStream : m_stream;
+}
+
+const mdl::BrushNode::SerializedFaces& MapFileSerializer::serializedFaces(
+  const mdl::BrushNode* brushNode)
+{
+  // doBeginFile skips the brushes of cached entities, but an entity's cached text
+  // cannot be used if its properties have changed
+  if (const auto* faces = brushNode->serializedFaces(m_mapFormat))
+  {
+    return *faces;
+  }
+
+  brushNode->setSerializedFaces(writeBrushFaces(brushNode->brush()));
+  return *brushNode->serializedFaces(m_mapFormat);
+}
+
+const MapFileSerializer::PrecomputedString& MapFileSerializer::precomputedString(
+  const mdl::PatchNode* patchNode)
+{
   auto it = m_nodeToPrecomputedString.find(patchNode);
+  if (it == std::end(m_nodeToPrecomputedString) && m_entityTextCache)
+  {
+    // see serializedFaces
+    it = m_nodeToPrecomputedString.emplace(patchNode, writePatch(patchNode->patch()))
+           .first;
+  }
+
   ensure(
     it != std::end(m_nodeToPrecomputedString),
     "attempted to serialize a patch which was not passed to doBeginFile");
-  const PrecomputedString& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
-
-  setFilePosition(patchNode);
+  return it->second;
 }
 
 void MapFileSerializer::setFilePosition(const mdl::Node* node)
@@ -452,10 +628,20 @@ size_t MapFileSerializer::startLine()
   return result;
 }
 
+void MapFileSerializer::writeEntityProperty(
+  std::ostream& stream, const mdl::EntityProperty& attribute) const
+{
+  fmt::format_to(
+    std::ostreambuf_iterator<char>(stream),
+    "\"{}\" \"{}\"\n",
+    escapeEntityProperties(attribute.key()),
+    escapeEntityProperties(attribute.value()));
+}
+
 /**
  * Threadsafe
  */
-MapFileSerializer::PrecomputedString MapFileSerializer::writeBrushFaces(
+mdl::BrushNode::SerializedFaces MapFileSerializer::writeBrushFaces(
   const mdl::Brush& brush) const
 {
   std::stringstream stream;
@@ -463,7 +649,7 @@ MapFileSerializer::PrecomputedString MapFileSerializer::writeBrushFaces(
   {
     doWriteBrushFace(stream, face);
   }
-  return PrecomputedString{stream.str(), brush.faces().size()};
+  return mdl::BrushNode::SerializedFaces{m_mapFormat, stream.str(), brush.faces().size()};
 }
 
 MapFileSerializer::PrecomputedString MapFileSerializer::writePatch(
@@ -20,10 +20,13 @@
 #pragma once
 
 #include "io/NodeSerializer.h"
+#include "mdl/BrushNode.h"
 #include "mdl/MapFormat.h"
 
 #include <iosfwd>
 #include <memory>
+#include <optional>
+#include <sstream>
 #include <unordered_map>
 #include <vector>
 
@@ -32,7 +35,6 @@ namespace tb::mdl
 {
 class BezierPatch;
 class Brush;
-class BrushNode;
 class BrushFace;
 class EntityProperty;
 class Node;
@@ -41,10 +43,13 @@ class PatchNode;
 
 namespace tb::io
 {
+class EntityTextCache;
 
 class MapFileSerializer : public NodeSerializer
 {
 private:
+  mdl::MapFormat m_mapFormat;
+
   using LineStack = std::vector<size_t>;
   LineStack m_startLineStack;
   size_t m_line;
@@ -57,19 +62,55 @@ private:
   };
   std::unordered_map<const mdl::Node*, PrecomputedString> m_nodeToPrecomputedString;
 
+  EntityTextCache* m_entityTextCache = nullptr;
+
+  /**
+   * The entity that is currently being serialized into m_entityStream so that its text
+   * can be added to the entity text cache.
+   */
+  struct RecordedEntity
+  {
+    const mdl::Node* brushParent;
+    std::vector<mdl::EntityProperty> properties;
+    std::vector<mdl::EntityProperty> extraProperties;
+    size_t lineNumber;
+  };
+  std::optional<RecordedEntity> m_recordedEntity;
+  std::ostringstream m_entityStream;
+
 public:
   static std::unique_ptr<NodeSerializer> create(
     mdl::MapFormat format, std::ostream& stream);
 
+  /**
+   * Creates a serializer that copies the text of unchanged entities from the given cache
+   * and updates the cache with the text of all other entities.
+   */
+  static std::unique_ptr<NodeSerializer> create(
+    mdl::MapFormat format, std::ostream& stream, EntityTextCache& entityTextCache);
+
 protected:
-  explicit MapFileSerializer(std::ostream& stream);
+  MapFileSerializer(mdl::MapFormat mapFormat, std::ostream& stream);
 
 private:
+  static std::unique_ptr<MapFileSerializer> createSerializer(
+    mdl::MapFormat format, std::ostream& stream);
+
   void doBeginFile(
     const std::vector<const mdl::Node*>& rootNodes,
     kdl::task_manager& taskManager) override;
   void doEndFile() override;
 
+  bool doWriteCachedEntity(
+    const mdl::Node* node,
+    const std::vector<mdl::EntityProperty>& properties,
+    const std::vector<mdl::EntityProperty>& extraProperties,
+    const mdl::Node* brushParent) override;
+  bool doWriteCachedEntityProperties(
+    const mdl::Node* node,
+    const std::vector<mdl::EntityProperty>& properties,
+    const std::vector<mdl::EntityProperty>& extraProperties) override;
+
   void doBeginEntity(const mdl::Node* node) override;
   void doEndEntity(const mdl::Node* node) override;
   void doEntityProperty(const mdl::EntityProperty& attribute) override;
@@ -79,13 +120,19 @@ private:
   void doPatch(const mdl::PatchNode* patchNode) override;
 
 private:
+  std::ostream& stream();
+  const mdl::BrushNode::SerializedFaces& serializedFaces(const mdl::BrushNode* brushNode);
+  const PrecomputedString& precomputedString(const mdl::PatchNode* patchNode);
+
   void setFilePosition(const mdl::Node* node);
   size_t startLine();
+  void writeEntityProperty(
+    std::ostream& stream, const mdl::EntityProperty& attribute) const;
 
 private: // threadsafe
   virtual void doWriteBrushFace(
     std::ostream& stream, const mdl::BrushFace& face) const = 0;
-  PrecomputedString writeBrushFaces(const mdl::Brush& brush) const;
+  mdl::BrushNode::SerializedFaces writeBrushFaces(const mdl::Brush& brush) const;
   PrecomputedString writePatch(const mdl::BezierPatch& patch) const;
 };
 
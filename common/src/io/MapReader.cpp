@@ -22,6 +22,7 @@
 #include "Error.h" // IWYU pragma: keep
 #include "FileLocation.h"
 #include "Uuid.h"
+#include "io/BufferedParserStatus.h"
 #include "io/ParserStatus.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
@@ -36,6 +37,8 @@
 #include "mdl/VisibilityState.h"
 #include "mdl/WorldNode.h"
 
+#include "kdl/overload.h"
+#include "kdl/range_to_vector.h"
 #include "kdl/result.h"
 #include "kdl/string_format.h"
 #include "kdl/string_utils.h"
@@ -46,10 +49,15 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
+#include <memory>
 #include <optional>
+#include <ranges>
 #include <ostream>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -60,6 +68,9 @@ namespace tb::io
 namespace
 {
 
+// smaller files are parsed on the calling thread
+constexpr auto MinChunkSize = size_t(64 * 1024);
+
 template <typename T>
 auto getFilePosition(const T& info)
 {
@@ -70,12 +81,54 @@ auto getFilePosition(const T& info)
 
 } // namespace
 
+/**
+ * Parses a chunk of a map file that contains whole entities and collects the resulting
+ * object infos. The object infos refer to their parents by their index within the chunk.
+ */
+class MapReader::ChunkReader : public MapReader
+{
+public:
+  ChunkReader(
+    const MapFileChunk& chunk,
+    const mdl::MapFormat sourceMapFormat,
+    const mdl::MapFormat targetMapFormat,
+    mdl::EntityPropertyConfig entityPropertyConfig)
+    : MapReader{
+        chunk.str,
+        sourceMapFormat,
+        targetMapFormat,
+        std::move(entityPropertyConfig),
+        chunk.line,
+        chunk.column}
+  {
+  }
+
+  Result<std::vector<ObjectInfo>> read(ParserStatus& status)
+  {
+    return parseEntities(status)
+           | kdl::transform([&]() { return std::move(m_objectInfos); });
+  }
+
+private:
+  mdl::Node* onWorldNode(std::unique_ptr<mdl::WorldNode>, ParserStatus&) override
+  {
+    return nullptr;
+  }
+
+  void onLayerNode(std::unique_ptr<mdl::Node>, ParserStatus&) override {}
+
+  void onNode(mdl::Node*, std::unique_ptr<mdl::Node>, ParserStatus&) override {}
+};
+
 MapReader::MapReader(
   const std::string_view str,
   const mdl::MapFormat sourceMapFormat,
   const mdl::MapFormat targetMapFormat,
-  mdl::EntityPropertyConfig entityPropertyConfig)
-  : StandardMapParser{str, sourceMapFormat, targetMapFormat}
+  mdl::EntityPropertyConfig entityPropertyConfig,
+  const size_t line,
+  const size_t column)
+  : StandardMapParser{str, sourceMapFormat, targetMapFormat, line, column}
+  , m_str{str}
   , m_entityPropertyConfig{std::move(entityPropertyConfig)}
 {
 }
@@ -83,11 +136,17 @@ MapReader::MapReader(
 Result<void> MapReader::readEntities(
   const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager)
 {
-  m_worldBounds = worldBounds;
-  return parseEntities(status)
+  return recordEntities(worldBounds, status, taskManager)
          | kdl::transform([&]() { createNodes(status, taskManager); });
 }
 
+Result<void> MapReader::recordEntities(
+  const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager)
+{
+  m_worldBounds = worldBounds;
+  return parseEntitiesInChunks(status, taskManager);
+}
+
 Result<void> MapReader::readBrushes(
   const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager)
 {
@@ -103,6 +162,18 @@ Result<void> MapReader::readBrushFaces(
   return parseBrushFaces(status);
 }
 
+const std::vector<MapReader::ObjectInfo>& MapReader::objectInfos() const
+{
+  return m_objectInfos;
+}
+
+void MapReader::setObjectInfos(
+  std::vector<ObjectInfo> objectInfos, const vm::bbox3d& worldBounds)
+{
+  m_objectInfos = std::move(objectInfos);
+  m_worldBounds = worldBounds;
+}
+
 // implement MapParser interface
 
 void MapReader::onBeginEntity(
@@ -905,6 +976,71 @@ std::unordered_map<mdl::Node*, mdl::Node*> buildNodeToParentMap(
 }
 } // namespace
 
+Result<void> MapReader::parseEntitiesInChunks(
+  ParserStatus& status, kdl::task_manager& taskManager)
+{
+  const auto workerCount = taskManager.worker_count();
+  if (workerCount < 2 || m_str.size() < 2 * MinChunkSize)
+  {
+    return parseEntities(status);
+  }
+
+  // create a few chunks per worker so that the load is balanced even if the entities
+  // have very different sizes
+  const auto chunks = splitIntoEntityChunks(
+    m_str, std::max(MinChunkSize, m_str.size() / (workerCount * 4)));
+  if (chunks.size() < 2)
+  {
+    return parseEntities(status);
+  }
+
+  using ChunkResult =
+    std::tuple<Result<std::vector<ObjectInfo>>, std::unique_ptr<BufferedParserStatus>>;
+
+  auto tasks = chunks | std::views::transform([&](const auto& chunk) {
+                 return std::function{[&]() {
+                   auto chunkStatus = std::make_unique<BufferedParserStatus>(status);
+                   auto chunkReader = ChunkReader{
+                     chunk, m_sourceMapFormat, m_targetMapFormat, m_entityPropertyConfig};
+                   auto objectInfos = chunkReader.read(*chunkStatus);
+                   return ChunkResult{std::move(objectInfos), std::move(chunkStatus)};
+                 }};
+               });
+  auto results = taskManager.run_tasks_and_wait(std::move(tasks));
+
+  if (std::ranges::any_of(
+        results, [](const auto& result) { return std::get<0>(result).is_error(); }))
+  {
+    // parse the entire file again to report the error exactly like a sequential parse
+    reset();
+    return parseEntities(status);
+  }
+
+  // merge the results in file order
+  for (auto& [objectInfos, chunkStatus] : results)
+  {
+    const auto offset = m_objectInfos.size();
+    for (auto& objectInfo : std::move(objectInfos).value())
+    {
+      std::visit(
+        kdl::overload(
+          [](EntityInfo&) {},
+          [&](auto& brushOrPatchInfo) {
+            if (brushOrPatchInfo.parentIndex)
+            {
+              *brushOrPatchInfo.parentIndex += offset;
+            }
+          }),
+        objectInfo);
+      m_objectInfos.push_back(std::move(objectInfo));
+    }
+
+    chunkStatus->flush();
+  }
+
+  return kdl::void_success;
+}
+
 /**
  * Creates nodes from the recorded object infos and resolves parent / child relationships.
  *
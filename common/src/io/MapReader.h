@@ -106,6 +106,9 @@ public: // only public so that helper methods can see these declarations
   using ObjectInfo = std::variant<EntityInfo, BrushInfo, PatchInfo>;
 
 private:
+  class ChunkReader;
+
+  std::string_view m_str;
   mdl::EntityPropertyConfig m_entityPropertyConfig;
   vm::bbox3d m_worldBounds;
 
@@ -123,18 +126,30 @@ protected:
    * @param targetMapFormat the format to convert the created objects to
    * @param entityPropertyConfig the entity property config to use
    * if orphaned
+   * @param line the line number of the first character of the given string
+   * @param column the column number of the first character of the given string
    */
   MapReader(
     std::string_view str,
     mdl::MapFormat sourceMapFormat,
     mdl::MapFormat targetMapFormat,
-    mdl::EntityPropertyConfig entityPropertyConfig);
+    mdl::EntityPropertyConfig entityPropertyConfig,
+    size_t line = 1,
+    size_t column = 1);
 
   /**
    * Attempts to parse as one or more entities.
+   *
+   * Large inputs are split into chunks of whole entities, which are parsed in parallel.
    */
   Result<void> readEntities(
     const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager);
+  /**
+   * Attempts to parse as one or more entities like readEntities, but only records the
+   * parsed objects. Call createNodes to create the nodes afterwards.
+   */
+  Result<void> recordEntities(
+    const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager);
   /**
    * Attempts to parse as one or more brushes without any enclosing entity.
    */
@@ -145,6 +160,22 @@ protected:
    */
   Result<void> readBrushFaces(const vm::bbox3d& worldBounds, ParserStatus& status);
 
+  /**
+   * Returns the objects recorded by the parser callbacks.
+   */
+  const std::vector<ObjectInfo>& objectInfos() const;
+
+  /**
+   * Replaces the recorded objects, e.g. with objects restored from a map cache. Call
+   * createNodes to create the nodes afterwards.
+   */
+  void setObjectInfos(std::vector<ObjectInfo> objectInfos, const vm::bbox3d& worldBounds);
+
+  /**
+   * Creates nodes from the recorded objects and passes them to the subclassing interface.
+   */
+  void createNodes(ParserStatus& status, kdl::task_manager& taskManager);
+
 protected: // implement MapParser interface
   void onBeginEntity(
     const FileLocation& location,
@@ -182,7 +213,8 @@ protected: // implement MapParser interface
     ParserStatus& status) override;
 
 private: // helper methods
-  void createNodes(ParserStatus& status, kdl::task_manager& taskManager);
+  Result<void> parseEntitiesInChunks(
+    ParserStatus& status, kdl::task_manager& taskManager);
 
 private: // subclassing interface - these will be called in the order that nodes should be
          // inserted
@@ -159,6 +159,12 @@ void NodeSerializer::entity(
   const std::vector<mdl::EntityProperty>& extraProperties,
   const mdl::Node* brushParent)
 {
+  if (doWriteCachedEntity(node, properties, extraProperties, brushParent))
+  {
+    ++m_entityNo;
+    return;
+  }
+
   beginEntity(node, properties, extraProperties);
 
   brushParent->visitChildren(kdl::overload(
@@ -189,8 +195,11 @@ void NodeSerializer::beginEntity(
   const std::vector<mdl::EntityProperty>& extraAttributes)
 {
   beginEntity(node);
-  entityProperties(properties);
-  entityProperties(extraAttributes);
+  if (!doWriteCachedEntityProperties(node, properties, extraAttributes))
+  {
+    entityProperties(properties);
+    entityProperties(extraAttributes);
+  }
 }
 
 void NodeSerializer::beginEntity(const mdl::Node* node)
@@ -352,6 +361,23 @@ std::vector<mdl::EntityProperty> NodeSerializer::groupProperties(
   return result;
 }
 
+bool NodeSerializer::doWriteCachedEntity(
+  const mdl::Node*,
+  const std::vector<mdl::EntityProperty>&,
+  const std::vector<mdl::EntityProperty>&,
+  const mdl::Node*)
+{
+  return false;
+}
+
+bool NodeSerializer::doWriteCachedEntityProperties(
+  const mdl::Node*,
+  const std::vector<mdl::EntityProperty>&,
+  const std::vector<mdl::EntityProperty>&)
+{
+  return false;
+}
+
 std::string NodeSerializer::escapeEntityProperties(const std::string& str) const
 {
   // Remove a trailing unescaped backslash, as this will choke the parser.
@@ -149,6 +149,27 @@ private:
     const std::vector<const mdl::Node*>& nodes, kdl::task_manager& taskManager) = 0;
   virtual void doEndFile() = 0;
 
+  /**
+   * Allows subclasses to write the given entity without serializing its properties,
+   * brushes and patches, e.g. by copying previously serialized text. Returns true if the
+   * entity was written.
+   */
+  virtual bool doWriteCachedEntity(
+    const mdl::Node* node,
+    const std::vector<mdl::EntityProperty>& properties,
+    const std::vector<mdl::EntityProperty>& extraProperties,
+    const mdl::Node* brushParent);
+
+  /**
+   * Allows subclasses to write the properties of the given entity without serializing
+   * them, e.g. by copying previously serialized text. Returns true if the properties were
+   * written.
+   */
+  virtual bool doWriteCachedEntityProperties(
+    const mdl::Node* node,
+    const std::vector<mdl::EntityProperty>& properties,
+    const std::vector<mdl::EntityProperty>& extraProperties);
+
   virtual void doBeginEntity(const mdl::Node* node) = 0;
   virtual void doEndEntity(const mdl::Node* node) = 0;
   virtual void doEntityProperty(const mdl::EntityProperty& property) = 0;
@@ -92,6 +92,13 @@ NodeWriter::NodeWriter(const mdl::WorldNode& world, std::ostream& stream)
 {
 }
 
+NodeWriter::NodeWriter(
+  const mdl::WorldNode& world, std::ostream& stream, EntityTextCache& entityTextCache)
+  : NodeWriter{
+      world, MapFileSerializer::create(world.mapFormat(), stream, entityTextCache)}
+{
+}
+
 NodeWriter::NodeWriter(
   const mdl::WorldNode& world, std::unique_ptr<NodeSerializer> serializer)
   : m_world{world}
@@ -31,6 +31,7 @@ namespace tb::io
 class BufferedReader;
 class BufferReaderSource;
 class CFile;
+class MappedFile;
 class ReaderSource;
 
 /**
@@ -64,6 +65,15 @@ public:
    */
   static Reader from(const CFile& file, size_t size);
 
+  /**
+   * Creates a new reader that reads from the given memory mapped file. The reader shares
+   * ownership of the mapping, so it remains valid even if the file is destroyed.
+   *
+   * @param file the file to read from
+   * @return the reader
+   */
+  static Reader from(const MappedFile& file);
+
   /**
    * Creates a new reader that reads from the given memory region.
    *
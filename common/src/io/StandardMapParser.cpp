@@ -55,14 +55,15 @@ auto tokenNames()
 
 } // namespace
 
-const std::string& QuakeMapTokenizer::NumberDelim()
+const CharClass& QuakeMapTokenizer::NumberDelim()
 {
-  static const std::string numberDelim(Whitespace() + ")");
+  static const auto numberDelim = Whitespace() | CharClass{")"};
   return numberDelim;
 }
 
-QuakeMapTokenizer::QuakeMapTokenizer(const std::string_view str)
-  : Tokenizer{tokenNames(), str, "\"", '\\'}
+QuakeMapTokenizer::QuakeMapTokenizer(
+  const std::string_view str, const size_t line, const size_t column)
+  : Tokenizer{tokenNames(), str, "\"", '\\', line, column}
 {
 }
 
@@ -168,14 +169,139 @@ QuakeMapTokenizer::Token QuakeMapTokenizer::emitToken()
   return Token{QuakeMapToken::Eof, nullptr, nullptr, length(), line(), column()};
 }
 
+std::vector<MapFileChunk> splitIntoEntityChunks(
+  const std::string_view str, const size_t minChunkSize)
+{
+  auto result = std::vector<MapFileChunk>{};
+
+  auto pos = size_t(0);
+  auto line = size_t(1);
+  auto column = size_t(1);
+  auto depth = size_t(0);
+
+  auto chunkStart = pos;
+  auto chunkLine = line;
+  auto chunkColumn = column;
+
+  const auto curChar = [&]() { return pos < str.size() ? str[pos] : '\0'; };
+  const auto lookAhead = [&]() { return pos + 1 < str.size() ? str[pos + 1] : '\0'; };
+
+  // counts lines and columns like the tokenizer does
+  const auto advance = [&]() {
+    if (str[pos] == '\n' || (str[pos] == '\r' && lookAhead() != '\n'))
+    {
+      ++line;
+      column = 1;
+    }
+    else
+    {
+      ++column;
+    }
+    ++pos;
+  };
+
+  const auto discardUntilEol = [&]() {
+    while (pos < str.size() && str[pos] != '\n' && str[pos] != '\r')
+    {
+      advance();
+    }
+  };
+
+  while (pos < str.size())
+  {
+    switch (str[pos])
+    {
+    case '/':
+      advance();
+      if (curChar() == '/')
+      {
+        advance();
+        if (curChar() == '/' && lookAhead() == ' ')
+        {
+          // the remainder of the line is tokenized normally
+          advance();
+        }
+        else
+        {
+          discardUntilEol();
+        }
+      }
+      break;
+    case ';':
+      advance();
+      discardUntilEol();
+      break;
+    case '"': {
+      advance();
+      auto escaped = false;
+      while (pos < str.size())
+      {
+        if (str[pos] == '"' && (!escaped || lookAhead() == '\n' || lookAhead() == '}'))
+        {
+          break;
+        }
+        escaped = str[pos] == '\\' && !escaped;
+        advance();
+      }
+      if (pos < str.size())
+      {
+        advance();
+      }
+      break;
+    }
+    case '{':
+      advance();
+      ++depth;
+      break;
+    case '}':
+      advance();
+      if (depth > 0 && --depth == 0 && pos - chunkStart >= minChunkSize)
+      {
+        result.push_back(
+          {str.substr(chunkStart, pos - chunkStart), chunkLine, chunkColumn});
+        chunkStart = pos;
+        chunkLine = line;
+        chunkColumn = column;
+      }
+      break;
+    case ' ':
+    case '\t':
+    case '\n':
+    case '\r':
+    case '(':
+    case ')':
+    case '[':
+    case ']':
+      advance();
+      break;
+    default:
+      // a word or a number, braces are only recognized at the start of a token
+      while (pos < str.size() && !QuakeMapTokenizer::Whitespace().contains(str[pos]))
+      {
+        advance();
+      }
+      break;
+    }
+  }
+
+  if (chunkStart < str.size())
+  {
+    result.push_back({str.substr(chunkStart), chunkLine, chunkColumn});
+  }
+
+  return result;
+}
+
 const std::string StandardMapParser::BrushPrimitiveId = "brushDef";
 const std::string StandardMapParser::PatchId = "patchDef2";
 
 StandardMapParser::StandardMapParser(
   const std::string_view str,
   const mdl::MapFormat sourceMapFormat,
-  const mdl::MapFormat targetMapFormat)
-  : m_tokenizer{str}
+  const mdl::MapFormat targetMapFormat,
+  const size_t line,
+  const size_t column)
+  : m_tokenizer{str, line, column}
   , m_sourceMapFormat{sourceMapFormat}
   , m_targetMapFormat{targetMapFormat}
 {
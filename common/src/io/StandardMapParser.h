@@ -63,11 +63,11 @@ static const Type Number = Integer | Decimal;
 class QuakeMapTokenizer : public Tokenizer<QuakeMapToken::Type>
 {
 private:
-  static const std::string& NumberDelim();
+  static const CharClass& NumberDelim();
   bool m_skipEol = true;
 
 public:
-  explicit QuakeMapTokenizer(std::string_view str);
+  explicit QuakeMapTokenizer(std::string_view str, size_t line = 1, size_t column = 1);
 
   void setSkipEol(bool skipEol);
 
@@ -75,6 +75,30 @@ private:
   Token emitToken() override;
 };
 
+/**
+ * A consecutive part of a map file that contains zero or more complete top level
+ * entities, along with the location of its first character.
+ */
+struct MapFileChunk
+{
+  std::string_view str;
+  size_t line;
+  size_t column;
+};
+
+/**
+ * Splits the given map file contents into consecutive chunks at the top level entity
+ * boundaries so that the chunks can be parsed independently. Every chunk except the last
+ * one is at least as long as the given minimum size. Concatenating the chunks yields the
+ * given string.
+ *
+ * This only looks at braces, quoted strings and comments and does not validate the
+ * contents. If the file is malformed, a chunk may end in the middle of an entity, in
+ * which case parsing that chunk will fail.
+ */
+std::vector<MapFileChunk> splitIntoEntityChunks(
+  std::string_view str, size_t minChunkSize);
+
 class StandardMapParser : public MapParser, public Parser<QuakeMapToken::Type>
 {
 private:
@@ -95,12 +119,21 @@ public:
    * Creates a new parser where the given string is expected to be formatted in the given
    * source map format, and the created objects are converted to the given target format.
    *
+   * The line and column are the location of the given string within its file and are
+   * used to report the locations of parsed objects and errors.
+   *
    * @param str the string to parse
    * @param sourceMapFormat the expected format of the given string
    * @param targetMapFormat the format to convert the created objects to
+   * @param line the line number of the first character of the given string
+   * @param column the column number of the first character of the given string
    */
   StandardMapParser(
-    std::string_view str, mdl::MapFormat sourceMapFormat, mdl::MapFormat targetMapFormat);
+    std::string_view str,
+    mdl::MapFormat sourceMapFormat,
+    mdl::MapFormat targetMapFormat,
+    size_t line = 1,
+    size_t column = 1);
 
   ~StandardMapParser() override;
 
@@ -21,6 +21,7 @@
 
 #include "Macros.h"
 #include "Token.h"
+#include "io/CharClass.h"
 #include "io/ParserException.h"
 
 #include "kdl/range_to_vector.h"
@@ -59,6 +60,8 @@ protected:
   const char* m_end;
   std::string m_escapableChars;
   char m_escapeChar;
+  // the characters that affect the line count or the escape state when advancing
+  CharClass m_stateChars;
   TokenizerState m_state;
 
 public:
@@ -73,6 +76,7 @@ public:
     , m_end{end}
     , m_escapableChars{escapableChars}
     , m_escapeChar{escapeChar}
+    , m_stateChars{std::string{'\n', '\r', escapeChar}}
     , m_state{begin, line, column, false}
   {
   }
@@ -131,9 +135,38 @@ protected:
 
   void advance(size_t offset)
   {
-    for (size_t i = 0; i < offset; ++i)
+    if (offset > size_t(m_end - m_state.cur))
     {
-      advance();
+      advanceTo(m_end);
+      errorIfEof();
+    }
+    advanceTo(m_state.cur + offset);
+  }
+
+  /**
+   * Advances to the given position, which must not be past the end of the input.
+   *
+   * This is equivalent to calling advance() until the given position is reached, but
+   * runs of characters that affect neither the line count nor the escape state are
+   * skipped in one step.
+   */
+  void advanceTo(const char* pos)
+  {
+    assert(pos >= m_state.cur && pos <= m_end);
+
+    while (m_state.cur < pos)
+    {
+      const auto* next = m_stateChars.findFirstOf(m_state.cur, pos);
+      if (next != m_state.cur)
+      {
+        m_state.column += size_t(next - m_state.cur);
+        m_state.escaped = false;
+        m_state.cur = next;
+      }
+      else
+      {
+        advance();
+      }
     }
   }
 
@@ -234,9 +267,9 @@ private:
   TokenNameMap m_tokenNames;
 
 public:
-  static const std::string& Whitespace()
+  static const CharClass& Whitespace()
   {
-    static const auto whitespace = std::string{" \t\n\r"};
+    static const auto whitespace = CharClass{" \t\n\r"};
     return whitespace;
   }
 
@@ -350,7 +383,7 @@ public:
     return std::string_view{startPos, size_t(endPos - startPos)};
   }
 
-  std::tuple<std::string_view, bool> readAnyString(std::string_view delims)
+  std::tuple<std::string_view, bool> readAnyString(const CharClass& delims)
   {
     while (isWhitespace(curChar()))
     {
@@ -404,11 +437,11 @@ protected:
     return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
   }
 
-  bool isWhitespace(const char c) const { return isAnyOf(c, Whitespace()); }
+  bool isWhitespace(const char c) const { return Whitespace().contains(c); }
 
   bool isEscaped() const { return escaped(); }
 
-  const char* readInteger(std::string_view delims)
+  const char* readInteger(const CharClass& delims)
   {
     if (curChar() == '+' || curChar() == '-' || isDigit(curChar()))
     {
@@ -417,10 +450,7 @@ protected:
       {
         advance();
       }
-      while (!eof() && isDigit(curChar()))
-      {
-        advance();
-      }
+      readDigits();
       if (eof() || isAnyOf(curChar(), delims))
       {
         return curPos();
@@ -432,7 +462,7 @@ protected:
     return nullptr;
   }
 
-  const char* readDecimal(std::string_view delims)
+  const char* readDecimal(const CharClass& delims)
   {
     if (curChar() == '+' || curChar() == '-' || curChar() == '.' || isDigit(curChar()))
     {
@@ -480,21 +510,21 @@ private:
   }
 
 protected:
-  const char* readUntil(std::string_view delims)
+  const char* readUntil(const CharClass& delims)
   {
     if (!eof())
     {
       do
       {
         advance();
-      } while (!eof() && !isAnyOf(curChar(), delims));
+      } while (!eof() && !delims.contains(curChar()));
     }
     return curPos();
   }
 
-  const char* readWhile(std::string_view allow)
+  const char* readWhile(const CharClass& allow)
   {
-    while (!eof() && isAnyOf(curChar(), allow))
+    while (!eof() && allow.contains(curChar()))
     {
       advance();
     }
@@ -504,8 +534,17 @@ protected:
   const char* readQuotedString(
     const char delim = '"', std::string_view hackDelims = std::string_view{})
   {
-    while (!eof() && (curChar() != delim || isEscaped()))
+    const char stopCharArray[] = {delim, '"'};
+    const auto stopChars =
+      CharClass{std::string_view{stopCharArray, hackDelims.empty() ? 1u : 2u}};
+    while (true)
     {
+      advanceTo(stopChars.findFirstOf(curPos(), m_end));
+      if (eof() || (curChar() == delim && !isEscaped()))
+      {
+        break;
+      }
+
       // This is a hack to handle paths with trailing backslashes that get misinterpreted
       // as escaped double quotation marks.
       if (
@@ -523,20 +562,17 @@ protected:
     return end;
   }
 
-  void discardWhile(std::string_view allow)
+  void discardWhile(const CharClass& allow)
   {
-    while (!eof() && isAnyOf(curChar(), allow))
+    while (!eof() && allow.contains(curChar()))
     {
       advance();
     }
   }
 
-  void discardUntil(std::string_view delims)
+  void discardUntil(const CharClass& delims)
   {
-    while (!eof() && !isAnyOf(curChar(), delims))
-    {
-      advance();
-    }
+    advanceTo(delims.findFirstOf(curPos(), m_end));
   }
 
   bool matchesPattern(std::string_view pattern) const
@@ -589,17 +625,7 @@ protected:
   }
 
 protected:
-  bool isAnyOf(const char c, std::string_view allow) const
-  {
-    for (const auto& a : allow)
-    {
-      if (c == a)
-      {
-        return true;
-      }
-    }
-    return false;
-  }
+  bool isAnyOf(const char c, const CharClass& allow) const { return allow.contains(c); }
 
   virtual Token emitToken() = 0;
 };
@@ -20,9 +20,11 @@
 #include "VirtualFileSystem.h"
 
 #include "io/File.h"
+#include "io/ImageFileSystem.h"
 #include "io/PathInfo.h"
 #include "io/TraversalMode.h"
 
+#include "kdl/path_hash.h"
 #include "kdl/path_utils.h"
 #include "kdl/result.h"
 #include "kdl/result_fold.h"
@@ -31,6 +33,7 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <mutex>
 #include <optional>
 #include <unordered_map>
 
@@ -76,16 +79,91 @@ bool operator!=(const VirtualMountPointId& lhs, const VirtualMountPointId& rhs)
   return !(lhs == rhs);
 }
 
+struct VirtualFileSystem::MountPointIndex
+{
+  std::once_flag built;
+
+  // maps the lowercase virtual paths of all entries of image file systems to the index
+  // of the last mounted image file system that contains them
+  std::unordered_map<std::filesystem::path, size_t, kdl::path_hash> imagePaths;
+
+  // the indices of the mount points that are not indexed, in mount order
+  std::vector<size_t> otherMountPoints;
+
+  /**
+   * Builds the index on the first call. The index is not modified afterwards, so it can
+   * be read concurrently without locking.
+   */
+  const MountPointIndex& get(const std::vector<VirtualMountPoint>& mountPoints)
+  {
+    std::call_once(built, [&]() {
+      for (size_t i = 0; i < mountPoints.size(); ++i)
+      {
+        if (!addImagePaths(mountPoints[i], i))
+        {
+          otherMountPoints.push_back(i);
+        }
+      }
+    });
+    return *this;
+  }
+
+private:
+  bool addImagePaths(const VirtualMountPoint& mountPoint, const size_t mountPointIndex)
+  {
+    const auto& fs = *mountPoint.mountedFileSystem;
+    if (!dynamic_cast<const ImageFileSystemBase*>(&fs))
+    {
+      return false;
+    }
+
+    const auto mountPathLC = kdl::path_to_lower(mountPoint.path);
+    return fs.find(std::filesystem::path{}, TraversalMode::Recursive)
+           | kdl::transform([&](const auto& paths) {
+               imagePaths[mountPathLC] = mountPointIndex;
+               for (const auto& path : paths)
+               {
+                 imagePaths[mountPathLC / kdl::path_to_lower(path)] = mountPointIndex;
+               }
+               return true;
+             })
+           | kdl::value_or(false);
+  }
+};
+
+VirtualFileSystem::VirtualFileSystem()
+  : m_index{std::make_unique<MountPointIndex>()}
+{
+}
+
+VirtualFileSystem::VirtualFileSystem(VirtualFileSystem&& other) noexcept = default;
+
+VirtualFileSystem::~VirtualFileSystem() = default;
+
+VirtualFileSystem& VirtualFileSystem::operator=(VirtualFileSystem&& other) noexcept =
+  default;
+
 Result<std::filesystem::path> VirtualFileSystem::makeAbsolute(
   const std::filesystem::path& path) const
 {
+  if (const auto result = findMountPoint(path))
+  {
+    if (auto absPath = result->mountPoint.mountedFileSystem->makeAbsolute(
+          result->pathSuffix);
+        absPath.is_success())
+    {
+      return absPath;
+    }
+  }
+
+  // fall back to the file systems mounted below
   for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
   {
     const auto& mountPoint = *it;
     if (matches(mountPoint, path))
     {
       const auto pathSuffix = suffix(mountPoint, path);
-      const auto absPath = mountPoint.mountedFileSystem->makeAbsolute(pathSuffix);
+      auto absPath = mountPoint.mountedFileSystem->makeAbsolute(pathSuffix);
       if (
         absPath.is_success()
         && mountPoint.mountedFileSystem->pathInfo(pathSuffix) != PathInfo::Unknown)
@@ -100,18 +178,9 @@ Result<std::filesystem::path> VirtualFileSystem::makeAbsolute(
 
 PathInfo VirtualFileSystem::pathInfo(const std::filesystem::path& path) const
 {
-  for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
+  if (const auto result = findMountPoint(path))
   {
-    const auto& mountPoint = *it;
-    if (matches(mountPoint, path))
-    {
-      const auto pathSuffix = suffix(mountPoint, path);
-      if (const auto pathInfo = mountPoint.mountedFileSystem->pathInfo(pathSuffix);
-          pathInfo != PathInfo::Unknown)
-      {
-        return pathInfo;
-      }
-    }
+    return result->pathInfo;
   }
 
   return std::any_of(
@@ -128,18 +197,9 @@ PathInfo VirtualFileSystem::pathInfo(const std::filesystem::path& path) const
 const FileSystemMetadata* VirtualFileSystem::metadata(
   const std::filesystem::path& path, const std::string& key) const
 {
-  for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
+  if (const auto result = findMountPoint(path))
   {
-    const auto& mountPoint = *it;
-    if (matches(mountPoint, path))
-    {
-      const auto pathSuffix = suffix(mountPoint, path);
-      if (const auto pathInfo = mountPoint.mountedFileSystem->pathInfo(pathSuffix);
-          pathInfo != PathInfo::Unknown)
-      {
-        return mountPoint.mountedFileSystem->metadata(pathSuffix, key);
-      }
-    }
+    return result->mountPoint.mountedFileSystem->metadata(result->pathSuffix, key);
   }
 
   return nullptr;
@@ -150,6 +210,7 @@ VirtualMountPointId VirtualFileSystem::mount(
 {
   const auto id = VirtualMountPointId{};
   m_mountPoints.push_back({id, path, std::move(fs)});
+  m_index = std::make_unique<MountPointIndex>();
   return id;
 }
 
@@ -162,6 +223,7 @@ bool VirtualFileSystem::unmount(const VirtualMountPointId& id)
       it != m_mountPoints.end())
   {
     m_mountPoints.erase(it);
+    m_index = std::make_unique<MountPointIndex>();
     return true;
   }
   return false;
@@ -170,6 +232,7 @@ bool VirtualFileSystem::unmount(const VirtualMountPointId& id)
 void VirtualFileSystem::unmountAll()
 {
   m_mountPoints.clear();
+  m_index = std::make_unique<MountPointIndex>();
 }
 
 namespace
@@ -300,20 +363,68 @@ Result<std::vector<std::filesystem::path>> VirtualFileSystem::doFind(
 Result<std::shared_ptr<File>> VirtualFileSystem::doOpenFile(
   const std::filesystem::path& path) const
 {
+  if (const auto result = findMountPoint(path))
+  {
+    return result->mountPoint.mountedFileSystem->openFile(result->pathSuffix);
+  }
+
+  return Error{fmt::format("{} not found", path)};
+}
+
+std::optional<VirtualFileSystem::FindMountPointResult> VirtualFileSystem::findMountPoint(
+  const std::filesystem::path& path) const
+{
+  const auto makeResult =
+    [&](const VirtualMountPoint& mountPoint) -> std::optional<FindMountPointResult> {
+    auto pathSuffix = suffix(mountPoint, path);
+    if (const auto pathInfo = mountPoint.mountedFileSystem->pathInfo(pathSuffix);
+        pathInfo != PathInfo::Unknown)
+    {
+      return FindMountPointResult{mountPoint, std::move(pathSuffix), pathInfo};
+    }
+    return std::nullopt;
+  };
+
+  const auto& index = m_index->get(m_mountPoints);
+  if (const auto imageIt = index.imagePaths.find(kdl::path_to_lower(path));
+      imageIt != index.imagePaths.end())
+  {
+    // only mount points that were mounted after the image file system can override it
+    for (auto it = index.otherMountPoints.rbegin();
+         it != index.otherMountPoints.rend() && *it > imageIt->second;
+         ++it)
+    {
+      const auto& mountPoint = m_mountPoints[*it];
+      if (matches(mountPoint, path))
+      {
+        if (auto result = makeResult(mountPoint))
+        {
+          return result;
+        }
+      }
+    }
+
+    if (auto result = makeResult(m_mountPoints[imageIt->second]))
+    {
+      return result;
+    }
+  }
+
+  // the path is not indexed as given, e.g. because it has a trailing separator, so all
+  // mount points are probed
   for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
   {
     const auto& mountPoint = *it;
     if (matches(mountPoint, path))
     {
-      const auto pathSuffix = suffix(mountPoint, path);
-      if (mountPoint.mountedFileSystem->pathInfo(pathSuffix) != PathInfo::Unknown)
+      if (auto result = makeResult(mountPoint))
       {
-        return mountPoint.mountedFileSystem->openFile(pathSuffix);
+        return result;
       }
     }
   }
 
-  return Error{fmt::format("{} not found", path)};
+  return std::nullopt;
 }
 
 WritableVirtualFileSystem::WritableVirtualFileSystem(
@@ -24,6 +24,7 @@
 
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace tb::io
@@ -50,12 +51,31 @@ struct VirtualMountPoint
   std::unique_ptr<FileSystem> mountedFileSystem;
 };
 
+/**
+ * Overlays the mounted file systems so that a path resolves to the most recently mounted
+ * file system that contains it.
+ *
+ * The contents of image file systems such as WAD or pak files never change, so they are
+ * indexed when the first path is resolved. Other mounted file systems are probed for
+ * every lookup. Paths that are not found in the index, e.g. because they are spelled
+ * differently, are resolved by probing all mounted file systems. The index is discarded
+ * whenever a file system is mounted or unmounted.
+ */
 class VirtualFileSystem : public FileSystem
 {
 private:
+  struct MountPointIndex;
+
   std::vector<VirtualMountPoint> m_mountPoints;
+  std::unique_ptr<MountPointIndex> m_index;
 
 public:
+  VirtualFileSystem();
+  VirtualFileSystem(VirtualFileSystem&& other) noexcept;
+  ~VirtualFileSystem() override;
+
+  VirtualFileSystem& operator=(VirtualFileSystem&& other) noexcept;
+
   Result<std::filesystem::path> makeAbsolute(
     const std::filesystem::path& path) const override;
   PathInfo pathInfo(const std::filesystem::path& path) const override;
@@ -72,6 +92,17 @@ protected:
     const std::filesystem::path& path, const TraversalMode& traversalMode) const override;
   Result<std::shared_ptr<File>> doOpenFile(
     const std::filesystem::path& path) const override;
+
+private:
+  struct FindMountPointResult
+  {
+    const VirtualMountPoint& mountPoint;
+    std::filesystem::path pathSuffix;
+    PathInfo pathInfo;
+  };
+
+  std::optional<FindMountPointResult> findMountPoint(
+    const std::filesystem::path& path) const;
 };
 
 class WritableVirtualFileSystem : public WritableFileSystem
@@ -27,6 +27,8 @@
 #include "kdl/string_format.h"
 #include "kdl/string_utils.h"
 
+#include <memory>
+
 namespace tb::io
 {
 namespace WadLayout
@@ -54,10 +56,25 @@ namespace WadEntryType
 // static const char WEPalette   = '@';
 }
 
-WadFileSystem::WadFileSystem(std::shared_ptr<CFile> file)
-  : ImageFileSystem{file->buffer()}
+namespace
+{
+Result<std::shared_ptr<File>> readEntry(
+  const File& file, const size_t entryAddress, const size_t entrySize)
 {
+  try
+  {
+    auto buffer = std::make_unique<char[]>(entrySize);
+    auto reader = file.reader().subReaderFromBegin(entryAddress, entrySize);
+    reader.read(buffer.get(), entrySize);
+    return std::static_pointer_cast<File>(
+      std::make_shared<OwningBufferFile>(std::move(buffer), entrySize));
+  }
+  catch (const ReaderException& e)
+  {
+    return Error{e.what()};
+  }
 }
+} // namespace
 
 Result<void> WadFileSystem::doReadDirectory()
 {
@@ -92,11 +109,15 @@ Result<void> WadFileSystem::doReadDirectory()
       return Error{"File directory is out of bounds."};
     }
 
-    reader.seekFromBegin(directoryOffset);
+    // Only the directory is read eagerly. The entries are read into their own buffers
+    // when they are opened, so that an opened entry doesn't keep the wad file alive.
+    auto directoryReader =
+      reader.subReaderFromBegin(directoryOffset, entryCount * WadLayout::DirEntrySize)
+        .buffer();
     for (size_t i = 0; i < entryCount; ++i)
     {
-      const auto entryAddress = reader.readSize<int32_t>();
-      const auto entrySize = reader.readSize<int32_t>();
+      const auto entryAddress = directoryReader.readSize<int32_t>();
+      const auto entrySize = directoryReader.readSize<int32_t>();
 
       if (m_file->size() < entryAddress + entrySize)
       {
@@ -104,20 +125,18 @@ Result<void> WadFileSystem::doReadDirectory()
           "File entry at address ", entryAddress, " is out of bounds")};
       }
 
-      reader.seekForward(WadLayout::DirEntryTypeOffset);
-      const auto entryType = reader.readString(1);
-      reader.seekForward(WadLayout::DirEntryNameOffset);
-      const auto entryName = reader.readString(WadLayout::DirEntryNameSize);
+      directoryReader.seekForward(WadLayout::DirEntryTypeOffset);
+      const auto entryType = directoryReader.readString(1);
+      directoryReader.seekForward(WadLayout::DirEntryNameOffset);
+      const auto entryName = directoryReader.readString(WadLayout::DirEntryNameSize);
       if (entryName.empty())
       {
         continue;
       }
 
       const auto path = std::filesystem::path{entryName + "." + entryType};
-      auto file_ = std::static_pointer_cast<File>(
-        std::make_shared<FileView>(m_file, entryAddress, entrySize));
-      addFile(path, [file = std::move(file_)]() -> Result<std::shared_ptr<File>> {
-        return file;
+      addFile(path, [this, entryAddress, entrySize]() {
+        return readEntry(*m_file, entryAddress, entrySize);
       });
     }
 
@@ -24,13 +24,20 @@
 
 namespace tb::io
 {
+class File;
 class FileSystem;
-class OwningBufferFile;
 
-class WadFileSystem : public ImageFileSystem<OwningBufferFile>
+/**
+ * Reads the directory of a wad file eagerly and reads each entry into its own buffer
+ * when it is opened.
+ *
+ * The wad file should be opened with Disk::openArchive so that a large wad file is
+ * memory mapped rather than kept open for the lifetime of this file system.
+ */
+class WadFileSystem : public ImageFileSystem<File>
 {
 public:
-  explicit WadFileSystem(std::shared_ptr<CFile> file);
+  using ImageFileSystem::ImageFileSystem;
 
 private:
   Result<void> doReadDirectory() override;
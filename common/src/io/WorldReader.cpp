@@ -19,6 +19,7 @@
 
 #include "WorldReader.h"
 
+#include "io/MapCache.h"
 #include "io/ParserStatus.h"
 #include "mdl/BrushNode.h"
 #include "mdl/Entity.h"
@@ -72,7 +73,8 @@ Result<std::unique_ptr<mdl::WorldNode>> WorldReader::tryRead(
   const vm::bbox3d& worldBounds,
   const mdl::EntityPropertyConfig& entityPropertyConfig,
   ParserStatus& status,
-  kdl::task_manager& taskManager)
+  kdl::task_manager& taskManager,
+  const ObjectInfoCallback& onObjectInfos)
 {
   auto parserErrors = std::vector<std::tuple<mdl::MapFormat, std::string>>{};
 
@@ -84,7 +86,8 @@ Result<std::unique_ptr<mdl::WorldNode>> WorldReader::tryRead(
     }
 
     auto reader = WorldReader{str, mapFormat, entityPropertyConfig};
-    if (auto result = reader.read(worldBounds, status, taskManager); result.is_success())
+    if (auto result = reader.read(worldBounds, status, taskManager, onObjectInfos);
+        result.is_success())
     {
       return result;
     }
@@ -106,6 +109,18 @@ Result<std::unique_ptr<mdl::WorldNode>> WorldReader::tryRead(
   return Error{"No valid formats to parse as"};
 }
 
+std::unique_ptr<mdl::WorldNode> WorldReader::readFromCache(
+  MapCache mapCache,
+  const vm::bbox3d& worldBounds,
+  const mdl::EntityPropertyConfig& entityPropertyConfig,
+  ParserStatus& status,
+  kdl::task_manager& taskManager)
+{
+  auto reader = WorldReader{"", mapCache.mapFormat, entityPropertyConfig};
+  reader.setObjectInfos(std::move(mapCache.objectInfos), worldBounds);
+  return reader.createWorld(status, taskManager);
+}
+
 namespace
 {
 
@@ -171,17 +186,31 @@ void setLinkIds(mdl::WorldNode& worldNode, ParserStatus& status)
 } // namespace
 
 Result<std::unique_ptr<mdl::WorldNode>> WorldReader::read(
-  const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager)
+  const vm::bbox3d& worldBounds,
+  ParserStatus& status,
+  kdl::task_manager& taskManager,
+  const ObjectInfoCallback& onObjectInfos)
 {
-  return readEntities(worldBounds, status, taskManager) | kdl::transform([&]() {
-           sanitizeLayerSortIndicies(*m_worldNode, status);
-           setLinkIds(*m_worldNode, status);
-           m_worldNode->rebuildNodeTree();
-           m_worldNode->enableNodeTreeUpdates();
-           return std::move(m_worldNode);
+  return recordEntities(worldBounds, status, taskManager) | kdl::transform([&]() {
+           if (onObjectInfos)
+           {
+             onObjectInfos(m_worldNode->mapFormat(), objectInfos());
+           }
+           return createWorld(status, taskManager);
          });
 }
 
+std::unique_ptr<mdl::WorldNode> WorldReader::createWorld(
+  ParserStatus& status, kdl::task_manager& taskManager)
+{
+  createNodes(status, taskManager);
+  sanitizeLayerSortIndicies(*m_worldNode, status);
+  setLinkIds(*m_worldNode, status);
+  m_worldNode->rebuildNodeTree();
+  m_worldNode->enableNodeTreeUpdates();
+  return std::move(m_worldNode);
+}
+
 mdl::Node* WorldReader::onWorldNode(
   std::unique_ptr<mdl::WorldNode> worldNode, ParserStatus&)
 {
@@ -22,6 +22,7 @@
 #include "Result.h"
 #include "io/MapReader.h"
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -38,6 +39,7 @@ class WorldNode;
 
 namespace tb::io
 {
+struct MapCache;
 class ParserStatus;
 
 /**
@@ -48,13 +50,23 @@ class WorldReader : public MapReader
   std::unique_ptr<mdl::WorldNode> m_worldNode;
 
 public:
+  /**
+   * Called with the map format and the parsed objects after a map was parsed
+   * successfully, but before any nodes are created. Used to write a map cache.
+   */
+  using ObjectInfoCallback =
+    std::function<void(mdl::MapFormat, const std::vector<ObjectInfo>&)>;
+
   WorldReader(
     std::string_view str,
     mdl::MapFormat sourceAndTargetMapFormat,
     const mdl::EntityPropertyConfig& entityPropertyConfig);
 
   Result<std::unique_ptr<mdl::WorldNode>> read(
-    const vm::bbox3d& worldBounds, ParserStatus& status, kdl::task_manager& taskManager);
+    const vm::bbox3d& worldBounds,
+    ParserStatus& status,
+    kdl::task_manager& taskManager,
+    const ObjectInfoCallback& onObjectInfos = {});
 
   /**
    * Try to parse the given string as the given map formats, in order.
@@ -65,6 +77,7 @@ public:
    * @param worldBounds world bounds
    * @param status status
    * @param taskManager the task manager to use for parallel tasks
+   * @param onObjectInfos called with the objects parsed using the successful format
    * @return the world node or an error if `str` can't be parsed by any of the given
    * formats
    */
@@ -74,8 +87,31 @@ public:
     const vm::bbox3d& worldBounds,
     const mdl::EntityPropertyConfig& entityPropertyConfig,
     ParserStatus& status,
+    kdl::task_manager& taskManager,
+    const ObjectInfoCallback& onObjectInfos = {});
+
+  /**
+   * Creates the world from the objects stored in the given map cache without parsing
+   * the map file.
+   *
+   * @param mapCache the map cache to read
+   * @param worldBounds world bounds
+   * @param entityPropertyConfig the entity property config to use
+   * @param status status
+   * @param taskManager the task manager to use for parallel tasks
+   * @return the world node
+   */
+  static std::unique_ptr<mdl::WorldNode> readFromCache(
+    MapCache mapCache,
+    const vm::bbox3d& worldBounds,
+    const mdl::EntityPropertyConfig& entityPropertyConfig,
+    ParserStatus& status,
     kdl::task_manager& taskManager);
 
+private:
+  std::unique_ptr<mdl::WorldNode> createWorld(
+    ParserStatus& status, kdl::task_manager& taskManager);
+
 private: // implement MapReader interface
   mdl::Node* onWorldNode(
     std::unique_ptr<mdl::WorldNode> worldNode, ParserStatus& status) override;
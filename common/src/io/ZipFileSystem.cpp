@@ -20,12 +20,14 @@
 #include "ZipFileSystem.h"
 
 #include "io/File.h"
+#include "io/ReaderException.h"
 
 #include "kdl/result.h"
 
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <cstdio>
 #include <memory>
 #include <string>
 
@@ -67,9 +69,35 @@ Result<void> ZipFileSystem::doReadDirectory()
 {
   mz_zip_zero_struct(&m_archive);
 
-  if (mz_zip_reader_init_cfile(&m_archive, m_file->file(), m_file->size(), 0) != MZ_TRUE)
+  if (const auto* cFile = dynamic_cast<const CFile*>(m_file.get()))
   {
-    return Error{"Error calling mz_zip_reader_init_cfile"};
+    // read the archive on demand instead of reading all of it into memory; miniz takes
+    // the current position of the file as the start of the archive
+    std::rewind(cFile->file());
+    if (
+      mz_zip_reader_init_cfile(&m_archive, cFile->file(), cFile->size(), 0) != MZ_TRUE)
+    {
+      return Error{"Error calling mz_zip_reader_init_cfile"};
+    }
+  }
+  else
+  {
+    try
+    {
+      // this does not copy the archive if the file is memory mapped or buffered
+      m_buffer = m_file->reader().buffer();
+    }
+    catch (const ReaderException& e)
+    {
+      return Error{e.what()};
+    }
+
+    if (
+      mz_zip_reader_init_mem(&m_archive, m_buffer->begin(), m_buffer->size(), 0)
+      != MZ_TRUE)
+    {
+      return Error{"Error calling mz_zip_reader_init_mem"};
+    }
   }
 
   const auto numFiles = mz_zip_reader_get_num_files(&m_archive);
@@ -81,23 +109,30 @@ Result<void> ZipFileSystem::doReadDirectory()
       addFile(path, [&, i, path]() -> Result<std::shared_ptr<File>> {
         auto loadFileGoard = std::lock_guard{m_mutex};
 
-        auto stat = mz_zip_archive_file_stat{};
-        if (!mz_zip_reader_file_stat(&m_archive, i, &stat))
-        {
-          return Error{fmt::format("mz_zip_reader_file_stat failed for {}", path)};
-        }
-
-        const auto uncompressedSize = static_cast<size_t>(stat.m_uncomp_size);
-        auto data = std::make_unique<char[]>(uncompressedSize);
-        auto* begin = data.get();
-
-        if (!mz_zip_reader_extract_to_mem(&m_archive, i, begin, uncompressedSize, 0))
-        {
-          return Error{fmt::format("mz_zip_reader_extract_to_mem failed for {}", path)};
-        }
-
-        return std::static_pointer_cast<File>(
-          std::make_shared<OwningBufferFile>(std::move(data), uncompressedSize));
+        return m_file->validate()
+               | kdl::and_then([&]() -> Result<std::shared_ptr<File>> {
+                   auto stat = mz_zip_archive_file_stat{};
+                   if (!mz_zip_reader_file_stat(&m_archive, i, &stat))
+                   {
+                     return Error{
+                       fmt::format("mz_zip_reader_file_stat failed for {}", path)};
+                   }
+
+                   const auto uncompressedSize = static_cast<size_t>(stat.m_uncomp_size);
+                   auto data = std::make_unique<char[]>(uncompressedSize);
+                   auto* begin = data.get();
+
+                   if (!mz_zip_reader_extract_to_mem(
+                         &m_archive, i, begin, uncompressedSize, 0))
+                   {
+                     return Error{
+                       fmt::format("mz_zip_reader_extract_to_mem failed for {}", path)};
+                   }
+
+                   return std::static_pointer_cast<File>(
+                     std::make_shared<OwningBufferFile>(
+                       std::move(data), uncompressedSize));
+                 });
       });
     }
   }
@@ -21,19 +21,22 @@
 
 #include "Result.h"
 #include "io/ImageFileSystem.h"
+#include "io/Reader.h"
 
 #include <miniz/miniz.h>
 
 #include <mutex>
+#include <optional>
 
 namespace tb::io
 {
-class CFile;
+class File;
 
-class ZipFileSystem : public ImageFileSystem<CFile>
+class ZipFileSystem : public ImageFileSystem<File>
 {
 private:
   mz_zip_archive m_archive;
+  std::optional<BufferedReader> m_buffer;
   std::mutex m_mutex;
 
 public:
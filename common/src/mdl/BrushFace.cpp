@@ -759,6 +759,11 @@ size_t BrushFace::lineNumber() const
   return m_lineNumber;
 }
 
+size_t BrushFace::lineCount() const
+{
+  return m_lineCount;
+}
+
 void BrushFace::setFilePosition(const size_t lineNumber, const size_t lineCount) const
 {
   m_lineNumber = lineNumber;
@@ -792,7 +797,7 @@ std::optional<double> BrushFace::intersectWithRay(const vm::ray3d& ray) const
   ensure(m_geometry != nullptr, "geometry is null");
 
   const auto cos = vm::dot(m_boundary.normal, ray.direction);
-  return cos < 0.0 ? vm::intersect_ray_polygon(
+  return cos < 0.0 ? vm::intersect_ray_convex_polygon(
                        ray,
                        m_boundary,
                        m_geometry->boundary().begin(),
@@ -43,6 +43,7 @@
 
 #include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace tb::mdl
@@ -96,6 +97,7 @@ Brush BrushNode::setBrush(Brush brush)
 
   using std::swap;
   swap(m_brush, brush);
+  m_serializedFaces = std::nullopt;
 
   updateSelectedFaceCount();
   invalidateIssues();
@@ -130,6 +132,9 @@ void BrushNode::setFaceMaterial(const size_t faceIndex, Material* material)
 {
   m_brush.face(faceIndex).setMaterial(material);
 
+  // the material can affect how the face is serialized
+  m_serializedFaces = std::nullopt;
+  nodeModificationCountDidChange();
   invalidateIssues();
   invalidateVertexCache();
 }
@@ -403,6 +408,19 @@ render::BrushRendererBrushCache& BrushNode::brushRendererBrushCache() const
   return *m_brushRendererBrushCache;
 }
 
+const BrushNode::SerializedFaces* BrushNode::serializedFaces(
+  const MapFormat mapFormat) const
+{
+  return m_serializedFaces && m_serializedFaces->mapFormat == mapFormat
+           ? &*m_serializedFaces
+           : nullptr;
+}
+
+void BrushNode::setSerializedFaces(SerializedFaces serializedFaces) const
+{
+  m_serializedFaces = std::move(serializedFaces);
+}
+
 void BrushNode::initializeTags(TagManager& tagManager)
 {
   Taggable::initializeTags(tagManager);
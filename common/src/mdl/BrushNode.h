@@ -46,6 +46,7 @@ class GroupNode;
 class LayerNode;
 class Material;
 class ModelFactory;
+enum class MapFormat;
 
 class BrushNode : public Node, public Object
 {
@@ -56,11 +57,19 @@ public:
   using VertexList = BrushVertexList;
   using EdgeList = BrushEdgeList;
 
+  struct SerializedFaces
+  {
+    MapFormat mapFormat;
+    std::string text;
+    size_t lineCount;
+  };
+
 private:
   mutable std::unique_ptr<render::BrushRendererBrushCache>
     m_brushRendererBrushCache; // unique_ptr for breaking header dependencies
   Brush m_brush;               // must be destroyed before the brush renderer cache
   size_t m_selectedFaceCount = 0u;
+  mutable std::optional<SerializedFaces> m_serializedFaces;
 
 public:
   explicit BrushNode(Brush brush);
@@ -128,6 +137,15 @@ public: // renderer cache
   void invalidateVertexCache();
   render::BrushRendererBrushCache& brushRendererBrushCache() const;
 
+public: // serialization cache
+  /**
+   * Returns the serialized faces of this brush in the given map format as they were
+   * cached by io::MapFileSerializer, or null if there is no such cached text. The cache
+   * is cleared whenever the brush or the material of one of its faces changes.
+   */
+  const SerializedFaces* serializedFaces(MapFormat mapFormat) const;
+  void setSerializedFaces(SerializedFaces serializedFaces) const;
+
 private: // implement Taggable interface
 public:
   void initializeTags(TagManager& tagManager) override;
@@ -0,0 +1,261 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CompactNodeContents.h"
+
+#include "Ensure.h"
+#include "mdl/BrushGeometry.h"
+#include "mdl/BrushNode.h"
+#include "mdl/EntityNode.h"
+#include "mdl/GroupNode.h"
+#include "mdl/LayerNode.h"
+#include "mdl/PatchNode.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/overload.h"
+
+#include <optional>
+
+namespace tb::mdl
+{
+namespace
+{
+
+const Brush* getBrush(const Node& node)
+{
+  const auto* brushNode = dynamic_cast<const BrushNode*>(&node);
+  return brushNode ? &brushNode->brush() : nullptr;
+}
+
+const Brush* getBrush(const NodeContents& contents)
+{
+  return std::get_if<Brush>(&contents.get());
+}
+
+bool hasSameGeometry(const BrushFace& lhs, const BrushFace& rhs)
+{
+  return lhs.points() == rhs.points() && lhs.boundary() == rhs.boundary();
+}
+
+bool hasSameGeometry(const Brush& lhs, const Brush& rhs)
+{
+  if (lhs.faceCount() != rhs.faceCount())
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < lhs.faceCount(); ++i)
+  {
+    if (!hasSameGeometry(lhs.face(i), rhs.face(i)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Compares everything except for the material, which is unset in node contents.
+ */
+bool isSameFace(const BrushFace& lhs, const BrushFace& rhs)
+{
+  return hasSameGeometry(lhs, rhs) && lhs.attributes() == rhs.attributes()
+         && lhs.uAxis() == rhs.uAxis() && lhs.vAxis() == rhs.vAxis()
+         && lhs.selected() == rhs.selected() && lhs.lineNumber() == rhs.lineNumber()
+         && lhs.lineCount() == rhs.lineCount();
+}
+
+size_t memoryUsage(const std::string& str)
+{
+  return str.capacity();
+}
+
+size_t memoryUsage(const BrushFace& face)
+{
+  return sizeof(BrushFace) + memoryUsage(face.attributes().materialName());
+}
+
+size_t memoryUsage(const Brush& brush)
+{
+  auto result = sizeof(Brush) + sizeof(BrushGeometry)
+                + brush.vertexCount() * sizeof(BrushVertex)
+                + brush.edgeCount() * (sizeof(BrushEdge) + 2 * sizeof(BrushHalfEdge))
+                + brush.faceCount() * sizeof(BrushFaceGeometry);
+  for (const auto& face : brush.faces())
+  {
+    result += memoryUsage(face);
+  }
+  return result;
+}
+
+size_t memoryUsage(const Layer& layer)
+{
+  return sizeof(Layer) + memoryUsage(layer.name());
+}
+
+size_t memoryUsage(const Group& group)
+{
+  return sizeof(Group) + memoryUsage(group.name());
+}
+
+size_t memoryUsage(const Entity& entity)
+{
+  auto result = sizeof(Entity);
+  for (const auto& property : entity.properties())
+  {
+    result += sizeof(EntityProperty) + memoryUsage(property.key())
+              + memoryUsage(property.value());
+  }
+  for (const auto& key : entity.protectedProperties())
+  {
+    result += sizeof(std::string) + memoryUsage(key);
+  }
+  return result;
+}
+
+size_t memoryUsage(const BezierPatch& patch)
+{
+  return sizeof(BezierPatch) + patch.controlPoints().size() * sizeof(BezierPatch::Point)
+         + memoryUsage(patch.materialName());
+}
+
+} // namespace
+
+CompactNodeContents::CompactNodeContents(NodeContents contents)
+  : m_contents{std::move(contents)}
+{
+}
+
+CompactNodeContents::CompactNodeContents(NodeContents contents, const Node& base)
+  : m_contents{std::move(contents)}
+{
+  const auto* brush = getBrush(std::get<NodeContents>(m_contents));
+  const auto* baseBrush = getBrush(base);
+  if (brush && baseBrush && hasSameGeometry(*brush, *baseBrush))
+  {
+    auto delta = BrushDelta{};
+    delta.faces.reserve(brush->faceCount());
+
+    for (size_t i = 0; i < brush->faceCount(); ++i)
+    {
+      const auto& face = brush->face(i);
+      if (isSameFace(face, baseBrush->face(i)))
+      {
+        delta.faces.emplace_back(std::nullopt);
+      }
+      else
+      {
+        // copying a face does not copy its geometry
+        delta.faces.emplace_back(face);
+      }
+    }
+
+    m_contents = std::move(delta);
+  }
+}
+
+NodeContents CompactNodeContents::expand(const Node& base) &&
+{
+  return std::move(*this).expand(getBrush(base));
+}
+
+NodeContents CompactNodeContents::expand(const NodeContents& base) &&
+{
+  return std::move(*this).expand(getBrush(base));
+}
+
+NodeContents CompactNodeContents::expand(const Brush* baseBrush) &&
+{
+  return std::visit(
+    kdl::overload(
+      [](NodeContents& contents) { return std::move(contents); },
+      [&](BrushDelta& delta) {
+        ensure(baseBrush != nullptr, "base is a brush");
+
+        auto brush = *baseBrush;
+        for (size_t i = 0; i < delta.faces.size(); ++i)
+        {
+          if (auto& face = delta.faces[i])
+          {
+            auto* geometry = brush.face(i).geometry();
+            brush.face(i) = std::move(*face);
+            brush.face(i).setGeometry(geometry);
+          }
+        }
+        return NodeContents{std::move(brush)};
+      }),
+    m_contents);
+}
+
+size_t CompactNodeContents::memoryUsage() const
+{
+  return sizeof(CompactNodeContents)
+         + std::visit(
+           kdl::overload(
+             [](const NodeContents& contents) { return mdl::memoryUsage(contents); },
+             [](const BrushDelta& delta) {
+               auto result =
+                 delta.faces.capacity() * sizeof(decltype(delta.faces)::value_type);
+               for (const auto& face : delta.faces)
+               {
+                 if (face)
+                 {
+                   result += face->attributes().materialName().capacity();
+                 }
+               }
+               return result;
+             }),
+           m_contents);
+}
+
+size_t memoryUsage(const NodeContents& contents)
+{
+  return std::visit([](const auto& x) { return memoryUsage(x); }, contents.get());
+}
+
+size_t memoryUsage(const Node& node)
+{
+  auto result = size_t(0);
+  node.accept(kdl::overload(
+    [&](auto&& thisLambda, const WorldNode* world) {
+      result += sizeof(WorldNode) + memoryUsage(world->entity());
+      world->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, const LayerNode* layer) {
+      result += sizeof(LayerNode) + memoryUsage(layer->layer());
+      layer->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, const GroupNode* group) {
+      result += sizeof(GroupNode) + memoryUsage(group->group());
+      group->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, const EntityNode* entity) {
+      result += sizeof(EntityNode) + memoryUsage(entity->entity());
+      entity->visitChildren(thisLambda);
+    },
+    [&](const BrushNode* brush) {
+      result += sizeof(BrushNode) + memoryUsage(brush->brush());
+    },
+    [&](const PatchNode* patch) {
+      result += sizeof(PatchNode) + memoryUsage(patch->patch());
+    }));
+  return result;
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,99 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "mdl/BrushFace.h"
+#include "mdl/NodeContents.h"
+
+#include <optional>
+#include <variant>
+#include <vector>
+
+namespace tb::mdl
+{
+class Node;
+
+/**
+ * Stores node contents relative to a base, which is either the current contents of a
+ * node or other node contents.
+ *
+ * If a brush has the same geometry as the base brush, it is stored as a list of faces
+ * where every face that is identical to the corresponding face of the base brush is
+ * omitted. The brush geometry is not stored at all, and the geometry of the base brush
+ * is reused when the contents are expanded. Brushes with different geometry and all other
+ * contents are stored as they are, so that expanding them restores them exactly.
+ *
+ * Compact contents must be expanded against the same base they were compacted against.
+ */
+class CompactNodeContents
+{
+private:
+  struct BrushDelta
+  {
+    std::vector<std::optional<BrushFace>> faces;
+  };
+
+  std::variant<NodeContents, BrushDelta> m_contents;
+
+public:
+  /**
+   * Stores the given contents as they are. They can be expanded against any base.
+   */
+  explicit CompactNodeContents(NodeContents contents);
+
+  /**
+   * Stores the given contents relative to the current contents of the given node.
+   */
+  CompactNodeContents(NodeContents contents, const Node& base);
+
+  /**
+   * Restores the full contents using the current contents of the given node as the base.
+   *
+   * The contents are moved out of this object, so it must not be used afterwards.
+   */
+  NodeContents expand(const Node& base) &&;
+
+  /**
+   * Restores the full contents using the given contents as the base.
+   *
+   * The contents are moved out of this object, so it must not be used afterwards.
+   */
+  NodeContents expand(const NodeContents& base) &&;
+
+  /**
+   * Returns an estimate of the number of bytes used by these contents.
+   */
+  size_t memoryUsage() const;
+
+private:
+  NodeContents expand(const Brush* baseBrush) &&;
+};
+
+/**
+ * Returns an estimate of the number of bytes used by the given contents.
+ */
+size_t memoryUsage(const NodeContents& contents);
+
+/**
+ * Returns an estimate of the number of bytes used by the given node and its descendants.
+ */
+size_t memoryUsage(const Node& node);
+
+} // namespace tb::mdl
@@ -21,6 +21,7 @@
 
 #include "el/EvaluationContext.h"
 #include "el/Expression.h"
+#include "el/ExpressionCache.h"
 #include "el/Types.h"
 #include "el/Value.h"
 #include "el/VariableStore.h"
@@ -59,22 +60,30 @@ DecalSpecification convertToDecal(
 
   return {};
 }
+auto makeCache(const el::ExpressionNode& expression)
+{
+  return std::make_shared<el::ExpressionCache<Result<DecalSpecification>>>(
+    expression.variableNames());
+}
 } // namespace
 
 kdl_reflect_impl(DecalSpecification);
 
 DecalDefinition::DecalDefinition()
   : m_expression{el::LiteralExpression{el::Value::Undefined}}
+  , m_cache{makeCache(m_expression)}
 {
 }
 
 DecalDefinition::DecalDefinition(const FileLocation& location)
   : m_expression{el::LiteralExpression{el::Value::Undefined}, location}
+  , m_cache{makeCache(m_expression)}
 {
 }
 
 DecalDefinition::DecalDefinition(el::ExpressionNode expression)
   : m_expression{std::move(expression)}
+  , m_cache{makeCache(m_expression)}
 {
 }
 
@@ -85,16 +94,19 @@ void DecalDefinition::append(const DecalDefinition& other)
   auto cases =
     std::vector<el::ExpressionNode>{std::move(m_expression), other.m_expression};
   m_expression = el::ExpressionNode{el::SwitchExpression{std::move(cases)}, location};
+  m_cache = makeCache(m_expression);
 }
 
 Result<DecalSpecification> DecalDefinition::decalSpecification(
   const el::VariableStore& variableStore) const
 {
-  return el::withEvaluationContext(
-    [&](auto& context) {
-      return convertToDecal(context, m_expression.evaluate(context));
-    },
-    variableStore);
+  return m_cache->getOrEvaluate(variableStore, [&]() {
+    return el::withEvaluationContext(
+      [&](auto& context) {
+        return convertToDecal(context, m_expression.evaluate(context));
+      },
+      variableStore);
+  });
 }
 
 Result<DecalSpecification> DecalDefinition::defaultDecalSpecification() const
@@ -24,6 +24,8 @@
 
 #include "kdl/reflection_decl.h"
 
+#include <memory>
+
 namespace tb
 {
 struct FileLocation;
@@ -48,6 +50,9 @@ class DecalDefinition
 {
 private:
   el::ExpressionNode m_expression;
+  // memoizes evaluation results, shared by copies and replaced when the expression
+  // changes
+  std::shared_ptr<el::ExpressionCache<Result<DecalSpecification>>> m_cache;
 
 public:
   DecalDefinition();
@@ -629,4 +629,9 @@ const EntityModelDataResource& EntityModel::dataResource() const
   return *m_dataResource;
 }
 
+EntityModelDataResource& EntityModel::dataResource()
+{
+  return *m_dataResource;
+}
+
 } // namespace tb::mdl
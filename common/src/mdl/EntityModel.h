@@ -457,6 +457,7 @@ public:
   EntityModelData* data();
 
   const EntityModelDataResource& dataResource() const;
+  EntityModelDataResource& dataResource();
 };
 
 } // namespace tb::mdl
@@ -161,6 +161,14 @@ const EntityModel* EntityModelManager::model(const std::filesystem::path& path)
   return nullptr;
 }
 
+void EntityModelManager::requestModel(const std::filesystem::path& path)
+{
+  if (auto it = m_models.find(path); it != std::end(m_models))
+  {
+    it->second.dataResource().request();
+  }
+}
+
 const std::vector<const EntityModel*> EntityModelManager::
   findEntityModelsByTextureResourceId(const std::vector<ResourceId>& resourceIds) const
 {
@@ -203,7 +211,8 @@ Result<EntityModel> EntityModelManager::loadModel(
       return createResourceSync(std::move(resourceLoader));
     };
 
-    const auto loadMaterial = [&](const auto& materialPath) {
+    // the material loader is run by the model loader on a worker thread
+    const auto loadMaterial = [&, createResource](const auto& materialPath) {
       return io::loadMaterial(
                fs, materialConfig, materialPath, createResource, m_shaders, std::nullopt)
              | kdl::or_else(io::makeReadMaterialErrorHandler(fs, m_logger))
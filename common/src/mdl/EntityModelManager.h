@@ -88,6 +88,12 @@ public:
   const EntityModelFrame* frame(const ModelSpecification& spec) const;
   const EntityModel* model(const std::filesystem::path& path) const;
 
+  /**
+   * Requests the model with the given path so that it is loaded before models that were
+   * requested earlier or not at all. Does nothing if the model was never loaded.
+   */
+  void requestModel(const std::filesystem::path& path);
+
   const std::vector<const EntityModel*> findEntityModelsByTextureResourceId(
     const std::vector<ResourceId>& resourceIds) const;
 
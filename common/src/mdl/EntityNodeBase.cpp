@@ -164,17 +164,21 @@ void EntityNodeBase::updatePropertyIndex(
 
     if (oldProp < newProp)
     {
-      removePropertyFromIndex(oldProp.key(), oldProp.value());
+      removePropertyFromIndex(oldProp.internedKey(), oldProp.internedValue());
       ++oldIt;
     }
     else if (oldProp > newProp)
     {
-      addPropertyToIndex(newProp.key(), newProp.value());
+      addPropertyToIndex(newProp.internedKey(), newProp.internedValue());
       ++newIt;
     }
     else
     {
-      updatePropertyIndex(oldProp.key(), oldProp.value(), newProp.key(), newProp.value());
+      updatePropertyIndex(
+        oldProp.internedKey(),
+        oldProp.internedValue(),
+        newProp.internedKey(),
+        newProp.internedValue());
       ++oldIt;
       ++newIt;
     }
@@ -183,14 +187,14 @@ void EntityNodeBase::updatePropertyIndex(
   while (oldIt != oldEnd)
   {
     const auto& oldProp = *oldIt;
-    removePropertyFromIndex(oldProp.key(), oldProp.value());
+    removePropertyFromIndex(oldProp.internedKey(), oldProp.internedValue());
     ++oldIt;
   }
 
   while (newIt != newEnd)
   {
     const auto& newProp = *newIt;
-    addPropertyToIndex(newProp.key(), newProp.value());
+    addPropertyToIndex(newProp.internedKey(), newProp.internedValue());
     ++newIt;
   }
 }
@@ -246,7 +250,7 @@ void EntityNodeBase::addPropertiesToIndex()
 {
   for (const auto& property : m_entity.properties())
   {
-    addPropertyToIndex(property.key(), property.value());
+    addPropertyToIndex(property.internedKey(), property.internedValue());
   }
 }
 
@@ -254,26 +258,27 @@ void EntityNodeBase::removePropertiesFromIndex()
 {
   for (const auto& property : m_entity.properties())
   {
-    removePropertyFromIndex(property.key(), property.value());
+    removePropertyFromIndex(property.internedKey(), property.internedValue());
   }
 }
 
-void EntityNodeBase::addPropertyToIndex(const std::string& key, const std::string& value)
+void EntityNodeBase::addPropertyToIndex(
+  const InternedString& key, const InternedString& value)
 {
   addToIndex(this, key, value);
 }
 
 void EntityNodeBase::removePropertyFromIndex(
-  const std::string& key, const std::string& value)
+  const InternedString& key, const InternedString& value)
 {
   removeFromIndex(this, key, value);
 }
 
 void EntityNodeBase::updatePropertyIndex(
-  const std::string& oldKey,
-  const std::string& oldValue,
-  const std::string& newKey,
-  const std::string& newValue)
+  const InternedString& oldKey,
+  const InternedString& oldValue,
+  const InternedString& newKey,
+  const InternedString& newValue)
 {
   if (oldKey == newKey && oldValue == newValue)
   {
@@ -24,16 +24,58 @@
 #include "mdl/EntityNodeBase.h"
 #include "mdl/EntityProperties.h"
 
-#include "kdl/compact_trie.h"
+#include "kdl/string_compare.h"
 #include "kdl/vector_utils.h"
 
-#include <iterator>
-#include <list>
 #include <string>
 #include <vector>
 
 namespace tb::mdl
 {
+namespace
+{
+
+void insert(EntityNodeStringIndex& index, const InternedString& str, EntityNodeBase* node)
+{
+  ++index[str][node];
+}
+
+void remove(EntityNodeStringIndex& index, const InternedString& str, EntityNodeBase* node)
+{
+  if (const auto strIt = index.find(str); strIt != index.end())
+  {
+    auto& nodes = strIt->second;
+    const auto nodeIt = nodes.find(node);
+    if (nodeIt != nodes.end() && --nodeIt->second == 0)
+    {
+      nodes.erase(nodeIt);
+      if (nodes.empty())
+      {
+        index.erase(strIt);
+      }
+    }
+  }
+}
+
+template <typename P>
+void findNodes(
+  const EntityNodeStringIndex& index,
+  const P& predicate,
+  std::set<EntityNodeBase*>& result)
+{
+  for (const auto& [str, nodes] : index)
+  {
+    if (predicate(str.str()))
+    {
+      for (const auto& [node, count] : nodes)
+      {
+        result.insert(node);
+      }
+    }
+  }
+}
+
+} // namespace
 
 EntityNodeIndexQuery EntityNodeIndexQuery::exact(std::string pattern)
 {
@@ -62,13 +104,23 @@ std::set<EntityNodeBase*> EntityNodeIndexQuery::execute(
   switch (m_type)
   {
   case Type::Exact:
-    index.find_matches(m_pattern, std::inserter(result, std::end(result)));
+    if (const auto it = index.find(InternedString{m_pattern}); it != index.end())
+    {
+      for (const auto& [node, count] : it->second)
+      {
+        result.insert(node);
+      }
+    }
     break;
   case Type::Prefix:
-    index.find_matches(m_pattern + "*", std::inserter(result, std::end(result)));
+    findNodes(
+      index,
+      [&](const auto& key) { return kdl::cs::str_is_prefix(key, m_pattern); },
+      result);
     break;
   case Type::Numbered:
-    index.find_matches(m_pattern + "%*", std::inserter(result, std::end(result)));
+    findNodes(
+      index, [&](const auto& key) { return isNumberedProperty(m_pattern, key); }, result);
     break;
   case Type::Any:
     break;
@@ -118,19 +170,11 @@ EntityNodeIndexQuery::EntityNodeIndexQuery(const Type type, std::string pattern)
 {
 }
 
-EntityNodeIndex::EntityNodeIndex()
-  : m_keyIndex{std::make_unique<EntityNodeStringIndex>()}
-  , m_valueIndex{std::make_unique<EntityNodeStringIndex>()}
-{
-}
-
-EntityNodeIndex::~EntityNodeIndex() = default;
-
 void EntityNodeIndex::addEntityNode(EntityNodeBase* node)
 {
   for (const auto& property : node->entity().properties())
   {
-    addProperty(node, property.key(), property.value());
+    addProperty(node, property.internedKey(), property.internedValue());
   }
 }
 
@@ -138,36 +182,42 @@ void EntityNodeIndex::removeEntityNode(EntityNodeBase* node)
 {
   for (const auto& property : node->entity().properties())
   {
-    removeProperty(node, property.key(), property.value());
+    removeProperty(node, property.internedKey(), property.internedValue());
   }
 }
 
 void EntityNodeIndex::addProperty(
-  EntityNodeBase* node, const std::string& key, const std::string& value)
+  EntityNodeBase* node, const InternedString& key, const InternedString& value)
 {
-  m_keyIndex->insert(key, node);
-  m_valueIndex->insert(value, node);
+  insert(m_keyIndex, key, node);
+  insert(m_valueIndex, value, node);
 }
 
 void EntityNodeIndex::removeProperty(
-  EntityNodeBase* node, const std::string& key, const std::string& value)
+  EntityNodeBase* node, const InternedString& key, const InternedString& value)
 {
-  m_keyIndex->remove(key, node);
-  m_valueIndex->remove(value, node);
+  remove(m_keyIndex, key, node);
+  remove(m_valueIndex, value, node);
 }
 
 std::vector<EntityNodeBase*> EntityNodeIndex::findEntityNodes(
   const EntityNodeIndexQuery& keyQuery, const std::string& value) const
 {
   // first, find Nodes which have `value` as the value for any key
-  auto result = std::vector<EntityNodeBase*>{};
-  m_valueIndex->find_matches(value, std::back_inserter(result));
-  if (result.empty())
+  const auto it = m_valueIndex.find(InternedString{value});
+  if (it == m_valueIndex.end())
   {
     return {};
   }
 
-  result = kdl::vec_sort_and_remove_duplicates(std::move(result));
+  auto result = std::vector<EntityNodeBase*>{};
+  result.reserve(it->second.size());
+  for (const auto& [node, count] : it->second)
+  {
+    result.push_back(node);
+  }
+
+  result = kdl::vec_sort(std::move(result));
   std::erase_if(result, [&](const auto* node) { return !keyQuery.execute(node, value); });
   return result;
 }
@@ -175,7 +225,11 @@ std::vector<EntityNodeBase*> EntityNodeIndex::findEntityNodes(
 std::vector<std::string> EntityNodeIndex::allKeys() const
 {
   auto result = std::vector<std::string>{};
-  m_keyIndex->get_keys(std::back_inserter(result));
+  result.reserve(m_keyIndex.size());
+  for (const auto& [key, nodes] : m_keyIndex)
+  {
+    result.push_back(key.str());
+  }
   return result;
 }
 
@@ -184,7 +238,7 @@ std::vector<std::string> EntityNodeIndex::allValuesForKeys(
 {
   auto result = std::vector<std::string>{};
 
-  const auto nameResult = keyQuery.execute(*m_keyIndex);
+  const auto nameResult = keyQuery.execute(m_keyIndex);
   for (const auto node : nameResult)
   {
     const auto matchingProperties = keyQuery.execute(node);
@@ -19,11 +19,11 @@
 
 #pragma once
 
-#include "kdl/compact_trie_forward.h"
+#include "mdl/InternedString.h"
 
-#include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace tb::mdl
@@ -31,7 +31,12 @@ namespace tb::mdl
 class EntityNodeBase;
 class EntityProperty;
 
-using EntityNodeStringIndex = kdl::compact_trie<EntityNodeBase*>;
+/**
+ * Maps interned strings to the nodes that contain them, counting how often each node
+ * contains each string. The strings are shared with the entity properties.
+ */
+using EntityNodeStringIndex =
+  std::unordered_map<InternedString, std::unordered_map<EntityNodeBase*, size_t>>;
 
 class EntityNodeIndexQuery
 {
@@ -65,20 +70,17 @@ private:
 class EntityNodeIndex
 {
 private:
-  std::unique_ptr<EntityNodeStringIndex> m_keyIndex;
-  std::unique_ptr<EntityNodeStringIndex> m_valueIndex;
+  EntityNodeStringIndex m_keyIndex;
+  EntityNodeStringIndex m_valueIndex;
 
 public:
-  EntityNodeIndex();
-  ~EntityNodeIndex();
-
   void addEntityNode(EntityNodeBase* node);
   void removeEntityNode(EntityNodeBase* node);
 
   void addProperty(
-    EntityNodeBase* node, const std::string& key, const std::string& value);
+    EntityNodeBase* node, const InternedString& key, const InternedString& value);
   void removeProperty(
-    EntityNodeBase* node, const std::string& key, const std::string& value);
+    EntityNodeBase* node, const InternedString& key, const InternedString& value);
 
   std::vector<EntityNodeBase*> findEntityNodes(
     const EntityNodeIndexQuery& keyQuery, const std::string& value) const;
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "el/Expression.h"
+#include "mdl/InternedString.h"
 
 #include "kdl/reflection_decl.h"
 
@@ -94,21 +95,29 @@ struct EntityPropertyConfig
 
 bool isNumberedProperty(std::string_view prefix, std::string_view key);
 
+/**
+ * A key value pair. Keys and values are interned, so that the many entities that share
+ * the same keys and values don't store copies of them, and so that comparing two
+ * properties only compares pointers.
+ */
 class EntityProperty
 {
 private:
-  std::string m_key;
-  std::string m_value;
+  InternedString m_key;
+  InternedString m_value;
 
 public:
   EntityProperty();
-  EntityProperty(std::string key, std::string value);
+  EntityProperty(InternedString key, InternedString value);
 
   kdl_reflect_decl(EntityProperty, m_key, m_value);
 
   const std::string& key() const;
   const std::string& value() const;
 
+  const InternedString& internedKey() const;
+  const InternedString& internedValue() const;
+
   bool hasKey(std::string_view key) const;
   bool hasValue(std::string_view value) const;
   bool hasKeyAndValue(std::string_view key, std::string_view value) const;
@@ -117,8 +126,8 @@ public:
   bool hasNumberedPrefix(std::string_view prefix) const;
   bool hasNumberedPrefixAndValue(std::string_view prefix, std::string_view value) const;
 
-  void setKey(std::string key);
-  void setValue(std::string value);
+  void setKey(InternedString key);
+  void setValue(InternedString value);
 };
 
 bool isLayer(const std::string& classname, const std::vector<EntityProperty>& properties);
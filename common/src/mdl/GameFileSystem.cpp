@@ -133,21 +133,21 @@ Result<std::unique_ptr<io::FileSystem>> createImageFileSystem(
 
   if (kdl::ci::str_is_equal(packageFormat, "idpak"))
   {
-    return io::Disk::openFile(path) | kdl::and_then([&](auto file) {
+    return io::Disk::openArchive(path) | kdl::and_then([&](auto file) {
              return io::createImageFileSystem<io::IdPakFileSystem>(std::move(file));
            })
            | kdl::transform(setMetadataAndCast);
   }
   else if (kdl::ci::str_is_equal(packageFormat, "dkpak"))
   {
-    return io::Disk::openFile(path) | kdl::and_then([&](auto file) {
+    return io::Disk::openArchive(path) | kdl::and_then([&](auto file) {
              return io::createImageFileSystem<io::DkPakFileSystem>(std::move(file));
            })
            | kdl::transform(setMetadataAndCast);
   }
   else if (kdl::ci::str_is_equal(packageFormat, "zip"))
   {
-    return io::Disk::openFile(path) | kdl::and_then([&](auto file) {
+    return io::Disk::openArchive(path) | kdl::and_then([&](auto file) {
              return io::createImageFileSystem<io::ZipFileSystem>(std::move(file));
            })
            | kdl::transform(setMetadataAndCast);
@@ -205,7 +205,7 @@ void GameFileSystem::mountWads(
   for (const auto& wadPath : wadPaths)
   {
     const auto resolvedWadPath = io::Disk::resolvePath(wadSearchPaths, wadPath);
-    io::Disk::openFile(resolvedWadPath) | kdl::and_then([](auto file) {
+    io::Disk::openArchive(resolvedWadPath) | kdl::and_then([](auto file) {
       return io::createImageFileSystem<io::WadFileSystem>(std::move(file));
     }) | kdl::transform([&](auto fs) {
       fs->setMetadata(io::makeImageFileSystemMetadata(resolvedWadPath));
@@ -0,0 +1,197 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "InternedString.h"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+
+namespace tb::mdl
+{
+
+struct InternedString::Entry
+{
+  const std::string str;
+  std::atomic<size_t> refCount;
+};
+
+struct InternedString::Pool
+{
+  struct Shard
+  {
+    std::mutex mutex;
+    std::unordered_map<std::string_view, Entry*> entries;
+  };
+
+  // spread the strings over several shards so that threads that parse entities
+  // concurrently rarely wait for each other
+  static constexpr size_t ShardCount = 16;
+  std::array<Shard, ShardCount> shards;
+
+  Shard& shard(const std::string_view str)
+  {
+    return shards[std::hash<std::string_view>{}(str) % ShardCount];
+  }
+
+  Entry* acquire(const std::string_view str)
+  {
+    auto& s = shard(str);
+    const auto lock = std::lock_guard{s.mutex};
+
+    if (const auto it = s.entries.find(str); it != s.entries.end())
+    {
+      it->second->refCount.fetch_add(1, std::memory_order_relaxed);
+      return it->second;
+    }
+
+    auto* entry = new Entry{std::string{str}, 1};
+    s.entries.emplace(entry->str, entry);
+    return entry;
+  }
+
+  void release(Entry* entry)
+  {
+    // only the last reference must be released while holding the lock, otherwise
+    // another thread could acquire the entry while it is being removed
+    auto refCount = entry->refCount.load(std::memory_order_relaxed);
+    while (refCount > 1)
+    {
+      if (entry->refCount.compare_exchange_weak(
+            refCount, refCount - 1, std::memory_order_acq_rel))
+      {
+        return;
+      }
+    }
+
+    auto& s = shard(entry->str);
+    const auto lock = std::lock_guard{s.mutex};
+    if (entry->refCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+      s.entries.erase(entry->str);
+      delete entry;
+    }
+  }
+
+  InternedStringStats stats()
+  {
+    auto result = InternedStringStats{0, 0};
+    for (auto& s : shards)
+    {
+      const auto lock = std::lock_guard{s.mutex};
+      result.count += s.entries.size();
+      result.bytes += s.entries.bucket_count() * sizeof(void*);
+      for (const auto& [str, entry] : s.entries)
+      {
+        // the hash map node, the entry and the string buffer if it is not inlined
+        result.bytes += sizeof(std::string_view) + 2 * sizeof(void*) + sizeof(Entry);
+        if (entry->str.capacity() > std::string{}.capacity())
+        {
+          result.bytes += entry->str.capacity() + 1;
+        }
+      }
+    }
+    return result;
+  }
+};
+
+InternedString::InternedString() = default;
+
+InternedString::InternedString(const std::string_view str)
+  : m_entry{!str.empty() ? pool().acquire(str) : nullptr}
+{
+}
+
+InternedString::InternedString(const std::string& str)
+  : InternedString{std::string_view{str}}
+{
+}
+
+InternedString::InternedString(const char* str)
+  : InternedString{std::string_view{str}}
+{
+}
+
+InternedString::InternedString(const InternedString& other)
+  : m_entry{other.m_entry}
+{
+  if (m_entry)
+  {
+    m_entry->refCount.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+InternedString::InternedString(InternedString&& other) noexcept
+  : m_entry{std::exchange(other.m_entry, nullptr)}
+{
+}
+
+InternedString::~InternedString()
+{
+  if (m_entry)
+  {
+    pool().release(m_entry);
+  }
+}
+
+InternedString& InternedString::operator=(InternedString other) noexcept
+{
+  std::swap(m_entry, other.m_entry);
+  return *this;
+}
+
+const std::string& InternedString::str() const
+{
+  static const auto emptyString = std::string{};
+  return m_entry ? m_entry->str : emptyString;
+}
+
+bool InternedString::empty() const
+{
+  return m_entry == nullptr;
+}
+
+InternedStringStats InternedString::stats()
+{
+  return pool().stats();
+}
+
+std::strong_ordering operator<=>(const InternedString& lhs, const InternedString& rhs)
+{
+  return lhs.m_entry == rhs.m_entry ? std::strong_ordering::equal
+                                    : lhs.str() <=> rhs.str();
+}
+
+std::ostream& operator<<(std::ostream& lhs, const InternedString& rhs)
+{
+  return lhs << rhs.str();
+}
+
+InternedString::Pool& InternedString::pool()
+{
+  // never destroyed so that interned strings with static storage duration can still
+  // release their entries when they are destroyed
+  static auto* pool = new Pool{};
+  return *pool;
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,103 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace tb::mdl
+{
+
+struct InternedStringStats
+{
+  size_t count;
+  size_t bytes;
+};
+
+/**
+ * An immutable string that is stored only once per process.
+ *
+ * All interned strings with the same contents share one reference counted entry in a
+ * global pool, so copying an interned string and comparing two interned strings for
+ * equality only copies or compares a pointer. An entry is removed from the pool when
+ * the last interned string that refers to it is destroyed.
+ *
+ * Interning a string locks a part of the pool, so interned strings can be created from
+ * multiple threads.
+ */
+class InternedString
+{
+private:
+  struct Entry;
+  struct Pool;
+
+  Entry* m_entry = nullptr;
+
+public:
+  InternedString();
+  InternedString(std::string_view str);
+  InternedString(const std::string& str);
+  InternedString(const char* str);
+
+  InternedString(const InternedString& other);
+  InternedString(InternedString&& other) noexcept;
+
+  ~InternedString();
+
+  InternedString& operator=(InternedString other) noexcept;
+
+  const std::string& str() const;
+  bool empty() const;
+
+  /**
+   * Returns the number of strings in the pool and an estimate of the memory they use.
+   */
+  static InternedStringStats stats();
+
+  friend bool operator==(const InternedString& lhs, const InternedString& rhs)
+  {
+    return lhs.m_entry == rhs.m_entry;
+  }
+
+  friend std::strong_ordering operator<=>(
+    const InternedString& lhs, const InternedString& rhs);
+
+  friend std::ostream& operator<<(std::ostream& lhs, const InternedString& rhs);
+
+  friend struct std::hash<InternedString>;
+
+private:
+  static Pool& pool();
+};
+
+} // namespace tb::mdl
+
+template <>
+struct std::hash<tb::mdl::InternedString>
+{
+  size_t operator()(const tb::mdl::InternedString& str) const noexcept
+  {
+    return std::hash<const void*>{}(str.m_entry);
+  }
+};
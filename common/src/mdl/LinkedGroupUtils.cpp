@@ -32,6 +32,8 @@
 #include "kdl/task_manager.h"
 #include "kdl/zip_iterator.h"
 
+#include <algorithm>
+#include <ranges>
 #include <string_view>
 #include <unordered_map>
 
@@ -261,6 +263,41 @@ Result<std::unique_ptr<Node>> cloneAndTransformRecursive(
            });
 }
 
+Result<NodeContents> transformNodeContents(
+  const Node& node, const vm::bbox3d& worldBounds, const vm::mat4x4d& transformation)
+{
+  return node.accept(kdl::overload(
+    [](const WorldNode*) -> Result<NodeContents> {
+      ensure(false, "Linked group structure is valid");
+    },
+    [](const LayerNode*) -> Result<NodeContents> {
+      ensure(false, "Linked group structure is valid");
+    },
+    [&](const GroupNode* groupNode) -> Result<NodeContents> {
+      auto group = groupNode->group();
+      group.transform(transformation);
+      return NodeContents{std::move(group)};
+    },
+    [&](const EntityNode* entityNode) -> Result<NodeContents> {
+      const auto updateAngleProperty =
+        entityNode->entityPropertyConfig().updateAnglePropertyAfterTransform;
+      auto entity = entityNode->entity();
+      entity.transform(transformation, updateAngleProperty);
+      return NodeContents{std::move(entity)};
+    },
+    [&](const BrushNode* brushNode) -> Result<NodeContents> {
+      auto brush = brushNode->brush();
+      return brush.transform(worldBounds, transformation, true)
+             | kdl::and_then(
+               [&]() -> Result<NodeContents> { return NodeContents{std::move(brush)}; });
+    },
+    [&](const PatchNode* patchNode) -> Result<NodeContents> {
+      auto patch = patchNode->patch();
+      patch.transform(transformation);
+      return NodeContents{std::move(patch)};
+    }));
+}
+
 /**
  * Given a node, clones its children recursively and applies the given transform.
  *
@@ -274,45 +311,16 @@ Result<std::vector<std::unique_ptr<Node>>> cloneAndTransformChildren(
 {
   auto nodesToClone = collectDescendants(std::vector{&node});
 
-  using TransformResult = Result<std::pair<const Node*, NodeContents>>;
-
   // In parallel, produce pairs { node pointer, transformed contents } from the nodes in
   // `nodesToClone`
   auto tasks =
     nodesToClone | std::views::transform([&](const auto& nodeToTransform) {
       return std::function{[&]() {
-        return nodeToTransform->accept(kdl::overload(
-          [](const WorldNode*) -> TransformResult {
-            ensure(false, "Linked group structure is valid");
-          },
-          [](const LayerNode*) -> TransformResult {
-            ensure(false, "Linked group structure is valid");
-          },
-          [&](const GroupNode* groupNode) -> TransformResult {
-            auto group = groupNode->group();
-            group.transform(transformation);
-            return std::make_pair(nodeToTransform, NodeContents{std::move(group)});
-          },
-          [&](const EntityNode* entityNode) -> TransformResult {
-            const auto updateAngleProperty =
-              entityNode->entityPropertyConfig().updateAnglePropertyAfterTransform;
-            auto entity = entityNode->entity();
-            entity.transform(transformation, updateAngleProperty);
-            return std::make_pair(nodeToTransform, NodeContents{std::move(entity)});
-          },
-          [&](const BrushNode* brushNode) -> TransformResult {
-            auto brush = brushNode->brush();
-            return brush.transform(worldBounds, transformation, true)
-                   | kdl::and_then([&]() -> TransformResult {
-                       return std::make_pair(
-                         nodeToTransform, NodeContents{std::move(brush)});
-                     });
-          },
-          [&](const PatchNode* patchNode) -> TransformResult {
-            auto patch = patchNode->patch();
-            patch.transform(transformation);
-            return std::make_pair(nodeToTransform, NodeContents{std::move(patch)});
-          }));
+        return transformNodeContents(*nodeToTransform, worldBounds, transformation)
+               | kdl::transform([&](auto contents) {
+                   return std::pair<const Node*, NodeContents>{
+                     nodeToTransform, std::move(contents)};
+                 });
       }};
     });
 
@@ -407,19 +415,8 @@ void preserveGroupNames(
       [](const PatchNode*) {}));
 }
 
-void preserveEntityProperties(
-  EntityNode& clonedEntityNode, const EntityNode& correspondingEntityNode)
+Entity preserveEntityProperties(Entity clonedEntity, const Entity& correspondingEntity)
 {
-  if (
-    clonedEntityNode.entity().protectedProperties().empty()
-    && correspondingEntityNode.entity().protectedProperties().empty())
-  {
-    return;
-  }
-
-  auto clonedEntity = clonedEntityNode.entity();
-  const auto& correspondingEntity = correspondingEntityNode.entity();
-
   const auto allProtectedProperties = kdl::vec_sort_and_remove_duplicates(kdl::vec_concat(
     clonedEntity.protectedProperties(), correspondingEntity.protectedProperties()));
 
@@ -435,7 +432,21 @@ void preserveEntityProperties(
     }
   }
 
-  clonedEntityNode.setEntity(std::move(clonedEntity));
+  return clonedEntity;
+}
+
+void preserveEntityProperties(
+  EntityNode& clonedEntityNode, const EntityNode& correspondingEntityNode)
+{
+  if (
+    clonedEntityNode.entity().protectedProperties().empty()
+    && correspondingEntityNode.entity().protectedProperties().empty())
+  {
+    return;
+  }
+
+  clonedEntityNode.setEntity(preserveEntityProperties(
+    clonedEntityNode.entity(), correspondingEntityNode.entity()));
 }
 
 template <typename T>
@@ -466,13 +477,237 @@ void preserveEntityProperties(
       [](const BrushNode*) {},
       [](const PatchNode*) {}));
 }
+
+template <typename N>
+bool hasLinkId(const Node& node, const std::string& linkId)
+{
+  const auto* nodeCasted = dynamic_cast<const N*>(&node);
+  return nodeCasted && nodeCasted->linkId() == linkId;
+}
+
+bool isCorrespondingNode(const Node& sourceNode, const Node& targetNode)
+{
+  return sourceNode.accept(kdl::overload(
+    [](const WorldNode*) { return false; },
+    [](const LayerNode*) { return false; },
+    [&](const GroupNode* groupNode) {
+      return hasLinkId<GroupNode>(targetNode, groupNode->linkId());
+    },
+    [&](const EntityNode* entityNode) {
+      return hasLinkId<EntityNode>(targetNode, entityNode->linkId());
+    },
+    [&](const BrushNode* brushNode) {
+      return hasLinkId<BrushNode>(targetNode, brushNode->linkId());
+    },
+    [&](const PatchNode* patchNode) {
+      return hasLinkId<PatchNode>(targetNode, patchNode->linkId());
+    }));
+}
+
+bool haveCorrespondingChildren(const Node& sourceNode, const Node& targetNode)
+{
+  return std::ranges::equal(
+    sourceNode.children(),
+    targetNode.children(),
+    [](const auto* sourceChild, const auto* targetChild) {
+      return isCorrespondingNode(*sourceChild, *targetChild);
+    });
+}
+
+struct ChangedLinkedNodes
+{
+  // pairs of source nodes and target nodes whose contents must be updated
+  std::vector<std::pair<const Node*, Node*>> nodesToUpdate;
+  // pairs of source nodes and target nodes whose children must be replaced
+  std::vector<std::pair<const Node*, Node*>> nodesToReplaceChildren;
+};
+
+/**
+ * Collects the descendants of the given source node that were modified after the given
+ * modification count, together with their corresponding target nodes.
+ */
+void collectChangedLinkedNodes(
+  const Node& sourceNode,
+  Node& targetNode,
+  const size_t modificationCount,
+  ChangedLinkedNodes& result)
+{
+  if (!haveCorrespondingChildren(sourceNode, targetNode))
+  {
+    result.nodesToReplaceChildren.emplace_back(&sourceNode, &targetNode);
+    return;
+  }
+
+  for (auto [sourceChild, targetChild] :
+       kdl::make_zip_range(sourceNode.children(), targetNode.children()))
+  {
+    if (sourceChild->modificationCount() > modificationCount)
+    {
+      result.nodesToUpdate.emplace_back(sourceChild, targetChild);
+      collectChangedLinkedNodes(*sourceChild, *targetChild, modificationCount, result);
+    }
+  }
+}
+
+bool isWithinWorldBounds(const NodeContents& contents, const vm::bbox3d& worldBounds)
+{
+  return std::visit(
+    kdl::overload(
+      [](const Layer&) { return true; },
+      [](const Group&) { return true; },
+      [&](const Entity& entity) {
+        return worldBounds.contains(EntityNode{entity}.logicalBounds());
+      },
+      [&](const Brush& brush) { return worldBounds.contains(brush.bounds()); },
+      [&](const BezierPatch& patch) { return worldBounds.contains(patch.bounds()); }),
+    contents.get());
+}
+
+/**
+ * Applies the preserved group names and entity properties of the given target node to
+ * the given contents. Returns false if the resulting contents are equal to the contents
+ * of the target node.
+ */
+bool preserveContents(NodeContents& contents, const Node& targetNode)
+{
+  return std::visit(
+    kdl::overload(
+      [&](Group& group) {
+        const auto& targetGroup = static_cast<const GroupNode&>(targetNode).group();
+        group.setName(targetGroup.name());
+        return group != targetGroup;
+      },
+      [&](Entity& entity) {
+        const auto& targetEntity = static_cast<const EntityNode&>(targetNode).entity();
+        entity = preserveEntityProperties(std::move(entity), targetEntity);
+        return entity != targetEntity;
+      },
+      [](auto&) { return true; }),
+    contents.get());
+}
+
+Result<std::vector<std::pair<Node*, NodeContents>>> transformChangedNodes(
+  const std::vector<std::pair<const Node*, Node*>>& nodesToUpdate,
+  const vm::bbox3d& worldBounds,
+  const vm::mat4x4d& transformation,
+  kdl::task_manager& taskManager)
+{
+  auto tasks = nodesToUpdate | std::views::transform([&](const auto& nodePair) {
+                 return std::function{[&]() {
+                   return transformNodeContents(
+                     *nodePair.first, worldBounds, transformation);
+                 }};
+               });
+
+  return taskManager.run_tasks_and_wait(tasks) | kdl::fold
+         | kdl::or_else([](const auto&) -> Result<std::vector<NodeContents>> {
+             return Error{"Failed to transform a linked node"};
+           })
+         | kdl::and_then(
+           [&](auto transformedContents)
+             -> Result<std::vector<std::pair<Node*, NodeContents>>> {
+             auto result = std::vector<std::pair<Node*, NodeContents>>{};
+             for (size_t i = 0; i < nodesToUpdate.size(); ++i)
+             {
+               auto* targetNode = nodesToUpdate[i].second;
+               auto& contents = transformedContents[i];
+               if (!isWithinWorldBounds(contents, worldBounds))
+               {
+                 return Error{"Updating a linked node would exceed world bounds"};
+               }
+
+               if (preserveContents(contents, *targetNode))
+               {
+                 result.emplace_back(targetNode, std::move(contents));
+               }
+             }
+             return result;
+           });
+}
+
+/**
+ * Clones and transforms the children of the given source node so that they can replace
+ * the children of the given target node.
+ */
+Result<std::vector<std::unique_ptr<Node>>> makeReplacementChildren(
+  const Node& sourceNode,
+  const Node& targetNode,
+  const vm::bbox3d& worldBounds,
+  const vm::mat4x4d& transformation,
+  kdl::task_manager& taskManager)
+{
+  return cloneAndTransformChildren(sourceNode, worldBounds, transformation, taskManager)
+         | kdl::transform([&](auto newChildren) {
+             const auto linkIdToNodeMap = makeLinkIdToNodeMap(targetNode.children());
+             preserveGroupNames(newChildren, linkIdToNodeMap);
+             preserveEntityProperties(newChildren, linkIdToNodeMap);
+             return newChildren;
+           });
+}
+
+Result<UpdateLinkedGroupsResult> replaceChildren(
+  const GroupNode& sourceGroupNode,
+  GroupNode& targetGroupNode,
+  const vm::bbox3d& worldBounds,
+  const vm::mat4x4d& transformation,
+  kdl::task_manager& taskManager)
+{
+  return makeReplacementChildren(
+           sourceGroupNode, targetGroupNode, worldBounds, transformation, taskManager)
+         | kdl::transform([&](auto newChildren) {
+             auto result = UpdateLinkedGroupsResult{};
+             result.childrenToReplace.emplace_back(
+               &targetGroupNode, std::move(newChildren));
+             return result;
+           });
+}
+
+Result<UpdateLinkedGroupsResult> updateChangedNodes(
+  const GroupNode& sourceGroupNode,
+  GroupNode& targetGroupNode,
+  const size_t modificationCount,
+  const vm::bbox3d& worldBounds,
+  const vm::mat4x4d& transformation,
+  kdl::task_manager& taskManager)
+{
+  auto changedNodes = ChangedLinkedNodes{};
+  if (sourceGroupNode.modificationCount() > modificationCount)
+  {
+    collectChangedLinkedNodes(
+      sourceGroupNode, targetGroupNode, modificationCount, changedNodes);
+  }
+
+  return transformChangedNodes(
+           changedNodes.nodesToUpdate, worldBounds, transformation, taskManager)
+         | kdl::and_then([&](auto contentsToSwap) {
+             return changedNodes.nodesToReplaceChildren
+                    | std::views::transform([&](const auto& nodePair) {
+                        const auto& [sourceNode, targetNode] = nodePair;
+                        return makeReplacementChildren(
+                                 *sourceNode,
+                                 *targetNode,
+                                 worldBounds,
+                                 transformation,
+                                 taskManager)
+                               | kdl::transform([&](auto newChildren) {
+                                   return std::pair{targetNode, std::move(newChildren)};
+                                 });
+                      })
+                    | kdl::fold | kdl::transform([&](auto childrenToReplace) {
+                        return UpdateLinkedGroupsResult{
+                          std::move(childrenToReplace), std::move(contentsToSwap)};
+                      });
+           });
+}
+
 } // namespace
 
 Result<UpdateLinkedGroupsResult> updateLinkedGroups(
   const GroupNode& sourceGroupNode,
   const std::vector<GroupNode*>& targetGroupNodes,
   const vm::bbox3d& worldBounds,
-  kdl::task_manager& taskManager)
+  kdl::task_manager& taskManager,
+  const std::optional<size_t> modificationCount)
 {
   const auto& sourceGroup = sourceGroupNode.group();
   const auto invertedSourceTransformation = vm::invert(sourceGroup.transformation());
@@ -483,23 +718,34 @@ Result<UpdateLinkedGroupsResult> updateLinkedGroups(
 
   const auto targetGroupNodesToUpdate =
     kdl::vec_erase(targetGroupNodes, &sourceGroupNode);
-  return kdl::vec_transform(
-           targetGroupNodesToUpdate,
-           [&](auto* targetGroupNode) {
-             const auto transformation =
-               targetGroupNode->group().transformation() * *invertedSourceTransformation;
-             return cloneAndTransformChildren(
-                      sourceGroupNode, worldBounds, transformation, taskManager)
-                    | kdl::transform([&](auto newChildren) {
-                        const auto linkIdToNodeMap =
-                          makeLinkIdToNodeMap(targetGroupNode->children());
-                        preserveGroupNames(newChildren, linkIdToNodeMap);
-                        preserveEntityProperties(newChildren, linkIdToNodeMap);
-                        return std::pair{
-                          static_cast<Node*>(targetGroupNode), std::move(newChildren)};
-                      });
-           })
-         | kdl::fold;
+  return targetGroupNodesToUpdate | std::views::transform([&](auto* targetGroupNode) {
+           const auto transformation =
+             targetGroupNode->group().transformation() * *invertedSourceTransformation;
+           return modificationCount ? updateChangedNodes(
+                                        sourceGroupNode,
+                                        *targetGroupNode,
+                                        *modificationCount,
+                                        worldBounds,
+                                        transformation,
+                                        taskManager)
+                                    : replaceChildren(
+                                        sourceGroupNode,
+                                        *targetGroupNode,
+                                        worldBounds,
+                                        transformation,
+                                        taskManager);
+         })
+         | kdl::fold | kdl::transform([](auto results) {
+             auto result = UpdateLinkedGroupsResult{};
+             for (auto& [childrenToReplace, contentsToSwap] : results)
+             {
+               result.childrenToReplace = kdl::vec_concat(
+                 std::move(result.childrenToReplace), std::move(childrenToReplace));
+               result.contentsToSwap = kdl::vec_concat(
+                 std::move(result.contentsToSwap), std::move(contentsToSwap));
+             }
+             return result;
+           });
 }
 
 namespace
@@ -25,6 +25,7 @@
 #include "mdl/EntityNode.h" // IWYU pragma: keep
 #include "mdl/GroupNode.h"
 #include "mdl/LayerNode.h"
+#include "mdl/NodeContents.h"
 #include "mdl/NodeVisitor.h"
 #include "mdl/PatchNode.h" // IWYU pragma: keep
 #include "mdl/WorldNode.h"
@@ -33,6 +34,7 @@
 #include "kdl/vector_utils.h"
 
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -105,8 +107,18 @@ struct FaceSelectionResult
 FaceSelectionResult faceSelectionWithLinkedGroupConstraints(
   WorldNode& world, const std::vector<BrushFaceHandle>& faces);
 
-using UpdateLinkedGroupsResult =
-  std::vector<std::pair<Node*, std::vector<std::unique_ptr<Node>>>>;
+struct UpdateLinkedGroupsResult
+{
+  /**
+   * Pairs of target nodes and the new children that should replace their children.
+   */
+  std::vector<std::pair<Node*, std::vector<std::unique_ptr<Node>>>> childrenToReplace;
+
+  /**
+   * Pairs of target nodes and the new contents that should replace their contents.
+   */
+  std::vector<std::pair<Node*, NodeContents>> contentsToSwap;
+};
 
 /**
  * Updates the given target group nodes from the given source group node.
@@ -115,6 +127,16 @@ using UpdateLinkedGroupsResult =
  * target nodes by means of the recorded transformations of the source group and the
  * corresponding target groups.
  *
+ * If a modification count is given, then the source group and the target groups are
+ * assumed to have been consistent when the given modification count was current. In this
+ * case, only the source nodes whose modification count is greater than the given count
+ * are propagated to the target groups: their transformed contents replace the contents of
+ * the corresponding target nodes, which are matched by their link IDs. Nodes that have
+ * not changed are left untouched. If the children of a source node were added, removed or
+ * reordered, then the children of the corresponding target node are replaced entirely.
+ * If no modification count is given, then the children of every target group are
+ * replaced.
+ *
  * Depending on the protected property keys of the cloned entities and their corresponding
  * entities in the target groups, some entity property changes may not be propagated from
  * the source group to the target groups. Specifically, if an entity property is protected
@@ -131,15 +153,15 @@ using UpdateLinkedGroupsResult =
  * - transforming any of the source node's children fails
  * - any of the transformed children is no longer within the world bounds
  *
- * If this operation succeeds, a vector of pairs is returned where each pair consists of
- * the target node that should be updated, and the new children that should replace the
- * target node's children.
+ * If this operation succeeds, the children and contents to replace in the target groups
+ * are returned.
  */
 Result<UpdateLinkedGroupsResult> updateLinkedGroups(
   const GroupNode& sourceGroupNode,
   const std::vector<mdl::GroupNode*>& targetGroupNodes,
   const vm::bbox3d& worldBounds,
-  kdl::task_manager& taskManager);
+  kdl::task_manager& taskManager,
+  std::optional<size_t> modificationCount = std::nullopt);
 
 std::vector<Error> initializeLinkIds(const std::vector<Node*>& nodes);
 
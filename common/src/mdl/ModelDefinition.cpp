@@ -22,6 +22,7 @@
 #include "el/ELExceptions.h"
 #include "el/EvaluationContext.h"
 #include "el/Expression.h"
+#include "el/ExpressionCache.h"
 #include "el/Types.h"
 #include "el/Value.h"
 #include "el/VariableStore.h"
@@ -30,10 +31,13 @@
 #include "kdl/reflection_impl.h"
 #include "kdl/string_compare.h"
 #include "kdl/string_format.h"
+#include "kdl/vector_utils.h"
 
 #include "vm/scalar.h"
 #include "vm/vec_io.h"
 
+#include <mutex>
+
 namespace tb::mdl
 {
 namespace
@@ -141,18 +145,60 @@ std::optional<vm::vec3d> convertToScale(
 
 } // namespace
 
+struct ModelDefinition::Cache
+{
+  el::ExpressionCache<Result<ModelSpecification>> modelSpecifications;
+
+  std::mutex scalesMutex;
+  std::optional<el::ExpressionNode> defaultScaleExpression;
+  std::shared_ptr<el::ExpressionCache<Result<vm::vec3d>>> scales;
+
+  explicit Cache(const el::ExpressionNode& expression)
+    : modelSpecifications{expression.variableNames()}
+  {
+  }
+
+  /**
+   * Returns the cache for the scale values. The scale values also depend on the given
+   * default scale expression, so the cache is replaced if that expression changes.
+   */
+  std::shared_ptr<el::ExpressionCache<Result<vm::vec3d>>> scaleCache(
+    const el::ExpressionNode& expression,
+    const std::optional<el::ExpressionNode>& defaultScaleExpression_)
+  {
+    const auto lock = std::lock_guard{scalesMutex};
+    if (!scales || defaultScaleExpression != defaultScaleExpression_)
+    {
+      auto variableNames = expression.variableNames();
+      if (defaultScaleExpression_)
+      {
+        variableNames = kdl::vec_sort_and_remove_duplicates(kdl::vec_concat(
+          std::move(variableNames), defaultScaleExpression_->variableNames()));
+      }
+
+      defaultScaleExpression = defaultScaleExpression_;
+      scales = std::make_shared<el::ExpressionCache<Result<vm::vec3d>>>(
+        std::move(variableNames));
+    }
+    return scales;
+  }
+};
+
 ModelDefinition::ModelDefinition()
   : m_expression{el::LiteralExpression{el::Value::Undefined}}
+  , m_cache{std::make_shared<Cache>(m_expression)}
 {
 }
 
 ModelDefinition::ModelDefinition(const FileLocation& location)
   : m_expression{el::LiteralExpression{el::Value::Undefined}, location}
+  , m_cache{std::make_shared<Cache>(m_expression)}
 {
 }
 
 ModelDefinition::ModelDefinition(el::ExpressionNode expression)
   : m_expression{std::move(expression)}
+  , m_cache{std::make_shared<Cache>(m_expression)}
 {
 }
 
@@ -162,16 +208,19 @@ void ModelDefinition::append(ModelDefinition other)
 
   auto cases = std::vector{std::move(m_expression), std::move(other.m_expression)};
   m_expression = el::ExpressionNode{el::SwitchExpression{std::move(cases)}, location};
+  m_cache = std::make_shared<Cache>(m_expression);
 }
 
 Result<ModelSpecification> ModelDefinition::modelSpecification(
   const el::VariableStore& variableStore) const
 {
-  return el::withEvaluationContext(
-    [&](auto& context) {
-      return convertToModel(context, m_expression.evaluate(context));
-    },
-    variableStore);
+  return m_cache->modelSpecifications.getOrEvaluate(variableStore, [&]() {
+    return el::withEvaluationContext(
+      [&](auto& context) {
+        return convertToModel(context, m_expression.evaluate(context));
+      },
+      variableStore);
+  });
 }
 
 Result<ModelSpecification> ModelDefinition::defaultModelSpecification() const
@@ -185,42 +234,45 @@ Result<vm::vec3d> ModelDefinition::scale(
   const el::VariableStore& variableStore,
   const std::optional<el::ExpressionNode>& defaultScaleExpression) const
 {
-  return el::withEvaluationContext(
-    [&](auto& context) {
-      const auto value = m_expression.evaluate(context);
+  const auto cache = m_cache->scaleCache(m_expression, defaultScaleExpression);
+  return cache->getOrEvaluate(variableStore, [&]() {
+    return el::withEvaluationContext(
+      [&](auto& context) {
+        const auto value = m_expression.evaluate(context);
 
-      switch (value.type())
-      {
-      case el::ValueType::Map:
-        if (
-          const auto scale = convertToScale(
-            context, value.atOrDefault(context, ModelSpecificationKeys::Scale)))
+        switch (value.type())
         {
-          return *scale;
+        case el::ValueType::Map:
+          if (
+            const auto scale = convertToScale(
+              context, value.atOrDefault(context, ModelSpecificationKeys::Scale)))
+          {
+            return *scale;
+          }
+        case el::ValueType::String:
+        case el::ValueType::Boolean:
+        case el::ValueType::Number:
+        case el::ValueType::Array:
+        case el::ValueType::Range:
+        case el::ValueType::Null:
+        case el::ValueType::Undefined:
+          break;
         }
-      case el::ValueType::String:
-      case el::ValueType::Boolean:
-      case el::ValueType::Number:
-      case el::ValueType::Array:
-      case el::ValueType::Range:
-      case el::ValueType::Null:
-      case el::ValueType::Undefined:
-        break;
-      }
 
-      if (defaultScaleExpression)
-      {
-        if (
-          const auto scale =
-            convertToScale(context, defaultScaleExpression->evaluate(context)))
+        if (defaultScaleExpression)
         {
-          return *scale;
+          if (
+            const auto scale =
+              convertToScale(context, defaultScaleExpression->evaluate(context)))
+          {
+            return *scale;
+          }
         }
-      }
 
-      return vm::vec3d{1, 1, 1};
-    },
-    variableStore);
+        return vm::vec3d{1, 1, 1};
+      },
+      variableStore);
+  });
 }
 
 kdl_reflect_impl(ModelDefinition);
@@ -27,6 +27,7 @@
 
 #include "vm/vec.h"
 
+#include <memory>
 #include <optional>
 
 namespace tb
@@ -48,7 +49,12 @@ constexpr auto Scale = "scale";
 class ModelDefinition
 {
 private:
+  struct Cache;
+
   el::ExpressionNode m_expression;
+  // memoizes evaluation results, shared by copies and replaced when the expression
+  // changes
+  std::shared_ptr<Cache> m_cache;
 
 public:
   ModelDefinition();
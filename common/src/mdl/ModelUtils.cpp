@@ -25,6 +25,7 @@
 #include "mdl/EditorContext.h"
 #include "mdl/NodeQueries.h"
 
+#include "kdl/task_manager.h"
 #include "kdl/vector_utils.h"
 
 #include <vector>
@@ -380,4 +381,17 @@ std::vector<EntityNode*> filterEntityNodes(const std::vector<Node*>& nodes)
   return result;
 }
 
+std::vector<const Issue*> collectIssues(
+  const std::vector<Node*>& nodes,
+  const std::vector<const Validator*>& validators,
+  kdl::task_manager& taskManager)
+{
+  // every task only validates its own nodes, so the issues can be stored per node
+  auto issuesPerNode = std::vector<std::vector<const Issue*>>(nodes.size());
+  taskManager.parallel_for(nodes.size(), [&](const size_t i) {
+    issuesPerNode[i] = nodes[i]->issues(validators);
+  });
+  return kdl::vec_flatten(std::move(issuesPerNode));
+}
+
 } // namespace tb::mdl
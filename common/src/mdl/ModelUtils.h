@@ -26,16 +26,23 @@
 #include <map>
 #include <vector>
 
+namespace kdl
+{
+class task_manager;
+} // namespace kdl
+
 namespace tb::mdl
 {
 
 class BrushFaceHandle;
+class Issue;
 class Node;
 class GroupNode;
 class BrushNode;
 class EntityNode;
 class LayerNode;
 class EditorContext;
+class Validator;
 
 HitType::Type nodeHitType();
 
@@ -80,4 +87,10 @@ vm::bbox3d computePhysicalBounds(
 std::vector<BrushNode*> filterBrushNodes(const std::vector<Node*>& nodes);
 std::vector<EntityNode*> filterEntityNodes(const std::vector<Node*>& nodes);
 
+// Validates the given nodes in parallel; the nodes must not be modified meanwhile
+std::vector<const Issue*> collectIssues(
+  const std::vector<Node*>& nodes,
+  const std::vector<const Validator*>& validators,
+  kdl::task_manager& taskManager);
+
 } // namespace tb::mdl
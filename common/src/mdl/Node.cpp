@@ -29,6 +29,7 @@
 #include "kdl/reflection_impl.h"
 #include "kdl/vector_utils.h"
 
+#include <atomic>
 #include <cassert>
 #include <iterator>
 #include <string>
@@ -39,7 +40,21 @@ namespace tb::mdl
 
 kdl_reflect_impl(NodePath);
 
-Node::Node() = default;
+namespace
+{
+
+size_t nextModificationCount()
+{
+  static auto counter = std::atomic<size_t>{0};
+  return ++counter;
+}
+
+} // namespace
+
+Node::Node()
+  : m_modificationCount{nextModificationCount()}
+{
+}
 
 Node::~Node()
 {
@@ -223,6 +238,11 @@ size_t Node::descendantCount() const
   return m_descendantCount;
 }
 
+size_t Node::modificationCount() const
+{
+  return m_modificationCount;
+}
+
 size_t Node::familySize() const
 {
   return m_descendantCount + 1;
@@ -368,6 +388,7 @@ void Node::descendantWillBeAdded(Node* newParent, Node* node, const size_t depth
 
 void Node::descendantWasAdded(Node* node, const size_t depth)
 {
+  updateModificationCount();
   doDescendantWasAdded(node, depth);
   if (m_parent)
   {
@@ -387,6 +408,7 @@ void Node::descendantWillBeRemoved(Node* node, const size_t depth)
 
 void Node::descendantWasRemoved(Node* oldParent, Node* node, const size_t depth)
 {
+  updateModificationCount();
   doDescendantWasRemoved(oldParent, node, depth);
   if (m_parent)
   {
@@ -475,6 +497,7 @@ void Node::nodeWillChange()
 
 void Node::nodeDidChange()
 {
+  updateModificationCount();
   if (m_parent)
   {
     m_parent->childDidChange(this);
@@ -512,6 +535,20 @@ void Node::nodePhysicalBoundsDidChange()
   }
 }
 
+void Node::nodeModificationCountDidChange()
+{
+  updateModificationCount();
+  if (m_parent)
+  {
+    m_parent->nodeModificationCountDidChange();
+  }
+}
+
+void Node::updateModificationCount()
+{
+  m_modificationCount = nextModificationCount();
+}
+
 void Node::childWillChange(Node* node)
 {
   doChildWillChange(node);
@@ -536,6 +573,7 @@ void Node::descendantWillChange(Node* node)
 
 void Node::descendantDidChange(Node* node)
 {
+  updateModificationCount();
   doDescendantDidChange(node);
   if (m_parent)
   {
@@ -793,6 +831,11 @@ size_t Node::lineNumber() const
   return m_lineNumber;
 }
 
+size_t Node::lineCount() const
+{
+  return m_lineCount;
+}
+
 void Node::setFilePosition(const size_t lineNumber, const size_t lineCount) const
 {
   m_lineNumber = lineNumber;
@@ -868,13 +911,13 @@ void Node::findEntityNodesWithNumberedProperty(
 }
 
 void Node::addToIndex(
-  EntityNodeBase* node, const std::string& key, const std::string& value)
+  EntityNodeBase* node, const InternedString& key, const InternedString& value)
 {
   doAddToIndex(node, key, value);
 }
 
 void Node::removeFromIndex(
-  EntityNodeBase* node, const std::string& key, const std::string& value)
+  EntityNodeBase* node, const InternedString& key, const InternedString& value)
 {
   doRemoveFromIndex(node, key, value);
 }
@@ -950,7 +993,7 @@ void Node::doFindEntityNodesWithNumberedProperty(
 }
 
 void Node::doAddToIndex(
-  EntityNodeBase* node, const std::string& key, const std::string& value)
+  EntityNodeBase* node, const InternedString& key, const InternedString& value)
 {
   if (m_parent)
   {
@@ -959,7 +1002,7 @@ void Node::doAddToIndex(
 }
 
 void Node::doRemoveFromIndex(
-  EntityNodeBase* node, const std::string& key, const std::string& value)
+  EntityNodeBase* node, const InternedString& key, const InternedString& value)
 {
   if (m_parent)
   {
@@ -42,6 +42,7 @@ namespace tb::mdl
 class EditorContext;
 class EntityNodeBase;
 struct EntityPropertyConfig;
+class InternedString;
 class ConstNodeVisitor;
 class Issue;
 class NodeVisitor;
@@ -71,6 +72,8 @@ private:
   LockState m_lockState = LockState::Inherited;
   bool m_lockedByOtherSelection = false;
 
+  size_t m_modificationCount;
+
   mutable size_t m_lineNumber = 0;
   mutable size_t m_lineCount = 0;
 
@@ -170,6 +173,16 @@ public: // tree management
   size_t descendantCount() const;
   size_t familySize() const;
 
+  /**
+   * Returns a number that changes whenever this node or any of its descendants changes,
+   * or when a descendant is added or removed.
+   *
+   * The numbers are drawn from a single counter shared by all nodes, so a pair of a node
+   * and its modification count identifies the state of that node's subtree. This allows
+   * caches to detect whether a node has changed since they last looked at it.
+   */
+  size_t modificationCount() const;
+
   bool shouldAddToSpacialIndex() const;
 
 public:
@@ -272,7 +285,16 @@ protected: // notification for parents
   };
   void nodePhysicalBoundsDidChange();
 
+  /**
+   * Updates the modification count of this node and its ancestors. Only call this for
+   * changes that are not reported via NotifyNodeChange, e.g. if the material of a brush
+   * face changes.
+   */
+  void nodeModificationCountDidChange();
+
 private:
+  void updateModificationCount();
+
   void childWillChange(Node* node);
   void childDidChange(Node* node);
   void descendantWillChange(Node* node);
@@ -345,6 +367,7 @@ public: // picking
 
 public: // file position
   size_t lineNumber() const;
+  size_t lineCount() const;
   void setFilePosition(size_t lineNumber, size_t lineCount) const;
   bool containsLine(size_t lineNumber) const;
 
@@ -498,9 +521,10 @@ protected: // index management
     const std::string& value,
     std::vector<EntityNodeBase*>& result) const;
 
-  void addToIndex(EntityNodeBase* node, const std::string& key, const std::string& value);
+  void addToIndex(
+    EntityNodeBase* node, const InternedString& key, const InternedString& value);
   void removeFromIndex(
-    EntityNodeBase* node, const std::string& key, const std::string& value);
+    EntityNodeBase* node, const InternedString& key, const InternedString& value);
 
 private: // subclassing interface
   virtual const std::string& doGetName() const = 0;
@@ -564,9 +588,9 @@ private: // subclassing interface
     std::vector<EntityNodeBase*>& result) const;
 
   virtual void doAddToIndex(
-    EntityNodeBase* node, const std::string& key, const std::string& value);
+    EntityNodeBase* node, const InternedString& key, const InternedString& value);
   virtual void doRemoveFromIndex(
-    EntityNodeBase* node, const std::string& key, const std::string& value);
+    EntityNodeBase* node, const InternedString& key, const InternedString& value);
 };
 
 } // namespace tb::mdl
@@ -34,6 +34,9 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <cstring>
 #include <ostream>
 #include <string>
@@ -73,47 +76,58 @@ bool Palette::indexedToRgba(
 {
   ensure(rgbaImage.size() == 4 * pixelCount, "incorrect destination buffer size");
 
-  const unsigned char* paletteData = (transparency == PaletteTransparency::Opaque)
-                                       ? m_data->opaqueData.data()
-                                       : m_data->index255TransparentData.data();
-
-  // Write rgba pixels
+  const auto& paletteData = (transparency == PaletteTransparency::Opaque)
+                              ? m_data->opaqueData
+                              : m_data->index255TransparentData;
+
+  // Palettes may have fewer than 256 colors, missing colors are transparent black
+  auto colors = std::array<uint32_t, 256>{};
+  std::memcpy(
+    colors.data(),
+    paletteData.data(),
+    std::min(paletteData.size(), colors.size() * sizeof(uint32_t)));
+
+  // Read all indices at once, the reader is too slow to be called per pixel
+  auto indices = std::vector<unsigned char>(pixelCount);
+  reader.read(indices.data(), pixelCount);
+
+  // Expand the indices into RGBA pixels and count how often each color is used. The
+  // colors are copied as 32 bit words, so that the loop compiles to a table lookup and a
+  // store per pixel.
+  auto colorCounts = std::array<uint32_t, 256>{};
   auto* const rgbaData = rgbaImage.data();
   for (size_t i = 0; i < pixelCount; ++i)
   {
-    const int index = reader.readInt<unsigned char>();
-
-    std::memcpy(rgbaData + (i * 4), &paletteData[index * 4], 4);
+    const auto index = indices[i];
+    std::memcpy(rgbaData + i * 4, &colors[index], 4);
+    ++colorCounts[index];
   }
 
-  // Check average color
-  uint32_t colorSum[3] = {0, 0, 0};
-  for (size_t i = 0; i < pixelCount; ++i)
+  // Compute the average color and the bitwise AND of the alpha channel of all pixels
+  // from the color counts
+  uint64_t colorSum[3] = {0, 0, 0};
+  unsigned char andAlpha = 0xFF;
+  for (size_t i = 0; i < colors.size(); ++i)
   {
-    colorSum[0] += uint32_t(rgbaData[(i * 4) + 0]);
-    colorSum[1] += uint32_t(rgbaData[(i * 4) + 1]);
-    colorSum[2] += uint32_t(rgbaData[(i * 4) + 2]);
+    if (colorCounts[i] > 0)
+    {
+      unsigned char rgba[4];
+      std::memcpy(rgba, &colors[i], 4);
+
+      colorSum[0] += uint64_t(colorCounts[i]) * rgba[0];
+      colorSum[1] += uint64_t(colorCounts[i]) * rgba[1];
+      colorSum[2] += uint64_t(colorCounts[i]) * rgba[2];
+      andAlpha = static_cast<unsigned char>(andAlpha & rgba[3]);
+    }
   }
+
   averageColor = Color{
     float(colorSum[0]) / (255.0f * float(pixelCount)),
     float(colorSum[1]) / (255.0f * float(pixelCount)),
     float(colorSum[2]) / (255.0f * float(pixelCount)),
     1.0f};
 
-  // Check for transparency
-  auto hasTransparency = false;
-  if (transparency == PaletteTransparency::Index255Transparent)
-  {
-    // Take the bitwise AND of the alpha channel of all pixels
-    unsigned char andAlpha = 0xFF;
-    for (size_t i = 0; i < pixelCount; ++i)
-    {
-      andAlpha = static_cast<unsigned char>(andAlpha & rgbaData[4 * i + 3]);
-    }
-    hasTransparency = (andAlpha != 0xFF);
-  }
-
-  return hasTransparency;
+  return transparency == PaletteTransparency::Index255Transparent && andAlpha != 0xFF;
 }
 
 bool operator==(const Palette& lhs, const Palette& rhs)
@@ -28,6 +28,7 @@
 #include "vm/util.h"
 #include "vm/vec.h"
 
+#include <cstddef>
 #include <initializer_list>
 #include <limits>
 #include <optional>
@@ -122,6 +123,12 @@ private:
   explicit Polyhedron_Vertex(const vm::vec<T, 3>& position);
 
 public:
+  /**
+   * Allocates and frees vertices using a PolyhedronElementPool.
+   */
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+
   /**
    * Returns the position of this vertex.
    */
@@ -274,6 +281,12 @@ private:
   explicit Polyhedron_Edge(HalfEdge* first, HalfEdge* second = nullptr);
 
 public:
+  /**
+   * Allocates and frees edges using a PolyhedronElementPool.
+   */
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+
   /**
    * Returns the origin of the first half edge.
    */
@@ -595,6 +608,12 @@ private:
   explicit Polyhedron_HalfEdge(Vertex* origin);
 
 public:
+  /**
+   * Allocates and frees half edges using a PolyhedronElementPool.
+   */
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+
   /**
    * Returns the origin vertex of this half edge.
    */
@@ -826,6 +845,12 @@ private:
   explicit Polyhedron_Face(HalfEdgeList&& boundary, const vm::plane<T, 3>& plane);
 
 public:
+  /**
+   * Allocates and frees faces using a PolyhedronElementPool.
+   */
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
+
   /**
    * Returns the circular list of half edges that make up the boundary of this face.
    */
@@ -21,6 +21,7 @@
 
 #include "Macros.h"
 #include "Polyhedron.h"
+#include "Polyhedron_ElementPool.h"
 
 #include "vm/distance.h"
 #include "vm/plane.h"
@@ -49,6 +50,24 @@ const kdl::intrusive_circular_link<Polyhedron_Edge<T, FP, VP>>& Polyhedron_GetEd
   return edge->m_link;
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Edge<T, FP, VP>::operator new(const size_t size)
+{
+  assert(size == sizeof(Polyhedron_Edge));
+  unused(size);
+  return PolyhedronElementPool<
+    sizeof(Polyhedron_Edge),
+    alignof(Polyhedron_Edge)>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Edge<T, FP, VP>::operator delete(void* ptr)
+{
+  PolyhedronElementPool<
+    sizeof(Polyhedron_Edge),
+    alignof(Polyhedron_Edge)>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 Polyhedron_Edge<T, FP, VP>::Polyhedron_Edge(HalfEdge* first, HalfEdge* second)
   : m_first{first}
@@ -0,0 +1,69 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Polyhedron_ElementPool.h"
+
+#include <mutex>
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+struct Registry
+{
+  std::mutex mutex;
+  std::vector<size_t (*)()> trimFunctions;
+};
+
+Registry& registry()
+{
+  // never destroyed, pools may still be registered during static destruction
+  static auto* instance = new Registry{};
+  return *instance;
+}
+
+} // namespace
+
+size_t trimPolyhedronElementPools()
+{
+  auto& r = registry();
+  const auto lock = std::lock_guard{r.mutex};
+
+  auto releasedBytes = size_t(0);
+  for (const auto trim : r.trimFunctions)
+  {
+    releasedBytes += trim();
+  }
+  return releasedBytes;
+}
+
+namespace detail
+{
+
+void registerPolyhedronElementPool(size_t (*trim)())
+{
+  auto& r = registry();
+  const auto lock = std::lock_guard{r.mutex};
+  r.trimFunctions.push_back(trim);
+}
+
+} // namespace detail
+} // namespace tb::mdl
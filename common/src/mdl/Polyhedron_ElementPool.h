@@ -0,0 +1,300 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace tb::mdl
+{
+
+/**
+ * Releases the slabs of all polyhedron element pools that contain no elements in use.
+ *
+ * Only elements that were handed over to the shared free lists are considered, together
+ * with the free lists of the calling thread. Other threads keep at most two batches of
+ * free elements each, and their slabs are retained.
+ *
+ * @return the number of bytes released
+ */
+size_t trimPolyhedronElementPools();
+
+namespace detail
+{
+void registerPolyhedronElementPool(size_t (*trim)());
+} // namespace detail
+
+/**
+ * Allocates the vertices, edges, half edges and faces of polyhedra.
+ *
+ * Polyhedra create and destroy their elements individually and in large numbers, e.g.
+ * whenever a brush is copied or its geometry is rebuilt. The pool carves elements of the
+ * given size out of large slabs and recycles freed elements using free lists, so that
+ * most allocations don't reach the general purpose allocator.
+ *
+ * Each thread keeps its own free lists, so allocating and freeing elements requires no
+ * synchronization. Freed elements are collected in batches, and a thread keeps at most
+ * two of them. Surplus batches and the batches of exiting threads are handed over to a
+ * shared list from which other threads refill their own lists. Slabs are only released
+ * by trimPolyhedronElementPools, e.g. when a document is closed.
+ */
+template <size_t Size, size_t Alignment>
+class PolyhedronElementPool
+{
+private:
+  struct FreeElement
+  {
+    FreeElement* next;
+  };
+
+  static constexpr auto ElementAlignment = std::max(Alignment, alignof(FreeElement));
+  static constexpr auto ElementSize =
+    (std::max(Size, sizeof(FreeElement)) + ElementAlignment - 1) / ElementAlignment
+    * ElementAlignment;
+  static constexpr auto BatchSize = size_t(256);
+
+  struct Batch
+  {
+    FreeElement* first = nullptr;
+    size_t size = 0;
+
+    void push(void* ptr)
+    {
+      first = new (ptr) FreeElement{first};
+      ++size;
+    }
+
+    void* pop()
+    {
+      auto* element = first;
+      first = element->next;
+      --size;
+      return element;
+    }
+  };
+
+  struct Shared
+  {
+    std::mutex mutex;
+    std::vector<Batch> batches;
+    std::vector<std::byte*> slabs;
+
+    void push(const Batch batch)
+    {
+      if (batch.size > 0)
+      {
+        const auto lock = std::lock_guard{mutex};
+        batches.push_back(batch);
+      }
+    }
+
+    Batch pop()
+    {
+      {
+        const auto lock = std::lock_guard{mutex};
+        if (!batches.empty())
+        {
+          const auto batch = batches.back();
+          batches.pop_back();
+          return batch;
+        }
+      }
+
+      // slabs are not released during shutdown, elements may still be freed then
+      auto* slab = static_cast<std::byte*>(::operator new(
+        BatchSize * ElementSize, std::align_val_t{ElementAlignment}));
+
+      {
+        const auto lock = std::lock_guard{mutex};
+        slabs.push_back(slab);
+      }
+
+      auto batch = Batch{};
+      for (size_t i = 0; i < BatchSize; ++i)
+      {
+        batch.push(slab + (BatchSize - i - 1) * ElementSize);
+      }
+      return batch;
+    }
+
+    size_t trim()
+    {
+      const auto lock = std::lock_guard{mutex};
+
+      std::sort(slabs.begin(), slabs.end(), std::less<>{});
+      const auto slabIndex = [&](const FreeElement* element) {
+        const auto* ptr = reinterpret_cast<const std::byte*>(element);
+        const auto it = std::upper_bound(slabs.begin(), slabs.end(), ptr, std::less<>{});
+        return size_t(it - slabs.begin()) - 1;
+      };
+
+      auto freeCounts = std::vector<size_t>(slabs.size(), 0);
+      for (const auto& batch : batches)
+      {
+        for (const auto* element = batch.first; element; element = element->next)
+        {
+          ++freeCounts[slabIndex(element)];
+        }
+      }
+
+      // rebuild the free lists from the elements of the slabs that are retained
+      auto retainedBatches = std::vector<Batch>{};
+      auto retainedBatch = Batch{};
+      for (auto& batch : batches)
+      {
+        while (batch.size > 0)
+        {
+          auto* element = batch.pop();
+          if (freeCounts[slabIndex(static_cast<FreeElement*>(element))] < BatchSize)
+          {
+            retainedBatch.push(element);
+            if (retainedBatch.size == BatchSize)
+            {
+              retainedBatches.push_back(retainedBatch);
+              retainedBatch = Batch{};
+            }
+          }
+        }
+      }
+      if (retainedBatch.size > 0)
+      {
+        retainedBatches.push_back(retainedBatch);
+      }
+      batches = std::move(retainedBatches);
+
+      auto retainedSlabs = std::vector<std::byte*>{};
+      for (size_t i = 0; i < slabs.size(); ++i)
+      {
+        if (freeCounts[i] < BatchSize)
+        {
+          retainedSlabs.push_back(slabs[i]);
+        }
+        else
+        {
+          ::operator delete(slabs[i], std::align_val_t{ElementAlignment});
+        }
+      }
+
+      const auto releasedCount = slabs.size() - retainedSlabs.size();
+      slabs = std::move(retainedSlabs);
+      return releasedCount * BatchSize * ElementSize;
+    }
+  };
+
+  struct Local
+  {
+    Batch current;
+    Batch full;
+
+    ~Local()
+    {
+      shared().push(current);
+      shared().push(full);
+      localDestroyed() = true;
+    }
+  };
+
+  static Shared& shared()
+  {
+    // never destroyed, elements may still be freed during static destruction
+    static auto* instance = [] {
+      detail::registerPolyhedronElementPool(&PolyhedronElementPool::trim);
+      return new Shared{};
+    }();
+    return *instance;
+  }
+
+  static Local& local()
+  {
+    thread_local auto instance = Local{};
+    return instance;
+  }
+
+  static bool& localDestroyed()
+  {
+    thread_local auto destroyed = false;
+    return destroyed;
+  }
+
+public:
+  static void* allocate()
+  {
+    if (localDestroyed())
+    {
+      // the thread is exiting, so we fall back to the shared list
+      auto batch = shared().pop();
+      auto* result = batch.pop();
+      shared().push(batch);
+      return result;
+    }
+
+    auto& l = local();
+    if (l.current.size == 0)
+    {
+      if (l.full.size > 0)
+      {
+        std::swap(l.current, l.full);
+      }
+      else
+      {
+        l.current = shared().pop();
+      }
+    }
+    return l.current.pop();
+  }
+
+  static void deallocate(void* ptr)
+  {
+    if (localDestroyed())
+    {
+      auto batch = Batch{};
+      batch.push(ptr);
+      shared().push(batch);
+      return;
+    }
+
+    auto& l = local();
+    if (l.current.size == BatchSize)
+    {
+      shared().push(l.full);
+      l.full = l.current;
+      l.current = Batch{};
+    }
+    l.current.push(ptr);
+  }
+
+  static size_t trim()
+  {
+    if (!localDestroyed())
+    {
+      auto& l = local();
+      shared().push(std::exchange(l.current, Batch{}));
+      shared().push(std::exchange(l.full, Batch{}));
+    }
+    return shared().trim();
+  }
+};
+
+} // namespace tb::mdl
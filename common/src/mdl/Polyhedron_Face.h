@@ -21,6 +21,7 @@
 
 #include "Macros.h"
 #include "Polyhedron.h"
+#include "Polyhedron_ElementPool.h"
 
 #include "kdl/optional_utils.h"
 
@@ -55,6 +56,24 @@ const kdl::intrusive_circular_link<Polyhedron_Face<T, FP, VP>>& Polyhedron_GetFa
   return face->m_link;
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Face<T, FP, VP>::operator new(const size_t size)
+{
+  assert(size == sizeof(Polyhedron_Face));
+  unused(size);
+  return PolyhedronElementPool<
+    sizeof(Polyhedron_Face),
+    alignof(Polyhedron_Face)>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Face<T, FP, VP>::operator delete(void* ptr)
+{
+  PolyhedronElementPool<
+    sizeof(Polyhedron_Face),
+    alignof(Polyhedron_Face)>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 Polyhedron_Face<T, FP, VP>::Polyhedron_Face(
   HalfEdgeList&& boundary, const vm::plane<T, 3>& plane)
@@ -19,7 +19,9 @@
 
 #pragma once
 
+#include "Macros.h"
 #include "Polyhedron.h"
+#include "Polyhedron_ElementPool.h"
 
 namespace tb::mdl
 {
@@ -40,6 +42,24 @@ Polyhedron_GetHalfEdgeLink<T, FP, VP>::operator()(
   return halfEdge->m_link;
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_HalfEdge<T, FP, VP>::operator new(const size_t size)
+{
+  assert(size == sizeof(Polyhedron_HalfEdge));
+  unused(size);
+  return PolyhedronElementPool<
+    sizeof(Polyhedron_HalfEdge),
+    alignof(Polyhedron_HalfEdge)>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_HalfEdge<T, FP, VP>::operator delete(void* ptr)
+{
+  PolyhedronElementPool<
+    sizeof(Polyhedron_HalfEdge),
+    alignof(Polyhedron_HalfEdge)>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 Polyhedron_HalfEdge<T, FP, VP>::Polyhedron_HalfEdge(Vertex* origin)
   : m_origin{origin}
@@ -32,9 +32,11 @@
 #include "vm/vec_io.h" // IWYU pragma: keep
 
 #include <algorithm>
+#include <functional>
 #include <sstream>
-#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace tb::mdl
 {
@@ -216,21 +218,42 @@ template <typename T, typename FP, typename VP>
 class Polyhedron<T, FP, VP>::Copy
 {
 private:
-  using VertexMap = std::unordered_map<const Vertex*, Vertex*>;
-  using VertexMapEntry = typename VertexMap::value_type;
+  /**
+   * Maps elements of the original to their copies. The entries are collected while
+   * copying and sorted once before the first lookup, which is much cheaper than
+   * maintaining a node based hash map for the few dozen elements of a typical brush.
+   */
+  template <typename E>
+  class ElementMap
+  {
+  private:
+    using Entry = std::pair<const E*, E*>;
+    std::vector<Entry> m_entries;
+
+  public:
+    explicit ElementMap(const size_t capacity) { m_entries.reserve(capacity); }
+
+    void insert(const E* original, E* copy) { m_entries.emplace_back(original, copy); }
+
+    void sort() { std::ranges::sort(m_entries, std::less<>{}, &Entry::first); }
 
-  using HalfEdgeMap = std::unordered_map<const HalfEdge*, HalfEdge*>;
-  using HalfEdgeMapEntry = typename HalfEdgeMap::value_type;
+    E* find(const E* original) const
+    {
+      const auto it =
+        std::ranges::lower_bound(m_entries, original, std::less<>{}, &Entry::first);
+      return it != m_entries.end() && it->first == original ? it->second : nullptr;
+    }
+  };
 
   /**
    * Maps the vertices of the original to their copies.
    */
-  VertexMap m_vertexMap;
+  ElementMap<Vertex> m_vertexMap;
 
   /**
    * Maps the half edges of the original to their copies.
    */
-  HalfEdgeMap m_halfEdgeMap;
+  ElementMap<HalfEdge> m_halfEdgeMap;
 
   /**
    * The copied vertices.
@@ -270,7 +293,9 @@ public:
     const VertexList& originalVertices,
     Polyhedron& destination,
     const CopyCallback& callback)
-    : m_destination{destination}
+    : m_vertexMap{originalVertices.size()}
+    , m_halfEdgeMap{2u * originalEdges.size()}
+    , m_destination{destination}
   {
     copyVertices(originalVertices, callback);
     copyFaces(originalFaces, callback);
@@ -285,11 +310,10 @@ private:
     {
       auto* copy = new Vertex{currentVertex->position()};
       callback.vertexWasCopied(currentVertex, copy);
-      assert(m_vertexMap.count(currentVertex) == 0u);
-      m_vertexMap.emplace(currentVertex, copy);
+      m_vertexMap.insert(currentVertex, copy);
       m_vertices.push_back(copy);
-      currentVertex = currentVertex->next();
     }
+    m_vertexMap.sort();
   }
 
   void copyFaces(const FaceList& originalFaces, const CopyCallback& callback)
@@ -298,6 +322,7 @@ private:
     {
       copyFace(currentFace, callback);
     }
+    m_halfEdgeMap.sort();
   }
 
   void copyFace(const Face* originalFace, const CopyCallback& callback)
@@ -315,20 +340,16 @@ private:
 
   HalfEdge* copyHalfEdge(const HalfEdge* original)
   {
-    const auto* originalOrigin = original->origin();
-
-    auto* myOrigin = findVertex(originalOrigin);
-    auto* copy = new HalfEdge{myOrigin};
-    assert(m_halfEdgeMap.count(original) == 0u);
-    m_halfEdgeMap.emplace(original, copy);
+    auto* copy = new HalfEdge{findVertex(original->origin())};
+    m_halfEdgeMap.insert(original, copy);
     return copy;
   }
 
-  Vertex* findVertex(const Vertex* original)
+  Vertex* findVertex(const Vertex* original) const
   {
-    auto it = m_vertexMap.find(original);
-    assert(it != m_vertexMap.end());
-    return it->second;
+    auto* copy = m_vertexMap.find(original);
+    assert(copy != nullptr);
+    return copy;
   }
 
   void copyEdges(const EdgeList& originalEdges)
@@ -353,16 +374,14 @@ private:
 
   HalfEdge* findOrCopyHalfEdge(const HalfEdge* original)
   {
-    if (auto it = m_halfEdgeMap.find(original); it != m_halfEdgeMap.end())
+    if (auto* copy = m_halfEdgeMap.find(original))
     {
-      return it->second;
+      return copy;
     }
 
-    const auto* originalOrigin = original->origin();
-    auto* myOrigin = findVertex(originalOrigin);
-    auto* copy = new HalfEdge{myOrigin};
-    m_halfEdgeMap.emplace(original, copy);
-    return copy;
+    // Half edges that do not belong to a face only occur in degenerate polyhedra. Each
+    // of them belongs to exactly one edge, so it is only looked up once.
+    return new HalfEdge{findVertex(original->origin())};
   }
 
   void swapContents()
@@ -19,7 +19,9 @@
 
 #pragma once
 
+#include "Macros.h"
 #include "Polyhedron.h"
+#include "Polyhedron_ElementPool.h"
 
 #include "kdl/intrusive_circular_list.h"
 
@@ -43,6 +45,24 @@ Polyhedron_GetVertexLink<T, FP, VP>::operator()(
   return vertex->m_link;
 }
 
+template <typename T, typename FP, typename VP>
+void* Polyhedron_Vertex<T, FP, VP>::operator new(const size_t size)
+{
+  assert(size == sizeof(Polyhedron_Vertex));
+  unused(size);
+  return PolyhedronElementPool<
+    sizeof(Polyhedron_Vertex),
+    alignof(Polyhedron_Vertex)>::allocate();
+}
+
+template <typename T, typename FP, typename VP>
+void Polyhedron_Vertex<T, FP, VP>::operator delete(void* ptr)
+{
+  PolyhedronElementPool<
+    sizeof(Polyhedron_Vertex),
+    alignof(Polyhedron_Vertex)>::deallocate(ptr);
+}
+
 template <typename T, typename FP, typename VP>
 Polyhedron_Vertex<T, FP, VP>::Polyhedron_Vertex(const vm::vec<T, 3>& position)
   : m_position{position}
@@ -27,6 +27,7 @@
 #include "kdl/reflection_impl.h"
 #include "kdl/result.h"
 
+#include <chrono>
 #include <functional>
 #include <future>
 #include <iostream>
@@ -228,6 +229,9 @@ ResourceState<T> drop(ResourceDropping<T> state, const bool glContextAvailable)
  * | Dropping       | process          | Dropped         |
  * | Dropped        | -                | -               |
  * | Failed         | -                | -               |
+ *
+ * Resources can be requested by their users, e.g. when they are about to be rendered.
+ * Unloaded resources that were requested more recently are loaded first.
  */
 template <typename T>
 class Resource
@@ -235,6 +239,7 @@ class Resource
 private:
   ResourceId m_id;
   ResourceState<T> m_state;
+  std::chrono::steady_clock::time_point m_lastRequestTime;
 
   kdl_reflect_inline(Resource, m_state);
 
@@ -255,6 +260,20 @@ public:
 
   const ResourceState<T>& state() const { return m_state; }
 
+  /**
+   * Returns the last time this resource was requested, or the clock's epoch if it was
+   * never requested.
+   */
+  std::chrono::steady_clock::time_point lastRequestTime() const
+  {
+    return m_lastRequestTime;
+  }
+
+  /**
+   * Marks this resource as requested at the current time.
+   */
+  void request() { m_lastRequestTime = std::chrono::steady_clock::now(); }
+
   const T* get() const
   {
     return std::visit(
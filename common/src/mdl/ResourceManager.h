@@ -25,8 +25,11 @@
 #include "kdl/reflection_impl.h"
 #include "kdl/vector_utils.h"
 
+#include <algorithm>
 #include <chrono>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace tb::mdl
@@ -41,9 +44,14 @@ public:
 
   virtual long useCount() const = 0;
 
+  virtual bool isUnloaded() const = 0;
+  virtual bool isLoading() const = 0;
   virtual bool isDropped() const = 0;
   virtual bool needsProcessing() const = 0;
 
+  virtual std::chrono::steady_clock::time_point lastRequestTime() const = 0;
+  virtual bool limitsLoading() const = 0;
+
   virtual void drop() = 0;
   virtual bool process(TaskRunner taskRunner, const ProcessContext& processContext) = 0;
 };
@@ -53,19 +61,35 @@ class ResourceWrapper : public ResourceWrapperBase
 {
 private:
   std::shared_ptr<Resource<T>> m_resource;
+  bool m_limitsLoading;
 
   kdl_reflect_inline(ResourceWrapper, m_resource);
 
 public:
-  explicit ResourceWrapper(std::shared_ptr<Resource<T>> resource)
+  explicit ResourceWrapper(
+    std::shared_ptr<Resource<T>> resource, const bool limitsLoading = true)
     : m_resource{std::move(resource)}
+    , m_limitsLoading{limitsLoading}
   {
   }
 
   const ResourceId& id() const override { return m_resource->id(); }
   long useCount() const override { return m_resource.use_count(); }
+  bool isUnloaded() const override
+  {
+    return std::holds_alternative<ResourceUnloaded<T>>(m_resource->state());
+  }
+  bool isLoading() const override
+  {
+    return std::holds_alternative<ResourceLoading<T>>(m_resource->state());
+  }
   bool isDropped() const override { return m_resource->isDropped(); }
   bool needsProcessing() const override { return m_resource->needsProcessing(); }
+  std::chrono::steady_clock::time_point lastRequestTime() const override
+  {
+    return m_resource->lastRequestTime();
+  }
+  bool limitsLoading() const override { return m_limitsLoading; }
   void drop() override { m_resource->drop(); }
   bool process(TaskRunner taskRunner, const ProcessContext& processContext) override
   {
@@ -101,17 +125,41 @@ public:
     });
   }
 
+  /**
+   * Adds the given resource to this resource manager.
+   *
+   * If limitsLoading is false, the resource does not count towards the maximum number of
+   * loading resources, and its loading is triggered as soon as it is processed. This is
+   * meant for resources that are cheap to load, so that they don't delay the loading of
+   * more expensive resources.
+   */
   template <typename ResourceT>
-  void addResource(std::shared_ptr<Resource<ResourceT>> resource)
+  void addResource(
+    std::shared_ptr<Resource<ResourceT>> resource, const bool limitsLoading = true)
   {
     m_resources.push_back(
-      std::make_unique<ResourceWrapper<ResourceT>>(std::move(resource)));
+      std::make_unique<ResourceWrapper<ResourceT>>(std::move(resource), limitsLoading));
   }
 
+  /**
+   * Advances the state of every resource that needs processing and returns the IDs of
+   * the resources whose state changed.
+   *
+   * Resources that are loading, loaded or being dropped are processed first, and so are
+   * unloaded resources that don't limit loading. Afterwards, loading is triggered for the
+   * remaining unloaded resources in the order of their last request time, starting with
+   * the most recently requested resource. If a maximum number of loading resources is
+   * given, no more resources are triggered once that number of resources that limit
+   * loading are loading, so that resources requested later can still overtake the
+   * resources that are waiting.
+   *
+   * If a timeout is given, processing stops once it has elapsed.
+   */
   std::vector<ResourceId> process(
     TaskRunner taskRunner,
     const ProcessContext& processContext,
-    std::optional<std::chrono::milliseconds> timeout = std::nullopt)
+    std::optional<std::chrono::milliseconds> timeout = std::nullopt,
+    std::optional<size_t> maxLoadingCount = std::nullopt)
   {
     const auto checkTimeout =
       timeout ? std::function{[timeout_ = *timeout,
@@ -121,6 +169,8 @@ public:
               : std::function{[]() { return true; }};
 
     auto result = std::vector<ResourceId>{};
+    auto unloadedResources = std::vector<ResourceWrapperBase*>{};
+    auto loadingCount = size_t(0);
 
     for (auto it = m_resources.begin(); it != m_resources.end() && checkTimeout();)
     {
@@ -130,7 +180,11 @@ public:
         resourceWrapper->drop();
       }
 
-      if (resourceWrapper->needsProcessing())
+      if (resourceWrapper->isUnloaded() && resourceWrapper->limitsLoading())
+      {
+        unloadedResources.push_back(resourceWrapper.get());
+      }
+      else if (resourceWrapper->needsProcessing())
       {
         if (resourceWrapper->process(taskRunner, processContext))
         {
@@ -138,11 +192,37 @@ public:
         }
       }
 
+      if (resourceWrapper->isLoading() && resourceWrapper->limitsLoading())
+      {
+        ++loadingCount;
+      }
+
       it = resourceWrapper->useCount() == 1 && resourceWrapper->isDropped()
              ? m_resources.erase(it)
              : std::next(it);
     }
 
+    std::ranges::stable_sort(
+      unloadedResources, std::greater{}, &ResourceWrapperBase::lastRequestTime);
+
+    for (auto* resourceWrapper : unloadedResources)
+    {
+      if (!checkTimeout() || (maxLoadingCount && loadingCount >= *maxLoadingCount))
+      {
+        break;
+      }
+
+      if (resourceWrapper->process(taskRunner, processContext))
+      {
+        result.push_back(resourceWrapper->id());
+      }
+
+      if (resourceWrapper->isLoading())
+      {
+        ++loadingCount;
+      }
+    }
+
     return result;
   }
 };
@@ -492,13 +492,13 @@ void WorldNode::doFindEntityNodesWithNumberedProperty(
 }
 
 void WorldNode::doAddToIndex(
-  EntityNodeBase* node, const std::string& key, const std::string& value)
+  EntityNodeBase* node, const InternedString& key, const InternedString& value)
 {
   m_entityNodeIndex->addProperty(node, key, value);
 }
 
 void WorldNode::doRemoveFromIndex(
-  EntityNodeBase* node, const std::string& key, const std::string& value)
+  EntityNodeBase* node, const InternedString& key, const InternedString& value)
 {
   m_entityNodeIndex->removeProperty(node, key, value);
 }
@@ -171,9 +171,13 @@ private: // implement Node interface
     const std::string& value,
     std::vector<EntityNodeBase*>& result) const override;
   void doAddToIndex(
-    EntityNodeBase* node, const std::string& key, const std::string& value) override;
+    EntityNodeBase* node,
+    const InternedString& key,
+    const InternedString& value) override;
   void doRemoveFromIndex(
-    EntityNodeBase* node, const std::string& key, const std::string& value) override;
+    EntityNodeBase* node,
+    const InternedString& key,
+    const InternedString& value) override;
 
 private: // implement EntityNodeBase interface
   void doPropertiesDidChange(const vm::bbox3d& oldBounds) override;
@@ -35,7 +35,11 @@
 #include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <limits>
+#include <numeric>
 #include <optional>
+#include <ostream>
+#include <tuple>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -122,6 +126,14 @@ node_address get_container(const vm::bbox<T, 3>& bounds, const T min_size)
 /**
  * An octree that allows for quick ray intersection queries.
  *
+ * The nodes are stored in flat arrays that are indexed by node index: the bounds of all
+ * nodes are stored contiguously so that queries can test them without touching the rest
+ * of the node data. The children of an inner node occupy a block of eight consecutive
+ * node indices. The root node is always stored at index 0.
+ *
+ * The nested leaf_node and inner_node types are only used to describe a tree, e.g. when
+ * constructing or comparing trees.
+ *
  * @tparam T the floating point type
  * @tparam S the number of dimensions for vector types
  * @tparam U the node data to store in the nodes
@@ -170,22 +182,6 @@ public:
     {
     }
 
-    inner_node(const detail::node_address i_address, std::vector<U> i_data)
-      : inner_node{
-          i_address,
-          std::move(i_data),
-          kdl::vec_from(
-            node{leaf_node{get_child(i_address, 0), {}}},
-            node{leaf_node{get_child(i_address, 1), {}}},
-            node{leaf_node{get_child(i_address, 2), {}}},
-            node{leaf_node{get_child(i_address, 3), {}}},
-            node{leaf_node{get_child(i_address, 4), {}}},
-            node{leaf_node{get_child(i_address, 5), {}}},
-            node{leaf_node{get_child(i_address, 6), {}}},
-            node{leaf_node{get_child(i_address, 7), {}}})}
-    {
-    }
-
     inner_node(const inner_node&) = delete;
     inner_node(inner_node&&) noexcept = default;
 
@@ -196,176 +192,22 @@ public:
   };
 
 private:
-  static detail::node_address& get_address(node& node)
-  {
-    return std::visit([](auto& x) -> detail::node_address& { return x.address; }, node);
-  }
-
-  static const detail::node_address& get_address(const node& node_)
-  {
-    return const_cast<const detail::node_address&>(get_address(const_cast<node&>(node_)));
-  }
-
-  static std::vector<U>& get_data(node& node)
-  {
-    return std::visit([](auto& x) -> std::vector<U>& { return x.data; }, node);
-  }
-
-  static const std::vector<U>& get_data(const node& node_)
-  {
-    return const_cast<const std::vector<U>&>(get_data(const_cast<node&>(node_)));
-  }
-
-  static bool is_inner_node(const node& node)
-  {
-    return std::visit(
-      kdl::overload(
-        [](const inner_node&) { return true; }, [](const leaf_node&) { return false; }),
-      node);
-  }
-
-  static bool is_leaf_node(const node& node) { return !is_inner_node(node); }
-
-  static bool is_empty(const node& node)
-  {
-    return std::visit(
-      kdl::overload(
-        [](const inner_node& i) {
-          return i.data.empty()
-                 && std::all_of(
-                   i.children.begin(), i.children.end(), [](const auto& child) {
-                     return is_leaf_node(child) && is_empty(child);
-                   });
-        },
-        [](const leaf_node& l) { return l.data.empty(); }),
-      node);
-  }
-
-  template <typename Predicate, typename Visitor>
-  static void visit_node_if(
-    const node& node, const Visitor& visitor, const Predicate& predicate)
-  {
-    if (predicate(node))
-    {
-      visitor(node);
-      std::visit(
-        kdl::overload(
-          [&](const inner_node& inner_node) {
-            for (const auto& child : inner_node.children)
-            {
-              visit_node_if(child, visitor, predicate);
-            }
-          },
-          [&](const leaf_node&) {}),
-        node);
-    }
-  }
-
-  static void update_root_address(
-    node& root,
-    const detail::node_address& address,
-    std::unordered_map<U, detail::node_address>& node_address_for_data)
-  {
-    assert(is_root(address));
-    assert(address.contains(get_address(root)));
-    get_address(root) = address;
+  static constexpr auto no_children = std::numeric_limits<size_t>::max();
 
-    for (const auto& d : get_data(root))
-    {
-      node_address_for_data.insert_or_assign(d, address);
-    }
-  }
-
-  static void insert_into_node(node& node, const detail::node_address& address, U data)
-  {
-    if (!get_address(node).contains(address))
-    {
-      const auto container_address = get_container(get_address(node), address);
-      const auto container_quadrant = get_quadrant(container_address, get_address(node));
-      assert(container_quadrant.has_value());
-
-      auto container_node = inner_node{container_address, {}};
-      container_node.children[*container_quadrant] = std::move(node);
-      node = std::move(container_node);
-    }
-
-    assert(get_address(node).contains(address));
-    if (const auto quadrant = get_quadrant(get_address(node), address))
-    {
-      std::visit(
-        kdl::overload(
-          [&](inner_node& i) {
-            insert_into_node(i.children[*quadrant], address, std::move(data));
-          },
-          [&](leaf_node& l) {
-            if (l.data.empty())
-            {
-              l.address = address;
-              l.data.push_back(std::move(data));
-            }
-            else
-            {
-              node = inner_node{l.address, std::move(l.data)};
-              insert_into_node(node, address, std::move(data));
-            }
-          }),
-        node);
-    }
-    else
-    {
-      get_data(node).push_back(std::move(data));
-    }
-  }
+  T m_min_size;
 
-  void remove_from_node(node& node, const detail::node_address& address, const U& data)
-  {
-    std::visit(
-      kdl::overload(
-        [&](inner_node& i) {
-          if (const auto quadrant = get_quadrant(i.address, address))
-          {
-            remove_from_node(i.children[*quadrant], address, data);
-          }
-          else
-          {
-            const auto i_data = std::find(i.data.begin(), i.data.end(), data);
-            assert(i_data != i.data.end());
-            i.data.erase(i_data);
-          }
+  // node storage, indexed by node index
+  std::vector<vm::bbox<T, 3>> m_bounds;
+  std::vector<detail::node_address> m_addresses;
+  std::vector<size_t> m_first_child;
+  std::vector<std::vector<U>> m_data;
 
-          if (!is_root(i.address))
-          {
-            const auto is_non_empty_child = [](const auto& c) {
-              return is_inner_node(c) || !get_data(c).empty();
-            };
-            const auto num_non_empty_children =
-              std::count_if(i.children.begin(), i.children.end(), is_non_empty_child);
-            if (num_non_empty_children == 0)
-            {
-              node = leaf_node{i.address, std::move(i.data)};
-            }
-            else if (num_non_empty_children == 1 && i.data.empty())
-            {
-              const auto i_non_empty_child =
-                std::find_if(i.children.begin(), i.children.end(), is_non_empty_child);
-              assert(i_non_empty_child != i.children.end());
+  // the bounds of each block of children, indexed by block, for testing them at once
+  std::vector<vm::bbox_packet<T, 8>> m_child_bounds;
 
-              auto child = std::move(*i_non_empty_child);
-              node = std::move(child);
-            }
-          }
-        },
-        [&](leaf_node& l) {
-          const auto i_data = std::find(l.data.begin(), l.data.end(), data);
-          assert(i_data != l.data.end());
-          l.data.erase(i_data);
-        }),
-      node);
-  }
+  // the first node indices of unused blocks of eight nodes
+  std::vector<size_t> m_free_blocks;
 
-private:
-  std::optional<node> m_root;
-  T m_min_size;
   std::unordered_map<U, detail::node_address> m_node_address_for_data;
 
 public:
@@ -375,30 +217,35 @@ public:
   }
 
   octree(const T min_size, node root)
-    : m_root{std::move(root)}
-    , m_min_size{min_size}
+    : m_min_size{min_size}
   {
-    auto visitor = kdl::overload(
-      [&](auto&& self, const inner_node& node) -> void {
-        for (const auto& data : node.data)
-        {
-          m_node_address_for_data.emplace(data, node.address);
-        }
-        for (const auto& child : node.children)
+    add_node();
+
+    auto add = kdl::overload(
+      [&](auto&& self, const size_t index, inner_node& inner) -> void {
+        assert(inner.children.size() == 8);
+
+        const auto first_child = allocate_block();
+        set_node(index, inner.address, first_child, std::move(inner.data));
+        for (size_t i = 0; i < 8; ++i)
         {
-          std::visit([&](const auto& c) { self(self, c); }, child);
+          std::visit(
+            [&](auto& child) { self(self, first_child + i, child); },
+            inner.children[i]);
         }
       },
-      [&](auto&&, const leaf_node& node) -> void {
-        for (const auto& data : node.data)
-        {
-          m_node_address_for_data.emplace(data, node.address);
-        }
+      [&](auto&&, const size_t index, leaf_node& leaf) -> void {
+        set_node(index, leaf.address, no_children, std::move(leaf.data));
       });
 
-    if (m_root)
+    std::visit([&](auto& n) { add(add, 0, n); }, root);
+
+    for (size_t i = 0; i < m_data.size(); ++i)
     {
-      std::visit([&](const auto& node) { visitor(visitor, node); }, *m_root);
+      for (const auto& data : m_data[i])
+      {
+        m_node_address_for_data.emplace(data, m_addresses[i]);
+      }
     }
   }
 
@@ -422,35 +269,36 @@ public:
     const auto address = detail::get_container(bounds, m_min_size);
     if (is_root(address))
     {
-      if (!m_root)
+      if (empty())
       {
-        m_root = leaf_node{address, {}};
+        add_node();
+        set_node(0, address, no_children, {});
       }
-      else if (!get_address(*m_root).contains(address))
+      else if (!m_addresses[0].contains(address))
       {
-        update_root_address(*m_root, address, m_node_address_for_data);
+        update_root_address(address);
       }
 
-      get_data(*m_root).push_back(std::move(data));
-      m_node_address_for_data.emplace(data, get_address(*m_root));
+      m_node_address_for_data.emplace(data, m_addresses[0]);
+      m_data[0].push_back(std::move(data));
     }
     else
     {
-      if (!m_root)
+      if (empty())
       {
-        m_root = inner_node{get_root(address), {}};
+        add_node();
+        make_inner_node(0, get_root(address), {});
       }
-      else if (!get_address(*m_root).contains(address))
+      else if (!m_addresses[0].contains(address))
       {
-        update_root_address(*m_root, get_root(address), m_node_address_for_data);
+        update_root_address(get_root(address));
       }
 
-      insert_into_node(*m_root, address, std::move(data));
       m_node_address_for_data.emplace(data, address);
+      insert_into_node(0, address, std::move(data));
     }
   }
 
-
   /**
    * Removes the node with the given data from this tree.
    *
@@ -465,12 +313,12 @@ public:
       return false;
     }
 
-    remove_from_node(*m_root, i_address->second, data);
-    m_node_address_for_data.erase(data);
+    remove_from_node(0, i_address->second, data);
+    m_node_address_for_data.erase(i_address);
 
     if (m_node_address_for_data.empty())
     {
-      m_root = std::nullopt;
+      clear();
     }
 
     return true;
@@ -500,8 +348,13 @@ public:
    */
   void clear()
   {
+    m_bounds.clear();
+    m_child_bounds.clear();
+    m_addresses.clear();
+    m_first_child.clear();
+    m_data.clear();
+    m_free_blocks.clear();
     m_node_address_for_data.clear();
-    m_root = std::nullopt;
   }
 
   /**
@@ -509,7 +362,19 @@ public:
    *
    * @return true if this tree is empty and false otherwise
    */
-  bool empty() const { return m_root == std::nullopt; }
+  bool empty() const { return m_addresses.empty(); }
+
+  /**
+   * Returns a description of the nodes of this tree, or nullopt if this tree is empty.
+   */
+  std::optional<node> root() const
+  {
+    if (empty())
+    {
+      return std::nullopt;
+    }
+    return describe_node(0);
+  }
 
   /**
    * Finds every data item in this tree whose bounding box intersects with the given ray
@@ -536,19 +401,28 @@ public:
   template <typename O>
   void find_intersectors(const vm::ray<T, 3>& ray, O out) const
   {
-    if (m_root)
-    {
-      visit_node_if(
-        *m_root,
-        [&](const auto& node) {
-          const auto& data = get_data(node);
-          std::copy(data.begin(), data.end(), out);
-        },
-        [&](const auto& node) {
-          const auto bounds = get_address(node).to_bounds(m_min_size);
-          return bounds.contains(ray.origin) || vm::intersect_ray_bbox(ray, bounds);
-        });
-    }
+    visit_nodes_if(
+      [&](const auto& data) { std::copy(data.begin(), data.end(), out); },
+      [&](const auto& bounds) { return intersects(ray, bounds); },
+      [&](const auto index) { return intersected_children(ray, index); });
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with any of the
+   * given rays. The tree is traversed only once for all rays.
+   *
+   * @param rays the rays to test
+   * @return a list of found data items for each of the given rays, in the same order
+   */
+  std::vector<std::vector<U>> find_intersectors(
+    const std::vector<vm::ray<T, 3>>& rays) const
+  {
+    return find_batched(
+      rays,
+      [](const auto& ray, const auto& bounds) { return intersects(ray, bounds); },
+      [&](const auto& ray, const auto index) {
+        return intersected_children(ray, index);
+      });
   }
 
   /**
@@ -576,19 +450,30 @@ public:
   template <typename O>
   void find_intersectors(const vm::bbox<T, 3>& bbox, O out) const
   {
-    if (m_root)
-    {
-      visit_node_if(
-        *m_root,
-        [&](const auto& node) {
-          const auto& data = get_data(node);
-          std::copy(data.begin(), data.end(), out);
-        },
-        [&](const auto& node) {
-          const auto bounds = get_address(node).to_bounds(m_min_size);
-          return bbox.intersects(bounds);
-        });
-    }
+    const auto predicate = [&](const auto& bounds) { return bbox.intersects(bounds); };
+    visit_nodes_if(
+      [&](const auto& data) { std::copy(data.begin(), data.end(), out); },
+      predicate,
+      [&](const auto index) { return children_if(index, predicate); });
+  }
+
+  /**
+   * Finds every data item in this tree whose bounding box intersects with any of the
+   * given bboxes. The tree is traversed only once for all bboxes.
+   *
+   * @param bboxes the bboxes to test
+   * @return a list of found data items for each of the given bboxes, in the same order
+   */
+  std::vector<std::vector<U>> find_intersectors(
+    const std::vector<vm::bbox<T, 3>>& bboxes) const
+  {
+    const auto predicate = [](const auto& bbox, const auto& bounds) {
+      return bbox.intersects(bounds);
+    };
+    return find_batched(bboxes, predicate, [&](const auto& bbox, const auto index) {
+      return children_if(
+        index, [&](const auto& bounds) { return predicate(bbox, bounds); });
+    });
   }
 
   /**
@@ -616,23 +501,377 @@ public:
   template <typename O>
   void find_containers(const vm::vec<T, 3>& point, O out) const
   {
-    if (m_root)
+    const auto predicate = [&](const auto& bounds) { return bounds.contains(point); };
+    visit_nodes_if(
+      [&](const auto& data) { std::copy(data.begin(), data.end(), out); },
+      predicate,
+      [&](const auto index) { return children_if(index, predicate); });
+  }
+
+  friend bool operator==(const octree& lhs, const octree& rhs)
+  {
+    return lhs.m_min_size == rhs.m_min_size && lhs.root() == rhs.root();
+  }
+
+  friend std::ostream& operator<<(std::ostream& lhs, const octree& rhs)
+  {
+    kdl::struct_stream{lhs} << "octree" << "m_root" << rhs.root() << "m_min_size"
+                            << rhs.m_min_size;
+    return lhs;
+  }
+
+private:
+  static bool intersects(const vm::ray<T, 3>& ray, const vm::bbox<T, 3>& bounds)
+  {
+    return bounds.contains(ray.origin) || vm::intersect_ray_bbox(ray, bounds);
+  }
+
+  /**
+   * Returns a bit mask of the children of the given inner node that are hit by the given
+   * ray. All children are tested at once using their bounds packet.
+   */
+  std::uint32_t intersected_children(const vm::ray<T, 3>& ray, const size_t index) const
+  {
+    return vm::intersect_ray_bbox_packet(
+      ray, m_child_bounds[block(m_first_child[index])]);
+  }
+
+  /**
+   * Returns a bit mask of the children of the given inner node whose bounds satisfy the
+   * given predicate.
+   */
+  template <typename Predicate>
+  std::uint32_t children_if(const size_t index, const Predicate& predicate) const
+  {
+    auto result = std::uint32_t(0);
+    for (size_t i = 0; i < 8; ++i)
     {
-      visit_node_if(
-        *m_root,
-        [&](const auto& node) {
-          const auto& data = get_data(node);
-          std::copy(data.begin(), data.end(), out);
-        },
-        [&](const auto& node) {
-          return get_address(node).to_bounds(m_min_size).contains(point);
-        });
+      if (predicate(m_bounds[m_first_child[index] + i]))
+      {
+        result |= std::uint32_t(1) << i;
+      }
     }
+    return result;
   }
 
-  kdl_reflect_inline(octree, m_root, m_min_size, m_node_address_for_data);
+  // every node except for the root belongs to a block of eight children
+  static size_t block(const size_t index)
+  {
+    assert(index > 0);
+    return (index - 1) / 8;
+  }
+
+  size_t add_node()
+  {
+    const auto index = m_addresses.size();
+    m_bounds.emplace_back();
+    m_addresses.emplace_back(0, 0, 0, 0);
+    m_first_child.push_back(no_children);
+    m_data.emplace_back();
+    return index;
+  }
+
+  size_t allocate_block()
+  {
+    if (!m_free_blocks.empty())
+    {
+      const auto first = m_free_blocks.back();
+      m_free_blocks.pop_back();
+      return first;
+    }
+
+    const auto first = add_node();
+    for (size_t i = 1; i < 8; ++i)
+    {
+      add_node();
+    }
+    m_child_bounds.emplace_back();
+    return first;
+  }
+
+  void free_block(const size_t first)
+  {
+    for (size_t i = first; i < first + 8; ++i)
+    {
+      m_first_child[i] = no_children;
+      m_data[i].clear();
+    }
+    m_free_blocks.push_back(first);
+  }
+
+  void set_node(
+    const size_t index,
+    const detail::node_address& address,
+    const size_t first_child,
+    std::vector<U> data)
+  {
+    m_bounds[index] = address.to_bounds(m_min_size);
+    if (index > 0)
+    {
+      m_child_bounds[block(index)].set((index - 1) % 8, m_bounds[index]);
+    }
+    m_addresses[index] = address;
+    m_first_child[index] = first_child;
+    m_data[index] = std::move(data);
+  }
+
+  void move_node(const size_t from, const size_t to)
+  {
+    set_node(to, m_addresses[from], m_first_child[from], std::move(m_data[from]));
+  }
+
+  // the address is passed by value because it may refer to an element of m_addresses,
+  // which is invalidated when a new block is allocated
+  void make_inner_node(
+    const size_t index, const detail::node_address address, std::vector<U> data)
+  {
+    const auto first_child = allocate_block();
+    for (size_t i = 0; i < 8; ++i)
+    {
+      set_node(first_child + i, get_child(address, i), no_children, {});
+    }
+    set_node(index, address, first_child, std::move(data));
+  }
+
+  bool is_inner_node(const size_t index) const
+  {
+    return m_first_child[index] != no_children;
+  }
+
+  node describe_node(const size_t index) const
+  {
+    if (is_inner_node(index))
+    {
+      auto children = std::vector<node>{};
+      children.reserve(8);
+      for (size_t i = 0; i < 8; ++i)
+      {
+        children.push_back(describe_node(m_first_child[index] + i));
+      }
+      return inner_node{m_addresses[index], m_data[index], std::move(children)};
+    }
+    return leaf_node{m_addresses[index], m_data[index]};
+  }
+
+  void update_root_address(const detail::node_address& address)
+  {
+    assert(is_root(address));
+    assert(address.contains(m_addresses[0]));
+    m_addresses[0] = address;
+    m_bounds[0] = address.to_bounds(m_min_size);
+
+    for (const auto& d : m_data[0])
+    {
+      m_node_address_for_data.insert_or_assign(d, address);
+    }
+  }
+
+  void insert_into_node(size_t index, const detail::node_address& address, U data)
+  {
+    while (true)
+    {
+      if (!m_addresses[index].contains(address))
+      {
+        // move the node into a new container node that also contains the address
+        const auto container_address = get_container(m_addresses[index], address);
+        const auto container_quadrant =
+          get_quadrant(container_address, m_addresses[index]);
+        assert(container_quadrant.has_value());
+
+        const auto first_child = allocate_block();
+        for (size_t i = 0; i < 8; ++i)
+        {
+          set_node(first_child + i, get_child(container_address, i), no_children, {});
+        }
+        move_node(index, first_child + *container_quadrant);
+        set_node(index, container_address, first_child, {});
+      }
+
+      assert(m_addresses[index].contains(address));
+      const auto quadrant = get_quadrant(m_addresses[index], address);
+      if (!quadrant)
+      {
+        m_data[index].push_back(std::move(data));
+        return;
+      }
+
+      if (is_inner_node(index))
+      {
+        index = m_first_child[index] + *quadrant;
+      }
+      else if (m_data[index].empty())
+      {
+        set_node(index, address, no_children, {});
+        m_data[index].push_back(std::move(data));
+        return;
+      }
+      else
+      {
+        auto leaf_data = std::move(m_data[index]);
+        make_inner_node(index, m_addresses[index], std::move(leaf_data));
+      }
+    }
+  }
+
+  void remove_from_node(
+    const size_t index, const detail::node_address& address, const U& data)
+  {
+    if (is_inner_node(index))
+    {
+      const auto first_child = m_first_child[index];
+      if (const auto quadrant = get_quadrant(m_addresses[index], address))
+      {
+        remove_from_node(first_child + *quadrant, address, data);
+      }
+      else
+      {
+        auto& node_data = m_data[index];
+        const auto i_data = std::find(node_data.begin(), node_data.end(), data);
+        assert(i_data != node_data.end());
+        node_data.erase(i_data);
+      }
+
+      if (!is_root(m_addresses[index]))
+      {
+        const auto is_non_empty_child = [&](const auto i) {
+          return is_inner_node(i) || !m_data[i].empty();
+        };
+
+        auto num_non_empty_children = size_t(0);
+        auto non_empty_child = no_children;
+        for (size_t i = first_child; i < first_child + 8; ++i)
+        {
+          if (is_non_empty_child(i))
+          {
+            ++num_non_empty_children;
+            non_empty_child = i;
+          }
+        }
+
+        if (num_non_empty_children == 0)
+        {
+          m_first_child[index] = no_children;
+          free_block(first_child);
+        }
+        else if (num_non_empty_children == 1 && m_data[index].empty())
+        {
+          move_node(non_empty_child, index);
+          free_block(first_child);
+        }
+      }
+    }
+    else
+    {
+      auto& node_data = m_data[index];
+      const auto i_data = std::find(node_data.begin(), node_data.end(), data);
+      assert(i_data != node_data.end());
+      node_data.erase(i_data);
+    }
+  }
+
+  template <typename Visitor, typename Predicate, typename ChildrenPredicate>
+  void visit_nodes_if(
+    const Visitor& visitor,
+    const Predicate& predicate,
+    const ChildrenPredicate& children_predicate) const
+  {
+    if (empty() || !predicate(m_bounds[0]))
+    {
+      return;
+    }
+
+    auto stack = std::vector<size_t>{0};
+    while (!stack.empty())
+    {
+      const auto index = stack.back();
+      stack.pop_back();
+
+      visitor(m_data[index]);
+      if (is_inner_node(index))
+      {
+        // push the children in reverse order so that they are visited in order
+        const auto children = children_predicate(index);
+        for (size_t i = 8; i > 0; --i)
+        {
+          if (children & (std::uint32_t(1) << (i - 1)))
+          {
+            stack.push_back(m_first_child[index] + i - 1);
+          }
+        }
+      }
+    }
+  }
+
+  template <typename Query, typename Predicate, typename ChildrenPredicate>
+  std::vector<std::vector<U>> find_batched(
+    const std::vector<Query>& queries,
+    const Predicate& predicate,
+    const ChildrenPredicate& children_predicate) const
+  {
+    auto result = std::vector<std::vector<U>>(queries.size());
+    if (empty())
+    {
+      return result;
+    }
+
+    // The queries that hit a node are stored as a range in this buffer. When visiting an
+    // inner node, the queries that hit each of its children are appended as a new range.
+    auto query_indices = std::vector<size_t>{};
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+      if (predicate(queries[i], m_bounds[0]))
+      {
+        query_indices.push_back(i);
+      }
+    }
+
+    auto children = std::vector<std::uint32_t>{};
+    auto stack =
+      std::vector<std::tuple<size_t, size_t, size_t>>{{0, 0, query_indices.size()}};
+    while (!stack.empty())
+    {
+      const auto [index, begin, end] = stack.back();
+      stack.pop_back();
+
+      const auto& data = m_data[index];
+      for (size_t i = begin; i < end; ++i)
+      {
+        auto& query_result = result[query_indices[i]];
+        query_result.insert(query_result.end(), data.begin(), data.end());
+      }
+
+      if (is_inner_node(index))
+      {
+        children.clear();
+        for (size_t i = begin; i < end; ++i)
+        {
+          children.push_back(children_predicate(queries[query_indices[i]], index));
+        }
+
+        // push the children in reverse order so that they are visited in order
+        for (size_t c = 8; c > 0; --c)
+        {
+          const auto child_begin = query_indices.size();
+          for (size_t i = begin; i < end; ++i)
+          {
+            if (children[i - begin] & (std::uint32_t(1) << (c - 1)))
+            {
+              query_indices.push_back(query_indices[i]);
+            }
+          }
+
+          const auto child_end = query_indices.size();
+          if (child_begin != child_end)
+          {
+            stack.emplace_back(m_first_child[index] + c - 1, child_begin, child_end);
+          }
+        }
+      }
+    }
+
+    return result;
+  }
 
-private:
   void check(const vm::bbox<T, 3>& bounds) const
   {
     if (vm::is_nan(bounds.min) || vm::is_nan(bounds.max))
@@ -30,7 +30,11 @@
 #include "render/BrushRendererArrays.h"
 #include "render/BrushRendererBrushCache.h"
 #include "render/RenderContext.h"
+#include "render/ViewFrustum.h"
 
+#include "kdl/vector_utils.h"
+
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <vector>
@@ -184,8 +188,13 @@ void BrushRenderer::invalidate()
   m_invalidBrushes = m_allBrushes;
 
   assert(m_brushInfo.empty());
-  assert(m_transparentFaces->empty());
-  assert(m_opaqueFaces->empty());
+  assert(std::ranges::all_of(m_chunks, [](const auto& entry) {
+    const auto& chunk = entry.second;
+    return chunk.transparentFaces->empty() && chunk.opaqueFaces->empty();
+  }));
+
+  // discard the chunks so that their bounds are recomputed
+  m_chunks.clear();
 }
 
 void BrushRenderer::invalidateMaterials(
@@ -233,15 +242,13 @@ void BrushRenderer::clear()
   m_allBrushes.clear();
   m_invalidBrushes.clear();
 
+  m_chunks.clear();
+
   m_vertexArray = std::make_shared<BrushVertexArray>();
-  m_edgeIndices = std::make_shared<BrushIndexArray>();
-  m_transparentFaces = std::make_shared<MaterialToBrushIndicesMap>();
-  m_opaqueFaces = std::make_shared<MaterialToBrushIndicesMap>();
 
-  m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
-  m_transparentFaceRenderer =
-    FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
-  m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
+  m_opaqueFaceRenderer = FaceRenderer{};
+  m_transparentFaceRenderer = FaceRenderer{};
+  m_edgeRenderer = IndexedEdgeRenderer{};
 }
 
 void BrushRenderer::setFaceColor(const Color& faceColor)
@@ -325,13 +332,15 @@ void BrushRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& rend
     {
       validate();
     }
+
+    const auto chunks = visibleChunks(ViewFrustum{renderContext.camera()});
     if (renderContext.showFaces())
     {
-      renderOpaqueFaces(renderBatch);
+      renderOpaqueFaces(chunks, renderBatch);
     }
     if (renderContext.showEdges() || m_showEdges)
     {
-      renderEdges(renderBatch);
+      renderEdges(chunks, renderBatch);
     }
   }
 }
@@ -347,21 +356,40 @@ void BrushRenderer::renderTransparent(
     }
     if (renderContext.showFaces())
     {
-      renderTransparentFaces(renderBatch);
+      renderTransparentFaces(
+        visibleChunks(ViewFrustum{renderContext.camera()}), renderBatch);
     }
   }
 }
 
-void BrushRenderer::renderOpaqueFaces(RenderBatch& renderBatch)
+void BrushRenderer::renderOpaqueFaces(
+  const std::vector<const Chunk*>& visibleChunks, RenderBatch& renderBatch)
 {
+  m_opaqueFaceRenderer = FaceRenderer{
+    m_vertexArray,
+    kdl::vec_transform(
+      visibleChunks,
+      [](const auto* chunk) {
+        return std::shared_ptr<const MaterialToBrushIndicesMap>{chunk->opaqueFaces};
+      }),
+    m_faceColor};
   m_opaqueFaceRenderer.setGrayscale(m_grayscale);
   m_opaqueFaceRenderer.setTint(m_tint);
   m_opaqueFaceRenderer.setTintColor(m_tintColor);
   m_opaqueFaceRenderer.render(renderBatch);
 }
 
-void BrushRenderer::renderTransparentFaces(RenderBatch& renderBatch)
+void BrushRenderer::renderTransparentFaces(
+  const std::vector<const Chunk*>& visibleChunks, RenderBatch& renderBatch)
 {
+  m_transparentFaceRenderer = FaceRenderer{
+    m_vertexArray,
+    kdl::vec_transform(
+      visibleChunks,
+      [](const auto* chunk) {
+        return std::shared_ptr<const MaterialToBrushIndicesMap>{chunk->transparentFaces};
+      }),
+    m_faceColor};
   m_transparentFaceRenderer.setGrayscale(m_grayscale);
   m_transparentFaceRenderer.setTint(m_tint);
   m_transparentFaceRenderer.setTintColor(m_tintColor);
@@ -369,8 +397,13 @@ void BrushRenderer::renderTransparentFaces(RenderBatch& renderBatch)
   m_transparentFaceRenderer.render(renderBatch);
 }
 
-void BrushRenderer::renderEdges(RenderBatch& renderBatch)
+void BrushRenderer::renderEdges(
+  const std::vector<const Chunk*>& visibleChunks, RenderBatch& renderBatch)
 {
+  m_edgeRenderer = IndexedEdgeRenderer{
+    m_vertexArray,
+    kdl::vec_transform(
+      visibleChunks, [](const auto* chunk) { return chunk->edgeIndices; })};
   if (m_showOccludedEdges)
   {
     m_edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
@@ -378,6 +411,20 @@ void BrushRenderer::renderEdges(RenderBatch& renderBatch)
   m_edgeRenderer.render(renderBatch, m_edgeColor);
 }
 
+std::vector<const BrushRenderer::Chunk*> BrushRenderer::visibleChunks(
+  const ViewFrustum& frustum) const
+{
+  auto result = std::vector<const Chunk*>{};
+  for (const auto& [position, chunk] : m_chunks)
+  {
+    if (frustum.intersects(chunk.bounds))
+    {
+      result.push_back(&chunk);
+    }
+  }
+  return result;
+}
+
 void BrushRenderer::validate()
 {
   assert(!valid());
@@ -388,11 +435,12 @@ void BrushRenderer::validate()
   }
   m_invalidBrushes.clear();
   assert(valid());
+}
 
-  m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
-  m_transparentFaceRenderer =
-    FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
-  m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
+std::tuple<size_t, size_t> BrushRenderer::countVisibleChunks(
+  const ViewFrustum& frustum) const
+{
+  return {m_chunks.size(), visibleChunks(frustum).size()};
 }
 
 static size_t triIndicesCountForPolygon(const size_t vertexCount)
@@ -529,6 +577,8 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
   }
 
   BrushInfo& info = m_brushInfo[&brushNode];
+  info.chunk = &findOrCreateChunk(vm::bbox3f{brushNode.physicalBounds()});
+  auto& chunk = *info.chunk;
 
   // collect vertices
   auto& brushCache = brushNode.brushRendererBrushCache();
@@ -550,7 +600,7 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
     if (edgeIndexCount > 0)
     {
       auto [key, insertDest] =
-        m_edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
+        chunk.edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
       info.edgeIndicesKey = key;
       getMarkedEdgeIndices(brushNode, edgePolicy, brushVerticesStartIndex, insertDest);
     }
@@ -603,7 +653,7 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
 
     if (transparentIndexCount > 0)
     {
-      auto& faceVboMap = *m_transparentFaces;
+      auto& faceVboMap = *chunk.transparentFaces;
       auto& holderPtr = faceVboMap[material];
       if (holderPtr == nullptr)
       {
@@ -638,7 +688,7 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
 
     if (opaqueIndexCount > 0)
     {
-      auto& faceVboMap = *m_opaqueFaces;
+      auto& faceVboMap = *chunk.opaqueFaces;
       auto& holderPtr = faceVboMap[material];
       if (holderPtr == nullptr)
       {
@@ -672,6 +722,25 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
   }
 }
 
+BrushRenderer::Chunk& BrushRenderer::findOrCreateChunk(const vm::bbox3f& bounds)
+{
+  const auto position = vm::vec3i{vm::floor(bounds.center() / ChunkSize)};
+  auto [it, inserted] = m_chunks.try_emplace(position);
+  auto& chunk = it->second;
+  if (inserted)
+  {
+    chunk.bounds = bounds;
+    chunk.edgeIndices = std::make_shared<BrushIndexArray>();
+    chunk.transparentFaces = std::make_shared<MaterialToBrushIndicesMap>();
+    chunk.opaqueFaces = std::make_shared<MaterialToBrushIndicesMap>();
+  }
+  else
+  {
+    chunk.bounds = vm::merge(chunk.bounds, bounds);
+  }
+  return chunk;
+}
+
 void BrushRenderer::addBrush(const mdl::BrushNode* brushNode)
 {
   // i.e. insert the brush as "invalid" if it's not already present.
@@ -710,36 +779,37 @@ void BrushRenderer::removeBrushFromVbo(const mdl::BrushNode& brushNode)
   }
 
   const auto& info = it->second;
+  auto& chunk = *info.chunk;
 
   // update Vbo's
   m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
   if (info.edgeIndicesKey != nullptr)
   {
-    m_edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
+    chunk.edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
   }
 
   for (const auto& [material, opaqueKey] : info.opaqueFaceIndicesKeys)
   {
-    auto faceIndexHolder = m_opaqueFaces->at(material);
+    auto faceIndexHolder = chunk.opaqueFaces->at(material);
     faceIndexHolder->zeroElementsWithKey(opaqueKey);
 
     if (!faceIndexHolder->hasValidIndices())
     {
       // There are no indices left to render for this material, so delete the <Material,
       // BrushIndexArray> entry from the map
-      m_opaqueFaces->erase(material);
+      chunk.opaqueFaces->erase(material);
     }
   }
   for (const auto& [material, transparentKey] : info.transparentFaceIndicesKeys)
   {
-    auto faceIndexHolder = m_transparentFaces->at(material);
+    auto faceIndexHolder = chunk.transparentFaces->at(material);
     faceIndexHolder->zeroElementsWithKey(transparentKey);
 
     if (!faceIndexHolder->hasValidIndices())
     {
       // There are no indices left to render for this material, so delete the <Material,
       // BrushIndexArray> entry from the map
-      m_transparentFaces->erase(material);
+      chunk.transparentFaces->erase(material);
     }
   }
 
@@ -26,6 +26,10 @@
 #include "render/EdgeRenderer.h"
 #include "render/FaceRenderer.h"
 
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <map>
 #include <memory>
 #include <tuple>
 #include <unordered_map>
@@ -41,6 +45,7 @@ class EditorContext;
 
 namespace tb::render
 {
+class ViewFrustum;
 
 class BrushRenderer
 {
@@ -119,8 +124,35 @@ public:
 private:
   std::unique_ptr<Filter> m_filter;
 
+  using MaterialToBrushIndicesMap =
+    std::unordered_map<const mdl::Material*, std::shared_ptr<BrushIndexArray>>;
+
+  /**
+   * Brushes are grouped into cubic chunks of this size by the centers of their bounds.
+   */
+  static constexpr auto ChunkSize = 2048.0f;
+
+  /**
+   * Every chunk has its own index arrays so that chunks outside of the view frustum can
+   * be skipped when rendering. All chunks share the vertex array.
+   */
+  struct Chunk
+  {
+    /**
+     * The union of the bounds of all brushes that were added to this chunk since it was
+     * created. This may be larger than necessary if brushes were removed again.
+     */
+    vm::bbox3f bounds;
+    std::shared_ptr<BrushIndexArray> edgeIndices;
+    std::shared_ptr<MaterialToBrushIndicesMap> transparentFaces;
+    std::shared_ptr<MaterialToBrushIndicesMap> opaqueFaces;
+  };
+
+  std::map<vm::vec3i, Chunk> m_chunks;
+
   struct BrushInfo
   {
+    Chunk* chunk;
     AllocationTracker::Block* vertexHolderKey;
     AllocationTracker::Block* edgeIndicesKey;
     std::vector<std::pair<const mdl::Material*, AllocationTracker::Block*>>
@@ -144,12 +176,6 @@ private:
   std::unordered_set<const mdl::BrushNode*> m_invalidBrushes;
 
   std::shared_ptr<BrushVertexArray> m_vertexArray;
-  std::shared_ptr<BrushIndexArray> m_edgeIndices;
-
-  using MaterialToBrushIndicesMap =
-    std::unordered_map<const mdl::Material*, std::shared_ptr<BrushIndexArray>>;
-  std::shared_ptr<MaterialToBrushIndicesMap> m_transparentFaces;
-  std::shared_ptr<MaterialToBrushIndicesMap> m_opaqueFaces;
 
   FaceRenderer m_opaqueFaceRenderer;
   FaceRenderer m_transparentFaceRenderer;
@@ -193,9 +219,8 @@ public:
    * Until a brush is invalidated, we don't re-evaluate the Filter, and don't check the
    * Brush object for modification.
    *
-   * Additionally, calling `invalidate()` guarantees the m_brushInfo, m_transparentFaces,
-   * and m_opaqueFaces maps will be empty, so the BrushRenderer will not have any
-   * lingering Material* pointers.
+   * Additionally, calling `invalidate()` guarantees the m_brushInfo and m_chunks maps
+   * will be empty, so the BrushRenderer will not have any lingering Material* pointers.
    */
   void invalidate();
   void invalidateMaterials(const std::vector<const mdl::Material*>& materials);
@@ -276,9 +301,14 @@ public: // rendering
   void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
 
 private:
-  void renderOpaqueFaces(RenderBatch& renderBatch);
-  void renderTransparentFaces(RenderBatch& renderBatch);
-  void renderEdges(RenderBatch& renderBatch);
+  void renderOpaqueFaces(
+    const std::vector<const Chunk*>& visibleChunks, RenderBatch& renderBatch);
+  void renderTransparentFaces(
+    const std::vector<const Chunk*>& visibleChunks, RenderBatch& renderBatch);
+  void renderEdges(
+    const std::vector<const Chunk*>& visibleChunks, RenderBatch& renderBatch);
+
+  std::vector<const Chunk*> visibleChunks(const ViewFrustum& frustum) const;
 
 public:
   /**
@@ -286,9 +316,16 @@ public:
    */
   void validate();
 
+  /**
+   * Returns the number of chunks and the number of chunks that intersect the given
+   * frustum. Only exposed for testing.
+   */
+  std::tuple<size_t, size_t> countVisibleChunks(const ViewFrustum& frustum) const;
+
 private:
   bool shouldDrawFaceInTransparentPass(
     const mdl::BrushNode& brushNode, const mdl::BrushFace& face) const;
+  Chunk& findOrCreateChunk(const vm::bbox3f& bounds);
   void validateBrush(const mdl::BrushNode& brushNode);
 
 public:
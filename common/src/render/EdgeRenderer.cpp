@@ -29,6 +29,8 @@
 #include "render/RenderUtils.h"
 #include "render/Shaders.h"
 
+#include <algorithm>
+
 namespace tb::render
 {
 
@@ -226,22 +228,27 @@ void DirectEdgeRenderer::doRender(
 IndexedEdgeRenderer::Render::Render(
   const EdgeRenderer::Params& params,
   std::shared_ptr<BrushVertexArray> vertexArray,
-  std::shared_ptr<BrushIndexArray> indexArray)
+  std::vector<std::shared_ptr<BrushIndexArray>> indexArrays)
   : RenderBase{params}
   , m_vertexArray{std::move(vertexArray)}
-  , m_indexArray{std::move(indexArray)}
+  , m_indexArrays{std::move(indexArrays)}
 {
 }
 
 void IndexedEdgeRenderer::Render::prepareVerticesAndIndices(VboManager& vboManager)
 {
   m_vertexArray->prepare(vboManager);
-  m_indexArray->prepare(vboManager);
+  for (auto& indexArray : m_indexArrays)
+  {
+    indexArray->prepare(vboManager);
+  }
 }
 
 void IndexedEdgeRenderer::Render::doRender(RenderContext& renderContext)
 {
-  if (m_indexArray->hasValidIndices())
+  if (std::ranges::any_of(m_indexArrays, [](const auto& indexArray) {
+        return indexArray->hasValidIndices();
+      }))
   {
     renderEdges(renderContext);
   }
@@ -250,10 +257,16 @@ void IndexedEdgeRenderer::Render::doRender(RenderContext& renderContext)
 void IndexedEdgeRenderer::Render::doRenderVertices(RenderContext&)
 {
   m_vertexArray->setupVertices();
-  m_indexArray->setupIndices();
-  m_indexArray->render(PrimType::Lines);
+  for (auto& indexArray : m_indexArrays)
+  {
+    if (indexArray->hasValidIndices())
+    {
+      indexArray->setupIndices();
+      indexArray->render(PrimType::Lines);
+      indexArray->cleanupIndices();
+    }
+  }
   m_vertexArray->cleanupVertices();
-  m_indexArray->cleanupIndices();
 }
 
 // IndexedEdgeRenderer
@@ -262,16 +275,16 @@ IndexedEdgeRenderer::IndexedEdgeRenderer() = default;
 
 IndexedEdgeRenderer::IndexedEdgeRenderer(
   std::shared_ptr<BrushVertexArray> vertexArray,
-  std::shared_ptr<BrushIndexArray> indexArray)
+  std::vector<std::shared_ptr<BrushIndexArray>> indexArrays)
   : m_vertexArray{std::move(vertexArray)}
-  , m_indexArray{std::move(indexArray)}
+  , m_indexArrays{std::move(indexArrays)}
 {
 }
 
 void IndexedEdgeRenderer::doRender(
   RenderBatch& renderBatch, const EdgeRenderer::Params& params)
 {
-  renderBatch.addOneShot(new Render{params, m_vertexArray, m_indexArray});
+  renderBatch.addOneShot(new Render{params, m_vertexArray, m_indexArrays});
 }
 
 } // namespace tb::render
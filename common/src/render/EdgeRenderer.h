@@ -25,6 +25,7 @@
 #include "render/VertexArray.h"
 
 #include <memory>
+#include <vector>
 
 namespace tb::render
 {
@@ -146,13 +147,13 @@ private:
   {
   private:
     std::shared_ptr<BrushVertexArray> m_vertexArray;
-    std::shared_ptr<BrushIndexArray> m_indexArray;
+    std::vector<std::shared_ptr<BrushIndexArray>> m_indexArrays;
 
   public:
     Render(
       const Params& params,
       std::shared_ptr<BrushVertexArray> vertexArray,
-      std::shared_ptr<BrushIndexArray> indexArray);
+      std::vector<std::shared_ptr<BrushIndexArray>> indexArrays);
 
   private:
     void prepareVerticesAndIndices(VboManager& vboManager) override;
@@ -162,13 +163,17 @@ private:
 
 private:
   std::shared_ptr<BrushVertexArray> m_vertexArray;
-  std::shared_ptr<BrushIndexArray> m_indexArray;
+  std::vector<std::shared_ptr<BrushIndexArray>> m_indexArrays;
 
 public:
   IndexedEdgeRenderer();
+
+  /**
+   * Renders the edges given by the indices of all of the given index arrays.
+   */
   IndexedEdgeRenderer(
     std::shared_ptr<BrushVertexArray> vertexArray,
-    std::shared_ptr<BrushIndexArray> indexArray);
+    std::vector<std::shared_ptr<BrushIndexArray>> indexArrays);
 
 private:
   void doRender(RenderBatch& renderBatch, const EdgeRenderer::Params& params) override;
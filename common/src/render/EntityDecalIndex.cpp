@@ -0,0 +1,141 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityDecalIndex.h"
+
+#include "mdl/BrushNode.h"
+#include "mdl/EntityNode.h"
+
+#include "kdl/vector_utils.h"
+
+#include <algorithm>
+
+namespace tb::render
+{
+namespace
+{
+// decals are usually small, so we use a smaller cell size than the world's node tree
+constexpr auto EntityTreeMinSize = 64.0;
+
+const auto NoBrushes = std::vector<const mdl::BrushNode*>{};
+} // namespace
+
+EntityDecalIndex::EntityDecalIndex()
+  : m_entityTree{EntityTreeMinSize}
+{
+}
+
+bool EntityDecalIndex::contains(const mdl::EntityNode* entityNode) const
+{
+  return m_entityTree.contains(entityNode);
+}
+
+void EntityDecalIndex::addOrUpdateEntity(const mdl::EntityNode* entityNode)
+{
+  if (m_entityTree.contains(entityNode))
+  {
+    m_entityTree.update(entityNode->physicalBounds(), entityNode);
+  }
+  else
+  {
+    m_entityTree.insert(entityNode->physicalBounds(), entityNode);
+  }
+}
+
+void EntityDecalIndex::removeEntity(const mdl::EntityNode* entityNode)
+{
+  clearBrushes(entityNode);
+  m_entityTree.remove(entityNode);
+}
+
+const std::vector<const mdl::BrushNode*>& EntityDecalIndex::brushes(
+  const mdl::EntityNode* entityNode) const
+{
+  const auto it = m_brushesByEntity.find(entityNode);
+  return it != m_brushesByEntity.end() ? it->second : NoBrushes;
+}
+
+void EntityDecalIndex::setBrushes(
+  const mdl::EntityNode* entityNode, std::vector<const mdl::BrushNode*> brushes)
+{
+  clearBrushes(entityNode);
+
+  for (const auto* brushNode : brushes)
+  {
+    m_entitiesByBrush[brushNode].push_back(entityNode);
+  }
+
+  if (!brushes.empty())
+  {
+    m_brushesByEntity.emplace(entityNode, std::move(brushes));
+  }
+}
+
+void EntityDecalIndex::clearBrushes(const mdl::EntityNode* entityNode)
+{
+  const auto it = m_brushesByEntity.find(entityNode);
+  if (it == m_brushesByEntity.end())
+  {
+    return;
+  }
+
+  for (const auto* brushNode : it->second)
+  {
+    if (const auto eIt = m_entitiesByBrush.find(brushNode);
+        eIt != m_entitiesByBrush.end())
+    {
+      auto& entityNodes = eIt->second;
+      entityNodes = kdl::vec_erase(std::move(entityNodes), entityNode);
+      if (entityNodes.empty())
+      {
+        m_entitiesByBrush.erase(eIt);
+      }
+    }
+  }
+
+  m_brushesByEntity.erase(it);
+}
+
+std::vector<const mdl::EntityNode*> EntityDecalIndex::findAffectedEntities(
+  const mdl::BrushNode* brushNode, const bool includeIntersecting) const
+{
+  auto result = std::vector<const mdl::EntityNode*>{};
+
+  if (includeIntersecting)
+  {
+    m_entityTree.find_intersectors(
+      brushNode->physicalBounds(), std::back_inserter(result));
+  }
+
+  if (const auto it = m_entitiesByBrush.find(brushNode); it != m_entitiesByBrush.end())
+  {
+    result.insert(result.end(), it->second.begin(), it->second.end());
+  }
+
+  return kdl::vec_sort_and_remove_duplicates(std::move(result));
+}
+
+void EntityDecalIndex::clear()
+{
+  m_entityTree.clear();
+  m_brushesByEntity.clear();
+  m_entitiesByBrush.clear();
+}
+
+} // namespace tb::render
@@ -0,0 +1,110 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "octree.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace tb::mdl
+{
+class BrushNode;
+class EntityNode;
+} // namespace tb::mdl
+
+namespace tb::render
+{
+
+/**
+ * Spatial index for decal entities and the brushes that their decals are projected onto.
+ *
+ * The decal entities are stored in an octree by their physical bounds, and for every
+ * entity, the index tracks the brushes its decal geometry was computed from. This allows
+ * finding the decals that are affected by a brush change without visiting every decal.
+ */
+class EntityDecalIndex
+{
+private:
+  using EntityTree = octree<double, const mdl::EntityNode*>;
+
+  EntityTree m_entityTree;
+  std::unordered_map<const mdl::EntityNode*, std::vector<const mdl::BrushNode*>>
+    m_brushesByEntity;
+  std::unordered_map<const mdl::BrushNode*, std::vector<const mdl::EntityNode*>>
+    m_entitiesByBrush;
+
+public:
+  EntityDecalIndex();
+
+  /**
+   * Indicates whether the given entity is in this index.
+   */
+  bool contains(const mdl::EntityNode* entityNode) const;
+
+  /**
+   * Adds the given entity to this index or updates its bounds if it is already in this
+   * index.
+   */
+  void addOrUpdateEntity(const mdl::EntityNode* entityNode);
+
+  /**
+   * Removes the given entity and its tracked brushes from this index. Calling with an
+   * unknown entity is allowed, but ignored.
+   */
+  void removeEntity(const mdl::EntityNode* entityNode);
+
+  /**
+   * Returns the brushes tracked by the given entity.
+   */
+  const std::vector<const mdl::BrushNode*>& brushes(
+    const mdl::EntityNode* entityNode) const;
+
+  /**
+   * Replaces the brushes tracked by the given entity.
+   */
+  void setBrushes(
+    const mdl::EntityNode* entityNode, std::vector<const mdl::BrushNode*> brushes);
+
+  /**
+   * Clears the brushes tracked by the given entity.
+   */
+  void clearBrushes(const mdl::EntityNode* entityNode);
+
+  /**
+   * Returns the entities whose decals might be affected by a change to the given brush.
+   * These are the entities whose bounds intersect the current bounds of the given brush
+   * and the entities that track the given brush. Every entity is returned at most once,
+   * and callers must still perform an exact intersection test if necessary.
+   *
+   * @param brushNode the brush node to check
+   * @param includeIntersecting whether to include entities that intersect the brush
+   * bounds; if false, only the entities tracking the brush are returned
+   */
+  std::vector<const mdl::EntityNode*> findAffectedEntities(
+    const mdl::BrushNode* brushNode, bool includeIntersecting = true) const;
+
+  /**
+   * Removes all entities and brushes from this index.
+   */
+  void clear();
+};
+
+} // namespace tb::render
@@ -154,13 +154,14 @@ void EntityDecalRenderer::invalidate()
 {
   for (auto& [ent, data] : m_entities)
   {
-    invalidateDecalData(data);
+    invalidateDecalData(ent, data);
   }
 }
 
 void EntityDecalRenderer::clear()
 {
   m_entities.clear();
+  m_index.clear();
   m_vertexArray = std::make_shared<BrushVertexArray>();
   m_faces = std::make_shared<MaterialToBrushIndicesMap>();
   m_faceRenderer = FaceRenderer{m_vertexArray, m_faces, m_faceColor};
@@ -203,7 +204,8 @@ void EntityDecalRenderer::updateEntity(const mdl::EntityNode* entityNode)
   if (isTracking && spec)
   {
     // entity is being tracked and has a decal specification, invalidate it
-    invalidateDecalData(entity->second);
+    invalidateDecalData(entityNode, entity->second);
+    m_index.addOrUpdateEntity(entityNode);
   }
   else if (isTracking)
   {
@@ -214,6 +216,7 @@ void EntityDecalRenderer::updateEntity(const mdl::EntityNode* entityNode)
   {
     // entity is not being tracked and has a decal specification, start tracking it
     m_entities.insert({entityNode, EntityDecalData{}});
+    m_index.addOrUpdateEntity(entityNode);
   }
 }
 
@@ -222,34 +225,38 @@ void EntityDecalRenderer::removeEntity(const mdl::EntityNode* entityNode)
   if (const auto it = m_entities.find(entityNode); it != std::end(m_entities))
   {
     // make sure the entity data is cleaned up
-    invalidateDecalData(it->second);
+    invalidateDecalData(entityNode, it->second);
     m_entities.erase(it);
+    m_index.removeEntity(entityNode);
   }
 }
 
 void EntityDecalRenderer::updateBrush(const mdl::BrushNode* brushNode)
 {
+  // if the brush is not visible, then it doesn't (currently) intersect
+  const auto& editorContext = kdl::mem_lock(m_document)->editorContext();
+  const auto visible = editorContext.visible(brushNode);
+
   // invalidate any entities that intersect this brush or are tracking this brush
-  for (auto& [ent, data] : m_entities)
+  for (const auto* entityNode : m_index.findAffectedEntities(brushNode, visible))
   {
+    auto& data = m_entities.at(entityNode);
+
     // skip entities that are going to be recomputed anyway
     if (!data.validated)
     {
       continue;
     }
 
-    // if the brush is not visible, then it doesn't (currently) intersect
-    const auto& editorContext = kdl::mem_lock(m_document)->editorContext();
-    const auto intersects =
-      editorContext.visible(brushNode) && brushNode->intersects(ent);
-    const auto tracked = std::find(data.brushes.begin(), data.brushes.end(), brushNode)
-                         != data.brushes.end();
+    const auto& brushes = m_index.brushes(entityNode);
+    const auto tracked =
+      std::find(brushes.begin(), brushes.end(), brushNode) != brushes.end();
 
     // if this brush is tracked by this entity or intersects, we'll need to
     // recalculate the geometry
-    if (intersects || tracked)
+    if (tracked || (visible && brushNode->intersects(entityNode)))
     {
-      invalidateDecalData(data);
+      invalidateDecalData(entityNode, data);
     }
   }
 }
@@ -257,25 +264,18 @@ void EntityDecalRenderer::updateBrush(const mdl::BrushNode* brushNode)
 void EntityDecalRenderer::removeBrush(const mdl::BrushNode* brushNode)
 {
   // invalidate any entities that are tracking this brush
-  for (auto& [ent, data] : m_entities)
+  for (const auto* entityNode : m_index.findAffectedEntities(brushNode, false))
   {
     // skip entities that are going to be recomputed anyway
-    if (!data.validated)
-    {
-      continue;
-    }
-
-    // if this brush is tracked by this entity, remove it and recalculate
-    const auto tracked = std::find(data.brushes.begin(), data.brushes.end(), brushNode)
-                         != data.brushes.end();
-    if (tracked)
+    if (auto& data = m_entities.at(entityNode); data.validated)
     {
-      invalidateDecalData(data);
+      invalidateDecalData(entityNode, data);
     }
   }
 }
 
-void EntityDecalRenderer::invalidateDecalData(EntityDecalData& data) const
+void EntityDecalRenderer::invalidateDecalData(
+  const mdl::EntityNode* entityNode, EntityDecalData& data)
 {
   // do nothing if the brush data is already marked as invalidated
   if (!data.validated)
@@ -284,6 +284,7 @@ void EntityDecalRenderer::invalidateDecalData(EntityDecalData& data) const
   }
 
   data.validated = false;
+  m_index.clearBrushes(entityNode);
 
   // if the material doesn't exist, do nothing
   // also do nothing if the VBO storage fields are null, but it shouldn't happen
@@ -309,7 +310,7 @@ void EntityDecalRenderer::invalidateDecalData(EntityDecalData& data) const
 }
 
 void EntityDecalRenderer::validateDecalData(
-  const mdl::EntityNode* entityNode, EntityDecalData& data) const
+  const mdl::EntityNode* entityNode, EntityDecalData& data)
 {
   if (data.validated)
   {
@@ -329,15 +330,16 @@ void EntityDecalRenderer::validateDecalData(
   const auto intersectors = world->nodeTree().find_intersectors(entityBounds);
 
   // track them in the entity
-  data.brushes.clear();
+  auto brushes = std::vector<const mdl::BrushNode*>{};
   for (const auto* node : intersectors)
   {
     const auto* brushNode = dynamic_cast<const mdl::BrushNode*>(node);
     if (brushNode && editorContext.visible(brushNode))
     {
-      data.brushes.push_back(brushNode);
+      brushes.push_back(brushNode);
     }
   }
+  m_index.setBrushes(entityNode, std::move(brushes));
 
   data.material = document->materialManager().material(spec->materialName);
   if (!data.material)
@@ -359,7 +361,7 @@ void EntityDecalRenderer::validateDecalData(
   auto vertices = std::vector<Vertex>{};
   auto indices = std::vector<size_t>{};
 
-  for (const auto& brush : data.brushes)
+  for (const auto& brush : m_index.brushes(entityNode))
   {
     for (const auto& face : brush->brush().faces())
     {
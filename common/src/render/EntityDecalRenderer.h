@@ -22,6 +22,7 @@
 #include "Color.h"
 #include "render/AllocationTracker.h"
 #include "render/EdgeRenderer.h"
+#include "render/EntityDecalIndex.h"
 #include "render/FaceRenderer.h"
 #include "render/GLVertexType.h"
 #include "render/Renderable.h"
@@ -53,10 +54,8 @@ class EntityDecalRenderer
 private:
   struct EntityDecalData
   {
-    std::vector<const mdl::BrushNode*> brushes;
-
-    /* will only be true if the brushes array has been calculated since the last change
-     * and the decal geometry is stored in the VBO */
+    /* will only be true if the tracked brushes have been calculated since the last
+     * change and the decal geometry is stored in the VBO */
     bool validated = false;
 
     mdl::Material* material = nullptr;
@@ -70,6 +69,7 @@ private:
 
   std::weak_ptr<ui::MapDocument> m_document;
   EntityWithDependenciesMap m_entities;
+  EntityDecalIndex m_index;
 
   using Vertex = render::GLVertexTypes::P3NT2::Vertex;
   using MaterialToBrushIndicesMap =
@@ -109,9 +109,9 @@ private:
   void updateBrush(const mdl::BrushNode* brushNode);
   void removeBrush(const mdl::BrushNode* brushNode);
 
-  void invalidateDecalData(EntityDecalData& data) const;
+  void invalidateDecalData(const mdl::EntityNode* entityNode, EntityDecalData& data);
 
-  void validateDecalData(const mdl::EntityNode* entityNode, EntityDecalData& data) const;
+  void validateDecalData(const mdl::EntityNode* entityNode, EntityDecalData& data);
 
 public: // rendering
   void render(RenderContext& renderContext, RenderBatch& renderBatch);
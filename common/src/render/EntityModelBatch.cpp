@@ -0,0 +1,53 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EntityModelBatch.h"
+
+namespace tb::render
+{
+
+void EntityModelBatcher::add(
+  MaterialRenderer* renderer,
+  const mdl::Orientation orientation,
+  const vm::mat4x4f& transformation)
+{
+  const auto [it, inserted] = m_batchIndices.emplace(renderer, m_batches.size());
+  if (inserted)
+  {
+    m_batches.push_back(EntityModelBatch{renderer, orientation, {}});
+  }
+  m_batches[it->second].transformations.push_back(transformation);
+}
+
+const std::vector<EntityModelBatch>& EntityModelBatcher::batches() const
+{
+  return m_batches;
+}
+
+size_t EntityModelBatcher::instanceCount() const
+{
+  auto result = size_t(0);
+  for (const auto& batch : m_batches)
+  {
+    result += batch.transformations.size();
+  }
+  return result;
+}
+
+} // namespace tb::render
@@ -0,0 +1,78 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "vm/mat.h"
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace tb::mdl
+{
+enum class Orientation;
+}
+
+namespace tb::render
+{
+class MaterialRenderer;
+
+/**
+ * A group of entity model instances that share a renderer, i.e. that show the same skin
+ * and frame of the same model. The transformations of the instances are stored in one
+ * contiguous buffer.
+ */
+struct EntityModelBatch
+{
+  MaterialRenderer* renderer;
+  mdl::Orientation orientation;
+  std::vector<vm::mat4x4f> transformations;
+};
+
+/**
+ * Groups entity model instances into batches so that every batch can be rendered while
+ * its vertex arrays and materials stay bound. The batches are kept in the order in which
+ * their first instance was added.
+ */
+class EntityModelBatcher
+{
+private:
+  std::vector<EntityModelBatch> m_batches;
+  std::unordered_map<const MaterialRenderer*, size_t> m_batchIndices;
+
+public:
+  /**
+   * Adds an instance of the given renderer with the given transformation. The given
+   * orientation is only used if this is the renderer's first instance.
+   */
+  void add(
+    MaterialRenderer* renderer,
+    mdl::Orientation orientation,
+    const vm::mat4x4f& transformation);
+
+  const std::vector<EntityModelBatch>& batches() const;
+
+  /**
+   * Returns the total number of instances in all batches.
+   */
+  size_t instanceCount() const;
+};
+
+} // namespace tb::render
@@ -28,15 +28,19 @@
 #include "mdl/EntityModel.h"
 #include "mdl/EntityModelManager.h"
 #include "mdl/EntityNode.h"
+#include "mdl/ModelSpecification.h"
+#include "mdl/Resource.h"
 #include "render/ActiveShader.h"
 #include "render/Camera.h"
+#include "render/EntityModelBatch.h"
 #include "render/MaterialIndexRangeRenderer.h"
 #include "render/RenderBatch.h"
 #include "render/RenderContext.h"
 #include "render/RenderUtils.h"
 #include "render/Shaders.h"
-#include "render/Transformation.h"
+#include "render/ViewFrustum.h"
 
+#include "vm/bbox.h"
 #include "vm/mat.h"
 
 #include <vector>
@@ -71,11 +75,14 @@ void EntityModelRenderer::addEntity(const mdl::EntityNode* entityNode)
   {
     m_entities.emplace(entityNode, renderer);
   }
+
+  updatePendingEntity(entityNode, modelSpec);
 }
 
 void EntityModelRenderer::removeEntity(const mdl::EntityNode* entityNode)
 {
   m_entities.erase(entityNode);
+  m_pendingEntities.erase(entityNode);
 }
 
 void EntityModelRenderer::updateEntity(const mdl::EntityNode* entityNode)
@@ -88,6 +95,8 @@ void EntityModelRenderer::updateEntity(const mdl::EntityNode* entityNode)
   auto* renderer = m_entityModelManager.renderer(modelSpec);
   auto it = m_entities.find(entityNode);
 
+  updatePendingEntity(entityNode, modelSpec);
+
   if (renderer == nullptr && it == std::end(m_entities))
   {
     return;
@@ -113,6 +122,7 @@ void EntityModelRenderer::updateEntity(const mdl::EntityNode* entityNode)
 void EntityModelRenderer::clear()
 {
   m_entities.clear();
+  m_pendingEntities.clear();
 }
 
 bool EntityModelRenderer::applyTinting() const
@@ -150,14 +160,86 @@ void EntityModelRenderer::render(RenderBatch& renderBatch)
   renderBatch.add(this);
 }
 
+void EntityModelRenderer::updatePendingEntity(
+  const mdl::EntityNode* entityNode, const mdl::ModelSpecification& modelSpec)
+{
+  const auto* model = entityNode->entity().model();
+  if (model && !model->data() && model->dataResource().needsProcessing())
+  {
+    m_pendingEntities[entityNode] = modelSpec.path;
+  }
+  else
+  {
+    m_pendingEntities.erase(entityNode);
+  }
+}
+
+void EntityModelRenderer::requestVisibleModels(const ViewFrustum& frustum)
+{
+  // the entity renderer draws the bounds of these entities until their models are loaded
+  for (const auto& [entityNode, modelPath] : m_pendingEntities)
+  {
+    if (
+      (m_showHiddenEntities || m_editorContext.visible(entityNode))
+      && frustum.intersects(vm::bbox3f{entityNode->physicalBounds()}))
+    {
+      m_entityModelManager.requestModel(modelPath);
+    }
+  }
+}
+
 void EntityModelRenderer::doPrepareVertices(VboManager& vboManager)
 {
   m_entityModelManager.prepare(vboManager);
 }
 
+EntityModelBatcher EntityModelRenderer::batchVisibleEntities(
+  const ViewFrustum& frustum) const
+{
+  auto batcher = EntityModelBatcher{};
+  if (m_entities.empty())
+  {
+    return batcher;
+  }
+
+  const auto& propertyConfig = m_entities.begin()->first->entityPropertyConfig();
+  const auto& defaultModelScaleExpression = propertyConfig.defaultModelScaleExpression;
+
+  for (const auto& [entityNode, renderer] : m_entities)
+  {
+    if (!m_showHiddenEntities && !m_editorContext.visible(entityNode))
+    {
+      continue;
+    }
+
+    if (!frustum.intersects(vm::bbox3f{entityNode->physicalBounds()}))
+    {
+      continue;
+    }
+
+    const auto* model = entityNode->entity().model();
+    const auto* modelData = model ? model->data() : nullptr;
+    if (!modelData)
+    {
+      continue;
+    }
+
+    batcher.add(
+      renderer,
+      modelData->orientation(),
+      vm::mat4x4f{entityNode->entity().modelTransformation(defaultModelScaleExpression)});
+  }
+
+  return batcher;
+}
+
 void EntityModelRenderer::doRender(RenderContext& renderContext)
 {
-  if (!m_entities.empty())
+  const auto frustum = ViewFrustum{renderContext.camera()};
+  requestVisibleModels(frustum);
+
+  const auto batcher = batchVisibleEntities(frustum);
+  if (!batcher.batches().empty())
   {
     auto& prefs = PreferenceManager::instance();
 
@@ -187,35 +269,18 @@ void EntityModelRenderer::doRender(RenderContext& renderContext)
     shader.set("CameraUp", renderContext.camera().up());
     shader.set("ViewMatrix", renderContext.camera().viewMatrix());
 
-    const auto& propertyConfig = m_entities.begin()->first->entityPropertyConfig();
-    const auto& defaultModelScaleExpression = propertyConfig.defaultModelScaleExpression;
-
-    for (const auto& [entityNode, renderer] : m_entities)
+    // the shader ignores the fixed function model view matrix, so only the model matrix
+    // uniform changes between instances
+    for (const auto& batch : batcher.batches())
     {
-      if (!m_showHiddenEntities && !m_editorContext.visible(entityNode))
-      {
-        continue;
-      }
-
-      const auto* model = entityNode->entity().model();
-      const auto* modelData = model ? model->data() : nullptr;
-      if (!modelData)
-      {
-        continue;
-      }
-
-      shader.set("Orientation", static_cast<int>(modelData->orientation()));
-
-      const auto transformation = vm::mat4x4f{
-        entityNode->entity().modelTransformation(defaultModelScaleExpression)};
-      const auto multMatrix =
-        MultiplyModelMatrix{renderContext.transformation(), transformation};
-
-      shader.set("ModelMatrix", transformation);
+      shader.set("Orientation", static_cast<int>(batch.orientation));
 
       auto renderFunc = DefaultMaterialRenderFunc{
         renderContext.minFilterMode(), renderContext.magFilterMode()};
-      renderer->render(renderFunc);
+      batch.renderer->renderInstances(
+        renderFunc, batch.transformations.size(), [&](const size_t i) {
+          shader.set("ModelMatrix", batch.transformations[i]);
+        });
     }
   }
 }
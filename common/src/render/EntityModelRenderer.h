@@ -22,6 +22,7 @@
 #include "Color.h"
 #include "render/Renderable.h"
 
+#include <filesystem>
 #include <unordered_map>
 
 namespace tb
@@ -34,13 +35,16 @@ namespace tb::mdl
 class EditorContext;
 class EntityModelManager;
 class EntityNode;
+struct ModelSpecification;
 } // namespace tb::mdl
 
 namespace tb::render
 {
+class EntityModelBatcher;
 class RenderBatch;
 struct ShaderConfig;
 class MaterialRenderer;
+class ViewFrustum;
 
 class EntityModelRenderer : public DirectRenderable
 {
@@ -52,6 +56,9 @@ private:
 
   std::unordered_map<const mdl::EntityNode*, MaterialRenderer*> m_entities;
 
+  // entities whose models are still loading, mapped to the model paths
+  std::unordered_map<const mdl::EntityNode*, std::filesystem::path> m_pendingEntities;
+
   bool m_applyTinting = false;
   Color m_tintColor;
 
@@ -107,6 +114,11 @@ public:
   void render(RenderBatch& renderBatch);
 
 private:
+  void updatePendingEntity(
+    const mdl::EntityNode* entityNode, const mdl::ModelSpecification& modelSpec);
+  void requestVisibleModels(const ViewFrustum& frustum);
+  EntityModelBatcher batchVisibleEntities(const ViewFrustum& frustum) const;
+
   void doPrepareVertices(VboManager& vboManager) override;
   void doRender(RenderContext& renderContext) override;
 };
@@ -32,6 +32,11 @@
 #include "render/RenderUtils.h"
 #include "render/Shaders.h"
 
+#include <algorithm>
+#include <functional>
+#include <tuple>
+#include <vector>
+
 namespace tb::render
 {
 
@@ -94,8 +99,16 @@ FaceRenderer::FaceRenderer(
   std::shared_ptr<BrushVertexArray> vertexArray,
   std::shared_ptr<MaterialToBrushIndicesMap> indexArrayMap,
   const Color& faceColor)
+  : FaceRenderer{std::move(vertexArray), std::vector{std::move(indexArrayMap)}, faceColor}
+{
+}
+
+FaceRenderer::FaceRenderer(
+  std::shared_ptr<BrushVertexArray> vertexArray,
+  std::vector<std::shared_ptr<MaterialToBrushIndicesMap>> indexArrayMaps,
+  const Color& faceColor)
   : m_vertexArray{std::move(vertexArray)}
-  , m_indexArrayMap{std::move(indexArrayMap)}
+  , m_indexArrayMaps{std::move(indexArrayMaps)}
   , m_faceColor{faceColor}
 {
 }
@@ -129,16 +142,35 @@ void FaceRenderer::prepareVerticesAndIndices(VboManager& vboManager)
 {
   m_vertexArray->prepare(vboManager);
 
-  for (const auto& [material, brushIndexHolderPtr] : *m_indexArrayMap)
+  for (const auto& indexArrayMap : m_indexArrayMaps)
   {
-    brushIndexHolderPtr->prepare(vboManager);
+    for (const auto& [material, brushIndexHolderPtr] : *indexArrayMap)
+    {
+      brushIndexHolderPtr->prepare(vboManager);
+    }
   }
 }
 
 void FaceRenderer::doRender(RenderContext& context)
 {
-  if (!m_indexArrayMap->empty() && m_vertexArray->setupVertices())
+  auto indexArrays = std::vector<std::tuple<const mdl::Material*, BrushIndexArray*>>{};
+  for (const auto& indexArrayMap : m_indexArrayMaps)
   {
+    for (const auto& [material, brushIndexHolderPtr] : *indexArrayMap)
+    {
+      if (brushIndexHolderPtr->hasValidIndices())
+      {
+        indexArrays.emplace_back(material, brushIndexHolderPtr.get());
+      }
+    }
+  }
+
+  if (!indexArrays.empty() && m_vertexArray->setupVertices())
+  {
+    std::ranges::stable_sort(indexArrays, std::less<>{}, [](const auto& entry) {
+      return std::get<0>(entry);
+    });
+
     auto& shaderManager = context.shaderManager();
     auto shader = ActiveShader{shaderManager, Shaders::FaceShader};
     auto& prefs = PreferenceManager::instance();
@@ -184,23 +216,25 @@ void FaceRenderer::doRender(RenderContext& context)
     {
       glAssert(glDepthMask(GL_FALSE));
     }
-    for (const auto& [material, brushIndexHolderPtr] : *m_indexArrayMap)
+    for (auto it = indexArrays.begin(); it != indexArrays.end();)
     {
-      if (brushIndexHolderPtr->hasValidIndices())
+      const auto* material = std::get<0>(*it);
+      const auto* texture = getTexture(material);
+      const auto enableMasked = texture && texture->mask() == mdl::TextureMask::On;
+
+      // set any per-material uniforms
+      shader.set("GridColor", gridColorForMaterial(material));
+      shader.set("EnableMasked", enableMasked);
+
+      func.before(material);
+      for (; it != indexArrays.end() && std::get<0>(*it) == material; ++it)
       {
-        const auto* texture = getTexture(material);
-        const auto enableMasked = texture && texture->mask() == mdl::TextureMask::On;
-
-        // set any per-material uniforms
-        shader.set("GridColor", gridColorForMaterial(material));
-        shader.set("EnableMasked", enableMasked);
-
-        func.before(material);
-        brushIndexHolderPtr->setupIndices();
-        brushIndexHolderPtr->render(PrimType::Triangles);
-        brushIndexHolderPtr->cleanupIndices();
-        func.after(material);
+        auto* brushIndexHolder = std::get<1>(*it);
+        brushIndexHolder->setupIndices();
+        brushIndexHolder->render(PrimType::Triangles);
+        brushIndexHolder->cleanupIndices();
       }
+      func.after(material);
     }
     if (m_alpha < 1.0f)
     {
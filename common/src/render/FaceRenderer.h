@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace tb::mdl
 {
@@ -43,7 +44,7 @@ private:
     const std::unordered_map<const mdl::Material*, std::shared_ptr<BrushIndexArray>>;
 
   std::shared_ptr<BrushVertexArray> m_vertexArray;
-  std::shared_ptr<MaterialToBrushIndicesMap> m_indexArrayMap;
+  std::vector<std::shared_ptr<MaterialToBrushIndicesMap>> m_indexArrayMaps;
   Color m_faceColor;
   bool m_grayscale = false;
   bool m_tint = false;
@@ -57,6 +58,15 @@ public:
     std::shared_ptr<MaterialToBrushIndicesMap> indexArrayMap,
     const Color& faceColor);
 
+  /**
+   * Renders the faces given by the indices of all of the given maps. The faces are
+   * rendered by material, so every material is only activated once.
+   */
+  FaceRenderer(
+    std::shared_ptr<BrushVertexArray> vertexArray,
+    std::vector<std::shared_ptr<MaterialToBrushIndicesMap>> indexArrayMaps,
+    const Color& faceColor);
+
   void setGrayscale(bool grayscale);
   void setTint(bool tint);
   void setTintColor(const Color& color);
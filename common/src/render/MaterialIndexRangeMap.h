@@ -175,6 +175,23 @@ public:
    */
   void render(VertexArray& vertexArray, MaterialRenderFunc& func);
 
+  /**
+   * Renders the primitives stored in this index range map once for each of the given
+   * number of instances. Each material is activated only once, and all instances are
+   * rendered with it before the next material is activated. The given setup function is
+   * called with the index of each instance before it is rendered.
+   *
+   * @param vertexArray the vertex array to render with
+   * @param func the render function to use
+   * @param instanceCount the number of instances to render
+   * @param setupInstance called before each instance is rendered
+   */
+  void render(
+    VertexArray& vertexArray,
+    MaterialRenderFunc& func,
+    size_t instanceCount,
+    const std::function<void(size_t)>& setupInstance);
+
   /**
    * Invokes the given function for each primitive stored in this map.
    *
@@ -0,0 +1,79 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ViewFrustum.h"
+
+#include "render/Camera.h"
+
+#include <utility>
+
+namespace tb::render
+{
+namespace
+{
+
+std::vector<vm::plane3f> frustumPlanes(const Camera& camera)
+{
+  auto topPlane = vm::plane3f{};
+  auto rightPlane = vm::plane3f{};
+  auto bottomPlane = vm::plane3f{};
+  auto leftPlane = vm::plane3f{};
+  camera.frustumPlanes(topPlane, rightPlane, bottomPlane, leftPlane);
+
+  auto result = std::vector<vm::plane3f>{topPlane, rightPlane, bottomPlane, leftPlane};
+  if (camera.perspectiveProjection())
+  {
+    result.emplace_back(
+      camera.position() + camera.direction() * camera.farPlane(), camera.direction());
+  }
+  return result;
+}
+
+} // namespace
+
+ViewFrustum::ViewFrustum(std::vector<vm::plane3f> planes)
+  : m_planes{std::move(planes)}
+{
+}
+
+ViewFrustum::ViewFrustum(const Camera& camera)
+  : ViewFrustum{frustumPlanes(camera)}
+{
+}
+
+bool ViewFrustum::intersects(const vm::bbox3f& bounds) const
+{
+  for (const auto& plane : m_planes)
+  {
+    // the box is outside if even its innermost corner is outside of the plane
+    const auto nearestCorner = vm::vec3f{
+      plane.normal.x() >= 0.0f ? bounds.min.x() : bounds.max.x(),
+      plane.normal.y() >= 0.0f ? bounds.min.y() : bounds.max.y(),
+      plane.normal.z() >= 0.0f ? bounds.min.z() : bounds.max.z(),
+    };
+    if (plane.point_distance(nearestCorner) > 0.0f)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace tb::render
@@ -0,0 +1,64 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "vm/bbox.h"
+#include "vm/plane.h"
+
+#include <vector>
+
+namespace tb::render
+{
+class Camera;
+
+/**
+ * The region of space that is visible to a camera. It is used to skip geometry on the
+ * CPU before it is sent to the GPU.
+ *
+ * The frustum is bounded by the camera's top, right, bottom and left planes. For a
+ * perspective camera, it is also bounded by the far plane, which limits the draw
+ * distance. An orthographic frustum is unbounded along the viewing direction.
+ */
+class ViewFrustum
+{
+private:
+  std::vector<vm::plane3f> m_planes;
+
+public:
+  /**
+   * Creates a frustum bounded by the given planes, whose normals must point outward.
+   */
+  explicit ViewFrustum(std::vector<vm::plane3f> planes);
+
+  /**
+   * Creates the frustum of the given camera.
+   */
+  explicit ViewFrustum(const Camera& camera);
+
+  /**
+   * Indicates whether any part of the given box might be visible. The test is
+   * conservative: a box that lies outside of the frustum near one of its edges may still
+   * be reported as visible.
+   */
+  bool intersects(const vm::bbox3f& bounds) const;
+};
+
+} // namespace tb::render
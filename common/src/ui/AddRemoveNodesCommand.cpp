@@ -21,6 +21,7 @@
 
 #include "Ensure.h"
 #include "Macros.h"
+#include "mdl/CompactNodeContents.h"
 #include "mdl/Node.h"
 #include "ui/MapDocumentCommandFacade.h"
 
@@ -71,6 +72,13 @@ AddRemoveNodesCommand::AddRemoveNodesCommand(
     break;
     switchDefault();
   }
+
+  updateMemoryUsage();
+}
+
+size_t AddRemoveNodesCommand::memoryUsage() const
+{
+  return UpdateLinkedGroupsCommandBase::memoryUsage() + m_memoryUsage;
 }
 
 std::string AddRemoveNodesCommand::makeName(const Action action)
@@ -113,6 +121,7 @@ void AddRemoveNodesCommand::doAction(MapDocumentCommandFacade& document)
 
   using std::swap;
   swap(m_nodesToAdd, m_nodesToRemove);
+  updateMemoryUsage();
 }
 
 void AddRemoveNodesCommand::undoAction(MapDocumentCommandFacade& document)
@@ -129,6 +138,21 @@ void AddRemoveNodesCommand::undoAction(MapDocumentCommandFacade& document)
 
   using std::swap;
   swap(m_nodesToAdd, m_nodesToRemove);
+  updateMemoryUsage();
+}
+
+void AddRemoveNodesCommand::updateMemoryUsage()
+{
+  // Only the nodes to add are owned by this command, the nodes to remove are owned by
+  // the document.
+  m_memoryUsage = 0;
+  for (const auto& [parent, children] : m_nodesToAdd)
+  {
+    for (const auto* child : children)
+    {
+      m_memoryUsage += mdl::memoryUsage(*child);
+    }
+  }
 }
 
 } // namespace tb::ui
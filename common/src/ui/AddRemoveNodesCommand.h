@@ -45,6 +45,7 @@ private:
   Action m_action;
   std::map<mdl::Node*, std::vector<mdl::Node*>> m_nodesToAdd;
   std::map<mdl::Node*, std::vector<mdl::Node*>> m_nodesToRemove;
+  size_t m_memoryUsage = 0;
 
 public:
   static std::unique_ptr<AddRemoveNodesCommand> add(
@@ -58,6 +59,8 @@ public:
     Action action, const std::map<mdl::Node*, std::vector<mdl::Node*>>& nodes);
   ~AddRemoveNodesCommand() override;
 
+  size_t memoryUsage() const override;
+
 private:
   static std::string makeName(Action action);
 
@@ -67,6 +70,7 @@ private:
 
   void doAction(MapDocumentCommandFacade& document);
   void undoAction(MapDocumentCommandFacade& document);
+  void updateMemoryUsage();
 
   deleteCopyAndMove(AddRemoveNodesCommand);
 };
@@ -37,6 +37,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <ostream>
 
 namespace tb::ui
 {
@@ -143,6 +144,16 @@ Autosaver::Autosaver(
 
 void Autosaver::triggerAutosave(Logger& logger)
 {
+  if (m_pendingBackup.valid())
+  {
+    if (m_pendingBackup.wait_for(std::chrono::seconds{0}) != std::future_status::ready)
+    {
+      // try again once the previous backup has been written
+      return;
+    }
+    waitForPendingAutosave(logger);
+  }
+
   if (!kdl::mem_expired(m_document))
   {
     auto document = kdl::mem_lock(m_document);
@@ -175,15 +186,37 @@ void Autosaver::autosave(Logger& logger, std::shared_ptr<MapDocument> document)
                           return fs.makeAbsolute(makeBackupName(mapBasename, backupNo));
                         });
              });
-  }) | kdl::transform([&](const auto& backupFilePath) {
+  }) | kdl::transform([&](auto backupFilePath) {
     m_lastSaveTime = Clock::now();
     m_lastModificationCount = document->modificationCount();
-    document->saveDocumentTo(backupFilePath);
 
-    logger.info() << "Created autosave backup at " << backupFilePath;
+    // Only serializing the document must happen on this thread, writing the file can
+    // happen in the background.
+    m_pendingBackup = std::async(
+      std::launch::async,
+      [backupFilePath = std::move(backupFilePath),
+       contents = document->serializeDocument(m_entityTextCache)]() {
+        return io::Disk::withOutputStream(
+                 backupFilePath, [&](auto& stream) { stream << contents; })
+               | kdl::transform([&]() { return backupFilePath; });
+      });
   }) | kdl::transform_error([&](auto e) {
     logger.error() << "Aborting autosave: " << e.msg;
   });
 }
 
+void Autosaver::waitForPendingAutosave(Logger& logger)
+{
+  if (m_pendingBackup.valid())
+  {
+    m_pendingBackup.get()
+      | kdl::transform([&](const auto& backupFilePath) {
+          logger.info() << "Created autosave backup at " << backupFilePath;
+        })
+      | kdl::transform_error([&](auto e) {
+          logger.error() << "Could not write autosave backup: " << e.msg;
+        });
+  }
+}
+
 } // namespace tb::ui
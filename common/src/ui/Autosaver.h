@@ -19,10 +19,13 @@
 
 #pragma once
 
+#include "Result.h"
+#include "io/EntityTextCache.h"
 #include "io/PathMatcher.h"
 
 #include <chrono>
 #include <filesystem>
+#include <future>
 #include <memory>
 
 namespace tb
@@ -65,6 +68,18 @@ private:
    */
   size_t m_lastModificationCount;
 
+  /**
+   * Keeps the serialized text of entities between autosaves so that only the entities
+   * that have changed since the last autosave must be serialized again.
+   */
+  io::EntityTextCache m_entityTextCache;
+
+  /**
+   * The backup that is currently being written on a background thread. The destructor of
+   * the future waits for the backup to be written.
+   */
+  std::future<Result<std::filesystem::path>> m_pendingBackup;
+
 public:
   explicit Autosaver(
     std::weak_ptr<MapDocument> document,
@@ -73,6 +88,12 @@ public:
 
   void triggerAutosave(Logger& logger);
 
+  /**
+   * Waits until the backup that is currently being written, if any, has been written
+   * and logs the outcome.
+   */
+  void waitForPendingAutosave(Logger& logger);
+
 private:
   void autosave(Logger& logger, std::shared_ptr<ui::MapDocument> document);
 };
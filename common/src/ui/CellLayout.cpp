@@ -21,6 +21,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <utility>
 
 namespace tb::ui
 {
@@ -444,42 +446,30 @@ const std::vector<LayoutRow>& LayoutGroup::rows() const
   return m_rows;
 }
 
-size_t LayoutGroup::indexOfRowAt(const float y) const
+std::span<const LayoutRow> LayoutGroup::rowsIntersectingY(
+  const float y, const float height) const
 {
-  for (size_t i = 0; i < m_rows.size(); ++i)
-  {
-    const auto& row = m_rows[i];
-    const auto& rowBounds = row.bounds();
-    if (y < rowBounds.bottom())
-    {
-      return i;
-    }
-  }
+  // rows are ordered by their vertical position and don't overlap
+  const auto first = std::ranges::partition_point(
+    m_rows, [&](const auto& row) { return row.bounds().bottom() < y; });
+  const auto last = std::partition_point(first, m_rows.end(), [&](const auto& row) {
+    return row.bounds().top() <= y + height;
+  });
+  return {first, last};
+}
 
-  return m_rows.size();
+size_t LayoutGroup::indexOfRowAt(const float y) const
+{
+  const auto it = std::ranges::partition_point(
+    m_rows, [&](const auto& row) { return row.bounds().bottom() <= y; });
+  return size_t(std::distance(m_rows.begin(), it));
 }
 
 const LayoutCell* LayoutGroup::cellAt(const float x, const float y) const
 {
-  for (size_t i = 0; i < m_rows.size(); ++i)
-  {
-    const auto& row = m_rows[i];
-    const auto& rowBounds = row.bounds();
-    if (y > rowBounds.bottom())
-    {
-      continue;
-    }
-    if (y < rowBounds.top())
-    {
-      return nullptr;
-    }
-    if (const auto* cell = row.cellAt(x, y))
-    {
-      return cell;
-    }
-  }
-
-  return nullptr;
+  const auto it = std::ranges::partition_point(
+    m_rows, [&](const auto& row) { return row.bounds().bottom() < y; });
+  return it != m_rows.end() && y >= it->bounds().top() ? it->cellAt(x, y) : nullptr;
 }
 
 bool LayoutGroup::hitTest(const float x, const float y) const
@@ -556,6 +546,41 @@ void LayoutGroup::addItem(
     m_contentBounds.height + (newRowHeight - oldRowHeight)};
 }
 
+size_t LayoutGroup::truncate(const size_t itemIndex)
+{
+  auto firstRemovedItem = size_t(0);
+  auto rowIt = m_rows.begin();
+  while (rowIt != m_rows.end() && firstRemovedItem + rowIt->cells().size() <= itemIndex)
+  {
+    firstRemovedItem += rowIt->cells().size();
+    ++rowIt;
+  }
+  m_rows.erase(rowIt, m_rows.end());
+
+  const auto contentHeight =
+    m_rows.empty() ? 0.0f : m_rows.back().bounds().bottom() - m_contentBounds.top();
+  m_contentBounds = LayoutBounds{
+    m_contentBounds.left(), m_contentBounds.top(), m_contentBounds.width, contentHeight};
+
+  return firstRemovedItem;
+}
+
+std::vector<LayoutCell> LayoutGroup::takeCells()
+{
+  auto cells = std::vector<LayoutCell>{};
+  for (auto& row : m_rows)
+  {
+    cells.insert(
+      cells.end(),
+      std::make_move_iterator(row.m_cells.begin()),
+      std::make_move_iterator(row.m_cells.end()));
+  }
+  m_rows.clear();
+  m_contentBounds = LayoutBounds{
+    m_contentBounds.left(), m_contentBounds.top(), m_contentBounds.width, 0.0f};
+  return cells;
+}
+
 CellLayout::CellLayout(const size_t maxCellsPerRow)
   : m_maxCellsPerRow{maxCellsPerRow}
 {
@@ -902,6 +927,30 @@ void CellLayout::addItem(
   m_height += (newGroupHeight - oldGroupHeight);
 }
 
+size_t CellLayout::truncate(const size_t groupIndex, const size_t itemIndex)
+{
+  if (!m_valid)
+  {
+    validate();
+  }
+
+  assert(groupIndex < m_groups.size());
+
+  for (auto i = m_groups.size() - 1; i > groupIndex; --i)
+  {
+    m_height -= m_groups[i].bounds().height + m_groupMargin;
+  }
+  m_groups.erase(m_groups.begin() + std::ptrdiff_t(groupIndex) + 1, m_groups.end());
+
+  auto& group = m_groups.back();
+  const auto oldGroupHeight = group.bounds().height;
+  const auto firstRemovedItem = group.truncate(itemIndex);
+  const auto newGroupHeight = group.bounds().height;
+
+  m_height -= (oldGroupHeight - newGroupHeight);
+  return firstRemovedItem;
+}
+
 void CellLayout::clear()
 {
   m_groups.clear();
@@ -919,29 +968,25 @@ void CellLayout::validate()
   m_valid = true;
   if (!m_groups.empty())
   {
-    auto copy = m_groups;
-    m_groups.clear();
+    auto groups = std::exchange(m_groups, {});
 
-    for (auto& group : copy)
+    for (auto& group : groups)
     {
       addGroup(group.title(), group.titleBounds().height);
-      for (const auto& row : group.rows())
+      for (auto& cell : group.takeCells())
       {
-        for (const auto& cell : row.cells())
-        {
-          const auto& itemBounds = cell.itemBounds();
-          const auto& titleBounds = cell.titleBounds();
-          const auto scale = cell.scale();
-          const auto itemWidth = itemBounds.width / scale;
-          const auto itemHeight = itemBounds.height / scale;
-          addItem(
-            cell.item(),
-            cell.title(),
-            itemWidth,
-            itemHeight,
-            titleBounds.width,
-            titleBounds.height);
-        }
+        const auto& itemBounds = cell.itemBounds();
+        const auto& titleBounds = cell.titleBounds();
+        const auto scale = cell.scale();
+        const auto itemWidth = itemBounds.width / scale;
+        const auto itemHeight = itemBounds.height / scale;
+        addItem(
+          std::move(cell.item()),
+          cell.title(),
+          itemWidth,
+          itemHeight,
+          titleBounds.width,
+          titleBounds.height);
       }
     }
   }
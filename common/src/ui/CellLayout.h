@@ -20,6 +20,7 @@
 #pragma once
 
 #include <any>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -124,6 +125,8 @@ private:
 
   std::vector<LayoutCell> m_cells;
 
+  friend class LayoutGroup;
+
 public:
   LayoutRow(
     float x,
@@ -216,6 +219,12 @@ public:
   LayoutBounds bounds() const;
 
   const std::vector<LayoutRow>& rows() const;
+
+  /**
+   * Returns the rows that intersect the given vertical range.
+   */
+  std::span<const LayoutRow> rowsIntersectingY(float y, float height) const;
+
   size_t indexOfRowAt(float y) const;
   const LayoutCell* cellAt(float x, float y) const;
 
@@ -229,6 +238,18 @@ public:
     float itemHeight,
     float titleWidth,
     float titleHeight);
+
+  /**
+   * Removes the row that contains the item with the given index and all rows after it.
+   *
+   * @return the index of the first removed item
+   */
+  size_t truncate(size_t itemIndex);
+
+  /**
+   * Removes all rows and returns their cells.
+   */
+  std::vector<LayoutCell> takeCells();
 };
 
 class CellLayout
@@ -303,6 +324,17 @@ public:
     float titleWidth,
     float titleHeight);
 
+  /**
+   * Removes the items of the given group starting at the row that contains the item with
+   * the given index, and all groups after the given group. Items and groups added
+   * afterwards are laid out after the remaining items, so a caller that changes only
+   * some items can re-add them starting at the returned index instead of rebuilding the
+   * entire layout.
+   *
+   * @return the index of the first removed item of the given group
+   */
+  size_t truncate(size_t groupIndex, size_t itemIndex);
+
   void clear();
 
 private:
@@ -119,6 +119,10 @@ private:
   void renderTitleStrings(float y, float height);
 
   virtual void doInitLayout(Layout& layout) = 0;
+  /**
+   * Adds the cells to the layout. The layout still contains the cells that were added
+   * by the previous call, so implementations must either clear it or update it.
+   */
   virtual void doReloadLayout(Layout& layout) = 0;
   virtual void doClear();
   virtual void doRender(Layout& layout, float y, float height) = 0;
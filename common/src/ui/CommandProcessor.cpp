@@ -131,6 +131,16 @@ private:
 
     return false;
   }
+
+  size_t memoryUsage() const override
+  {
+    auto result = UndoableCommand::memoryUsage();
+    for (const auto& command : m_commands)
+    {
+      result += command->memoryUsage();
+    }
+    return result;
+  }
 };
 
 } // namespace
@@ -162,9 +172,12 @@ struct CommandProcessor::SubmitAndStoreResult
 };
 
 CommandProcessor::CommandProcessor(
-  MapDocumentCommandFacade& document, const std::chrono::milliseconds collationInterval)
+  MapDocumentCommandFacade& document,
+  const std::chrono::milliseconds collationInterval,
+  const std::optional<size_t> memoryBudget)
   : m_document{document}
   , m_collationInterval{collationInterval}
+  , m_memoryBudget{memoryBudget}
   , m_lastCommandTimestamp{std::chrono::time_point<std::chrono::system_clock>{}}
 {
 }
@@ -201,6 +214,17 @@ const std::string& CommandProcessor::redoCommandName() const
   return m_redoStack.back()->name();
 }
 
+size_t CommandProcessor::memoryUsage() const
+{
+  return m_memoryUsage;
+}
+
+void CommandProcessor::setMemoryBudget(const std::optional<size_t> memoryBudget)
+{
+  m_memoryBudget = memoryBudget;
+  enforceMemoryBudget();
+}
+
 void CommandProcessor::startTransaction(std::string name, const TransactionScope scope)
 {
   m_transactionStack.emplace_back(std::move(name), scope);
@@ -247,6 +271,7 @@ std::unique_ptr<CommandResult> CommandProcessor::execute(std::unique_ptr<Command
   {
     m_undoStack.clear();
     m_redoStack.clear();
+    m_memoryUsage = 0;
   }
   return result;
 }
@@ -305,6 +330,7 @@ void CommandProcessor::clear()
 
   m_undoStack.clear();
   m_redoStack.clear();
+  m_memoryUsage = 0;
   m_lastCommandTimestamp = std::chrono::time_point<std::chrono::system_clock>();
 }
 
@@ -317,8 +343,8 @@ CommandProcessor::SubmitAndStoreResult CommandProcessor::executeAndStoreCommand(
     return {std::move(commandResult), false};
   }
 
+  clearRedoStack();
   const auto commandStored = storeCommand(std::move(command), collate);
-  m_redoStack.clear();
   return {std::move(commandResult), commandStored};
 }
 
@@ -435,13 +461,18 @@ bool CommandProcessor::pushToUndoStack(
   if (collatable(collate, timestamp))
   {
     auto& lastCommand = m_undoStack.back();
+    const auto lastMemoryUsage = lastCommand->memoryUsage();
     if (lastCommand->collateWith(*command))
     {
+      m_memoryUsage = m_memoryUsage - lastMemoryUsage + lastCommand->memoryUsage();
+      enforceMemoryBudget();
       return false;
     }
   }
 
+  m_memoryUsage += command->memoryUsage();
   m_undoStack.push_back(std::move(command));
+  enforceMemoryBudget();
   return true;
 }
 
@@ -450,7 +481,9 @@ std::unique_ptr<UndoableCommand> CommandProcessor::popFromUndoStack()
   assert(m_transactionStack.empty());
   assert(!m_undoStack.empty());
 
-  return kdl::vec_pop_back(m_undoStack);
+  auto command = kdl::vec_pop_back(m_undoStack);
+  m_memoryUsage -= command->memoryUsage();
+  return command;
 }
 
 bool CommandProcessor::collatable(
@@ -460,9 +493,28 @@ bool CommandProcessor::collatable(
          && timestamp - m_lastCommandTimestamp <= m_collationInterval;
 }
 
+void CommandProcessor::enforceMemoryBudget()
+{
+  if (!m_memoryBudget || m_undoStack.empty())
+  {
+    return;
+  }
+
+  auto first = m_undoStack.begin();
+  const auto last = std::prev(m_undoStack.end());
+  while (m_memoryUsage > *m_memoryBudget && first != last)
+  {
+    m_memoryUsage -= (*first)->memoryUsage();
+    ++first;
+  }
+
+  m_undoStack.erase(m_undoStack.begin(), first);
+}
+
 void CommandProcessor::pushToRedoStack(std::unique_ptr<UndoableCommand> command)
 {
   assert(m_transactionStack.empty());
+  m_memoryUsage += command->memoryUsage();
   m_redoStack.push_back(std::move(command));
 }
 
@@ -471,7 +523,18 @@ std::unique_ptr<UndoableCommand> CommandProcessor::popFromRedoStack()
   assert(m_transactionStack.empty());
   assert(!m_redoStack.empty());
 
-  return kdl::vec_pop_back(m_redoStack);
+  auto command = kdl::vec_pop_back(m_redoStack);
+  m_memoryUsage -= command->memoryUsage();
+  return command;
+}
+
+void CommandProcessor::clearRedoStack()
+{
+  for (const auto& command : m_redoStack)
+  {
+    m_memoryUsage -= command->memoryUsage();
+  }
+  m_redoStack.clear();
 }
 
 } // namespace tb::ui
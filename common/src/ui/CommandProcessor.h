@@ -23,6 +23,7 @@
 
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -51,6 +52,10 @@ enum class TransactionScope;
  * The command processor supports nested transactions. Each transaction can be committed
  * or rolled back individually. Committing a nested transaction adds it as a command to
  * the containing transaction.
+ *
+ * If the command processor has a memory budget, then the oldest commands are removed from
+ * the undo stack whenever the memory used by the undo and redo stacks exceeds the budget.
+ * The most recently executed command is never removed.
  */
 class CommandProcessor
 {
@@ -65,6 +70,11 @@ private:
    */
   std::chrono::milliseconds m_collationInterval;
 
+  /**
+   * The maximum number of bytes that the undo and redo stacks may use, if any.
+   */
+  std::optional<size_t> m_memoryBudget;
+
   /**
    * Holds the commands that were executed so far, with the most recently executed command
    * at the end of the vector.
@@ -77,6 +87,12 @@ private:
    */
   std::vector<std::unique_ptr<UndoableCommand>> m_redoStack;
 
+  /**
+   * An estimate of the number of bytes used by the commands on the undo and redo stacks.
+   * Updated whenever a command is added to or removed from either stack.
+   */
+  size_t m_memoryUsage = 0;
+
   /**
    * The time stamp of when the last command was executed.
    */
@@ -97,10 +113,13 @@ public:
    * they are executed or undone.
    *
    * @param document the document to pass to commands, may be null
+   * @param collationInterval the maximum time between two collatable commands
+   * @param memoryBudget the maximum number of bytes the undo and redo stacks may use
    */
   explicit CommandProcessor(
     MapDocumentCommandFacade& document,
-    std::chrono::milliseconds collationInterval = std::chrono::milliseconds{1000});
+    std::chrono::milliseconds collationInterval = std::chrono::milliseconds{1000},
+    std::optional<size_t> memoryBudget = std::nullopt);
 
   ~CommandProcessor();
 
@@ -165,6 +184,20 @@ public:
    */
   const std::string& redoCommandName() const;
 
+  /**
+   * Returns an estimate of the number of bytes used by the commands on the undo and redo
+   * stacks.
+   */
+  size_t memoryUsage() const;
+
+  /**
+   * Sets the maximum number of bytes the undo and redo stacks may use and immediately
+   * removes the oldest commands from the undo stack if they exceed the new budget.
+   *
+   * @param memoryBudget the new memory budget, or std::nullopt to remove the budget
+   */
+  void setMemoryBudget(std::optional<size_t> memoryBudget);
+
   /**
    * Starts a new transaction. If a transaction is currently executing, then the newly
    * started transaction becomes a nested transaction and will be added as a command to
@@ -373,6 +406,13 @@ private:
 
   bool collatable(bool collate, std::chrono::system_clock::time_point timestamp) const;
 
+  /**
+   * Removes the oldest commands from the undo stack until the memory used by the undo and
+   * redo stacks does not exceed the memory budget anymore, or until only one command is
+   * left on the undo stack.
+   */
+  void enforceMemoryBudget();
+
   /**
    * Pushes the given command onto the redo stack. Takes ownership of the given command.
    *
@@ -388,6 +428,11 @@ private:
    * @return the topmost command of the redo stack
    */
   std::unique_ptr<UndoableCommand> popFromRedoStack();
+
+  /**
+   * Removes all commands from the redo stack.
+   */
+  void clearRedoStack();
 };
 
 } // namespace tb::ui
@@ -77,20 +77,45 @@ QWidget* IssueBrowser::createTabBarPage(QWidget* parent)
 void IssueBrowser::connectObservers()
 {
   auto document = kdl::mem_lock(m_document);
+  m_notifierConnection += document->documentWillBeClearedNotifier.connect(
+    this, &IssueBrowser::documentWillBeCleared);
   m_notifierConnection +=
     document->documentWasSavedNotifier.connect(this, &IssueBrowser::documentWasSaved);
   m_notifierConnection += document->documentWasNewedNotifier.connect(
     this, &IssueBrowser::documentWasNewedOrLoaded);
   m_notifierConnection += document->documentWasLoadedNotifier.connect(
     this, &IssueBrowser::documentWasNewedOrLoaded);
+  m_notifierConnection +=
+    document->commandDoNotifier.connect(this, &IssueBrowser::commandDo);
+  m_notifierConnection +=
+    document->commandUndoNotifier.connect(this, &IssueBrowser::commandUndo);
   m_notifierConnection +=
     document->nodesWereAddedNotifier.connect(this, &IssueBrowser::nodesWereAdded);
+  m_notifierConnection += document->nodesWillBeRemovedNotifier.connect(
+    this, &IssueBrowser::nodesWillBeRemoved);
   m_notifierConnection +=
     document->nodesWereRemovedNotifier.connect(this, &IssueBrowser::nodesWereRemoved);
+  m_notifierConnection +=
+    document->nodesWillChangeNotifier.connect(this, &IssueBrowser::nodesWillChange);
   m_notifierConnection +=
     document->nodesDidChangeNotifier.connect(this, &IssueBrowser::nodesDidChange);
   m_notifierConnection += document->brushFacesDidChangeNotifier.connect(
     this, &IssueBrowser::brushFacesDidChange);
+  m_notifierConnection += document->materialCollectionsWillChangeNotifier.connect(
+    this, &IssueBrowser::resourcesWillChange);
+  m_notifierConnection += document->entityDefinitionsWillChangeNotifier.connect(
+    this, &IssueBrowser::resourcesWillChange);
+  m_notifierConnection +=
+    document->modsWillChangeNotifier.connect(this, &IssueBrowser::resourcesWillChange);
+  m_notifierConnection += document->resourceProcessingWillStartNotifier.connect(
+    this, &IssueBrowser::resourceProcessingWillStart);
+  m_notifierConnection += document->resourceProcessingDidFinishNotifier.connect(
+    this, &IssueBrowser::resourceProcessingDidFinish);
+}
+
+void IssueBrowser::documentWillBeCleared(MapDocument*)
+{
+  m_view->documentWillChange();
 }
 
 void IssueBrowser::documentWasNewedOrLoaded(MapDocument*)
@@ -101,7 +126,18 @@ void IssueBrowser::documentWasNewedOrLoaded(MapDocument*)
 
 void IssueBrowser::documentWasSaved(MapDocument*)
 {
-  m_view->update();
+  // saving updates the line numbers of the nodes and their issues
+  m_view->reload();
+}
+
+void IssueBrowser::commandDo(Command&)
+{
+  m_view->documentWillChange();
+}
+
+void IssueBrowser::commandUndo(UndoableCommand&)
+{
+  m_view->documentWillChange();
 }
 
 void IssueBrowser::nodesWereAdded(const std::vector<mdl::Node*>&)
@@ -109,11 +145,21 @@ void IssueBrowser::nodesWereAdded(const std::vector<mdl::Node*>&)
   m_view->reload();
 }
 
+void IssueBrowser::nodesWillBeRemoved(const std::vector<mdl::Node*>&)
+{
+  m_view->documentWillChange();
+}
+
 void IssueBrowser::nodesWereRemoved(const std::vector<mdl::Node*>&)
 {
   m_view->reload();
 }
 
+void IssueBrowser::nodesWillChange(const std::vector<mdl::Node*>&)
+{
+  m_view->documentWillChange();
+}
+
 void IssueBrowser::nodesDidChange(const std::vector<mdl::Node*>&)
 {
   m_view->reload();
@@ -129,6 +175,22 @@ void IssueBrowser::issueIgnoreChanged(mdl::Issue*)
   m_view->update();
 }
 
+void IssueBrowser::resourcesWillChange()
+{
+  m_view->documentWillChange();
+}
+
+void IssueBrowser::resourceProcessingWillStart()
+{
+  // processing resources updates the materials and the face tags
+  m_view->pauseValidation();
+}
+
+void IssueBrowser::resourceProcessingDidFinish()
+{
+  m_view->resumeValidation();
+}
+
 void IssueBrowser::updateFilterFlags()
 {
   auto document = kdl::mem_lock(m_document);
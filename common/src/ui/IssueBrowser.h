@@ -38,9 +38,11 @@ class Node;
 
 namespace tb::ui
 {
+class Command;
 class FlagsPopupEditor;
 class IssueBrowserView;
 class MapDocument;
+class UndoableCommand;
 
 class IssueBrowser : public TabBookPage
 {
@@ -65,13 +67,21 @@ public:
 
 private:
   void connectObservers();
+  void documentWillBeCleared(MapDocument* document);
   void documentWasNewedOrLoaded(MapDocument* document);
   void documentWasSaved(MapDocument* document);
+  void commandDo(Command& command);
+  void commandUndo(UndoableCommand& command);
   void nodesWereAdded(const std::vector<mdl::Node*>& nodes);
+  void nodesWillBeRemoved(const std::vector<mdl::Node*>& nodes);
   void nodesWereRemoved(const std::vector<mdl::Node*>& nodes);
+  void nodesWillChange(const std::vector<mdl::Node*>& nodes);
   void nodesDidChange(const std::vector<mdl::Node*>& nodes);
   void brushFacesDidChange(const std::vector<mdl::BrushFaceHandle>& faces);
   void issueIgnoreChanged(mdl::Issue* issue);
+  void resourcesWillChange();
+  void resourceProcessingWillStart();
+  void resourceProcessingDidFinish();
 
   void updateFilterFlags();
 
@@ -31,6 +31,7 @@
 #include "mdl/Issue.h"
 #include "mdl/IssueQuickFix.h"
 #include "mdl/LayerNode.h"
+#include "mdl/ModelUtils.h"
 #include "mdl/PatchNode.h"
 #include "mdl/WorldNode.h"
 #include "ui/MapDocument.h"
@@ -39,13 +40,73 @@
 
 #include "kdl/memory_utils.h"
 #include "kdl/overload.h"
+#include "kdl/task_manager.h"
 #include "kdl/vector_set.h"
 #include "kdl/vector_utils.h"
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 namespace tb::ui
 {
+namespace
+{
+
+// the number of nodes to validate before checking whether the validation was stopped
+constexpr size_t ValidationBatchSize = 1024;
+
+std::vector<mdl::Node*> collectNodesToValidate(mdl::WorldNode& worldNode)
+{
+  // Validators use the logical bounds, which some nodes compute lazily. Compute them here
+  // so that they are only read while the nodes are being validated on a worker thread.
+  auto result = std::vector<mdl::Node*>{};
+  worldNode.accept(kdl::overload(
+    [&](auto&& thisLambda, mdl::WorldNode* world) {
+      result.push_back(world);
+      world->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, mdl::LayerNode* layer) {
+      result.push_back(layer);
+      layer->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, mdl::GroupNode* group) {
+      result.push_back(group);
+      group->logicalBounds();
+      group->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, mdl::EntityNode* entity) {
+      result.push_back(entity);
+      entity->logicalBounds();
+      entity->visitChildren(thisLambda);
+    },
+    [&](mdl::BrushNode* brush) {
+      result.push_back(brush);
+      brush->logicalBounds();
+    },
+    [&](mdl::PatchNode* patch) {
+      result.push_back(patch);
+      patch->logicalBounds();
+    }));
+  return result;
+}
+
+} // namespace
+
+/**
+ * The state shared between the UI thread and the worker thread that validates the nodes.
+ * The worker holds the mutex while it validates a batch of nodes, which also writes the
+ * issues that the nodes cache, and it stops once the run was cancelled. The UI thread
+ * holds the mutex while it changes the document.
+ */
+struct IssueBrowserView::ValidationRun
+{
+  std::mutex mutex;
+  bool cancelled = false;
+};
 
 IssueBrowserView::IssueBrowserView(std::weak_ptr<MapDocument> document, QWidget* parent)
   : QWidget{parent}
@@ -55,6 +116,11 @@ IssueBrowserView::IssueBrowserView(std::weak_ptr<MapDocument> document, QWidget*
   bindEvents();
 }
 
+IssueBrowserView::~IssueBrowserView()
+{
+  stopValidation();
+}
+
 void IssueBrowserView::createGui()
 {
   m_tableModel = new IssueBrowserModel{this};
@@ -100,6 +166,31 @@ void IssueBrowserView::reload()
   invalidate();
 }
 
+void IssueBrowserView::documentWillChange()
+{
+  if (m_validationRun)
+  {
+    invalidate();
+  }
+}
+
+void IssueBrowserView::pauseValidation()
+{
+  if (m_validationRun && !m_validationPause)
+  {
+    // wait until the worker has finished its current batch
+    m_validationPause = std::unique_lock{m_validationRun->mutex};
+  }
+}
+
+void IssueBrowserView::resumeValidation()
+{
+  if (m_validationPause)
+  {
+    m_validationPause.unlock();
+  }
+}
+
 void IssueBrowserView::deselectAll()
 {
   m_tableView->clearSelection();
@@ -110,6 +201,12 @@ void IssueBrowserView::deselectAll()
  */
 void IssueBrowserView::updateSelection()
 {
+  if (!m_valid)
+  {
+    // the issues may belong to nodes that have changed or have been removed
+    return;
+  }
+
   auto document = kdl::mem_lock(m_document);
 
   auto nodes = std::vector<mdl::Node*>{};
@@ -126,57 +223,119 @@ void IssueBrowserView::updateSelection()
   document->selectNodes(nodes);
 }
 
-void IssueBrowserView::updateIssues()
+void IssueBrowserView::startValidation()
 {
   auto document = kdl::mem_lock(m_document);
-  if (document->world() != nullptr)
+  auto* world = document->world();
+  if (!world)
   {
-    const auto validators = document->world()->registeredValidators();
+    m_tableModel->setIssues({});
+    m_valid = true;
+    return;
+  }
 
-    auto issues = std::vector<const mdl::Issue*>{};
-    const auto collectIssues = [&](auto* node) {
-      for (auto* issue : node->issues(validators))
+  auto& taskManager = document->taskManager();
+  auto validationRun = std::make_shared<ValidationRun>();
+  m_validationRun = validationRun;
+
+  taskManager.run_task([this,
+                        &taskManager,
+                        validationRun,
+                        generation = m_generation,
+                        nodes = collectNodesToValidate(*world),
+                        validators = world->registeredValidators()]() {
+    // The view stops the run before it is destroyed, so it's safe to post the issues as
+    // long as the run wasn't cancelled.
+    for (size_t first = 0; first < nodes.size(); first += ValidationBatchSize)
+    {
+      const auto last = std::min(first + ValidationBatchSize, nodes.size());
+      const auto batch = std::vector<mdl::Node*>{
+        std::next(nodes.begin(), static_cast<std::ptrdiff_t>(first)),
+        std::next(nodes.begin(), static_cast<std::ptrdiff_t>(last))};
+
+      auto lock = std::lock_guard{validationRun->mutex};
+      if (validationRun->cancelled)
       {
-        if (
-          m_showHiddenIssues
-          || (!issue->hidden() && (issue->type() & m_hiddenIssueTypes) == 0))
-        {
-          issues.push_back(issue);
-        }
+        return;
       }
-    };
-
-    document->world()->accept(kdl::overload(
-      [&](auto&& thisLambda, mdl::WorldNode* world) {
-        collectIssues(world);
-        world->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::LayerNode* layer) {
-        collectIssues(layer);
-        layer->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::GroupNode* group) {
-        collectIssues(group);
-        group->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::EntityNode* entity) {
-        collectIssues(entity);
-        entity->visitChildren(thisLambda);
-      },
-      [&](mdl::BrushNode* brush) { collectIssues(brush); },
-      [&](mdl::PatchNode* patch) { collectIssues(patch); }));
-
-    issues = kdl::vec_sort(std::move(issues), [](const auto* lhs, const auto* rhs) {
-      return lhs->seqId() > rhs->seqId();
-    });
-    m_tableModel->setIssues(std::move(issues));
+
+      QMetaObject::invokeMethod(
+        this,
+        [this,
+         generation,
+         issues = mdl::collectIssues(batch, validators, taskManager)]() mutable {
+          validationDidProduceIssues(generation, std::move(issues));
+        },
+        Qt::QueuedConnection);
+    }
+
+    auto lock = std::lock_guard{validationRun->mutex};
+    if (!validationRun->cancelled)
+    {
+      QMetaObject::invokeMethod(
+        this,
+        [this, generation]() { validationDidFinish(generation); },
+        Qt::QueuedConnection);
+    }
+  });
+}
+
+void IssueBrowserView::stopValidation()
+{
+  if (m_validationRun)
+  {
+    {
+      // wait until the worker has finished its current batch unless it is paused
+      auto lock = m_validationPause ? std::move(m_validationPause)
+                                    : std::unique_lock{m_validationRun->mutex};
+      m_validationRun->cancelled = true;
+    }
+    m_validationRun.reset();
+  }
+}
+
+void IssueBrowserView::validationDidProduceIssues(
+  const size_t generation, std::vector<const mdl::Issue*> issues)
+{
+  if (generation != m_generation)
+  {
+    // the document has changed since the validation was started
+    return;
+  }
+
+  issues = kdl::vec_filter(std::move(issues), [&](const auto* issue) {
+    return m_showHiddenIssues
+           || (!issue->hidden() && (issue->type() & m_hiddenIssueTypes) == 0);
+  });
+
+  m_tableModel->addIssues(issues);
+  m_validatedIssues = kdl::vec_concat(std::move(m_validatedIssues), std::move(issues));
+}
+
+void IssueBrowserView::validationDidFinish(const size_t generation)
+{
+  if (generation != m_generation)
+  {
+    return;
   }
+
+  m_validationRun.reset();
+
+  // removes the issues that were not found again, the issues are only selectable in the
+  // document once they are valid
+  m_tableModel->setIssues(std::exchange(m_validatedIssues, {}));
+  m_valid = true;
 }
 
 void IssueBrowserView::applyQuickFix(const mdl::IssueQuickFix& quickFix)
 {
-  auto document = kdl::mem_lock(m_document);
   const auto issues = collectIssues(getSelection());
+  if (issues.empty())
+  {
+    return;
+  }
+
+  auto document = kdl::mem_lock(m_document);
 
   auto transaction =
     Transaction{document, "Apply Quick Fix (" + quickFix.description() + ")"};
@@ -188,6 +347,12 @@ void IssueBrowserView::applyQuickFix(const mdl::IssueQuickFix& quickFix)
 std::vector<const mdl::Issue*> IssueBrowserView::collectIssues(
   const QList<QModelIndex>& indices) const
 {
+  if (!m_valid)
+  {
+    // the issues may belong to nodes that have changed or have been removed
+    return {};
+  }
+
   // Use a vector_set to filter out duplicates.
   // The QModelIndex list returned by getSelection() contains duplicates
   // (not sure why, current row and selected row?)
@@ -197,8 +362,7 @@ std::vector<const mdl::Issue*> IssueBrowserView::collectIssues(
   {
     if (index.isValid())
     {
-      const auto row = static_cast<size_t>(index.row());
-      result.insert(m_tableModel->issues().at(row));
+      result.insert(m_tableModel->issue(index.row()));
     }
   }
   return result.release_data();
@@ -207,7 +371,7 @@ std::vector<const mdl::Issue*> IssueBrowserView::collectIssues(
 std::vector<const mdl::IssueQuickFix*> IssueBrowserView::collectQuickFixes(
   const QList<QModelIndex>& indices) const
 {
-  if (indices.empty())
+  if (indices.empty() || !m_valid)
   {
     return {};
   }
@@ -219,8 +383,7 @@ std::vector<const mdl::IssueQuickFix*> IssueBrowserView::collectQuickFixes(
     {
       continue;
     }
-    const auto* issue = m_tableModel->issues().at(static_cast<size_t>(index.row()));
-    issueTypes &= issue->type();
+    issueTypes &= m_tableModel->issue(index.row())->type();
   }
 
   auto document = kdl::mem_lock(m_document);
@@ -273,7 +436,7 @@ void IssueBrowserView::bindEvents()
 void IssueBrowserView::itemRightClicked(const QPoint& pos)
 {
   const auto selectedIndexes = m_tableView->selectionModel()->selectedIndexes();
-  if (selectedIndexes.empty())
+  if (selectedIndexes.empty() || !m_valid)
   {
     return;
   }
@@ -322,43 +485,168 @@ void IssueBrowserView::hideIssues()
 
 void IssueBrowserView::invalidate()
 {
+  // The running validation must be stopped because it reads the document, and its result
+  // would be stale anyway. The current issues remain visible until the next validation
+  // replaces them.
+  stopValidation();
+  ++m_generation;
   m_valid = false;
-  m_tableModel->setIssues({});
+  m_validatedIssues.clear();
+
+  scheduleValidation();
+}
 
-  QMetaObject::invokeMethod(this, "validate", Qt::QueuedConnection);
+void IssueBrowserView::scheduleValidation()
+{
+  if (!m_validationPending)
+  {
+    m_validationPending = true;
+    QMetaObject::invokeMethod(this, "validate", Qt::QueuedConnection);
+  }
 }
 
+/**
+ * Starts validating the document on a worker thread unless the issues are valid or a
+ * validation is already running. The issues of every batch of nodes are added to the
+ * table as soon as the batch has been validated.
+ *
+ * The document is not copied. Instead, every change to the document must be announced by
+ * calling documentWillChange, which stops a running validation before the document is
+ * modified, or pauseValidation if the change doesn't affect the issues.
+ */
 void IssueBrowserView::validate()
 {
-  if (!m_valid)
+  m_validationPending = false;
+  if (!m_valid && !m_validationRun)
   {
-    updateIssues();
-    m_valid = true;
+    startValidation();
   }
 }
 
 // IssueBrowserModel
 
+IssueBrowserModel::IssueRow::IssueRow(const mdl::Issue& issue_)
+  : issue{&issue_}
+  , seqId{issue_.seqId()}
+  , lineNumber{issue_.lineNumber()}
+  , description{QString::fromStdString(issue_.description())}
+  , hidden{issue_.hidden()}
+{
+}
+
 IssueBrowserModel::IssueBrowserModel(QObject* parent)
   : QAbstractTableModel{parent}
 {
 }
 
+void IssueBrowserModel::addIssues(std::vector<const mdl::Issue*> issues)
+{
+  auto rows = std::vector<IssueRow>{};
+  for (const auto* issue : issues)
+  {
+    if (!std::ranges::binary_search(
+          m_rows, issue->seqId(), std::greater{}, &IssueRow::seqId))
+    {
+      rows.emplace_back(*issue);
+    }
+  }
+
+  std::ranges::sort(rows, std::greater{}, &IssueRow::seqId);
+  insertIssueRows(std::move(rows));
+}
+
 void IssueBrowserModel::setIssues(std::vector<const mdl::Issue*> issues)
 {
-  beginResetModel();
-  m_issues = std::move(issues);
-  endResetModel();
+  auto rows =
+    kdl::vec_transform(issues, [](const auto* issue) { return IssueRow{*issue}; });
+  std::ranges::sort(rows, std::greater{}, &IssueRow::seqId);
+
+  // sequence ids are unique, so a row with the same sequence id as one of the given
+  // issues shows that issue, even if the row's issue has been deleted since
+  const auto isRemoved = [&](const auto& row) {
+    return !std::ranges::binary_search(
+      rows, row.seqId, std::greater{}, &IssueRow::seqId);
+  };
+
+  for (auto last = m_rows.size(); last > 0;)
+  {
+    if (!isRemoved(m_rows[last - 1]))
+    {
+      --last;
+      continue;
+    }
+
+    auto first = last - 1;
+    while (first > 0 && isRemoved(m_rows[first - 1]))
+    {
+      --first;
+    }
+
+    beginRemoveRows(QModelIndex{}, static_cast<int>(first), static_cast<int>(last) - 1);
+    m_rows.erase(
+      std::next(m_rows.begin(), static_cast<std::ptrdiff_t>(first)),
+      std::next(m_rows.begin(), static_cast<std::ptrdiff_t>(last)));
+    endRemoveRows();
+
+    last = first;
+  }
+
+  insertIssueRows(kdl::vec_filter(rows, [&](const auto& row) {
+    return !std::ranges::binary_search(
+      m_rows, row.seqId, std::greater{}, &IssueRow::seqId);
+  }));
+
+  // line numbers may have changed, e.g. because the document was saved
+  m_rows = std::move(rows);
+  if (!m_rows.empty())
+  {
+    emit dataChanged(
+      index(0, 0), index(static_cast<int>(m_rows.size()) - 1, columnCount({}) - 1));
+  }
+}
+
+const mdl::Issue* IssueBrowserModel::issue(const int row) const
+{
+  return m_rows.at(static_cast<size_t>(row)).issue;
 }
 
-const std::vector<const mdl::Issue*>& IssueBrowserModel::issues()
+size_t IssueBrowserModel::seqId(const int row) const
 {
-  return m_issues;
+  return m_rows.at(static_cast<size_t>(row)).seqId;
+}
+
+/**
+ * Inserts the given rows, which must be sorted like the rows of this model and must not
+ * be contained in it. Consecutive rows are inserted together.
+ */
+void IssueBrowserModel::insertIssueRows(std::vector<IssueRow> rows)
+{
+  for (auto first = rows.begin(); first != rows.end();)
+  {
+    const auto position =
+      std::ranges::lower_bound(m_rows, first->seqId, std::greater{}, &IssueRow::seqId);
+    const auto last = position != m_rows.end()
+                        ? std::find_if(
+                            first,
+                            rows.end(),
+                            [&](const auto& row) { return row.seqId < position->seqId; })
+                        : rows.end();
+
+    const auto row = static_cast<int>(std::distance(m_rows.begin(), position));
+    const auto count = static_cast<int>(std::distance(first, last));
+
+    beginInsertRows(QModelIndex{}, row, row + count - 1);
+    m_rows.insert(
+      position, std::make_move_iterator(first), std::make_move_iterator(last));
+    endInsertRows();
+
+    first = last;
+  }
 }
 
 int IssueBrowserModel::rowCount(const QModelIndex& parent) const
 {
-  return parent.isValid() ? 0 : static_cast<int>(m_issues.size());
+  return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
 }
 
 int IssueBrowserModel::columnCount(const QModelIndex& parent) const
@@ -370,31 +658,31 @@ QVariant IssueBrowserModel::data(const QModelIndex& index, const int role) const
 {
   if (
     !index.isValid() || index.row() < 0
-    || index.row() >= static_cast<int>(m_issues.size()) || index.column() < 0
+    || index.row() >= static_cast<int>(m_rows.size()) || index.column() < 0
     || index.column() >= 2)
   {
     return QVariant{};
   }
 
-  const auto* issue = m_issues.at(static_cast<size_t>(index.row()));
+  const auto& row = m_rows.at(static_cast<size_t>(index.row()));
 
   if (role == Qt::DisplayRole)
   {
     if (index.column() == 0)
     {
-      if (issue->lineNumber() > 0)
+      if (row.lineNumber > 0)
       {
-        return QVariant::fromValue<size_t>(issue->lineNumber());
+        return QVariant::fromValue<size_t>(row.lineNumber);
       }
     }
     else
     {
-      return QVariant{QString::fromStdString(issue->description())};
+      return QVariant{row.description};
     }
   }
   else if (role == Qt::FontRole)
   {
-    if (issue->hidden())
+    if (row.hidden)
     {
       // hidden issues are italic
       auto italicFont = QFont{};
@@ -20,11 +20,13 @@
 #pragma once
 
 #include <QAbstractItemModel>
+#include <QString>
 #include <QWidget>
 
 #include "mdl/IssueType.h"
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 class QWidget;
@@ -36,6 +38,7 @@ namespace mdl
 {
 class Issue;
 class IssueQuickFix;
+class Node;
 } // namespace mdl
 
 namespace ui
@@ -47,12 +50,24 @@ class IssueBrowserView : public QWidget
 {
   Q_OBJECT
 private:
+  struct ValidationRun;
+
   std::weak_ptr<MapDocument> m_document;
 
   int m_hiddenIssueTypes = 0;
   bool m_showHiddenIssues = false;
 
   bool m_valid = false;
+  bool m_validationPending = false;
+
+  // incremented whenever the issues become stale, the results of validation runs that
+  // were started before are dropped
+  size_t m_generation = 0;
+  std::shared_ptr<ValidationRun> m_validationRun;
+  std::unique_lock<std::mutex> m_validationPause;
+
+  // the issues found by the running validation so far
+  std::vector<const mdl::Issue*> m_validatedIssues;
 
   QTableView* m_tableView = nullptr;
   IssueBrowserModel* m_tableModel = nullptr;
@@ -60,6 +75,7 @@ private:
 public:
   explicit IssueBrowserView(
     std::weak_ptr<MapDocument> document, QWidget* parent = nullptr);
+  ~IssueBrowserView() override;
 
 private:
   void createGui();
@@ -71,8 +87,25 @@ public:
   void reload();
   void deselectAll();
 
+  /**
+   * Must be called before the document is changed. Validation reads the document on a
+   * worker thread, so a running validation is stopped and started again later.
+   */
+  void documentWillChange();
+
+  /**
+   * Must be called before the document is changed in a way that doesn't affect the
+   * issues. A running validation waits until resumeValidation is called.
+   */
+  void pauseValidation();
+  void resumeValidation();
+
 private:
-  void updateIssues();
+  void startValidation();
+  void stopValidation();
+  void validationDidProduceIssues(
+    size_t generation, std::vector<const mdl::Issue*> issues);
+  void validationDidFinish(size_t generation);
 
   std::vector<const mdl::Issue*> collectIssues(const QList<QModelIndex>& indices) const;
   std::vector<const mdl::IssueQuickFix*> collectQuickFixes(
@@ -93,25 +126,57 @@ private:
 
 private:
   void invalidate();
+  void scheduleValidation();
 public slots:
   void validate();
 };
 
 /**
- * Trivial QAbstractTableModel subclass, when the issues list changes,
- * it just refreshes the entire list with beginResetModel()/endResetModel().
+ * Table model for the issues, sorted so that the most recently created issues come first.
+ *
+ * Issues are owned by their nodes and are deleted when their nodes change. Therefore, the
+ * model keeps a copy of everything it displays, so that the issues can remain visible
+ * until they are replaced by the result of the next validation. The issues themselves
+ * must only be accessed while they are valid.
+ *
+ * Issues are added while they are being validated, and the issues that were not found
+ * again are removed once the validation has finished. Rows are inserted and removed
+ * individually rather than resetting the model, so that the selection is retained.
  */
 class IssueBrowserModel : public QAbstractTableModel
 {
   Q_OBJECT
 private:
-  std::vector<const mdl::Issue*> m_issues;
+  struct IssueRow
+  {
+    explicit IssueRow(const mdl::Issue& issue);
+
+    const mdl::Issue* issue;
+    size_t seqId;
+    size_t lineNumber;
+    QString description;
+    bool hidden;
+  };
+
+  std::vector<IssueRow> m_rows;
 
 public:
   explicit IssueBrowserModel(QObject* parent);
 
+  /**
+   * Adds the given issues unless the model already contains them.
+   */
+  void addIssues(std::vector<const mdl::Issue*> issues);
+
+  /**
+   * Replaces the issues of this model with the given issues.
+   */
   void setIssues(std::vector<const mdl::Issue*> issues);
-  const std::vector<const mdl::Issue*>& issues();
+  const mdl::Issue* issue(int row) const;
+  size_t seqId(int row) const;
+
+private:
+  void insertIssueRows(std::vector<IssueRow> rows);
 
 public: // QAbstractTableModel overrides
   int rowCount(const QModelIndex& parent) const override;
@@ -25,9 +25,11 @@
 #include "Uuid.h"
 #include "io/BrushFaceReader.h"
 #include "io/DiskIO.h"
+#include "io/EntityTextCache.h"
 #include "io/ExportOptions.h"
 #include "io/GameConfigParser.h"
 #include "io/LoadMaterialCollections.h"
+#include "io/MapCache.h"
 #include "io/MapHeader.h"
 #include "io/NodeReader.h"
 #include "io/NodeWriter.h"
@@ -83,6 +85,7 @@
 #include "mdl/PointEntityWithBrushesValidator.h"
 #include "mdl/Polyhedron.h"
 #include "mdl/Polyhedron3.h"
+#include "mdl/Polyhedron_ElementPool.h"
 #include "mdl/PropertyKeyWithDoubleQuotationMarksValidator.h"
 #include "mdl/PropertyValueWithDoubleQuotationMarksValidator.h"
 #include "mdl/PushSelection.h"
@@ -118,6 +121,7 @@
 #include "kdl/map_utils.h"
 #include "kdl/overload.h"
 #include "kdl/path_utils.h"
+#include "kdl/range_to_vector.h"
 #include "kdl/range_utils.h"
 #include "kdl/result.h"
 #include "kdl/result_fold.h"
@@ -139,6 +143,7 @@
 #include <cassert>
 #include <cstdlib>
 #include <map>
+#include <optional>
 #include <ranges>
 #include <sstream>
 #include <string>
@@ -595,6 +600,64 @@ void MapDocument::createEntityDefinitionActions()
 
 namespace
 {
+std::optional<std::unique_ptr<mdl::WorldNode>> loadMapFromCache(
+  const std::filesystem::path& cachePath,
+  const io::MapCacheKey& cacheKey,
+  const vm::bbox3d& worldBounds,
+  const mdl::EntityPropertyConfig& entityPropertyConfig,
+  io::ParserStatus& parserStatus,
+  kdl::task_manager& taskManager,
+  Logger& logger)
+{
+  if (io::Disk::pathInfo(cachePath) != io::PathInfo::File)
+  {
+    return std::nullopt;
+  }
+
+  return io::Disk::openFile(cachePath)
+         | kdl::and_then(
+           [&](auto file) { return io::readMapCache(file->reader(), cacheKey); })
+         | kdl::transform([&](auto mapCache) {
+             return std::optional{io::WorldReader::readFromCache(
+               std::move(mapCache),
+               worldBounds,
+               entityPropertyConfig,
+               parserStatus,
+               taskManager)};
+           })
+         | kdl::transform_error([&](auto e) {
+             logger.info() << "Ignoring map cache " << cachePath << ": " << e.msg;
+             return std::optional<std::unique_ptr<mdl::WorldNode>>{};
+           })
+         | kdl::value();
+}
+
+Result<void> writeMapCache(
+  const std::filesystem::path& cachePath,
+  const io::MapCacheKey& cacheKey,
+  const mdl::MapFormat mapFormat,
+  const std::vector<io::MapReader::ObjectInfo>& objectInfos)
+{
+  // Write to a temporary file and replace the cache file when done so that a partially
+  // written cache is never read.
+  auto tempPath = cachePath;
+  tempPath += "." + generateUuid();
+
+  return io::Disk::withOutputStream(
+           tempPath,
+           std::ios::out | std::ios::binary,
+           [&](auto& stream) {
+             return io::writeMapCache(stream, cacheKey, mapFormat, objectInfos);
+           })
+         | kdl::and_then([&]() { return io::Disk::moveFile(tempPath, cachePath); })
+         | kdl::or_else([&](auto e) {
+             // ignore errors
+             auto error = std::error_code{};
+             std::filesystem::remove(tempPath, error);
+             return Result<void>{std::move(e)};
+           });
+}
+
 Result<std::unique_ptr<mdl::WorldNode>> loadMap(
   const mdl::GameConfig& config,
   const mdl::MapFormat mapFormat,
@@ -609,6 +672,44 @@ Result<std::unique_ptr<mdl::WorldNode>> loadMap(
   auto parserStatus = io::SimpleParserStatus{logger};
   return io::Disk::openFile(path) | kdl::and_then([&](auto file) {
            auto fileReader = file->reader().buffer();
+
+           // The map cache stores the parsed objects so that the next time the map is
+           // loaded, we can skip parsing it. It is keyed by the map file contents and the
+           // game config, so any change to either invalidates it.
+           auto onObjectInfos = io::WorldReader::ObjectInfoCallback{};
+           if (pref(Preferences::UseMapCache))
+           {
+             const auto cachePath = io::mapCachePath(path);
+             const auto cacheKey =
+               io::makeMapCacheKey(fileReader.stringView(), config, mapFormat);
+
+             if (
+               auto worldNode = loadMapFromCache(
+                 cachePath,
+                 cacheKey,
+                 worldBounds,
+                 entityPropertyConfig,
+                 parserStatus,
+                 taskManager,
+                 logger))
+             {
+               return Result<std::unique_ptr<mdl::WorldNode>>{std::move(*worldNode)};
+             }
+
+             onObjectInfos = [&taskManager, cachePath, cacheKey](
+                               const auto parsedMapFormat, const auto& objectInfos) {
+               // The objects are consumed when the nodes are created, so the task needs
+               // its own copy. Copying is much cheaper than writing the cache, and the
+               // task cannot log errors because the logger is not thread safe. A cache
+               // that could not be written is recreated the next time the map is loaded.
+               taskManager.run_task(
+                 [cachePath, cacheKey, parsedMapFormat, objectInfos]() {
+                   return writeMapCache(
+                     cachePath, cacheKey, parsedMapFormat, objectInfos);
+                 });
+             };
+           }
+
            if (mapFormat == mdl::MapFormat::Unknown)
            {
              // Try all formats listed in the game config
@@ -624,12 +725,13 @@ Result<std::unique_ptr<mdl::WorldNode>> loadMap(
                worldBounds,
                entityPropertyConfig,
                parserStatus,
-               taskManager);
+               taskManager,
+               onObjectInfos);
            }
 
            auto worldReader =
              io::WorldReader{fileReader.stringView(), mapFormat, entityPropertyConfig};
-           return worldReader.read(worldBounds, parserStatus, taskManager);
+           return worldReader.read(worldBounds, parserStatus, taskManager, onObjectInfos);
          });
 }
 
@@ -764,6 +866,21 @@ void MapDocument::saveDocumentTo(const std::filesystem::path& path)
   });
 }
 
+std::string MapDocument::serializeDocument(io::EntityTextCache& entityTextCache) const
+{
+  ensure(m_game.get() != nullptr, "game is null");
+  ensure(m_world, "world is null");
+
+  auto stream = std::ostringstream{};
+  io::writeMapHeader(stream, m_game->config().name, m_world->mapFormat());
+
+  auto writer = io::NodeWriter{*m_world, stream, entityTextCache};
+  writer.setExporting(false);
+  writer.writeMap(m_taskManager);
+
+  return stream.str();
+}
+
 Result<void> MapDocument::exportDocumentAs(const io::ExportOptions& options)
 {
   return std::visit(
@@ -2576,10 +2693,16 @@ bool MapDocument::updateLinkedGroups()
     {
       setHasPendingChanges(allChangedLinkedGroups, false);
 
-      auto command = std::make_unique<UpdateLinkedGroupsCommand>(allChangedLinkedGroups);
+      auto command = std::make_unique<UpdateLinkedGroupsCommand>(
+        allChangedLinkedGroups, m_linkedGroupsModificationCount);
       const auto result = executeAndStore(std::move(command));
-      return result->success();
+      if (!result->success())
+      {
+        return false;
+      }
     }
+
+    m_linkedGroupsModificationCount = m_world->modificationCount();
   }
 
   return true;
@@ -4379,6 +4502,11 @@ const std::string& MapDocument::redoCommandName() const
   return doGetRedoCommandName();
 }
 
+size_t MapDocument::undoMemoryUsage() const
+{
+  return doGetUndoMemoryUsage();
+}
+
 void MapDocument::undoCommand()
 {
   doUndoCommand();
@@ -4465,6 +4593,11 @@ std::unique_ptr<CommandResult> MapDocument::executeAndStore(
 
 void MapDocument::processResourcesSync(const mdl::ProcessContext& processContext)
 {
+  NotifyBeforeAndAfter notifyResourceProcessing(
+    m_resourceManager->needsProcessing(),
+    resourceProcessingWillStartNotifier,
+    resourceProcessingDidFinishNotifier);
+
   auto allProcessedResourceIds = std::vector<mdl::ResourceId>{};
   while (m_resourceManager->needsProcessing())
   {
@@ -4491,10 +4624,20 @@ void MapDocument::processResourcesAsync(const mdl::ProcessContext& processContex
 {
   using namespace std::chrono_literals;
 
+  // keep only a few entity models loading at a time so that recently requested models
+  // don't have to wait for all others to load; textures are not limited
+  const auto maxLoadingCount = 2 * std::max(m_taskManager.worker_count(), size_t(1));
+
+  NotifyBeforeAndAfter notifyResourceProcessing(
+    m_resourceManager->needsProcessing(),
+    resourceProcessingWillStartNotifier,
+    resourceProcessingDidFinishNotifier);
+
   const auto processedResourceIds = m_resourceManager->process(
     [&](auto task) { return m_taskManager.run_task(std::move(task)); },
     processContext,
-    20ms);
+    20ms,
+    maxLoadingCount);
 
   if (!processedResourceIds.empty())
   {
@@ -4533,6 +4676,7 @@ void MapDocument::setWorld(
 {
   m_worldBounds = worldBounds;
   m_world = std::move(worldNode);
+  m_linkedGroupsModificationCount = std::nullopt;
   m_game = game;
 
   m_entityModelManager->setGame(game.get(), m_taskManager);
@@ -4550,6 +4694,8 @@ void MapDocument::setWorld(
 void MapDocument::clearWorld()
 {
   m_world.reset();
+  mdl::trimPolyhedronElementPools();
+  m_linkedGroupsModificationCount = std::nullopt;
   m_currentLayer = nullptr;
 }
 
@@ -4740,7 +4886,9 @@ void MapDocument::loadMaterials()
     m_game->config().materialConfig,
     [&](auto resourceLoader) {
       auto resource = std::make_shared<mdl::TextureResource>(std::move(resourceLoader));
-      m_resourceManager->addResource(resource);
+      // textures are cheap to load and are not requested by the renderer, so they
+      // would only delay the loading of visible entity models if they were limited
+      m_resourceManager->addResource(resource, false);
       return resource;
     },
     m_taskManager);
@@ -5373,6 +5521,10 @@ void MapDocument::preferenceDidChange(const std::filesystem::path& path)
     const std::filesystem::path newGamePath = gameFactory.gamePath(m_game->config().name);
     m_game->setGamePath(newGamePath, logger());
 
+    const auto nodes = std::vector<mdl::Node*>{m_world.get()};
+    NotifyBeforeAndAfter notifyNodes(
+      nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+
     clearEntityModels();
     setEntityModels();
 
@@ -54,6 +54,11 @@ namespace tb
 class Color;
 } // namespace tb
 
+namespace tb::io
+{
+class EntityTextCache;
+} // namespace tb::io
+
 namespace tb::mdl
 {
 class Brush;
@@ -143,6 +148,9 @@ protected:
   size_t m_lastSaveModificationCount = 0;
   size_t m_modificationCount = 0;
 
+  // the world's modification count when all linked groups were last known to be in sync
+  std::optional<size_t> m_linkedGroupsModificationCount;
+
   mdl::NodeCollection m_selectedNodes;
   std::vector<mdl::BrushFaceHandle> m_selectedBrushFaces;
 
@@ -201,7 +209,9 @@ public: // notification
 
   Notifier<const std::vector<mdl::BrushFaceHandle>&> brushFacesDidChangeNotifier;
 
+  Notifier<> resourceProcessingWillStartNotifier;
   Notifier<const std::vector<mdl::ResourceId>> resourcesWereProcessedNotifier;
+  Notifier<> resourceProcessingDidFinishNotifier;
 
   Notifier<> materialCollectionsWillChangeNotifier;
   Notifier<> materialCollectionsDidChangeNotifier;
@@ -319,6 +329,14 @@ public: // new, load, save document
   void saveDocument();
   void saveDocumentAs(const std::filesystem::path& path);
   void saveDocumentTo(const std::filesystem::path& path);
+
+  /**
+   * Serializes the document into a string with the same contents as a file written by
+   * saveDocumentTo. The text of entities that haven't changed since the given cache was
+   * last used is copied from the cache.
+   */
+  std::string serializeDocument(io::EntityTextCache& entityTextCache) const;
+
   Result<void> exportDocumentAs(const io::ExportOptions& options);
 
 private:
@@ -655,6 +673,7 @@ public: // command processing
   bool canRedoCommand() const;
   const std::string& undoCommandName() const;
   const std::string& redoCommandName() const;
+  size_t undoMemoryUsage() const;
   void undoCommand();
   void redoCommand();
   bool canRepeatCommands() const;
@@ -679,6 +698,7 @@ private: // subclassing interface for command processing
   virtual bool doCanRedoCommand() const = 0;
   virtual const std::string& doGetUndoCommandName() const = 0;
   virtual const std::string& doGetRedoCommandName() const = 0;
+  virtual size_t doGetUndoMemoryUsage() const = 0;
   virtual void doUndoCommand() = 0;
   virtual void doRedoCommand() = 0;
 
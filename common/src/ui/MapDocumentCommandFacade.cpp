@@ -20,6 +20,8 @@
 #include "MapDocumentCommandFacade.h"
 
 #include "Ensure.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
 #include "mdl/Brush.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
@@ -48,6 +50,7 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -68,6 +71,12 @@ std::vector<mdl::Node*> collectOldChildren(
   return result;
 }
 
+std::optional<size_t> undoMemoryBudget()
+{
+  const auto megabytes = pref(Preferences::UndoMemoryBudget);
+  return megabytes > 0 ? std::optional{size_t(megabytes) * 1024 * 1024} : std::nullopt;
+}
+
 } // namespace
 
 std::shared_ptr<MapDocument> MapDocumentCommandFacade::newMapDocument(
@@ -79,7 +88,8 @@ std::shared_ptr<MapDocument> MapDocumentCommandFacade::newMapDocument(
 
 MapDocumentCommandFacade::MapDocumentCommandFacade(kdl::task_manager& taskManager)
   : MapDocument{taskManager}
-  , m_commandProcessor{std::make_unique<CommandProcessor>(*this)}
+  , m_commandProcessor{std::make_unique<CommandProcessor>(
+      *this, std::chrono::milliseconds{1000}, undoMemoryBudget())}
 {
   connectObservers();
 }
@@ -624,6 +634,18 @@ void MapDocumentCommandFacade::connectObservers()
     m_commandProcessor->transactionDoneNotifier.connect(transactionDoneNotifier);
   m_notifierConnection +=
     m_commandProcessor->transactionUndoneNotifier.connect(transactionUndoneNotifier);
+
+  auto& prefs = PreferenceManager::instance();
+  m_notifierConnection += prefs.preferenceDidChangeNotifier.connect(
+    this, &MapDocumentCommandFacade::preferenceDidChange);
+}
+
+void MapDocumentCommandFacade::preferenceDidChange(const std::filesystem::path& path)
+{
+  if (path == Preferences::UndoMemoryBudget.path())
+  {
+    m_commandProcessor->setMemoryBudget(undoMemoryBudget());
+  }
 }
 
 bool MapDocumentCommandFacade::isCurrentDocumentStateObservable() const
@@ -651,6 +673,11 @@ const std::string& MapDocumentCommandFacade::doGetRedoCommandName() const
   return m_commandProcessor->redoCommandName();
 }
 
+size_t MapDocumentCommandFacade::doGetUndoMemoryUsage() const
+{
+  return m_commandProcessor->memoryUsage();
+}
+
 void MapDocumentCommandFacade::doUndoCommand()
 {
   m_commandProcessor->undo();
@@ -23,6 +23,7 @@
 #include "mdl/NodeContents.h"
 #include "ui/MapDocument.h"
 
+#include <filesystem>
 #include <map>
 #include <memory>
 #include <string>
@@ -115,6 +116,7 @@ private: // notification
   void connectObservers();
   void documentWasNewed(MapDocument* document);
   void documentWasLoaded(MapDocument* document);
+  void preferenceDidChange(const std::filesystem::path& path);
 
 private: // implement MapDocument interface
   bool isCurrentDocumentStateObservable() const override;
@@ -123,6 +125,7 @@ private: // implement MapDocument interface
   bool doCanRedoCommand() const override;
   const std::string& doGetUndoCommandName() const override;
   const std::string& doGetRedoCommandName() const override;
+  size_t doGetUndoMemoryUsage() const override;
   void doUndoCommand() override;
   void doRedoCommand() override;
 
@@ -47,6 +47,10 @@
 #include "vm/mat_ext.h"
 #include "vm/vec.h"
 
+#include <algorithm>
+#include <filesystem>
+#include <iterator>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -155,6 +159,12 @@ void MaterialBrowserView::doInitLayout(Layout& layout)
 }
 
 void MaterialBrowserView::doReloadLayout(Layout& layout)
+{
+  updateLayout(layout, getLayoutItems(layout));
+}
+
+std::vector<MaterialBrowserView::LayoutItemGroup> MaterialBrowserView::getLayoutItems(
+  const Layout& layout)
 {
   const auto& fontPath = pref(Preferences::RendererFontPath());
   const auto fontSize = pref(Preferences::BrowserFontSize);
@@ -164,49 +174,121 @@ void MaterialBrowserView::doReloadLayout(Layout& layout)
 
   if (m_group)
   {
-    for (const auto* collection : getCollections())
-    {
-      layout.addGroup(collection->path().string(), float(fontSize) + 2.0f);
-      addMaterialsToLayout(layout, getMaterials(*collection), font);
-    }
-  }
-  else
-  {
-    addMaterialsToLayout(layout, getMaterials(), font);
+    return kdl::vec_transform(getCollections(), [&](const auto* collection) {
+      return LayoutItemGroup{
+        collection->path().string(),
+        float(fontSize) + 2.0f,
+        getLayoutItems(layout, getMaterials(*collection), font)};
+    });
   }
+
+  return {
+    LayoutItemGroup{std::nullopt, 0.0f, getLayoutItems(layout, getMaterials(), font)}};
 }
 
-void MaterialBrowserView::addMaterialsToLayout(
-  Layout& layout,
+std::vector<MaterialBrowserView::LayoutItem> MaterialBrowserView::getLayoutItems(
+  const Layout& layout,
   const std::vector<const mdl::Material*>& materials,
   const render::FontDescriptor& font)
 {
-  for (const auto* material : materials)
+  const auto maxCellWidth = layout.maxCellWidth();
+  const auto scaleFactor = pref(Preferences::MaterialBrowserIconSize);
+  auto& textureFont = fontManager().font(font);
+
+  return kdl::vec_transform(materials, [&](const auto* material) {
+    auto materialName = std::filesystem::path{material->name()}.filename().string();
+    const auto titleHeight = textureFont.measure(materialName).y();
+
+    const auto* texture = material->texture();
+    const auto textureSize = texture ? texture->sizef() : vm::vec2f{64, 64};
+    const auto scaledTextureSize = vm::round(scaleFactor * textureSize);
+
+    return LayoutItem{
+      material,
+      std::move(materialName),
+      scaledTextureSize.x(),
+      scaledTextureSize.y(),
+      maxCellWidth,
+      titleHeight + 4.0f};
+  });
+}
+
+namespace
+{
+
+void addItemsToLayout(CellLayout& layout, const auto& items, const size_t firstItem)
+{
+  for (auto i = firstItem; i < items.size(); ++i)
   {
-    addMaterialToLayout(layout, *material, font);
+    const auto& item = items[i];
+    layout.addItem(
+      item.material,
+      item.title,
+      item.itemWidth,
+      item.itemHeight,
+      item.titleWidth,
+      item.titleHeight);
   }
 }
 
-void MaterialBrowserView::addMaterialToLayout(
-  Layout& layout, const mdl::Material& material, const render::FontDescriptor& font)
+void addGroupToLayout(CellLayout& layout, const auto& group)
 {
-  const auto maxCellWidth = layout.maxCellWidth();
+  if (group.title)
+  {
+    layout.addGroup(*group.title, group.titleHeight);
+  }
+  addItemsToLayout(layout, group.items, 0);
+}
 
-  const auto materialName = std::filesystem::path{material.name()}.filename().string();
-  const auto titleHeight = fontManager().font(font).measure(materialName).y();
+} // namespace
 
-  const auto scaleFactor = pref(Preferences::MaterialBrowserIconSize);
-  const auto* texture = material.texture();
-  const auto textureSize = texture ? texture->sizef() : vm::vec2f{64, 64};
-  const auto scaledTextureSize = vm::round(scaleFactor * textureSize);
+void MaterialBrowserView::updateLayout(
+  Layout& layout, std::vector<LayoutItemGroup> layoutItems)
+{
+  const auto [oldGroupIt, newGroupIt] = std::ranges::mismatch(m_layoutItems, layoutItems);
+  if (oldGroupIt == m_layoutItems.end() && newGroupIt == layoutItems.end())
+  {
+    return;
+  }
+
+  auto groupIndex = size_t(std::distance(m_layoutItems.begin(), oldGroupIt));
+  auto firstItem = size_t(0);
+  if (
+    oldGroupIt != m_layoutItems.end() && newGroupIt != layoutItems.end()
+    && oldGroupIt->title == newGroupIt->title
+    && oldGroupIt->titleHeight == newGroupIt->titleHeight)
+  {
+    // keep the group and the items before the first changed item
+    const auto [oldItemIt, newItemIt] =
+      std::ranges::mismatch(oldGroupIt->items, newGroupIt->items);
+    firstItem = size_t(std::distance(oldGroupIt->items.begin(), oldItemIt));
+  }
+  else if (groupIndex > 0)
+  {
+    // keep the previous group entirely
+    --groupIndex;
+    firstItem = m_layoutItems[groupIndex].items.size();
+  }
 
-  layout.addItem(
-    &material,
-    materialName,
-    scaledTextureSize.x(),
-    scaledTextureSize.y(),
-    maxCellWidth,
-    titleHeight + 4.0f);
+  if (groupIndex == 0 && firstItem == 0)
+  {
+    layout.clear();
+    for (const auto& group : layoutItems)
+    {
+      addGroupToLayout(layout, group);
+    }
+  }
+  else
+  {
+    firstItem = layout.truncate(groupIndex, firstItem);
+    addItemsToLayout(layout, layoutItems[groupIndex].items, firstItem);
+    for (size_t i = groupIndex + 1; i < layoutItems.size(); ++i)
+    {
+      addGroupToLayout(layout, layoutItems[i]);
+    }
+  }
+
+  m_layoutItems = std::move(layoutItems);
 }
 
 std::vector<const mdl::MaterialCollection*> MaterialBrowserView::getCollections() const
@@ -257,8 +339,9 @@ std::vector<const mdl::Material*> MaterialBrowserView::filterMaterials(
   }
   if (!m_filterText.empty())
   {
+    const auto patterns = kdl::str_split(m_filterText, " ");
     materials = kdl::vec_erase_if(std::move(materials), [&](const auto* material) {
-      return !kdl::all_of(kdl::str_split(m_filterText, " "), [&](const auto& pattern) {
+      return !kdl::all_of(patterns, [&](const auto& pattern) {
         return kdl::ci::str_contains(material->name(), pattern);
       });
     });
@@ -287,7 +370,10 @@ std::vector<const mdl::Material*> MaterialBrowserView::sortMaterials(
   }
 }
 
-void MaterialBrowserView::doClear() {}
+void MaterialBrowserView::doClear()
+{
+  m_layoutItems.clear();
+}
 
 void MaterialBrowserView::doRender(Layout& layout, const float y, const float height)
 {
@@ -324,27 +410,24 @@ void MaterialBrowserView::renderBounds(Layout& layout, const float y, const floa
   {
     if (group.intersectsY(y, height))
     {
-      for (const auto& row : group.rows())
+      for (const auto& row : group.rowsIntersectingY(y, height))
       {
-        if (row.intersectsY(y, height))
+        for (const auto& cell : row.cells())
         {
-          for (const auto& cell : row.cells())
-          {
-            const auto& bounds = cell.itemBounds();
-            const auto& material = cellData(cell);
-            const auto& color = materialColor(material);
-            vertices.emplace_back(
-              vm::vec2f{bounds.left() - 2.0f, height - (bounds.top() - 2.0f - y)}, color);
-            vertices.emplace_back(
-              vm::vec2f{bounds.left() - 2.0f, height - (bounds.bottom() + 2.0f - y)},
-              color);
-            vertices.emplace_back(
-              vm::vec2f{bounds.right() + 2.0f, height - (bounds.bottom() + 2.0f - y)},
-              color);
-            vertices.emplace_back(
-              vm::vec2f{bounds.right() + 2.0f, height - (bounds.top() - 2.0f - y)},
-              color);
-          }
+          const auto& bounds = cell.itemBounds();
+          const auto& material = cellData(cell);
+          const auto& color = materialColor(material);
+          vertices.emplace_back(
+            vm::vec2f{bounds.left() - 2.0f, height - (bounds.top() - 2.0f - y)}, color);
+          vertices.emplace_back(
+            vm::vec2f{bounds.left() - 2.0f, height - (bounds.bottom() + 2.0f - y)},
+            color);
+          vertices.emplace_back(
+            vm::vec2f{bounds.right() + 2.0f, height - (bounds.bottom() + 2.0f - y)},
+            color);
+          vertices.emplace_back(
+            vm::vec2f{bounds.right() + 2.0f, height - (bounds.top() - 2.0f - y)},
+            color);
         }
       }
     }
@@ -386,30 +469,27 @@ void MaterialBrowserView::renderMaterials(
   {
     if (group.intersectsY(y, height))
     {
-      for (const auto& row : group.rows())
+      for (const auto& row : group.rowsIntersectingY(y, height))
       {
-        if (row.intersectsY(y, height))
+        for (const auto& cell : row.cells())
         {
-          for (const auto& cell : row.cells())
-          {
-            const auto& bounds = cell.itemBounds();
-            const auto& material = cellData(cell);
-
-            auto vertexArray = render::VertexArray::move(std::vector<Vertex>{
-              Vertex{{bounds.left(), height - (bounds.top() - y)}, {0, 0}},
-              Vertex{{bounds.left(), height - (bounds.bottom() - y)}, {0, 1}},
-              Vertex{{bounds.right(), height - (bounds.bottom() - y)}, {1, 1}},
-              Vertex{{bounds.right(), height - (bounds.top() - y)}, {1, 0}},
-            });
-
-            material.activate(
-              pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
-
-            vertexArray.prepare(vboManager());
-            vertexArray.render(render::PrimType::Quads);
-
-            material.deactivate();
-          }
+          const auto& bounds = cell.itemBounds();
+          const auto& material = cellData(cell);
+
+          auto vertexArray = render::VertexArray::move(std::vector<Vertex>{
+            Vertex{{bounds.left(), height - (bounds.top() - y)}, {0, 0}},
+            Vertex{{bounds.left(), height - (bounds.bottom() - y)}, {0, 1}},
+            Vertex{{bounds.right(), height - (bounds.bottom() - y)}, {1, 1}},
+            Vertex{{bounds.right(), height - (bounds.top() - y)}, {1, 0}},
+          });
+
+          material.activate(
+            pref(Preferences::TextureMinFilter), pref(Preferences::TextureMagFilter));
+
+          vertexArray.prepare(vboManager());
+          vertexArray.render(render::PrimType::Quads);
+
+          material.deactivate();
         }
       }
     }
@@ -24,6 +24,7 @@
 #include "ui/CellView.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -61,6 +62,31 @@ private:
 
   const mdl::Material* m_selectedMaterial = nullptr;
 
+  struct LayoutItem
+  {
+    const mdl::Material* material;
+    std::string title;
+    float itemWidth;
+    float itemHeight;
+    float titleWidth;
+    float titleHeight;
+
+    bool operator==(const LayoutItem& other) const = default;
+  };
+
+  struct LayoutItemGroup
+  {
+    // std::nullopt if materials are not grouped
+    std::optional<std::string> title;
+    float titleHeight;
+    std::vector<LayoutItem> items;
+
+    bool operator==(const LayoutItemGroup& other) const = default;
+  };
+
+  // the items that were added to the layout when it was last reloaded
+  std::vector<LayoutItemGroup> m_layoutItems;
+
   NotifierConnection m_notifierConnection;
 
 public:
@@ -88,12 +114,18 @@ private:
   void doInitLayout(Layout& layout) override;
   void doReloadLayout(Layout& layout) override;
 
-  void addMaterialsToLayout(
-    Layout& layout,
+  std::vector<LayoutItemGroup> getLayoutItems(const Layout& layout);
+  std::vector<LayoutItem> getLayoutItems(
+    const Layout& layout,
     const std::vector<const mdl::Material*>& materials,
     const render::FontDescriptor& font);
-  void addMaterialToLayout(
-    Layout& layout, const mdl::Material& material, const render::FontDescriptor& font);
+
+  /**
+   * Updates the layout so that it contains the given items. The layout is kept up to the
+   * first item that differs from the items it was last updated with, and only the rows
+   * from that item on are laid out again.
+   */
+  void updateLayout(Layout& layout, std::vector<LayoutItemGroup> layoutItems);
 
   std::vector<const mdl::MaterialCollection*> getCollections() const;
   std::vector<const mdl::Material*> getMaterials(
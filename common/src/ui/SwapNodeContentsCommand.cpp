@@ -24,14 +24,36 @@
 
 #include "kdl/vector_utils.h"
 
+#include <unordered_map>
+
 namespace tb::ui
 {
+namespace
+{
+
+/**
+ * Expands the given compact contents against the bases returned by the given function.
+ */
+template <typename GetBase>
+std::vector<std::pair<mdl::Node*, mdl::NodeContents>> expandNodeContents(
+  std::vector<std::pair<mdl::Node*, mdl::CompactNodeContents>> nodes,
+  const GetBase& getBase)
+{
+  return kdl::vec_transform(std::move(nodes), [&](auto pair) {
+    return std::pair{pair.first, std::move(pair.second).expand(getBase(pair.first))};
+  });
+}
+
+} // namespace
 
 SwapNodeContentsCommand::SwapNodeContentsCommand(
   std::string name, std::vector<std::pair<mdl::Node*, mdl::NodeContents>> nodes)
   : UpdateLinkedGroupsCommandBase{std::move(name), true}
-  , m_nodes{std::move(nodes)}
+  , m_nodes{kdl::vec_transform(std::move(nodes), [](auto pair) {
+    return std::pair{pair.first, mdl::CompactNodeContents{std::move(pair.second)}};
+  })}
 {
+  updateMemoryUsage();
 }
 
 SwapNodeContentsCommand::~SwapNodeContentsCommand() = default;
@@ -39,14 +61,14 @@ SwapNodeContentsCommand::~SwapNodeContentsCommand() = default;
 std::unique_ptr<CommandResult> SwapNodeContentsCommand::doPerformDo(
   MapDocumentCommandFacade& document)
 {
-  document.performSwapNodeContents(m_nodes);
+  swapNodeContents(document);
   return std::make_unique<CommandResult>(true);
 }
 
 std::unique_ptr<CommandResult> SwapNodeContentsCommand::doPerformUndo(
   MapDocumentCommandFacade& document)
 {
-  document.performSwapNodeContents(m_nodes);
+  swapNodeContents(document);
   return std::make_unique<CommandResult>(true);
 }
 
@@ -62,10 +84,60 @@ bool SwapNodeContentsCommand::doCollateWith(UndoableCommand& command)
     kdl::vec_sort(myNodes);
     kdl::vec_sort(theirNodes);
 
-    return myNodes == theirNodes;
+    if (myNodes == theirNodes)
+    {
+      // Our contents were compacted against the contents which the other command has
+      // replaced since, and which it now holds. We restore those first, then we can
+      // restore our contents and compact them against the current contents.
+      auto intermediateNodes = expandNodeContents(
+        std::move(other->m_nodes),
+        [](const auto* node) -> const mdl::Node& { return *node; });
+      other->m_nodes.clear();
+
+      const auto intermediateContents = std::unordered_map<mdl::Node*, mdl::NodeContents>{
+        std::make_move_iterator(intermediateNodes.begin()),
+        std::make_move_iterator(intermediateNodes.end())};
+      compactNodeContents(expandNodeContents(
+        std::move(m_nodes), [&](auto* node) -> const mdl::NodeContents& {
+          return intermediateContents.at(node);
+        }));
+      return true;
+    }
   }
 
   return false;
 }
 
+size_t SwapNodeContentsCommand::memoryUsage() const
+{
+  return UpdateLinkedGroupsCommandBase::memoryUsage() + m_memoryUsage;
+}
+
+void SwapNodeContentsCommand::swapNodeContents(MapDocumentCommandFacade& document)
+{
+  auto nodes = expandNodeContents(
+    std::move(m_nodes), [](const auto* node) -> const mdl::Node& { return *node; });
+  document.performSwapNodeContents(nodes);
+  compactNodeContents(std::move(nodes));
+}
+
+void SwapNodeContentsCommand::compactNodeContents(
+  std::vector<std::pair<mdl::Node*, mdl::NodeContents>> nodes)
+{
+  m_nodes = kdl::vec_transform(std::move(nodes), [](auto pair) {
+    return std::pair{
+      pair.first, mdl::CompactNodeContents{std::move(pair.second), *pair.first}};
+  });
+  updateMemoryUsage();
+}
+
+void SwapNodeContentsCommand::updateMemoryUsage()
+{
+  m_memoryUsage = 0;
+  for (const auto& [node, contents] : m_nodes)
+  {
+    m_memoryUsage += contents.memoryUsage();
+  }
+}
+
 } // namespace tb::ui
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Macros.h"
+#include "mdl/CompactNodeContents.h"
 #include "mdl/NodeContents.h"
 #include "ui/UpdateLinkedGroupsCommandBase.h"
 
@@ -35,10 +36,20 @@ class Node;
 namespace tb::ui
 {
 
+/**
+ * Swaps the contents of the given nodes with the given contents.
+ *
+ * After every swap, the contents held by this command are compacted against the current
+ * contents of their nodes, so that brushes are only stored as the differences to the
+ * current brushes. See mdl::CompactNodeContents.
+ */
 class SwapNodeContentsCommand : public UpdateLinkedGroupsCommandBase
 {
 protected:
-  std::vector<std::pair<mdl::Node*, mdl::NodeContents>> m_nodes;
+  std::vector<std::pair<mdl::Node*, mdl::CompactNodeContents>> m_nodes;
+
+private:
+  size_t m_memoryUsage = 0;
 
 public:
   SwapNodeContentsCommand(
@@ -51,6 +62,13 @@ public:
 
   bool doCollateWith(UndoableCommand& command) override;
 
+  size_t memoryUsage() const override;
+
+private:
+  void swapNodeContents(MapDocumentCommandFacade& document);
+  void compactNodeContents(std::vector<std::pair<mdl::Node*, mdl::NodeContents>> nodes);
+  void updateMemoryUsage();
+
   deleteCopyAndMove(SwapNodeContentsCommand);
 };
 
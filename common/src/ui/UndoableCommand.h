@@ -45,6 +45,12 @@ public:
 
   virtual bool collateWith(UndoableCommand& command);
 
+  /**
+   * Returns an estimate of the number of bytes this command uses to store the information
+   * it needs to be undone and redone.
+   */
+  virtual size_t memoryUsage() const;
+
 protected:
   virtual std::unique_ptr<CommandResult> doPerformUndo(
     MapDocumentCommandFacade& document) = 0;
@@ -25,9 +25,13 @@ namespace tb::ui
 {
 
 UpdateLinkedGroupsCommand::UpdateLinkedGroupsCommand(
-  std::vector<mdl::GroupNode*> changedLinkedGroups)
+  std::vector<mdl::GroupNode*> changedLinkedGroups,
+  std::optional<size_t> consistentModificationCount)
   : UpdateLinkedGroupsCommandBase{
-      "Update Linked Groups", true, std::move(changedLinkedGroups)}
+      "Update Linked Groups",
+      true,
+      std::move(changedLinkedGroups),
+      consistentModificationCount}
 {
 }
 
@@ -22,6 +22,7 @@
 #include "Macros.h"
 #include "ui/UpdateLinkedGroupsCommandBase.h"
 
+#include <optional>
 #include <vector>
 
 namespace tb::mdl
@@ -35,7 +36,9 @@ namespace tb::ui
 class UpdateLinkedGroupsCommand : public UpdateLinkedGroupsCommandBase
 {
 public:
-  explicit UpdateLinkedGroupsCommand(std::vector<mdl::GroupNode*> changedLinkedGroups);
+  explicit UpdateLinkedGroupsCommand(
+    std::vector<mdl::GroupNode*> changedLinkedGroups,
+    std::optional<size_t> consistentModificationCount = std::nullopt);
   ~UpdateLinkedGroupsCommand() override;
 
   std::unique_ptr<CommandResult> doPerformDo(MapDocumentCommandFacade& document) override;
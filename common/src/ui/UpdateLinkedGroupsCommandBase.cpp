@@ -32,9 +32,11 @@ namespace tb::ui
 UpdateLinkedGroupsCommandBase::UpdateLinkedGroupsCommandBase(
   std::string name,
   const bool updateModificationCount,
-  std::vector<mdl::GroupNode*> changedLinkedGroups)
+  std::vector<mdl::GroupNode*> changedLinkedGroups,
+  std::optional<size_t> consistentModificationCount)
   : UndoableCommand{std::move(name), updateModificationCount}
-  , m_updateLinkedGroupsHelper{std::move(changedLinkedGroups)}
+  , m_updateLinkedGroupsHelper{
+      std::move(changedLinkedGroups), consistentModificationCount}
 {
 }
 
@@ -101,4 +103,9 @@ bool UpdateLinkedGroupsCommandBase::collateWith(UndoableCommand& command)
   return false;
 }
 
+size_t UpdateLinkedGroupsCommandBase::memoryUsage() const
+{
+  return UndoableCommand::memoryUsage() + m_updateLinkedGroupsHelper.memoryUsage();
+}
+
 } // namespace tb::ui
@@ -24,6 +24,7 @@
 #include "ui/UpdateLinkedGroupsHelper.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 
 namespace tb::ui
@@ -39,7 +40,8 @@ protected:
   UpdateLinkedGroupsCommandBase(
     std::string name,
     bool updateModificationCount,
-    std::vector<mdl::GroupNode*> changedLinkedGroups = {});
+    std::vector<mdl::GroupNode*> changedLinkedGroups = {},
+    std::optional<size_t> consistentModificationCount = std::nullopt);
 
 public:
   ~UpdateLinkedGroupsCommandBase() override;
@@ -49,6 +51,8 @@ public:
 
   bool collateWith(UndoableCommand& command) override;
 
+  size_t memoryUsage() const override;
+
 private:
   deleteCopyAndMove(UpdateLinkedGroupsCommandBase);
 };
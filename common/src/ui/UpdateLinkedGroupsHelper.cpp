@@ -19,6 +19,7 @@
 
 #include "UpdateLinkedGroupsHelper.h"
 
+#include "mdl/CompactNodeContents.h"
 #include "mdl/GroupNode.h"
 #include "mdl/LinkedGroupUtils.h"
 #include "mdl/ModelUtils.h"
@@ -47,6 +48,30 @@ auto compareByAncestry(const mdl::GroupNode* lhs, const mdl::GroupNode* rhs)
   return rhs->isAncestorOf(lhs);
 }
 
+/**
+ * Moves the entries of the given source vector whose nodes are not yet contained in the
+ * given destination vector to the end of the destination vector.
+ */
+template <typename T>
+void appendUniqueNodes(
+  std::vector<std::pair<mdl::Node*, T>>& destination,
+  std::vector<std::pair<mdl::Node*, T>>& source)
+{
+  auto nodes = std::unordered_set<const mdl::Node*>{};
+  for (const auto& [node, value] : destination)
+  {
+    nodes.insert(node);
+  }
+
+  for (auto& [node, value] : source)
+  {
+    if (nodes.insert(node).second)
+    {
+      destination.emplace_back(node, std::move(value));
+    }
+  }
+}
+
 } // namespace
 
 bool checkLinkedGroupsToUpdate(const std::vector<mdl::GroupNode*>& changedLinkedGroups)
@@ -60,8 +85,10 @@ bool checkLinkedGroupsToUpdate(const std::vector<mdl::GroupNode*>& changedLinked
 }
 
 UpdateLinkedGroupsHelper::UpdateLinkedGroupsHelper(
-  ChangedLinkedGroups changedLinkedGroups)
+  ChangedLinkedGroups changedLinkedGroups,
+  std::optional<size_t> consistentModificationCount)
   : m_state{kdl::vec_sort(std::move(changedLinkedGroups), compareByAncestry)}
+  , m_consistentModificationCount{consistentModificationCount}
 {
 }
 
@@ -71,45 +98,48 @@ Result<void> UpdateLinkedGroupsHelper::applyLinkedGroupUpdates(
   MapDocumentCommandFacade& document)
 {
   return computeLinkedGroupUpdates(document)
-         | kdl::transform([&]() { doApplyOrUndoLinkedGroupUpdates(document); });
+         | kdl::transform([&]() { doApplyOrUndoLinkedGroupUpdates(document, true); });
 }
 
 void UpdateLinkedGroupsHelper::undoLinkedGroupUpdates(MapDocumentCommandFacade& document)
 {
-  doApplyOrUndoLinkedGroupUpdates(document);
+  doApplyOrUndoLinkedGroupUpdates(document, false);
 }
 
 void UpdateLinkedGroupsHelper::collateWith(UpdateLinkedGroupsHelper& other)
 {
   // Both helpers have already applied their changes at this point, so in both helpers,
-  // m_linkedGroups contains pairs p where
-  // - p.first is the group node to update
-  // - p.second is a vector containing the group node's original children
+  // m_state contains
+  // - pairs p of linked group nodes and their original children where
+  //   - p.first is the group node to update
+  //   - p.second is a vector containing the group node's original children
+  // - pairs p of linked nodes and their original contents where
+  //   - p.first is the node to update
+  //   - p.second contains the node's original contents
   //
-  // Let p_o be an update from the other helper. If p_o is an update for a linked group
-  // node that was updated by this helper, then there is a pair p_t in this helper such
-  // that p_t.first == p_o.first. In this case, we want to keep the old children of the
-  // linked group node stored in this helper and discard those in the other helper. If
-  // p_o is not an update for a linked group node that was updated by this helper, then
-  // we will add p_o to our updates and remove it from the other helper's updates to
-  // prevent the replaced node to be deleted with the other helper.
+  // Let p_o be an update from the other helper. If p_o is an update for a node that was
+  // updated by this helper, then there is a pair p_t in this helper such that p_t.first
+  // == p_o.first. In this case, we want to keep the original children or contents of the
+  // node stored in this helper and discard those in the other helper. If p_o is not an
+  // update for a node that was updated by this helper, then we will add p_o to our
+  // updates and remove it from the other helper's updates to prevent the replaced nodes
+  // to be deleted with the other helper.
 
   auto& myLinkedGroupUpdates = std::get<LinkedGroupUpdates>(m_state);
   auto& theirLinkedGroupUpdates = std::get<LinkedGroupUpdates>(other.m_state);
 
-  for (auto& [theirGroupNodeToUpdate_, theirOldChildren] : theirLinkedGroupUpdates)
-  {
-    const auto myIt = std::ranges::find_if(
-      myLinkedGroupUpdates,
-      [theirGroupNodeToUpdate = theirGroupNodeToUpdate_](const auto& p) {
-        return p.first == theirGroupNodeToUpdate;
-      });
-    if (myIt == std::end(myLinkedGroupUpdates))
-    {
-      myLinkedGroupUpdates.emplace_back(
-        theirGroupNodeToUpdate_, std::move(theirOldChildren));
-    }
-  }
+  appendUniqueNodes(
+    myLinkedGroupUpdates.childrenToReplace, theirLinkedGroupUpdates.childrenToReplace);
+  appendUniqueNodes(
+    myLinkedGroupUpdates.contentsToSwap, theirLinkedGroupUpdates.contentsToSwap);
+
+  updateMemoryUsage();
+  other.updateMemoryUsage();
+}
+
+size_t UpdateLinkedGroupsHelper::memoryUsage() const
+{
+  return m_memoryUsage;
 }
 
 Result<void> UpdateLinkedGroupsHelper::computeLinkedGroupUpdates(
@@ -118,7 +148,8 @@ Result<void> UpdateLinkedGroupsHelper::computeLinkedGroupUpdates(
   return std::visit(
     kdl::overload(
       [&](const ChangedLinkedGroups& changedLinkedGroups) {
-        return computeLinkedGroupUpdates(changedLinkedGroups, document)
+        return computeLinkedGroupUpdates(
+                 changedLinkedGroups, m_consistentModificationCount, document)
                | kdl::transform([&](auto&& linkedGroupUpdates) {
                    m_state =
                      std::forward<decltype(linkedGroupUpdates)>(linkedGroupUpdates);
@@ -130,7 +161,9 @@ Result<void> UpdateLinkedGroupsHelper::computeLinkedGroupUpdates(
 
 Result<UpdateLinkedGroupsHelper::LinkedGroupUpdates> UpdateLinkedGroupsHelper::
   computeLinkedGroupUpdates(
-    const ChangedLinkedGroups& changedLinkedGroups, MapDocumentCommandFacade& document)
+    const ChangedLinkedGroups& changedLinkedGroups,
+    const std::optional<size_t> consistentModificationCount,
+    MapDocumentCommandFacade& document)
 {
   if (!checkLinkedGroupsToUpdate(changedLinkedGroups))
   {
@@ -144,24 +177,89 @@ Result<UpdateLinkedGroupsHelper::LinkedGroupUpdates> UpdateLinkedGroupsHelper::
              groupNode);
 
            return mdl::updateLinkedGroups(
-             *groupNode, groupNodesToUpdate, worldBounds, document.taskManager());
+             *groupNode,
+             groupNodesToUpdate,
+             worldBounds,
+             document.taskManager(),
+             consistentModificationCount);
          })
-         | kdl::fold
-         | kdl::and_then([&](auto nestedUpdateLists) -> Result<LinkedGroupUpdates> {
-             return kdl::vec_flatten(std::move(nestedUpdateLists));
+         | kdl::fold | kdl::transform([](auto nestedUpdateLists) {
+             // Nested link sets can result in multiple updates for the same node. Only
+             // the last update for each node is kept, and the order of the updates is
+             // preserved so that descendants are still updated before their ancestors.
+             auto result = LinkedGroupUpdates{};
+             for (auto& updates : nestedUpdateLists | std::views::reverse)
+             {
+               std::ranges::reverse(updates.childrenToReplace);
+               std::ranges::reverse(updates.contentsToSwap);
+               appendUniqueNodes(result.childrenToReplace, updates.childrenToReplace);
+               appendUniqueNodes(result.contentsToSwap, updates.contentsToSwap);
+             }
+             std::ranges::reverse(result.childrenToReplace);
+             std::ranges::reverse(result.contentsToSwap);
+             return result;
            });
 }
 
 void UpdateLinkedGroupsHelper::doApplyOrUndoLinkedGroupUpdates(
-  MapDocumentCommandFacade& document)
+  MapDocumentCommandFacade& document, const bool apply)
 {
-  std::visit(
-    kdl::overload(
-      [](const ChangedLinkedGroups&) {},
-      [&](LinkedGroupUpdates&& linkedGroupUpdates) {
-        m_state = document.performReplaceChildren(std::move(linkedGroupUpdates));
-      }),
-    std::move(m_state));
+  auto* linkedGroupUpdates = std::get_if<LinkedGroupUpdates>(&m_state);
+  if (!linkedGroupUpdates)
+  {
+    return;
+  }
+
+  // Swapped nodes may belong to a subtree whose children are replaced by another update,
+  // so we must swap them while they are still in the document, and restore the subtree
+  // before swapping them back.
+  const auto swapNodeContents = [&]() {
+    if (!linkedGroupUpdates->contentsToSwap.empty())
+    {
+      document.performSwapNodeContents(linkedGroupUpdates->contentsToSwap);
+    }
+  };
+  const auto replaceChildren = [&]() {
+    if (!linkedGroupUpdates->childrenToReplace.empty())
+    {
+      linkedGroupUpdates->childrenToReplace = document.performReplaceChildren(
+        std::move(linkedGroupUpdates->childrenToReplace));
+    }
+  };
+
+  if (apply)
+  {
+    swapNodeContents();
+    replaceChildren();
+  }
+  else
+  {
+    replaceChildren();
+    swapNodeContents();
+  }
+
+  updateMemoryUsage();
+}
+
+void UpdateLinkedGroupsHelper::updateMemoryUsage()
+{
+  // Computing the memory usage visits every node, so it is only done when the nodes
+  // held by this helper change.
+  m_memoryUsage = 0;
+  if (const auto* linkedGroupUpdates = std::get_if<LinkedGroupUpdates>(&m_state))
+  {
+    for (const auto& [node, children] : linkedGroupUpdates->childrenToReplace)
+    {
+      for (const auto& child : children)
+      {
+        m_memoryUsage += mdl::memoryUsage(*child);
+      }
+    }
+    for (const auto& [node, contents] : linkedGroupUpdates->contentsToSwap)
+    {
+      m_memoryUsage += mdl::memoryUsage(contents);
+    }
+  }
 }
 
 } // namespace tb::ui
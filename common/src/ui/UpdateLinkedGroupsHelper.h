@@ -20,16 +20,15 @@
 #pragma once
 
 #include "Result.h"
+#include "mdl/LinkedGroupUtils.h"
 
-#include <memory>
-#include <utility>
+#include <optional>
 #include <variant>
 #include <vector>
 
 namespace tb::mdl
 {
 class GroupNode;
-class Node;
 } // namespace tb::mdl
 
 namespace tb::ui
@@ -49,33 +48,48 @@ bool checkLinkedGroupsToUpdate(const std::vector<mdl::GroupNode*>& changedLinked
  *
  * The class is initialized with a vector of group nodes whose changes should be
  * propagated to the members of their respective link sets. When applyLinkedGroupUpdates
- * is first called, a replacement node is created for each linked group that needs to be
- * updated, and these linked groups are replaced with their replacements. Calling
- * applyLinkedGroupUpdates replaces the replacement nodes with their original
- * corresponding groups again, effectively undoing the change.
+ * is first called, the nodes of the linked groups that need to be updated are replaced
+ * with their replacements. Calling applyLinkedGroupUpdates replaces the replacements
+ * with their original corresponding nodes again, effectively undoing the change.
+ *
+ * If the helper is given the modification count at which all linked groups were last
+ * consistent, then only the nodes that were modified since then are propagated.
+ * Otherwise, all children of the linked groups are replaced.
  */
 class UpdateLinkedGroupsHelper
 {
 private:
   using ChangedLinkedGroups = std::vector<mdl::GroupNode*>;
-  using LinkedGroupUpdates =
-    std::vector<std::pair<mdl::Node*, std::vector<std::unique_ptr<mdl::Node>>>>;
+  using LinkedGroupUpdates = mdl::UpdateLinkedGroupsResult;
   std::variant<ChangedLinkedGroups, LinkedGroupUpdates> m_state;
+  std::optional<size_t> m_consistentModificationCount;
+  size_t m_memoryUsage = 0;
 
 public:
-  explicit UpdateLinkedGroupsHelper(ChangedLinkedGroups changedLinkedGroups);
+  explicit UpdateLinkedGroupsHelper(
+    ChangedLinkedGroups changedLinkedGroups,
+    std::optional<size_t> consistentModificationCount = std::nullopt);
   ~UpdateLinkedGroupsHelper();
 
   Result<void> applyLinkedGroupUpdates(MapDocumentCommandFacade& document);
   void undoLinkedGroupUpdates(MapDocumentCommandFacade& document);
   void collateWith(UpdateLinkedGroupsHelper& other);
 
+  /**
+   * Returns an estimate of the number of bytes used by the nodes and node contents that
+   * this helper holds to undo or redo its updates.
+   */
+  size_t memoryUsage() const;
+
 private:
   Result<void> computeLinkedGroupUpdates(MapDocumentCommandFacade& document);
   static Result<LinkedGroupUpdates> computeLinkedGroupUpdates(
-    const ChangedLinkedGroups& changedLinkedGroups, MapDocumentCommandFacade& document);
+    const ChangedLinkedGroups& changedLinkedGroups,
+    std::optional<size_t> consistentModificationCount,
+    MapDocumentCommandFacade& document);
 
-  void doApplyOrUndoLinkedGroupUpdates(MapDocumentCommandFacade& document);
+  void doApplyOrUndoLinkedGroupUpdates(MapDocumentCommandFacade& document, bool apply);
+  void updateMemoryUsage();
 };
 
 } // namespace tb::ui
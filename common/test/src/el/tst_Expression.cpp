@@ -1202,6 +1202,23 @@ TEST_CASE("Expression")
       preorderVisit("{{ x -> 1 }}")
       == std::vector<std::string>{"{{ x -> 1 }}", "x -> 1", "x", "1"});
   }
+
+  SECTION("variableNames")
+  {
+    const auto variableNames = [](const auto& str) {
+      return io::ELParser::parseStrict(str).value().variableNames();
+    };
+
+    CHECK(variableNames("1") == std::vector<std::string>{});
+    CHECK(variableNames("a") == std::vector<std::string>{"a"});
+    CHECK(variableNames("[b, a, b]") == std::vector<std::string>{"a", "b"});
+    CHECK(variableNames("{x: a, y: 2}") == std::vector<std::string>{"a"});
+    CHECK(variableNames("-a + b") == std::vector<std::string>{"a", "b"});
+    CHECK(variableNames("a[b]") == std::vector<std::string>{"a", "b"});
+    CHECK(
+      variableNames("{{ a == 1 -> b, c }}")
+      == std::vector<std::string>{"a", "b", "c"});
+  }
 }
 
 } // namespace tb::el
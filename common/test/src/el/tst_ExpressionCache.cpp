@@ -0,0 +1,70 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "el/ExpressionCache.h"
+#include "el/Value.h"
+#include "el/VariableStore.h"
+
+#include "Catch2.h"
+
+namespace tb::el
+{
+
+TEST_CASE("ExpressionCache")
+{
+  auto cache = ExpressionCache<int>{{"a", "b"}};
+  auto evaluations = 0;
+
+  // returns the number of the evaluation that produced the result
+  const auto getOrEvaluate = [&](const MapType& variables) {
+    return cache.getOrEvaluate(VariableTable{variables}, [&]() { return ++evaluations; });
+  };
+
+  SECTION("Evaluates only once for the same variable values")
+  {
+    CHECK(getOrEvaluate({{"a", Value{"x"}}, {"b", Value{"y"}}}) == 1);
+    CHECK(getOrEvaluate({{"a", Value{"x"}}, {"b", Value{"y"}}}) == 1);
+    CHECK(cache.size() == 1);
+  }
+
+  SECTION("Ignores variables that are not referenced")
+  {
+    CHECK(getOrEvaluate({{"a", Value{"x"}}, {"b", Value{"y"}}}) == 1);
+    CHECK(getOrEvaluate({{"a", Value{"x"}}, {"b", Value{"y"}}, {"c", Value{"z"}}}) == 1);
+  }
+
+  SECTION("Evaluates again for different variable values")
+  {
+    CHECK(getOrEvaluate({{"a", Value{"x"}}, {"b", Value{"y"}}}) == 1);
+    CHECK(getOrEvaluate({{"a", Value{"x"}}, {"b", Value{"z"}}}) == 2);
+    CHECK(getOrEvaluate({{"a", Value{"xy"}}, {"b", Value{""}}}) == 3);
+    CHECK(getOrEvaluate({{"a", Value{"x"}}, {"b", Value{"z"}}}) == 2);
+    CHECK(cache.size() == 3);
+  }
+
+  SECTION("Does not cache results for values that are not strings")
+  {
+    CHECK(getOrEvaluate({{"a", Value{"x"}}, {"b", Value{1}}}) == 1);
+    CHECK(getOrEvaluate({{"a", Value{"x"}}, {"b", Value{1}}}) == 2);
+    CHECK(getOrEvaluate({{"a", Value{"x"}}}) == 3);
+    CHECK(cache.size() == 0);
+  }
+}
+
+} // namespace tb::el
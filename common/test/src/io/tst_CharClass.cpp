@@ -0,0 +1,88 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "io/CharClass.h"
+
+#include <string>
+
+#include "Catch2.h"
+
+namespace tb::io
+{
+
+TEST_CASE("CharClass")
+{
+  SECTION("contains")
+  {
+    const auto charClass = CharClass{" \t\xff"};
+    CHECK(charClass.contains(' '));
+    CHECK(charClass.contains('\t'));
+    CHECK(charClass.contains('\xff'));
+    CHECK_FALSE(charClass.contains('\n'));
+    CHECK_FALSE(charClass.contains('\0'));
+    CHECK_FALSE(CharClass{}.contains(' '));
+  }
+
+  SECTION("operator|")
+  {
+    const auto charClass = CharClass{"ab"} | CharClass{"bc"};
+    CHECK(charClass.contains('a'));
+    CHECK(charClass.contains('b'));
+    CHECK(charClass.contains('c'));
+    CHECK_FALSE(charClass.contains('d'));
+  }
+
+  SECTION("findFirstOf")
+  {
+    const auto find = [](const CharClass& charClass, const std::string& str) {
+      return size_t(
+        charClass.findFirstOf(str.data(), str.data() + str.size()) - str.data());
+    };
+
+    CHECK(find("\n\r", "") == 0);
+    CHECK(find("\n\r", "abc") == 3);
+    CHECK(find("\n\r", "abc\ndef") == 3);
+
+    // characters found in the SIMD loop, the scalar prefix and the scalar tail
+    CHECK(find("\n\r", std::string(40, 'a') + "\r") == 40);
+    CHECK(find("\n\r", std::string(20, 'a') + "\n" + std::string(20, 'a')) == 20);
+    CHECK(find("\n\r", std::string(35, 'a') + "\n") == 35);
+    CHECK(find("\n\r", std::string(100, 'a')) == 100);
+
+    // more characters than can be compared using SIMD instructions
+    const auto large = CharClass{"abcdefghijklmnopqrstuvwxyz"};
+    CHECK(find(large, std::string(40, ' ') + "z") == 40);
+  }
+
+  SECTION("findFirstNotOf")
+  {
+    const auto find = [](const CharClass& charClass, const std::string& str) {
+      return size_t(
+        charClass.findFirstNotOf(str.data(), str.data() + str.size()) - str.data());
+    };
+
+    CHECK(find(" \t", "") == 0);
+    CHECK(find(" \t", "  a") == 2);
+    CHECK(find(" \t", std::string(40, ' ') + "a") == 40);
+    CHECK(find(" \t", std::string(20, '\t') + "a" + std::string(20, ' ')) == 20);
+    CHECK(find(" \t", std::string(100, ' ')) == 100);
+  }
+}
+
+} // namespace tb::io
@@ -30,6 +30,7 @@
 #include <fmt/std.h>
 
 #include <filesystem>
+#include <fstream>
 
 #include "Catch2.h"
 
@@ -110,6 +111,45 @@ TEST_CASE("DiskIO")
     }
   }
 
+  SECTION("fixPath after changes")
+  {
+    if (Disk::isCaseSensitive())
+    {
+      REQUIRE(Disk::fixPath(env.dir() / "TEST.txt") == env.dir() / "test.txt");
+      REQUIRE(
+        Disk::fixPath(env.dir() / "ANOTHERDIR/TEST3.map")
+        == env.dir() / "anotherDir/test3.map");
+      REQUIRE(Disk::fixPath(env.dir() / "DIR1/FILE.txt") == env.dir() / "DIR1/FILE.txt");
+
+      SECTION("Changes made using DiskIO")
+      {
+        REQUIRE(Disk::withOutputStream(env.dir() / "newFile.txt", [](auto& stream) {
+                  stream << "some text...";
+                }).is_success());
+        CHECK(Disk::fixPath(env.dir() / "NEWFILE.TXT") == env.dir() / "newFile.txt");
+
+        REQUIRE(Disk::renameDirectory(env.dir() / "anotherDir", env.dir() / "renamedDir")
+                  .is_success());
+        CHECK(
+          Disk::fixPath(env.dir() / "RENAMEDDIR/TEST3.map")
+          == env.dir() / "renamedDir/test3.map");
+        CHECK(
+          Disk::fixPath(env.dir() / "ANOTHERDIR/TEST3.map")
+          == env.dir() / "ANOTHERDIR/TEST3.map");
+      }
+
+      SECTION("Changes made elsewhere")
+      {
+        std::filesystem::rename(env.dir() / "test.txt", env.dir() / "Test.TXT");
+        CHECK(Disk::fixPath(env.dir() / "TEST.txt") == env.dir() / "Test.TXT");
+
+        std::filesystem::rename(env.dir() / "dir1", env.dir() / "Dir1");
+        std::ofstream{env.dir() / "Dir1/File.txt"} << "some text...";
+        CHECK(Disk::fixPath(env.dir() / "DIR1/FILE.txt") == env.dir() / "Dir1/File.txt");
+      }
+    }
+  }
+
   SECTION("pathInfo")
   {
     CHECK(Disk::pathInfo("asdf/bleh") == PathInfo::Unknown);
@@ -203,23 +243,24 @@ TEST_CASE("DiskIO")
 
     CHECK(
       Disk::openFile("asdf/bleh")
-      == Result<std::shared_ptr<CFile>>{Error{fmt::format(
+      == Result<std::shared_ptr<File>>{Error{fmt::format(
         "Failed to open {}: path does not denote a file",
         std::filesystem::path{"asdf/bleh"})}});
     CHECK(
       Disk::openFile(env.dir() / "does/not/exist")
-      == Result<std::shared_ptr<CFile>>{Error{fmt::format(
+      == Result<std::shared_ptr<File>>{Error{fmt::format(
         "Failed to open {}: path does not denote a file",
         env.dir() / "does/not/exist")}});
 
     CHECK(
       Disk::openFile(env.dir() / "does_not_exist.txt")
-      == Result<std::shared_ptr<CFile>>{Error{fmt::format(
+      == Result<std::shared_ptr<File>>{Error{fmt::format(
         "Failed to open {}: path does not denote a file",
         env.dir() / "does_not_exist.txt")}});
 
     auto file = Disk::openFile(env.dir() / "test.txt");
     CHECK(file.is_success());
+    CHECK(std::dynamic_pointer_cast<OwningBufferFile>(file | kdl::value()) != nullptr);
 
     file = Disk::openFile(env.dir() / "anotherDir/subDirTest/test2.map");
     CHECK(file.is_success());
@@ -231,6 +272,19 @@ TEST_CASE("DiskIO")
     CHECK(file.is_success());
   }
 
+  SECTION("openArchive")
+  {
+    CHECK(
+      Disk::openArchive(env.dir() / "does_not_exist.txt")
+      == Result<std::shared_ptr<File>>{Error{fmt::format(
+        "Failed to open {}: path does not denote a file",
+        env.dir() / "does_not_exist.txt")}});
+
+    // small archives are not memory mapped
+    auto file = Disk::openArchive(env.dir() / "test.txt");
+    CHECK(std::dynamic_pointer_cast<OwningBufferFile>(file | kdl::value()) != nullptr);
+  }
+
   SECTION("withStream")
   {
     SECTION("withInputStream")
@@ -22,6 +22,7 @@
 #include "io/DkPakFileSystem.h"
 #include "io/IdPakFileSystem.h"
 #include "io/PathInfo.h"
+#include "io/TestEnvironment.h"
 #include "io/TraversalMode.h"
 #include "io/WadFileSystem.h"
 #include "io/ZipFileSystem.h"
@@ -986,6 +987,45 @@ TEST_CASE("Flat ImageFileSystems")
 
 TEST_CASE("WadFileSystem")
 {
+  SECTION("Wad entries don't reference the wad file")
+  {
+    const auto wadPath =
+      std::filesystem::current_path() / "fixture/test/io/Wad/cr8_czg.wad";
+    const auto wadFile = Disk::openFile(wadPath) | kdl::value();
+    const auto fs = createImageFileSystem<WadFileSystem>(wadFile) | kdl::value();
+    const auto useCount = wadFile.use_count();
+
+    const auto entryFile = fs->openFile("cr8_czg_3.D") | kdl::value();
+    CHECK(wadFile.use_count() == useCount);
+
+    CHECK(std::dynamic_pointer_cast<OwningBufferFile>(entryFile) != nullptr);
+
+    const auto entryReader = entryFile->reader().buffer();
+    CHECK(
+      std::vector<unsigned char>(entryReader.begin(), entryReader.end())
+      == cr8_czg_03_contents);
+  }
+
+  SECTION("Large wad files are memory mapped")
+  {
+    const auto env = TestEnvironment{[](auto& env_) {
+      const auto wadPath =
+        std::filesystem::current_path() / "fixture/test/io/Wad/cr8_czg.wad";
+      std::filesystem::copy(wadPath, env_.dir() / "large.wad");
+      std::filesystem::resize_file(env_.dir() / "large.wad", Disk::MinMappedFileSize);
+    }};
+
+    const auto wadFile = Disk::openArchive(env.dir() / "large.wad") | kdl::value();
+    CHECK(std::dynamic_pointer_cast<MappedFile>(wadFile) != nullptr);
+
+    const auto fs = createImageFileSystem<WadFileSystem>(wadFile) | kdl::value();
+    const auto entryFile = fs->openFile("cr8_czg_3.D") | kdl::value();
+    const auto entryReader = entryFile->reader().buffer();
+    CHECK(
+      std::vector<unsigned char>(entryReader.begin(), entryReader.end())
+      == cr8_czg_03_contents);
+  }
+
   SECTION("Wad files can be replaced while wad file system exists")
   {
     const auto wadPath =
@@ -1010,6 +1050,36 @@ TEST_CASE("WadFileSystem")
       REQUIRE(std::filesystem::remove(copyPath));
     }
   }
+
+  SECTION("Large wad files can be replaced while wad file system exists")
+  {
+    auto env = TestEnvironment{[](auto& env_) {
+      const auto wadPath =
+        std::filesystem::current_path() / "fixture/test/io/Wad/cr8_czg.wad";
+      std::filesystem::copy(wadPath, env_.dir() / "large.wad");
+      std::filesystem::resize_file(env_.dir() / "large.wad", Disk::MinMappedFileSize);
+    }};
+
+    const auto fs = Disk::openArchive(env.dir() / "large.wad")
+                    | kdl::and_then([](auto file) {
+                        return createImageFileSystem<WadFileSystem>(std::move(file));
+                      })
+                    | kdl::value();
+
+    const auto entryFile = fs->openFile("cr8_czg_3.D") | kdl::value();
+
+    auto errorCode = std::error_code{};
+    CHECK(std::filesystem::remove(env.dir() / "large.wad", errorCode));
+    CHECK(errorCode == std::error_code{});
+
+    env.createFile("large.wad", "replaced");
+    CHECK(env.loadFile("large.wad") == "replaced");
+
+    const auto entryReader = entryFile->reader().buffer();
+    CHECK(
+      std::vector<unsigned char>(entryReader.begin(), entryReader.end())
+      == cr8_czg_03_contents);
+  }
 }
 
 } // namespace tb::io
@@ -0,0 +1,216 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "io/MapCache.h"
+#include "io/NodeWriter.h"
+#include "io/Reader.h"
+#include "io/TestParserStatus.h"
+#include "io/WorldReader.h"
+#include "mdl/GameConfig.h"
+#include "mdl/WorldNode.h"
+
+#include "kdl/result.h"
+#include "kdl/task_manager.h"
+
+#include <sstream>
+#include <string>
+
+#include "Catch2.h"
+
+namespace tb::io
+{
+namespace
+{
+
+const auto StandardMap = R"(
+{
+"classname" "worldspawn"
+"message" "cached"
+{
+( -800 288 1024 ) ( -736 288 1024 ) ( -736 224 1024 ) METAL4_5 64 0 0 1 1
+( -800 288 1024 ) ( -800 224 1024 ) ( -800 224 576 ) METAL4_5 0 0 0 1 1
+( -736 224 1024 ) ( -736 288 1024 ) ( -736 288 576 ) METAL4_5 0 0 0 1 1
+( -736 288 1024 ) ( -800 288 1024 ) ( -800 288 576 ) METAL4_5 64 0 0 1 1
+( -800 224 1024 ) ( -736 224 1024 ) ( -736 224 576 ) METAL4_5 64 0 0 1 1
+( -800 224 576 ) ( -736 224 576 ) ( -736 288 576 ) METAL4_5 64 0 15 1 1
+}
+}
+{
+"classname" "func_group"
+"_tb_type" "_tb_layer"
+"_tb_name" "My Layer"
+"_tb_id" "1"
+}
+{
+"classname" "func_group"
+"_tb_type" "_tb_group"
+"_tb_name" "My Group"
+"_tb_id" "2"
+"_tb_linked_group_id" "linked_group_id"
+"_tb_layer" "1"
+}
+{
+"classname" "light"
+"origin" "0 0 0"
+"_tb_group" "2"
+}
+{
+"classname" "func_door"
+"_tb_layer" "1"
+{
+( 0 0 0 ) ( 0 1 0 ) ( 0 0 1 ) DOOR 0 0 0 0.5 2
+( 0 0 0 ) ( 0 0 1 ) ( 1 0 0 ) DOOR 0 0 0 1 1
+( 0 0 0 ) ( 1 0 0 ) ( 0 1 0 ) DOOR 0 0 0 1 1
+( 64 64 64 ) ( 64 64 65 ) ( 64 65 64 ) DOOR 0 0 0 1 1
+( 64 64 64 ) ( 65 64 64 ) ( 64 64 65 ) DOOR 0 0 0 1 1
+( 64 64 64 ) ( 64 65 64 ) ( 65 64 64 ) DOOR 0 0 0 1 1
+}
+}
+)";
+
+const auto ValveMap = R"(
+{
+"classname" "worldspawn"
+"mapversion" "220"
+{
+( -800 288 1024 ) ( -736 288 1024 ) ( -736 224 1024 ) METAL4_5 [ 1 0 0 64 ] [ 0 -1 0 0 ] 0 1 1
+( -800 288 1024 ) ( -800 224 1024 ) ( -800 224 576 ) METAL4_5 [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -736 224 1024 ) ( -736 288 1024 ) ( -736 288 576 ) METAL4_5 [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -736 288 1024 ) ( -800 288 1024 ) ( -800 288 576 ) METAL4_5 [ 1 0 0 64 ] [ 0 0 -1 0 ] 0 1 1
+( -800 224 1024 ) ( -736 224 1024 ) ( -736 224 576 ) METAL4_5 [ 1 0 0 64 ] [ 0 0 -1 0 ] 0 1 1
+( -800 224 576 ) ( -736 224 576 ) ( -736 288 576 ) METAL4_5 [ 0.7 0.7 0 64 ] [ 0 -1 0 0 ] 0 0.5 1
+}
+}
+{
+"classname" "info_player_start"
+"origin" "32 32 24"
+}
+)";
+
+std::string writeMap(const mdl::WorldNode& worldNode, kdl::task_manager& taskManager)
+{
+  auto str = std::stringstream{};
+  auto writer = NodeWriter{worldNode, str};
+  writer.writeMap(taskManager);
+  return str.str();
+}
+
+} // namespace
+
+TEST_CASE("MapCache")
+{
+  auto taskManager = kdl::task_manager{};
+  const auto worldBounds = vm::bbox3d{8192.0};
+  auto status = TestParserStatus{};
+
+  using T = std::tuple<std::string, mdl::MapFormat>;
+
+  // clang-format off
+  const auto
+  [data,       mapFormat] = GENERATE(values<T>({
+  {StandardMap, mdl::MapFormat::Standard},
+  {ValveMap,    mdl::MapFormat::Valve},
+  }));
+  // clang-format on
+
+  CAPTURE(mapFormat);
+
+  auto gameConfig = mdl::GameConfig{};
+  gameConfig.name = "Quake";
+
+  const auto key = makeMapCacheKey(data, gameConfig, mapFormat);
+
+  auto cache = std::stringstream{};
+  auto worldReader = WorldReader{data, mapFormat, {}};
+  auto worldNode = worldReader.read(
+    worldBounds,
+    status,
+    taskManager,
+    [&](const auto parsedMapFormat, const auto& objectInfos) {
+      CHECK(parsedMapFormat == mapFormat);
+      REQUIRE(writeMapCache(cache, key, parsedMapFormat, objectInfos).is_success());
+    });
+  REQUIRE(worldNode.is_success());
+
+  const auto cacheData = cache.str();
+  REQUIRE(!cacheData.empty());
+
+  SECTION("Restores the parsed map")
+  {
+    auto mapCache = readMapCache(
+      Reader::from(cacheData.data(), cacheData.data() + cacheData.size()), key);
+    REQUIRE(mapCache.is_success());
+    CHECK(mapCache.value().mapFormat == mapFormat);
+
+    const auto cachedWorldNode = WorldReader::readFromCache(
+      std::move(mapCache).value(), worldBounds, {}, status, taskManager);
+    REQUIRE(cachedWorldNode != nullptr);
+    CHECK(cachedWorldNode->mapFormat() == mapFormat);
+    CHECK(
+      writeMap(*cachedWorldNode, taskManager)
+      == writeMap(*worldNode.value(), taskManager));
+  }
+
+  SECTION("Rejects a stale cache")
+  {
+    const auto cacheReader =
+      Reader::from(cacheData.data(), cacheData.data() + cacheData.size());
+
+    CHECK(readMapCache(
+            cacheReader, makeMapCacheKey(std::string{data} + " ", gameConfig, mapFormat))
+            .is_error());
+    CHECK(readMapCache(
+            cacheReader, makeMapCacheKey(data, gameConfig, mdl::MapFormat::Unknown))
+            .is_error());
+
+    auto otherGameConfig = gameConfig;
+    otherGameConfig.name = "Quake 2";
+    CHECK(readMapCache(cacheReader, makeMapCacheKey(data, otherGameConfig, mapFormat))
+            .is_error());
+
+    otherGameConfig = gameConfig;
+    otherGameConfig.entityConfig.setDefaultProperties = true;
+    CHECK(readMapCache(cacheReader, makeMapCacheKey(data, otherGameConfig, mapFormat))
+            .is_error());
+  }
+
+  SECTION("Rejects a corrupt cache")
+  {
+    const auto truncatedData = cacheData.substr(0, cacheData.size() / 2);
+    CHECK(readMapCache(
+            Reader::from(
+              truncatedData.data(), truncatedData.data() + truncatedData.size()),
+            key)
+            .is_error());
+
+    auto invalidData = cacheData;
+    invalidData[0] = 'X';
+    CHECK(readMapCache(
+            Reader::from(invalidData.data(), invalidData.data() + invalidData.size()),
+            key)
+            .is_error());
+  }
+}
+
+TEST_CASE("mapCachePath")
+{
+  CHECK(mapCachePath("/maps/e1m1.map") == "/maps/e1m1.map.tbcache");
+}
+
+} // namespace tb::io
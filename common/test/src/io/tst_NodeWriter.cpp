@@ -18,6 +18,7 @@
  */
 
 #include "TestUtils.h"
+#include "io/EntityTextCache.h"
 #include "io/NodeWriter.h"
 #include "mdl/BrushBuilder.h"
 #include "mdl/BrushFace.h"
@@ -38,6 +39,7 @@
 #include <fmt/format.h>
 
 #include <sstream>
+#include <tuple>
 #include <vector>
 
 #include "catch/Matchers.h"
@@ -1105,6 +1107,132 @@ TEST_CASE("NodeWriter")
 
     CHECK(actual == expected);
   }
+
+  SECTION("writeMapCachesSerializedBrushFaces")
+  {
+    const auto worldBounds = vm::bbox3d{8192.0};
+
+    auto map = mdl::WorldNode{{}, {}, mdl::MapFormat::Standard};
+    auto builder = mdl::BrushBuilder{map.mapFormat(), worldBounds};
+
+    auto* brushNode = new mdl::BrushNode{builder.createCube(64.0, "none") | kdl::value()};
+    map.defaultLayer()->addChild(brushNode);
+
+    const auto writeMap = [&](const mdl::WorldNode& world) {
+      auto str = std::stringstream{};
+      auto writer = NodeWriter{world, str};
+      writer.writeMap(taskManager);
+      return str.str();
+    };
+
+    CHECK(brushNode->serializedFaces(mdl::MapFormat::Standard) == nullptr);
+
+    const auto expected = writeMap(map);
+    REQUIRE(brushNode->serializedFaces(mdl::MapFormat::Standard) != nullptr);
+    CHECK(brushNode->serializedFaces(mdl::MapFormat::Valve) == nullptr);
+    CHECK_THAT(
+      expected,
+      Catch::Contains(brushNode->serializedFaces(mdl::MapFormat::Standard)->text));
+
+    CHECK(writeMap(map) == expected);
+
+    auto brush = brushNode->brush();
+    auto attributes = brush.face(0).attributes();
+    attributes.setXOffset(16.0f);
+    brush.face(0).setAttributes(attributes);
+    brushNode->setBrush(std::move(brush));
+
+    CHECK(brushNode->serializedFaces(mdl::MapFormat::Standard) == nullptr);
+
+    auto otherMap = mdl::WorldNode{{}, {}, mdl::MapFormat::Standard};
+    otherMap.defaultLayer()->addChild(new mdl::BrushNode{brushNode->brush()});
+
+    CHECK(writeMap(map) == writeMap(otherMap));
+  }
+
+  SECTION("writeMapWithEntityTextCache")
+  {
+    const auto worldBounds = vm::bbox3d{8192.0};
+
+    auto map = mdl::WorldNode{{}, {}, mdl::MapFormat::Standard};
+    auto builder = mdl::BrushBuilder{map.mapFormat(), worldBounds};
+
+    auto* worldBrushNode =
+      new mdl::BrushNode{builder.createCube(64.0, "none") | kdl::value()};
+    auto* entityNode = new mdl::EntityNode{mdl::Entity{{{"classname", "func_door"}}}};
+    auto* entityBrushNode =
+      new mdl::BrushNode{builder.createCube(32.0, "door") | kdl::value()};
+    entityNode->addChild(entityBrushNode);
+    map.defaultLayer()->addChildren({worldBrushNode, entityNode});
+
+    const auto writeWithoutCache = [&]() {
+      auto str = std::stringstream{};
+      auto writer = NodeWriter{map, str};
+      writer.writeMap(taskManager);
+      return std::tuple{
+        str.str(), entityNode->lineNumber(), entityBrushNode->lineNumber()};
+    };
+
+    auto cache = EntityTextCache{};
+    const auto writeWithCache = [&]() {
+      auto str = std::stringstream{};
+      auto writer = NodeWriter{map, str, cache};
+      writer.writeMap(taskManager);
+      return std::tuple{
+        str.str(), entityNode->lineNumber(), entityBrushNode->lineNumber()};
+    };
+
+    CHECK(writeWithCache() == writeWithoutCache());
+    CHECK(cache.size() == 2u);
+    CHECK(writeWithCache() == writeWithoutCache());
+
+    SECTION("Changing a brush")
+    {
+      entityBrushNode->setBrush(builder.createCube(16.0, "door") | kdl::value());
+      CHECK(writeWithCache() == writeWithoutCache());
+    }
+
+    SECTION("Changing entity properties")
+    {
+      entityNode->setEntity(mdl::Entity{{{"classname", "func_wall"}}});
+      CHECK(writeWithCache() == writeWithoutCache());
+    }
+
+    SECTION("Changing a worldspawn brush")
+    {
+      worldBrushNode->setBrush(builder.createCube(128.0, "none") | kdl::value());
+      CHECK(writeWithCache() == writeWithoutCache());
+      CHECK(cache.size() == 2u);
+    }
+
+    SECTION("Changing worldspawn properties")
+    {
+      map.setEntity(mdl::Entity{{{"classname", "worldspawn"}, {"wad", "some.wad"}}});
+      CHECK(writeWithCache() == writeWithoutCache());
+      CHECK(cache.size() == 2u);
+    }
+
+    SECTION("Moving an unchanged entity to another line")
+    {
+      auto* otherBrushNode =
+        new mdl::BrushNode{builder.createCube(128.0, "none") | kdl::value()};
+      map.defaultLayer()->addChild(otherBrushNode);
+
+      const auto [cachedStr, cachedEntityLine, cachedBrushLine] = writeWithCache();
+      const auto [str, entityLine, brushLine] = writeWithoutCache();
+      CHECK(cachedStr == str);
+      CHECK(cachedEntityLine == entityLine);
+      CHECK(cachedBrushLine == brushLine);
+    }
+
+    SECTION("Removing an entity")
+    {
+      map.defaultLayer()->removeChild(entityNode);
+      CHECK(std::get<0>(writeWithCache()) == std::get<0>(writeWithoutCache()));
+      CHECK(cache.size() == 1u);
+      delete entityNode;
+    }
+  }
 }
 
 } // namespace tb::io
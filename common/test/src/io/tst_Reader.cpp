@@ -17,11 +17,14 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "io/DiskIO.h"
 #include "io/File.h"
 #include "io/Reader.h"
 #include "io/ReaderException.h"
+#include "io/TestEnvironment.h"
 
+#include "kdl/result.h"
+
+#include <chrono>
 #include <filesystem>
 #include <memory>
 #include <string>
@@ -42,7 +45,15 @@ const char* buff()
 std::shared_ptr<File> file()
 {
   static auto result =
-    Disk::openFile(std::filesystem::current_path() / "fixture/test/io/Reader/10byte")
+    createCFile(std::filesystem::current_path() / "fixture/test/io/Reader/10byte")
+    | kdl::value();
+  return result;
+}
+
+std::shared_ptr<File> mappedFile()
+{
+  static auto result =
+    createMappedFile(std::filesystem::current_path() / "fixture/test/io/Reader/10byte")
     | kdl::value();
   return result;
 }
@@ -70,7 +81,15 @@ TEST_CASE("BufferReaderTest.createEmpty")
 TEST_CASE("FileReaderTest.createEmpty")
 {
   const auto emptyFile =
-    Disk::openFile(std::filesystem::current_path() / "fixture/test/io/Reader/empty")
+    createCFile(std::filesystem::current_path() / "fixture/test/io/Reader/empty")
+    | kdl::value();
+  createEmpty(emptyFile->reader());
+}
+
+TEST_CASE("MappedFileReaderTest.createEmpty")
+{
+  const auto emptyFile =
+    createMappedFile(std::filesystem::current_path() / "fixture/test/io/Reader/empty")
     | kdl::value();
   createEmpty(emptyFile->reader());
 }
@@ -110,6 +129,11 @@ TEST_CASE("FileReaderTest.createNonEmpty")
   createNonEmpty(file()->reader());
 }
 
+TEST_CASE("MappedFileReaderTest.createNonEmpty")
+{
+  createNonEmpty(mappedFile()->reader());
+}
+
 static void seekFromBegin(Reader&& r)
 {
   r.seekFromBegin(0U);
@@ -135,6 +159,11 @@ TEST_CASE("FileReaderTest.seekFromBegin")
   seekFromBegin(file()->reader());
 }
 
+TEST_CASE("MappedFileReaderTest.seekFromBegin")
+{
+  seekFromBegin(mappedFile()->reader());
+}
+
 static void seekFromEnd(Reader&& r)
 {
   r.seekFromEnd(0U);
@@ -160,6 +189,11 @@ TEST_CASE("FileReaderTest.seekFromEnd")
   seekFromEnd(file()->reader());
 }
 
+TEST_CASE("MappedFileReaderTest.seekFromEnd")
+{
+  seekFromEnd(mappedFile()->reader());
+}
+
 static void seekForward(Reader&& r)
 {
   r.seekForward(1U);
@@ -200,6 +234,11 @@ TEST_CASE("FileReaderTest.seekForward")
   seekForward(file()->reader());
 }
 
+TEST_CASE("MappedFileReaderTest.seekForward")
+{
+  seekForward(mappedFile()->reader());
+}
+
 static void subReader(Reader&& r)
 {
   auto s = r.subReaderFromBegin(5, 3);
@@ -229,4 +268,38 @@ TEST_CASE("FileReaderTest.subReader")
 {
   subReader(file()->reader());
 }
+
+TEST_CASE("MappedFileReaderTest.subReader")
+{
+  subReader(mappedFile()->reader());
+}
+
+TEST_CASE("MappedFileReaderTest.readerOutlivesFile")
+{
+  auto reader =
+    createMappedFile(std::filesystem::current_path() / "fixture/test/io/Reader/10byte")
+    | kdl::transform([](auto f) { return f->reader().subReaderFromBegin(5, 3); })
+    | kdl::value();
+
+  CHECK(reader.readString(3) == "fgh");
+}
+
+TEST_CASE("MappedFileReaderTest.validate")
+{
+  auto env = TestEnvironment{};
+  env.createFile("test.txt", "some content");
+
+  const auto path = env.dir() / "test.txt";
+  auto mappedFile_ = createMappedFile(path) | kdl::value();
+  const auto fileView = FileView{mappedFile_, 5, 7};
+
+  CHECK(mappedFile_->validate().is_success());
+  CHECK(fileView.validate().is_success());
+
+  std::filesystem::last_write_time(
+    path, std::filesystem::last_write_time(path) + std::chrono::seconds{10});
+
+  CHECK(mappedFile_->validate().is_error());
+  CHECK(fileView.validate().is_error());
+}
 } // namespace tb::io
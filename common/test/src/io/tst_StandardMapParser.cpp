@@ -0,0 +1,129 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "io/StandardMapParser.h"
+
+#include "kdl/range_to_vector.h"
+
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::io
+{
+
+TEST_CASE("QuakeMapTokenizer")
+{
+  SECTION("Tracks lines and columns across long comments and strings")
+  {
+    const auto comment = "// " + std::string(40, 'c');
+    const auto message = std::string(40, 'm') + "\\\"" + std::string(20, 'm');
+    const auto str = comment + "\n{\n\"message\" \"" + message + "\" 1\n}";
+
+    auto tokenizer = QuakeMapTokenizer{str};
+    tokenizer.setSkipEol(true);
+
+    auto token = tokenizer.nextToken();
+    CHECK(token.type() == QuakeMapToken::OBrace);
+    CHECK(token.line() == 2);
+
+    CHECK(tokenizer.nextToken().data() == "message");
+
+    token = tokenizer.nextToken();
+    CHECK(token.type() == QuakeMapToken::String);
+    CHECK(token.data() == message);
+    CHECK(token.line() == 3);
+    CHECK(token.column() == 11);
+
+    token = tokenizer.nextToken();
+    CHECK(token.type() == QuakeMapToken::Integer);
+    CHECK(token.line() == 3);
+    CHECK(token.column() == 11 + message.size() + 3);
+
+    token = tokenizer.nextToken();
+    CHECK(token.type() == QuakeMapToken::CBrace);
+    CHECK(token.line() == 4);
+    CHECK(token.column() == 1);
+  }
+}
+
+TEST_CASE("splitIntoEntityChunks")
+{
+  using T = std::tuple<std::string_view, size_t, size_t>;
+
+  const auto split = [](const std::string_view str, const size_t minChunkSize) {
+    return splitIntoEntityChunks(str, minChunkSize)
+           | std::views::transform([](const auto& chunk) {
+               return T{chunk.str, chunk.line, chunk.column};
+             })
+           | kdl::to_vector;
+  };
+
+  CHECK(split("", 0).empty());
+  CHECK(split("{}", 0) == std::vector<T>{{"{}", 1, 1}});
+  CHECK(split("{} {}", 0) == std::vector<T>{{"{}", 1, 1}, {" {}", 1, 3}});
+  CHECK(
+    split("{}\n{}\n", 0)
+    == std::vector<T>{{"{}", 1, 1}, {"\n{}", 1, 3}, {"\n", 2, 3}});
+
+  SECTION("Nested braces")
+  {
+    CHECK(
+      split("{ { ( 1 2 3 ) } }\n{ }", 0)
+      == std::vector<T>{{"{ { ( 1 2 3 ) } }", 1, 1}, {"\n{ }", 1, 18}});
+  }
+
+  SECTION("Braces in quoted strings, comments and words are ignored")
+  {
+    CHECK(
+      split(R"({ "}" } { "a\" })", 0)
+      == std::vector<T>{{R"({ "}" })", 1, 1}, {R"( { "a\" })", 1, 8}});
+    CHECK(
+      split("{ // }\n} {\n; }\n}", 0)
+      == std::vector<T>{{"{ // }\n}", 1, 1}, {" {\n; }\n}", 2, 2}});
+    CHECK(
+      split("{ tex}ture } {}", 0)
+      == std::vector<T>{{"{ tex}ture }", 1, 1}, {" {}", 1, 13}});
+  }
+
+  SECTION("Braces after a /// comment are not ignored")
+  {
+    CHECK(
+      split("{ /// }\n{}", 0) == std::vector<T>{{"{ /// }", 1, 1}, {"\n{}", 1, 8}});
+  }
+
+  SECTION("Chunks have a minimum size")
+  {
+    CHECK(
+      split("{ } { } { }", 6)
+      == std::vector<T>{{"{ } { }", 1, 1}, {" { }", 1, 8}});
+  }
+
+  SECTION("Unbalanced braces")
+  {
+    CHECK(split("{ {", 0) == std::vector<T>{{"{ {", 1, 1}});
+    CHECK(split("} {}", 0) == std::vector<T>{{"} {}", 1, 1}});
+  }
+}
+
+} // namespace tb::io
@@ -19,6 +19,7 @@
 
 #include "io/File.h"
 #include "io/FileSystemMetadata.h"
+#include "io/ImageFileSystem.h"
 #include "io/TestFileSystem.h"
 #include "io/TraversalMode.h"
 #include "io/VirtualFileSystem.h"
@@ -28,12 +29,42 @@
 #include <fmt/format.h>
 #include <fmt/std.h>
 
+#include <utility>
+#include <vector>
+
 #include "catch/Matchers.h"
 
 #include "Catch2.h"
 
 namespace tb::io
 {
+namespace
+{
+
+class TestImageFileSystem : public ImageFileSystemBase
+{
+private:
+  std::vector<std::pair<std::filesystem::path, std::shared_ptr<File>>> m_files;
+
+public:
+  explicit TestImageFileSystem(
+    std::vector<std::pair<std::filesystem::path, std::shared_ptr<File>>> files)
+    : m_files{std::move(files)}
+  {
+  }
+
+private:
+  Result<void> doReadDirectory() override
+  {
+    for (const auto& [path, file] : m_files)
+    {
+      addFile(path, [file = file]() { return Result<std::shared_ptr<File>>{file}; });
+    }
+    return Result<void>{};
+  }
+};
+
+} // namespace
 
 TEST_CASE("VirtualFileSystem")
 {
@@ -774,6 +805,124 @@ TEST_CASE("VirtualFileSystem")
       CHECK(vfs.openFile("foo/bar/g") == Result<std::shared_ptr<File>>{fs2_foo_bar_g});
     }
   }
+
+  SECTION("with image file systems and other file systems mounted")
+  {
+    auto fs1_bar_foo = makeObjectFile(1);
+    auto fs1_bar_bat = makeObjectFile(2);
+    auto img1_bar_bat = makeObjectFile(3);
+    auto img1_bar_baz = makeObjectFile(4);
+    auto img1_foo_cat = makeObjectFile(5);
+    auto fs2_bar_baz = makeObjectFile(6);
+    auto img2_bar_foo = makeObjectFile(7);
+
+    vfs.mount(
+      "",
+      std::make_unique<TestFileSystem>(
+        Entry{DirectoryEntry{
+          "",
+          {
+            DirectoryEntry{
+              "bar",
+              {
+                FileEntry{"foo", fs1_bar_foo},
+                FileEntry{"bat", fs1_bar_bat},
+              }},
+          }}},
+        std::unordered_map<std::string, FileSystemMetadata>{},
+        "/fs1"));
+    const auto img1Id = vfs.mount(
+      "",
+      createImageFileSystem<TestImageFileSystem>(
+        std::vector<std::pair<std::filesystem::path, std::shared_ptr<File>>>{
+          {"bar/bat", img1_bar_bat},
+          {"bar/baz", img1_bar_baz},
+          {"Foo/Cat", img1_foo_cat},
+        })
+        | kdl::value());
+    vfs.mount(
+      "",
+      std::make_unique<TestFileSystem>(
+        Entry{DirectoryEntry{
+          "",
+          {
+            DirectoryEntry{
+              "bar",
+              {
+                FileEntry{"baz", fs2_bar_baz},
+              }},
+          }}},
+        std::unordered_map<std::string, FileSystemMetadata>{},
+        "/fs2"));
+    vfs.mount(
+      "qux",
+      createImageFileSystem<TestImageFileSystem>(
+        std::vector<std::pair<std::filesystem::path, std::shared_ptr<File>>>{
+          {"bar/foo", img2_bar_foo},
+        })
+        | kdl::value());
+
+    SECTION("pathInfo")
+    {
+      CHECK(vfs.pathInfo("bar") == PathInfo::Directory);
+      CHECK(vfs.pathInfo("bar/bat") == PathInfo::File);
+      CHECK(vfs.pathInfo("foo") == PathInfo::Directory);
+      CHECK(vfs.pathInfo("FOO/cat") == PathInfo::File);
+      CHECK(vfs.pathInfo("qux") == PathInfo::Directory);
+      CHECK(vfs.pathInfo("qux/bar") == PathInfo::Directory);
+      CHECK(vfs.pathInfo("qux/bar/foo") == PathInfo::File);
+      CHECK(vfs.pathInfo("qux/bar/bat") == PathInfo::Unknown);
+      CHECK(vfs.pathInfo("bar/cat") == PathInfo::Unknown);
+
+      // paths that are spelled differently than the indexed paths
+      CHECK(vfs.pathInfo("foo/") == PathInfo::Directory);
+      CHECK(vfs.pathInfo("qux/bar/") == PathInfo::Directory);
+      CHECK(vfs.pathInfo("foo//cat") == PathInfo::File);
+    }
+
+    SECTION("makeAbsolute")
+    {
+      CHECK(vfs.makeAbsolute("bar/foo") == "/fs1/bar/foo");
+      CHECK(vfs.makeAbsolute("bar/bat") == "/bar/bat");
+      CHECK(vfs.makeAbsolute("bar/baz") == "/fs2/bar/baz");
+      CHECK(vfs.makeAbsolute("foo/") == "/foo/");
+    }
+
+    SECTION("openFile")
+    {
+      CHECK(vfs.openFile("bar/foo") == Result<std::shared_ptr<File>>{fs1_bar_foo});
+      CHECK(vfs.openFile("bar/bat") == Result<std::shared_ptr<File>>{img1_bar_bat});
+      CHECK(vfs.openFile("bar/baz") == Result<std::shared_ptr<File>>{fs2_bar_baz});
+      CHECK(vfs.openFile("foo/cat") == Result<std::shared_ptr<File>>{img1_foo_cat});
+      CHECK(vfs.openFile("qux/bar/foo") == Result<std::shared_ptr<File>>{img2_bar_foo});
+      CHECK(
+        vfs.openFile("foo//cat") == Result<std::shared_ptr<File>>{img1_foo_cat});
+    }
+
+    SECTION("unmounting an image file system")
+    {
+      REQUIRE(vfs.openFile("bar/bat") == Result<std::shared_ptr<File>>{img1_bar_bat});
+
+      vfs.unmount(img1Id);
+      CHECK(vfs.openFile("bar/bat") == Result<std::shared_ptr<File>>{fs1_bar_bat});
+      CHECK(vfs.pathInfo("foo/cat") == PathInfo::Unknown);
+    }
+
+    SECTION("mounting an image file system")
+    {
+      REQUIRE(vfs.openFile("bar/foo") == Result<std::shared_ptr<File>>{fs1_bar_foo});
+
+      auto img3_bar_foo = makeObjectFile(8);
+      vfs.mount(
+        "",
+        createImageFileSystem<TestImageFileSystem>(
+          std::vector<std::pair<std::filesystem::path, std::shared_ptr<File>>>{
+            {"bar/foo", img3_bar_foo},
+          })
+          | kdl::value());
+      CHECK(vfs.openFile("bar/foo") == Result<std::shared_ptr<File>>{img3_bar_foo});
+    }
+  }
 }
 
 } // namespace tb::io
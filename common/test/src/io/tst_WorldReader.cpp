@@ -1980,6 +1980,105 @@ common/caulk
     REQUIRE(world != nullptr);
     CHECK(world->mapFormat() == mdl::MapFormat::Standard);
   }
+
+  SECTION("parseLargeMapInChunks")
+  {
+    auto data = std::string{R"(
+{
+"classname" "worldspawn"
+}
+)"};
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      // every 100th entity has a duplicate property to check that warnings are reported
+      const auto duplicate = i % 100 == 0 ? R"("targetname" "duplicate")" : "";
+      data += fmt::format(
+        R"(// entity {0}
+{{
+"classname" "func_wall"
+"targetname" "wall_{0}"
+{1}
+{{
+( -{0} -64 -16 ) ( -{0} -63 -16 ) ( -{0} -64 -15 ) none 0 0 0 1 1
+( -64 -64 -16 ) ( -64 -64 -15 ) ( -63 -64 -16 ) none 0 0 0 1 1
+( -64 -64 -16 ) ( -63 -64 -16 ) ( -64 -63 -16 ) none 0 0 0 1 1
+( 64 64 16 ) ( 64 65 16 ) ( 65 64 16 ) none 0 0 0 1 1
+( 64 64 16 ) ( 65 64 16 ) ( 64 64 17 ) none 0 0 0 1 1
+( 64 64 16 ) ( 64 64 17 ) ( 64 65 16 ) none 0 0 0 1 1
+}}
+}}
+)",
+        i,
+        duplicate);
+    }
+
+    auto sequentialTaskManager = kdl::task_manager{0};
+    auto sequentialStatus = TestParserStatus{};
+    auto sequentialReader = WorldReader{data, mdl::MapFormat::Standard, {}};
+    auto sequentialResult =
+      sequentialReader.read(worldBounds, sequentialStatus, sequentialTaskManager);
+
+    auto parallelTaskManager = kdl::task_manager{4};
+    auto parallelStatus = TestParserStatus{};
+    auto parallelReader = WorldReader{data, mdl::MapFormat::Standard, {}};
+    auto parallelResult =
+      parallelReader.read(worldBounds, parallelStatus, parallelTaskManager);
+
+    REQUIRE(sequentialResult.is_success());
+    REQUIRE(parallelResult.is_success());
+
+    CHECK(
+      parallelStatus.countStatus(LogLevel::Warn)
+      == sequentialStatus.countStatus(LogLevel::Warn));
+    CHECK(parallelStatus.countStatus(LogLevel::Warn) == 10u);
+
+    const auto& sequentialNodes = sequentialResult.value()->defaultLayer()->children();
+    const auto& parallelNodes = parallelResult.value()->defaultLayer()->children();
+    REQUIRE(parallelNodes.size() == 1000u);
+    REQUIRE(parallelNodes.size() == sequentialNodes.size());
+
+    for (size_t i = 0; i < parallelNodes.size(); ++i)
+    {
+      const auto* sequentialEntityNode =
+        dynamic_cast<const mdl::EntityNode*>(sequentialNodes[i]);
+      const auto* parallelEntityNode =
+        dynamic_cast<const mdl::EntityNode*>(parallelNodes[i]);
+      REQUIRE(sequentialEntityNode != nullptr);
+      REQUIRE(parallelEntityNode != nullptr);
+
+      CHECK(parallelEntityNode->entity() == sequentialEntityNode->entity());
+      CHECK(parallelEntityNode->lineNumber() == sequentialEntityNode->lineNumber());
+      REQUIRE(parallelEntityNode->childCount() == 1u);
+      CHECK(
+        parallelEntityNode->children().front()->lineNumber()
+        == sequentialEntityNode->children().front()->lineNumber());
+    }
+
+    SECTION("Errors are reported with their original location")
+    {
+      data += R"(
+{
+"classname" "func_wall"
+{
+( 0 0 0 ) ( 0 0 1 ) ( 0 1 0 ) none 0 0 0 1 1 garbage
+}
+}
+)";
+
+      auto sequentialErrorReader = WorldReader{data, mdl::MapFormat::Standard, {}};
+      auto parallelErrorReader = WorldReader{data, mdl::MapFormat::Standard, {}};
+
+      const auto sequentialError =
+        sequentialErrorReader.read(worldBounds, sequentialStatus, sequentialTaskManager);
+      const auto parallelError =
+        parallelErrorReader.read(worldBounds, parallelStatus, parallelTaskManager);
+
+      REQUIRE(sequentialError.is_error());
+      REQUIRE(parallelError.is_error());
+      CHECK(parallelError.error() == sequentialError.error());
+    }
+  }
 }
 
 } // namespace tb::io
@@ -0,0 +1,152 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/Brush.h"
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushFace.h"
+#include "mdl/BrushNode.h"
+#include "mdl/CompactNodeContents.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/MapFormat.h"
+#include "mdl/NodeContents.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/mat_ext.h"
+#include "vm/vec.h"
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+
+TEST_CASE("CompactNodeContents")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Valve, worldBounds};
+
+  auto brushNode = BrushNode{builder.createCube(64.0, "material") | kdl::value()};
+  const auto& currentBrush = brushNode.brush();
+
+  SECTION("Brush with unchanged geometry")
+  {
+    auto brush = currentBrush;
+
+    auto attributes = brush.face(2).attributes();
+    attributes.setXOffset(16.0f);
+    attributes.setMaterialName("other");
+    brush.face(2).setAttributes(attributes);
+
+    auto compactContents = CompactNodeContents{NodeContents{brush}, brushNode};
+    CHECK(
+      compactContents.memoryUsage()
+      < CompactNodeContents{NodeContents{brush}}.memoryUsage());
+
+    const auto contents = std::move(compactContents).expand(brushNode);
+    const auto& expandedBrush = std::get<Brush>(contents.get());
+    CHECK(expandedBrush == brush);
+    CHECK(expandedBrush.face(2).attributes().xOffset() == 16.0f);
+    CHECK(expandedBrush.bounds() == brush.bounds());
+  }
+
+  SECTION("Brush with moved vertices")
+  {
+    auto brush = currentBrush;
+    REQUIRE(brush
+              .moveVertices(
+                worldBounds, {vm::vec3d{32, 32, 32}}, vm::vec3d{-16, -16, -16})
+              .is_success());
+    REQUIRE(brush.faceCount() != currentBrush.faceCount());
+
+    // brushes with changed geometry are stored as they are
+    auto compactContents = CompactNodeContents{NodeContents{brush}, brushNode};
+    CHECK(
+      compactContents.memoryUsage()
+      == CompactNodeContents{NodeContents{brush}}.memoryUsage());
+
+    const auto contents = std::move(compactContents).expand(brushNode);
+    const auto& expandedBrush = std::get<Brush>(contents.get());
+    CHECK(expandedBrush == brush);
+    CHECK(expandedBrush.vertexPositions() == brush.vertexPositions());
+    CHECK(expandedBrush.bounds() == brush.bounds());
+  }
+
+  SECTION("Brush with translated geometry")
+  {
+    auto brush = currentBrush;
+    REQUIRE(brush
+              .transform(worldBounds, vm::translation_matrix(vm::vec3d{16, 0, 0}), false)
+              .is_success());
+
+    const auto contents =
+      CompactNodeContents{NodeContents{brush}, brushNode}.expand(brushNode);
+    const auto& expandedBrush = std::get<Brush>(contents.get());
+    CHECK(expandedBrush == brush);
+    CHECK(expandedBrush.vertexPositions() == brush.vertexPositions());
+    CHECK(expandedBrush.bounds() == brush.bounds());
+  }
+
+  SECTION("Expanding against other contents")
+  {
+    auto otherBrush = currentBrush;
+    REQUIRE(otherBrush
+              .transform(worldBounds, vm::translation_matrix(vm::vec3d{0, 16, 0}), false)
+              .is_success());
+
+    auto brush = otherBrush;
+    auto attributes = brush.face(0).attributes();
+    attributes.setRotation(45.0f);
+    brush.face(0).setAttributes(attributes);
+
+    auto otherNode = BrushNode{otherBrush};
+    const auto contents = CompactNodeContents{NodeContents{brush}, otherNode}.expand(
+      NodeContents{otherBrush});
+    CHECK(std::get<Brush>(contents.get()) == brush);
+  }
+
+  SECTION("Other contents are stored as they are")
+  {
+    auto entityNode = EntityNode{Entity{{{"classname", "light"}}}};
+    auto entity = Entity{{{"classname", "info_player_start"}}};
+
+    const auto contents =
+      CompactNodeContents{NodeContents{entity}, entityNode}.expand(brushNode);
+    CHECK(std::get<Entity>(contents.get()) == entity);
+  }
+}
+
+TEST_CASE("CompactNodeContents.memoryUsage")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Valve, worldBounds};
+
+  auto* brushNode = new BrushNode{builder.createCube(64.0, "material") | kdl::value()};
+  CHECK(memoryUsage(*brushNode) > memoryUsage(NodeContents{brushNode->brush()}));
+
+  auto entityNode = EntityNode{Entity{{{"classname", "func_door"}}}};
+  entityNode.addChild(brushNode);
+  CHECK(
+    memoryUsage(entityNode)
+    == sizeof(EntityNode) + memoryUsage(NodeContents{entityNode.entity()})
+         + memoryUsage(*brushNode));
+}
+
+} // namespace tb::mdl
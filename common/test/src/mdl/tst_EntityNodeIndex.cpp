@@ -198,6 +198,58 @@ TEST_CASE("EntityNodeIndex")
       index.allValuesForKeys(EntityNodeIndexQuery::exact("test")),
       Catch::UnorderedEquals(std::vector<std::string>{"somevalue", "somevalue2"}));
   }
+
+  SECTION("allValuesForKeys with prefix and numbered queries")
+  {
+    auto entity1 = EntityNode{Entity{{
+      {"target1", "a"},
+      {"target2", "b"},
+      {"targetname", "c"},
+    }}};
+
+    index.addEntityNode(&entity1);
+
+    CHECK_THAT(
+      index.allValuesForKeys(EntityNodeIndexQuery::prefix("target")),
+      Catch::UnorderedEquals(std::vector<std::string>{"a", "b", "c"}));
+    CHECK_THAT(
+      index.allValuesForKeys(EntityNodeIndexQuery::numbered("target")),
+      Catch::UnorderedEquals(std::vector<std::string>{"a", "b"}));
+    CHECK(index.allValuesForKeys(EntityNodeIndexQuery::exact("missing")).empty());
+  }
+
+  SECTION("Values are not treated as patterns")
+  {
+    auto entity1 = EntityNode{Entity{{{"model", "*12"}}}};
+    auto entity2 = EntityNode{Entity{{{"model", "*112"}}}};
+
+    index.addEntityNode(&entity1);
+    index.addEntityNode(&entity2);
+
+    CHECK_THAT(
+      findExactExact(index, "model", "*12"),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{&entity1}));
+    CHECK(findExactExact(index, "model", "*").empty());
+  }
+
+  SECTION("Properties with the same key and value")
+  {
+    auto entity1 = EntityNode{Entity{{
+      {"target1", "somevalue"},
+      {"target2", "somevalue"},
+    }}};
+
+    index.addEntityNode(&entity1);
+    index.removeProperty(&entity1, "target1", "somevalue");
+
+    CHECK_THAT(
+      findNumberedExact(index, "target", "somevalue"),
+      Catch::UnorderedEquals(std::vector<EntityNodeBase*>{&entity1}));
+
+    index.removeProperty(&entity1, "target2", "somevalue");
+    CHECK(findNumberedExact(index, "target", "somevalue").empty());
+    CHECK(index.allKeys().empty());
+  }
 }
 
 } // namespace tb::mdl
@@ -0,0 +1,130 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/InternedString.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+
+TEST_CASE("InternedString")
+{
+  SECTION("Empty strings")
+  {
+    CHECK(InternedString{}.empty());
+    CHECK(InternedString{""}.empty());
+    CHECK(InternedString{} == InternedString{""});
+    CHECK(InternedString{}.str() == "");
+  }
+
+  SECTION("Equal strings share their contents")
+  {
+    const auto str1 = InternedString{"classname"};
+    const auto str2 = InternedString{std::string{"class"} + "name"};
+    const auto str3 = InternedString{"origin"};
+
+    CHECK(str1.str() == "classname");
+    CHECK(&str1.str() == &str2.str());
+    CHECK(str1 == str2);
+    CHECK(str1 != str3);
+  }
+
+  SECTION("Ordering")
+  {
+    CHECK(InternedString{"a"} < InternedString{"b"});
+    CHECK(InternedString{"b"} > InternedString{"a"});
+    CHECK(InternedString{} < InternedString{"a"});
+    CHECK((InternedString{"a"} <=> InternedString{"a"}) == std::strong_ordering::equal);
+  }
+
+  SECTION("Copying and moving")
+  {
+    auto str1 = InternedString{"targetname"};
+    auto str2 = str1;
+    CHECK(str2 == str1);
+
+    auto str3 = std::move(str1);
+    CHECK(str3 == str2);
+    CHECK(str1.empty());
+
+    str1 = str3;
+    CHECK(str1 == str3);
+
+    str1 = InternedString{"target"};
+    CHECK(str1.str() == "target");
+    CHECK(str3.str() == "targetname");
+  }
+
+  SECTION("Entries are removed when the last string is destroyed")
+  {
+    const auto countBefore = InternedString::stats().count;
+    {
+      const auto str1 = InternedString{"a string that is not interned anywhere else"};
+      const auto str2 = str1;
+      const auto str3 = InternedString{"a string that is not interned anywhere else"};
+      CHECK(InternedString::stats().count == countBefore + 1);
+    }
+    CHECK(InternedString::stats().count == countBefore);
+  }
+
+  SECTION("Interning strings concurrently")
+  {
+    auto threads = std::vector<std::thread>{};
+    auto results = std::vector<std::vector<InternedString>>(4);
+    for (auto& result : results)
+    {
+      threads.emplace_back([&]() {
+        for (size_t i = 0; i < 1000; ++i)
+        {
+          result.emplace_back(std::to_string(i % 100));
+          // create and remove other entries concurrently, too
+          InternedString{std::to_string(1000 + i)};
+        }
+      });
+    }
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      CHECK(results[0][i] == results[1][i]);
+      CHECK(results[0][i] == results[2][i]);
+      CHECK(results[0][i] == results[3][i]);
+      CHECK(results[0][i].str() == std::to_string(i % 100));
+    }
+  }
+
+  SECTION("operator<<")
+  {
+    auto str = std::stringstream{};
+    str << InternedString{"light"};
+    CHECK(str.str() == "light");
+  }
+}
+
+} // namespace tb::mdl
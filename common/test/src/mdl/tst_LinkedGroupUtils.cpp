@@ -39,6 +39,7 @@
 #include "vm/mat.h"
 #include "vm/mat_ext.h"
 
+#include <algorithm>
 #include <numeric>
 #include <vector>
 
@@ -223,14 +224,20 @@ TEST_CASE("updateLinkedGroups")
     SECTION("Target group list is empty")
     {
       updateLinkedGroups(groupNode, {}, worldBounds, taskManager)
-        | kdl::transform([&](const UpdateLinkedGroupsResult& r) { CHECK(r.empty()); })
+        | kdl::transform([&](const UpdateLinkedGroupsResult& r) {
+            CHECK(r.childrenToReplace.empty());
+            CHECK(r.contentsToSwap.empty());
+          })
         | kdl::transform_error([](const auto&) { FAIL(); });
     }
 
     SECTION("Target group list contains only source group")
     {
       updateLinkedGroups(groupNode, {&groupNode}, worldBounds, taskManager)
-        | kdl::transform([&](const UpdateLinkedGroupsResult& r) { CHECK(r.empty()); })
+        | kdl::transform([&](const UpdateLinkedGroupsResult& r) {
+            CHECK(r.childrenToReplace.empty());
+            CHECK(r.contentsToSwap.empty());
+          })
         | kdl::transform_error([](const auto&) { FAIL(); });
     }
 
@@ -256,9 +263,9 @@ TEST_CASE("updateLinkedGroups")
 
       updateLinkedGroups(groupNode, {groupNodeClone.get()}, worldBounds, taskManager)
         | kdl::transform([&](const UpdateLinkedGroupsResult& r) {
-            CHECK(r.size() == 1u);
+            CHECK(r.childrenToReplace.size() == 1u);
 
-            const auto& p = r.front();
+            const auto& p = r.childrenToReplace.front();
             const auto& [groupNodeToUpdate, newChildren] = p;
 
             CHECK(groupNodeToUpdate == groupNodeClone.get());
@@ -311,9 +318,9 @@ TEST_CASE("updateLinkedGroups")
       updateLinkedGroups(
         *innerGroupNode, {innerGroupNodeClone.get()}, worldBounds, taskManager)
         | kdl::transform([&](const UpdateLinkedGroupsResult& r) {
-            CHECK(r.size() == 1u);
+            CHECK(r.childrenToReplace.size() == 1u);
 
-            const auto& p = r.front();
+            const auto& p = r.childrenToReplace.front();
             const auto& [groupNodeToUpdate, newChildren] = p;
 
             CHECK(groupNodeToUpdate == innerGroupNodeClone.get());
@@ -342,9 +349,9 @@ TEST_CASE("updateLinkedGroups")
       updateLinkedGroups(
         *innerGroupNode, {innerGroupNodeClone.get()}, worldBounds, taskManager)
         | kdl::transform([&](const UpdateLinkedGroupsResult& r) {
-            CHECK(r.size() == 1u);
+            CHECK(r.childrenToReplace.size() == 1u);
 
-            const auto& p = r.front();
+            const auto& p = r.childrenToReplace.front();
             const auto& [groupNodeToUpdate, newChildren] = p;
 
             CHECK(groupNodeToUpdate == innerGroupNodeClone.get());
@@ -413,8 +420,8 @@ TEST_CASE("updateLinkedGroups")
     updateLinkedGroups(
       outerGroupNode, {outerGroupNodeClone.get()}, worldBounds, taskManager)
       | kdl::transform([&](const UpdateLinkedGroupsResult& r) {
-          REQUIRE(r.size() == 1u);
-          const auto& [groupNodeToUpdate, newChildren] = r.front();
+          REQUIRE(r.childrenToReplace.size() == 1u);
+          const auto& [groupNodeToUpdate, newChildren] = r.childrenToReplace.front();
 
           REQUIRE(groupNodeToUpdate == outerGroupNodeClone.get());
           REQUIRE(newChildren.size() == 1u);
@@ -495,9 +502,9 @@ TEST_CASE("updateLinkedGroups")
       updateLinkedGroups(
         outerGroupNode, {outerGroupNodeClone.get()}, worldBounds, taskManager)
         | kdl::transform([&](const UpdateLinkedGroupsResult& r) {
-            REQUIRE(r.size() == 1u);
+            REQUIRE(r.childrenToReplace.size() == 1u);
 
-            const auto& [groupNodeToUpdate, newChildren] = r.front();
+            const auto& [groupNodeToUpdate, newChildren] = r.childrenToReplace.front();
             REQUIRE(groupNodeToUpdate == outerGroupNodeClone.get());
 
             const auto* innerReplacement =
@@ -633,8 +640,8 @@ TEST_CASE("updateLinkedGroups")
 
     updateLinkedGroups(sourceGroupNode, {targetGroupNode.get()}, worldBounds, taskManager)
       | kdl::transform([&](const UpdateLinkedGroupsResult& r) {
-          REQUIRE(r.size() == 1u);
-          const auto& p = r.front();
+          REQUIRE(r.childrenToReplace.size() == 1u);
+          const auto& p = r.childrenToReplace.front();
 
           const auto& newChildren = p.second;
           REQUIRE(newChildren.size() == 1u);
@@ -691,8 +698,8 @@ TEST_CASE("updateLinkedGroups")
 
     updateLinkedGroups(sourceGroupNode, {targetGroupNode.get()}, worldBounds, taskManager)
       | kdl::transform([&](const UpdateLinkedGroupsResult& r) {
-          REQUIRE(r.size() == 1u);
-          const auto& p = r.front();
+          REQUIRE(r.childrenToReplace.size() == 1u);
+          const auto& p = r.childrenToReplace.front();
 
           const auto& newChildren = p.second;
           REQUIRE(newChildren.size() == 2u);
@@ -712,6 +719,108 @@ TEST_CASE("updateLinkedGroups")
         })
       | kdl::transform_error([](const auto&) { FAIL(); });
   }
+
+  SECTION("Update only nodes that changed after the given modification count")
+  {
+    const auto worldBounds = vm::bbox3d{8192.0};
+    const auto brushBuilder = BrushBuilder{MapFormat::Quake3, worldBounds};
+
+    auto sourceGroupNode = GroupNode{Group{"name"}};
+    auto* sourceBrushNode =
+      new BrushNode{brushBuilder.createCube(64.0, "material") | kdl::value()};
+    auto* sourceEntityNode = new EntityNode{Entity{}};
+    sourceGroupNode.addChildren({sourceBrushNode, sourceEntityNode});
+
+    auto targetGroupNode = std::unique_ptr<GroupNode>{
+      static_cast<GroupNode*>(sourceGroupNode.cloneRecursively(worldBounds))};
+    transformNode(
+      *targetGroupNode, vm::translation_matrix(vm::vec3d{32, 0, 0}), worldBounds);
+
+    auto* targetEntityNode =
+      dynamic_cast<EntityNode*>(targetGroupNode->children().back());
+    REQUIRE(targetEntityNode != nullptr);
+    REQUIRE(targetEntityNode->entity().origin() == vm::vec3d{32, 0, 0});
+
+    const auto modificationCount =
+      std::max(sourceGroupNode.modificationCount(), targetGroupNode->modificationCount());
+
+    SECTION("If no node was changed")
+    {
+      updateLinkedGroups(
+        sourceGroupNode,
+        {targetGroupNode.get()},
+        worldBounds,
+        taskManager,
+        modificationCount)
+        | kdl::transform([&](const UpdateLinkedGroupsResult& r) {
+            CHECK(r.childrenToReplace.empty());
+            CHECK(r.contentsToSwap.empty());
+          })
+        | kdl::transform_error([](const auto&) { FAIL(); });
+    }
+
+    SECTION("If a node was changed")
+    {
+      transformNode(
+        *sourceEntityNode, vm::translation_matrix(vm::vec3d{0, 0, 16}), worldBounds);
+
+      updateLinkedGroups(
+        sourceGroupNode,
+        {targetGroupNode.get()},
+        worldBounds,
+        taskManager,
+        modificationCount)
+        | kdl::transform([&](const UpdateLinkedGroupsResult& r) {
+            CHECK(r.childrenToReplace.empty());
+            REQUIRE(r.contentsToSwap.size() == 1u);
+
+            const auto& [nodeToUpdate, newContents] = r.contentsToSwap.front();
+            CHECK(nodeToUpdate == targetEntityNode);
+            CHECK(
+              std::get<Entity>(newContents.get()).origin() == vm::vec3d{32, 0, 16});
+          })
+        | kdl::transform_error([](const auto&) { FAIL(); });
+    }
+
+    SECTION("If a node was added")
+    {
+      sourceGroupNode.addChild(new EntityNode{Entity{}});
+
+      updateLinkedGroups(
+        sourceGroupNode,
+        {targetGroupNode.get()},
+        worldBounds,
+        taskManager,
+        modificationCount)
+        | kdl::transform([&](const UpdateLinkedGroupsResult& r) {
+            CHECK(r.contentsToSwap.empty());
+            REQUIRE(r.childrenToReplace.size() == 1u);
+
+            const auto& [groupNodeToUpdate, newChildren] = r.childrenToReplace.front();
+            CHECK(groupNodeToUpdate == targetGroupNode.get());
+            CHECK(newChildren.size() == 3u);
+          })
+        | kdl::transform_error([](const auto&) { FAIL(); });
+    }
+
+    SECTION("If a changed node exceeds the world bounds")
+    {
+      transformNode(
+        *sourceEntityNode,
+        vm::translation_matrix(vm::vec3d{8192 - 24, 0, 0}),
+        worldBounds);
+
+      updateLinkedGroups(
+        sourceGroupNode,
+        {targetGroupNode.get()},
+        worldBounds,
+        taskManager,
+        modificationCount)
+        | kdl::transform([](auto) { FAIL(); }) | kdl::transform_error([](auto e) {
+            CHECK(e == Error{"Updating a linked node would exceed world bounds"});
+          });
+    }
+  }
 }
 
 TEST_CASE("initializeLinkIds")
@@ -29,19 +29,25 @@
 #include "mdl/EntityNode.h"
 #include "mdl/Group.h"
 #include "mdl/GroupNode.h"
+#include "mdl/Issue.h"
 #include "mdl/Layer.h"
 #include "mdl/LayerNode.h"
 #include "mdl/LockState.h"
 #include "mdl/MapFormat.h"
+#include "mdl/MissingClassnameValidator.h"
 #include "mdl/ModelUtils.h"
 #include "mdl/PatchNode.h"
 #include "mdl/WorldNode.h"
 
+#include "kdl/range_to_vector.h"
 #include "kdl/result.h"
+#include "kdl/task_manager.h"
 
 #include "vm/bbox.h"
 #include "vm/mat_ext.h"
 
+#include <ranges>
+
 #include "Catch2.h"
 
 namespace tb::mdl
@@ -642,4 +648,36 @@ TEST_CASE("ModelUtils.filterNodes")
   }
 }
 
+TEST_CASE("ModelUtils.collectIssues")
+{
+  auto taskManager = kdl::task_manager{4};
+
+  auto validator = MissingClassnameValidator{};
+  const auto validators = std::vector<const Validator*>{&validator};
+
+  auto worldNode = WorldNode{{}, {}, MapFormat::Quake3};
+  auto nodes = std::vector<Node*>{};
+  auto nodesWithIssues = std::vector<Node*>{};
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    auto* entityNode = i % 3 == 0 ? new EntityNode{Entity{}}
+                                  : new EntityNode{Entity{{{"classname", "light"}}}};
+    worldNode.defaultLayer()->addChild(entityNode);
+    nodes.push_back(entityNode);
+    if (i % 3 == 0)
+    {
+      nodesWithIssues.push_back(entityNode);
+    }
+  }
+
+  const auto issues = collectIssues(nodes, validators, taskManager);
+  CHECK(
+    (issues | std::views::transform([](const auto* issue) { return &issue->node(); })
+     | kdl::to_vector)
+    == nodesWithIssues);
+
+  // the issues are cached by the nodes
+  CHECK(collectIssues(nodes, validators, taskManager) == issues);
+}
+
 } // namespace tb::mdl
@@ -25,6 +25,7 @@
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
 #include "mdl/EditorContext.h"
+#include "mdl/Entity.h"
 #include "mdl/EntityNode.h"
 #include "mdl/GroupNode.h"
 #include "mdl/LayerNode.h"
@@ -396,6 +397,77 @@ TEST_CASE("NodeTest.replaceChildren")
   CHECK(childNode3->parent() == &rootNode);
 }
 
+TEST_CASE("NodeTest.modificationCount")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = BrushBuilder{MapFormat::Standard, worldBounds};
+
+  auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
+  auto* layerNode = worldNode.defaultLayer();
+  auto* entityNode = new EntityNode{Entity{}};
+  auto* otherEntityNode = new EntityNode{Entity{}};
+  auto* brushNode = new BrushNode{builder.createCube(64.0, "material") | kdl::value()};
+
+  CHECK(entityNode->modificationCount() != otherEntityNode->modificationCount());
+
+  auto worldCount = worldNode.modificationCount();
+  auto layerCount = layerNode->modificationCount();
+
+  layerNode->addChildren({entityNode, otherEntityNode});
+  CHECK(worldNode.modificationCount() != worldCount);
+  CHECK(layerNode->modificationCount() != layerCount);
+
+  worldCount = worldNode.modificationCount();
+  layerCount = layerNode->modificationCount();
+  auto entityCount = entityNode->modificationCount();
+  const auto otherEntityCount = otherEntityNode->modificationCount();
+
+  entityNode->addChild(brushNode);
+  CHECK(worldNode.modificationCount() != worldCount);
+  CHECK(layerNode->modificationCount() != layerCount);
+  CHECK(entityNode->modificationCount() != entityCount);
+  CHECK(otherEntityNode->modificationCount() == otherEntityCount);
+
+  worldCount = worldNode.modificationCount();
+  layerCount = layerNode->modificationCount();
+  entityCount = entityNode->modificationCount();
+  auto brushCount = brushNode->modificationCount();
+
+  SECTION("Selection does not change modification counts")
+  {
+    brushNode->select();
+    CHECK(brushNode->modificationCount() == brushCount);
+    CHECK(entityNode->modificationCount() == entityCount);
+  }
+
+  SECTION("Changing a node changes the modification counts of its ancestors")
+  {
+    brushNode->setBrush(builder.createCube(32.0, "material") | kdl::value());
+    CHECK(brushNode->modificationCount() != brushCount);
+    CHECK(entityNode->modificationCount() != entityCount);
+    CHECK(layerNode->modificationCount() != layerCount);
+    CHECK(worldNode.modificationCount() != worldCount);
+    CHECK(otherEntityNode->modificationCount() == otherEntityCount);
+  }
+
+  SECTION("Changing a face material changes the modification counts")
+  {
+    brushNode->setFaceMaterial(0, nullptr);
+    CHECK(brushNode->modificationCount() != brushCount);
+    CHECK(entityNode->modificationCount() != entityCount);
+    CHECK(worldNode.modificationCount() != worldCount);
+  }
+
+  SECTION("Removing a node changes the modification counts of its former ancestors")
+  {
+    entityNode->removeChild(brushNode);
+    CHECK(brushNode->modificationCount() == brushCount);
+    CHECK(entityNode->modificationCount() != entityCount);
+    CHECK(worldNode.modificationCount() != worldCount);
+    delete brushNode;
+  }
+}
+
 TEST_CASE("NodeTest.partialSelection")
 {
   auto rootNode = TestNode{};
@@ -19,10 +19,14 @@
 
 #include "Result.h"
 #include "io/DiskIO.h"
+#include "io/Reader.h"
 #include "mdl/Palette.h"
+#include "mdl/TextureBuffer.h"
 
 #include "kdl/result.h"
 
+#include <vector>
+
 #include "Catch2.h"
 
 namespace tb::mdl
@@ -214,4 +218,60 @@ TEST_CASE("loadPalette")
   CHECK(loadPalette(*file, filePath) == expectedPalette);
 }
 
+TEST_CASE("Palette.indexedToRgba")
+{
+  const auto palette =
+    makePalette(
+      {0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, 0x80, 0x90}, PaletteColorFormat::Rgb)
+    | kdl::value();
+
+  auto averageColor = Color{};
+
+  SECTION("Opaque")
+  {
+    const auto indices = std::vector<char>{0, 1, 1, 2};
+    auto reader = io::Reader::from(indices.data(), indices.data() + indices.size());
+    auto buffer = TextureBuffer{4 * 4};
+
+    CHECK(!palette.indexedToRgba(
+      reader, 4, buffer, PaletteTransparency::Opaque, averageColor));
+    CHECK(reader.position() == 4);
+    CHECK(
+      std::vector<unsigned char>(buffer.data(), buffer.data() + buffer.size())
+      == std::vector<unsigned char>{
+        0x10, 0x20, 0x30, 0xFF, 0x40, 0x50, 0x60, 0xFF,
+        0x40, 0x50, 0x60, 0xFF, 0x70, 0x80, 0x90, 0xFF,
+      });
+    CHECK(averageColor.r() == Approx(float(0x10 + 0x40 + 0x40 + 0x70) / (4.0f * 255.0f)));
+    CHECK(averageColor.g() == Approx(float(0x20 + 0x50 + 0x50 + 0x80) / (4.0f * 255.0f)));
+    CHECK(averageColor.b() == Approx(float(0x30 + 0x60 + 0x60 + 0x90) / (4.0f * 255.0f)));
+    CHECK(averageColor.a() == 1.0f);
+  }
+
+  SECTION("Last color is transparent")
+  {
+    const auto indices = std::vector<char>{0, 2};
+    auto reader = io::Reader::from(indices.data(), indices.data() + indices.size());
+    auto buffer = TextureBuffer{2 * 4};
+
+    CHECK(palette.indexedToRgba(
+      reader, 2, buffer, PaletteTransparency::Index255Transparent, averageColor));
+    CHECK(
+      std::vector<unsigned char>(buffer.data(), buffer.data() + buffer.size())
+      == std::vector<unsigned char>{0x10, 0x20, 0x30, 0xFF, 0x70, 0x80, 0x90, 0x00});
+  }
+
+  SECTION("Indices without a color")
+  {
+    const auto indices = std::vector<char>{1, char(200)};
+    auto reader = io::Reader::from(indices.data(), indices.data() + indices.size());
+    auto buffer = TextureBuffer{2 * 4};
+
+    palette.indexedToRgba(reader, 2, buffer, PaletteTransparency::Opaque, averageColor);
+    CHECK(
+      std::vector<unsigned char>(buffer.data(), buffer.data() + buffer.size())
+      == std::vector<unsigned char>{0x40, 0x50, 0x60, 0xFF, 0x00, 0x00, 0x00, 0x00});
+  }
+}
+
 } // namespace tb::mdl
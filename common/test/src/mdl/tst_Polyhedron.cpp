@@ -19,6 +19,7 @@
 
 #include "mdl/Polyhedron.h"
 #include "mdl/Polyhedron_DefaultPayload.h"
+#include "mdl/Polyhedron_ElementPool.h"
 #include "mdl/Polyhedron_IO.h" // IWYU pragma: keep
 #include "mdl/Polyhedron_Instantiation.h"
 
@@ -28,6 +29,7 @@
 #include <algorithm>
 #include <iterator>
 #include <set>
+#include <vector>
 
 #include "Catch2.h"
 
@@ -1368,4 +1370,50 @@ TEST_CASE("PolyhedronTest.intersection_polygon_polyhedron_any_orientation")
     cube));
 }
 
+TEST_CASE("PolyhedronTest.trimElementPools")
+{
+  // use an element size that no polyhedron element has
+  using Pool = PolyhedronElementPool<200, 8>;
+
+  trimPolyhedronElementPools();
+
+  auto elements = std::vector<void*>{};
+  for (size_t i = 0; i < 1024; ++i)
+  {
+    elements.push_back(Pool::allocate());
+  }
+
+  SECTION("Slabs without elements in use are released")
+  {
+    for (auto* element : elements)
+    {
+      Pool::deallocate(element);
+    }
+    CHECK(trimPolyhedronElementPools() == 1024 * 200);
+  }
+
+  SECTION("Slabs with elements in use are retained")
+  {
+    for (size_t i = 1; i < elements.size(); ++i)
+    {
+      Pool::deallocate(elements[i]);
+    }
+    CHECK(trimPolyhedronElementPools() == 768 * 200);
+
+    // the free elements of the retained slab are still available
+    elements.resize(1);
+    for (size_t i = 0; i < 255; ++i)
+    {
+      elements.push_back(Pool::allocate());
+    }
+    CHECK(trimPolyhedronElementPools() == 0);
+
+    for (auto* element : elements)
+    {
+      Pool::deallocate(element);
+    }
+    CHECK(trimPolyhedronElementPools() == 256 * 200);
+  }
+}
+
 } // namespace tb::mdl
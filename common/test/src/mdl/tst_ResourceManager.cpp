@@ -229,6 +229,49 @@ TEST_CASE("ResourceManager")
       }
     }
 
+    SECTION("requested resources are loaded first")
+    {
+      auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
+      auto resource2 = std::make_shared<ResourceT>(mockResourceLoader);
+      resourceManager.addResource(resource1);
+      resourceManager.addResource(resource2);
+
+      resource2->request();
+
+      CHECK(
+        resourceManager.process(taskRunner, processContext, std::nullopt, 1)
+        == std::vector{resource2->id()});
+      CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(resource1->state()));
+      CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource2->state()));
+
+      CHECK(resourceManager.process(taskRunner, processContext, std::nullopt, 1).empty());
+
+      mockTaskRunner.resolveNextPromise();
+
+      CHECK(
+        resourceManager.process(taskRunner, processContext, std::nullopt, 1)
+        == std::vector{resource2->id(), resource1->id()});
+      CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource1->state()));
+      CHECK(std::holds_alternative<ResourceLoaded<MockResource>>(resource2->state()));
+    }
+
+    SECTION("resources that don't limit loading are loaded immediately")
+    {
+      auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
+      auto resource2 = std::make_shared<ResourceT>(mockResourceLoader);
+      auto resource3 = std::make_shared<ResourceT>(mockResourceLoader);
+      resourceManager.addResource(resource1);
+      resourceManager.addResource(resource2, false);
+      resourceManager.addResource(resource3);
+
+      CHECK(
+        resourceManager.process(taskRunner, processContext, std::nullopt, 1)
+        == std::vector{resource2->id(), resource1->id()});
+      CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource1->state()));
+      CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource2->state()));
+      CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(resource3->state()));
+    }
+
     SECTION("dropping resources")
     {
       auto mockDropCalls = std::array{std::optional<bool>{}, std::optional<bool>{}};
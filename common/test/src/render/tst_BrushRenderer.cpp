@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/MapFormat.h"
+#include "render/BrushRenderer.h"
+#include "render/PerspectiveCamera.h"
+#include "render/ViewFrustum.h"
+
+#include "kdl/result.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <tuple>
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+
+TEST_CASE("BrushRenderer.countVisibleChunks")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = mdl::BrushBuilder{mdl::MapFormat::Standard, worldBounds};
+
+  auto nearBrushNode =
+    mdl::BrushNode{builder.createCube(64.0, "material") | kdl::value()};
+  auto farBrushNode = mdl::BrushNode{
+    builder.createCuboid(vm::bbox3d{{4096, 0, 0}, {4160, 64, 64}}, "material")
+    | kdl::value()};
+  auto behindBrushNode = mdl::BrushNode{
+    builder.createCuboid(vm::bbox3d{{-4160, 0, 0}, {-4096, 64, 64}}, "material")
+    | kdl::value()};
+
+  auto renderer = BrushRenderer{};
+  renderer.addBrush(&nearBrushNode);
+  renderer.addBrush(&farBrushNode);
+  renderer.addBrush(&behindBrushNode);
+  renderer.validate();
+
+  const auto viewport = Camera::Viewport{0, 0, 800, 600};
+  const auto position = vm::vec3f{-256, 0, 0};
+  const auto direction = vm::vec3f{1, 0, 0};
+  const auto up = vm::vec3f{0, 0, 1};
+
+  SECTION("Chunks behind the camera are culled")
+  {
+    const auto camera =
+      PerspectiveCamera{90.0f, 1.0f, 8192.0f, viewport, position, direction, up};
+    CHECK(renderer.countVisibleChunks(ViewFrustum{camera}) == std::tuple{3, 2});
+  }
+
+  SECTION("Chunks beyond the far plane are culled")
+  {
+    const auto camera =
+      PerspectiveCamera{90.0f, 1.0f, 1024.0f, viewport, position, direction, up};
+    CHECK(renderer.countVisibleChunks(ViewFrustum{camera}) == std::tuple{3, 1});
+  }
+
+  SECTION("Removing brushes keeps their chunks until the renderer is invalidated")
+  {
+    renderer.removeBrush(&farBrushNode);
+
+    const auto camera =
+      PerspectiveCamera{90.0f, 1.0f, 8192.0f, viewport, position, direction, up};
+    CHECK(renderer.countVisibleChunks(ViewFrustum{camera}) == std::tuple{3, 2});
+
+    renderer.invalidate();
+    renderer.validate();
+    CHECK(renderer.countVisibleChunks(ViewFrustum{camera}) == std::tuple{2, 1});
+  }
+}
+
+} // namespace tb::render
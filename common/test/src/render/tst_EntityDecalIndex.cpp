@@ -0,0 +1,116 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/BrushBuilder.h"
+#include "mdl/BrushNode.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityNode.h"
+#include "mdl/MapFormat.h"
+#include "render/EntityDecalIndex.h"
+
+#include "kdl/result.h"
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+
+TEST_CASE("EntityDecalIndex")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+  const auto builder = mdl::BrushBuilder{mdl::MapFormat::Standard, worldBounds};
+
+  auto brushNode = mdl::BrushNode{builder.createCube(64.0, "material") | kdl::value()};
+  auto farBrushNode = mdl::BrushNode{
+    builder.createCuboid(vm::bbox3d{{1024, 1024, 1024}, {1088, 1088, 1088}}, "material")
+    | kdl::value()};
+
+  auto nearEntityNode = mdl::EntityNode{mdl::Entity{{{"origin", "0 0 32"}}}};
+  auto farEntityNode = mdl::EntityNode{mdl::Entity{{{"origin", "-2048 -2048 -2048"}}}};
+
+  auto index = EntityDecalIndex{};
+  index.addOrUpdateEntity(&nearEntityNode);
+  index.addOrUpdateEntity(&farEntityNode);
+
+  CHECK(index.contains(&nearEntityNode));
+  CHECK(index.contains(&farEntityNode));
+
+  SECTION("findAffectedEntities returns intersecting entities")
+  {
+    CHECK(
+      index.findAffectedEntities(&brushNode)
+      == std::vector<const mdl::EntityNode*>{&nearEntityNode});
+    CHECK(index.findAffectedEntities(&brushNode, false).empty());
+    CHECK(index.findAffectedEntities(&farBrushNode).empty());
+  }
+
+  SECTION("findAffectedEntities returns tracking entities")
+  {
+    index.setBrushes(&farEntityNode, {&brushNode, &farBrushNode});
+    CHECK(
+      index.brushes(&farEntityNode)
+      == std::vector<const mdl::BrushNode*>{&brushNode, &farBrushNode});
+
+    CHECK_THAT(
+      index.findAffectedEntities(&brushNode),
+      Catch::UnorderedEquals(
+        std::vector<const mdl::EntityNode*>{&nearEntityNode, &farEntityNode}));
+    CHECK(
+      index.findAffectedEntities(&farBrushNode, false)
+      == std::vector<const mdl::EntityNode*>{&farEntityNode});
+
+    index.clearBrushes(&farEntityNode);
+    CHECK(index.brushes(&farEntityNode).empty());
+    CHECK(index.findAffectedEntities(&farBrushNode).empty());
+  }
+
+  SECTION("addOrUpdateEntity updates the entity bounds")
+  {
+    farEntityNode.setEntity(mdl::Entity{{{"origin", "1056 1056 1056"}}});
+    index.addOrUpdateEntity(&farEntityNode);
+
+    CHECK(
+      index.findAffectedEntities(&farBrushNode)
+      == std::vector<const mdl::EntityNode*>{&farEntityNode});
+  }
+
+  SECTION("removeEntity removes the entity and its brushes")
+  {
+    index.setBrushes(&nearEntityNode, {&farBrushNode});
+    index.removeEntity(&nearEntityNode);
+
+    CHECK_FALSE(index.contains(&nearEntityNode));
+    CHECK(index.findAffectedEntities(&brushNode).empty());
+    CHECK(index.findAffectedEntities(&farBrushNode).empty());
+  }
+
+  SECTION("clear")
+  {
+    index.setBrushes(&nearEntityNode, {&brushNode});
+    index.clear();
+
+    CHECK_FALSE(index.contains(&nearEntityNode));
+    CHECK_FALSE(index.contains(&farEntityNode));
+    CHECK(index.findAffectedEntities(&brushNode).empty());
+  }
+}
+
+} // namespace tb::render
@@ -0,0 +1,73 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/EntityModel.h"
+#include "render/EntityModelBatch.h"
+#include "render/MaterialIndexRangeRenderer.h"
+
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
+#include "vm/vec.h"
+
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+
+TEST_CASE("EntityModelBatcher")
+{
+  auto renderer1 = MaterialIndexRangeRenderer{};
+  auto renderer2 = MaterialIndexRangeRenderer{};
+
+  const auto t1 = vm::translation_matrix(vm::vec3f{1, 0, 0});
+  const auto t2 = vm::translation_matrix(vm::vec3f{0, 1, 0});
+  const auto t3 = vm::translation_matrix(vm::vec3f{0, 0, 1});
+
+  auto batcher = EntityModelBatcher{};
+
+  SECTION("Empty batcher")
+  {
+    CHECK(batcher.batches().empty());
+    CHECK(batcher.instanceCount() == 0u);
+  }
+
+  SECTION("Instances are grouped by renderer")
+  {
+    batcher.add(&renderer1, mdl::Orientation::Oriented, t1);
+    batcher.add(&renderer2, mdl::Orientation::ViewPlaneParallel, t2);
+    batcher.add(&renderer1, mdl::Orientation::Oriented, t3);
+
+    const auto& batches = batcher.batches();
+    REQUIRE(batches.size() == 2u);
+
+    CHECK(batches[0].renderer == &renderer1);
+    CHECK(batches[0].orientation == mdl::Orientation::Oriented);
+    CHECK(batches[0].transformations == std::vector<vm::mat4x4f>{t1, t3});
+
+    CHECK(batches[1].renderer == &renderer2);
+    CHECK(batches[1].orientation == mdl::Orientation::ViewPlaneParallel);
+    CHECK(batches[1].transformations == std::vector<vm::mat4x4f>{t2});
+
+    CHECK(batcher.instanceCount() == 3u);
+  }
+}
+
+} // namespace tb::render
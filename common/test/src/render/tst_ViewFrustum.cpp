@@ -0,0 +1,103 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "render/OrthographicCamera.h"
+#include "render/PerspectiveCamera.h"
+#include "render/ViewFrustum.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+namespace
+{
+
+vm::bbox3f boxAt(const vm::vec3f& center)
+{
+  return vm::bbox3f{center - vm::vec3f{16, 16, 16}, center + vm::vec3f{16, 16, 16}};
+}
+
+} // namespace
+
+TEST_CASE("ViewFrustum")
+{
+  const auto viewport = Camera::Viewport{0, 0, 800, 600};
+
+  SECTION("Perspective camera")
+  {
+    const auto camera = PerspectiveCamera{
+      90.0f,
+      1.0f,
+      1024.0f,
+      viewport,
+      vm::vec3f{0, 0, 0},
+      vm::vec3f{1, 0, 0},
+      vm::vec3f{0, 0, 1}};
+    const auto frustum = ViewFrustum{camera};
+
+    CHECK(frustum.intersects(boxAt({256, 0, 0})));
+    CHECK(frustum.intersects(boxAt({256, 64, -64})));
+    CHECK(frustum.intersects(boxAt({0, 0, 0})));
+
+    // behind the camera
+    CHECK_FALSE(frustum.intersects(boxAt({-256, 0, 0})));
+
+    // outside of the side planes
+    CHECK_FALSE(frustum.intersects(boxAt({256, 1024, 0})));
+    CHECK_FALSE(frustum.intersects(boxAt({256, -1024, 0})));
+    CHECK_FALSE(frustum.intersects(boxAt({256, 0, 1024})));
+    CHECK_FALSE(frustum.intersects(boxAt({256, 0, -1024})));
+
+    // beyond the far plane
+    CHECK(frustum.intersects(boxAt({1024, 0, 0})));
+    CHECK_FALSE(frustum.intersects(boxAt({1100, 0, 0})));
+
+    // a large box that contains the camera
+    CHECK(frustum.intersects(vm::bbox3f{4096.0f}));
+  }
+
+  SECTION("Orthographic camera")
+  {
+    const auto camera = OrthographicCamera{
+      1.0f,
+      1024.0f,
+      viewport,
+      vm::vec3f{0, 0, 0},
+      vm::vec3f{0, 0, -1},
+      vm::vec3f{0, 1, 0}};
+    const auto frustum = ViewFrustum{camera};
+
+    CHECK(frustum.intersects(boxAt({0, 0, 0})));
+    CHECK(frustum.intersects(boxAt({380, 280, 0})));
+
+    // the depth is not bounded
+    CHECK(frustum.intersects(boxAt({0, 0, 4096})));
+    CHECK(frustum.intersects(boxAt({0, 0, -4096})));
+
+    // outside of the viewport
+    CHECK_FALSE(frustum.intersects(boxAt({512, 0, 0})));
+    CHECK_FALSE(frustum.intersects(boxAt({0, -512, 0})));
+  }
+}
+
+} // namespace tb::render
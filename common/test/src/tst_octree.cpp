@@ -675,6 +675,65 @@ TEST_CASE("octree.find_intersectors-bbox")
   }
 }
 
+TEST_CASE("octree.find_intersectors-batched")
+{
+  auto tree = octree<double, int>{32.0};
+
+  SECTION("empty tree")
+  {
+    CHECK(
+      tree.find_intersectors(std::vector<vm::ray3d>{{{0, 0, 0}, {1, 0, 0}}})
+      == std::vector<std::vector<int>>{{}});
+    CHECK(
+      tree.find_intersectors(std::vector<vm::bbox3d>{{{0, 0, 0}, {1, 1, 1}}})
+      == std::vector<std::vector<int>>{{}});
+  }
+
+  SECTION("multiple nodes")
+  {
+    for (int i = 0; i < 64; ++i)
+    {
+      const auto x = double(i % 8) * 48.0 - 192.0;
+      const auto y = double(i / 8) * 48.0 - 192.0;
+      tree.insert({{x, y, -16}, {x + 16, y + 16, 16}}, i);
+    }
+
+    const auto rays = std::vector<vm::ray3d>{
+      {{0, 0, 0}, {1, 0, 0}},
+      {{8, 8, -64}, {0, 0, 1}},
+      {{-184, -184, 64}, {0, 0, -1}},
+      {{-256, -184, 0}, {1, 0, 0}},
+      {{1024, 1024, 1024}, {1, 0, 0}},
+    };
+
+    const auto bboxes = std::vector<vm::bbox3d>{
+      {{0, 0, 0}, {1, 1, 1}},
+      {{-64, -64, -64}, {64, 64, 64}},
+      {{-1024, -1024, -1024}, {1024, 1024, 1024}},
+      {{1024, 1024, 1024}, {2048, 2048, 2048}},
+    };
+
+    const auto rayResults = tree.find_intersectors(rays);
+    REQUIRE(rayResults.size() == rays.size());
+    for (size_t i = 0; i < rays.size(); ++i)
+    {
+      CHECK_THAT(
+        rayResults[i], Catch::UnorderedEquals(tree.find_intersectors(rays[i])));
+    }
+
+    const auto bboxResults = tree.find_intersectors(bboxes);
+    REQUIRE(bboxResults.size() == bboxes.size());
+    for (size_t i = 0; i < bboxes.size(); ++i)
+    {
+      CHECK_THAT(
+        bboxResults[i], Catch::UnorderedEquals(tree.find_intersectors(bboxes[i])));
+    }
+
+    CHECK(bboxResults[2].size() == 64);
+    CHECK(bboxResults[3].empty());
+  }
+}
+
 TEST_CASE("octree.find_containers")
 {
   auto tree = octree<double, int>{32.0};
@@ -0,0 +1,245 @@
+/*
+ Copyright (C) 2025 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ui/CellLayout.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::ui
+{
+namespace
+{
+
+struct Item
+{
+  int id;
+  float width;
+  float height;
+};
+
+CellLayout makeLayout()
+{
+  auto layout = CellLayout{};
+  layout.setWidth(400.0f);
+  layout.setCellWidth(32.0f, 64.0f);
+  layout.setCellHeight(32.0f, 64.0f);
+  layout.setCellMargin(4.0f);
+  layout.setTitleMargin(2.0f);
+  layout.setRowMargin(6.0f);
+  layout.setGroupMargin(8.0f);
+  layout.setOuterMargin(10.0f);
+  return layout;
+}
+
+std::vector<Item> makeItems(const int count, const int firstId = 0)
+{
+  auto items = std::vector<Item>{};
+  for (auto i = 0; i < count; ++i)
+  {
+    items.push_back(
+      Item{firstId + i, float(16 + (i % 5) * 16), float(16 + (i % 3) * 24)});
+  }
+  return items;
+}
+
+void addItems(CellLayout& layout, const std::vector<Item>& items, const size_t first = 0)
+{
+  for (auto i = first; i < items.size(); ++i)
+  {
+    const auto& item = items[i];
+    layout.addItem(
+      item.id, std::to_string(item.id), item.width, item.height, 64.0f, 12.0f);
+  }
+}
+
+using CellInfo = std::tuple<int, std::string, float, float, float, float>;
+
+std::vector<CellInfo> getCells(CellLayout& layout)
+{
+  auto result = std::vector<CellInfo>{};
+  for (const auto& group : layout.groups())
+  {
+    for (const auto& row : group.rows())
+    {
+      for (const auto& cell : row.cells())
+      {
+        const auto& bounds = cell.cellBounds();
+        result.emplace_back(
+          cell.itemAs<int>(),
+          cell.title(),
+          bounds.x,
+          bounds.y,
+          bounds.width,
+          bounds.height);
+      }
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("LayoutGroup")
+{
+  auto layout = makeLayout();
+  addItems(layout, makeItems(40));
+
+  REQUIRE(layout.groups().size() == 1u);
+  const auto& group = layout.groups().front();
+  const auto& rows = group.rows();
+  REQUIRE(rows.size() > 4u);
+
+  SECTION("rowsIntersectingY")
+  {
+    CHECK(group.rowsIntersectingY(0.0f, 0.0f).empty());
+    CHECK(group.rowsIntersectingY(rows.back().bounds().bottom() + 1.0f, 100.0f).empty());
+
+    const auto all = group.rowsIntersectingY(0.0f, layout.height());
+    CHECK(all.data() == rows.data());
+    CHECK(all.size() == rows.size());
+
+    const auto& row1 = rows[1];
+    const auto& row3 = rows[3];
+    const auto some = group.rowsIntersectingY(
+      row1.bounds().bottom() - 1.0f, row3.bounds().top() - row1.bounds().bottom() + 2.0f);
+    CHECK(some.data() == &rows[1]);
+    CHECK(some.size() == 3u);
+
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+      const auto& bounds = rows[i].bounds();
+      const auto intersecting = group.rowsIntersectingY(bounds.top(), bounds.height);
+      CHECK(intersecting.data() == &rows[i]);
+      CHECK(intersecting.size() == 1u);
+    }
+  }
+
+  SECTION("cellAt")
+  {
+    for (const auto& row : rows)
+    {
+      for (const auto& cell : row.cells())
+      {
+        const auto& bounds = cell.cellBounds();
+        CHECK(
+          group.cellAt(bounds.left() + 1.0f, bounds.top() + 1.0f)->itemAs<int>()
+          == cell.itemAs<int>());
+      }
+    }
+
+    const auto& bounds = rows[1].bounds();
+    CHECK(group.cellAt(bounds.left() + 1.0f, bounds.top() - 1.0f) == nullptr);
+    CHECK(
+      group.cellAt(bounds.left() + 1.0f, rows.back().bounds().bottom() + 1.0f)
+      == nullptr);
+  }
+
+  SECTION("indexOfRowAt")
+  {
+    CHECK(group.indexOfRowAt(0.0f) == 0u);
+    CHECK(group.indexOfRowAt(rows[2].bounds().top()) == 2u);
+    CHECK(group.indexOfRowAt(rows.back().bounds().bottom() + 1.0f) == rows.size());
+  }
+}
+
+TEST_CASE("CellLayout")
+{
+  SECTION("truncate")
+  {
+    SECTION("Without groups")
+    {
+      auto oldItems = makeItems(40);
+      auto newItems = oldItems;
+      newItems.erase(newItems.begin() + 23);
+      newItems.push_back(Item{100, 48.0f, 64.0f});
+
+      auto expected = makeLayout();
+      addItems(expected, newItems);
+
+      auto layout = makeLayout();
+      addItems(layout, oldItems);
+
+      const auto firstItem = layout.truncate(0, 23);
+      CHECK(firstItem <= 23u);
+      CHECK(
+        layout.groups().front().rows().size()
+        < expected.groups().front().rows().size());
+
+      addItems(layout, newItems, firstItem);
+      CHECK(getCells(layout) == getCells(expected));
+      CHECK(layout.height() == expected.height());
+    }
+
+    SECTION("With groups")
+    {
+      const auto addGroups =
+        [](CellLayout& layout, const std::vector<std::vector<Item>>& groups) {
+          for (size_t i = 0; i < groups.size(); ++i)
+          {
+            layout.addGroup("group " + std::to_string(i), 14.0f);
+            addItems(layout, groups[i]);
+          }
+        };
+
+      auto oldGroups = std::vector<std::vector<Item>>{
+        makeItems(20), makeItems(30, 100), makeItems(10, 200)};
+      auto newGroups = oldGroups;
+      newGroups[1][17].height = 64.0f;
+      newGroups.pop_back();
+
+      auto expected = makeLayout();
+      addGroups(expected, newGroups);
+
+      auto layout = makeLayout();
+      addGroups(layout, oldGroups);
+
+      const auto firstItem = layout.truncate(1, 17);
+      CHECK(layout.groups().size() == 2u);
+
+      addItems(layout, newGroups[1], firstItem);
+      CHECK(getCells(layout) == getCells(expected));
+      CHECK(layout.height() == expected.height());
+    }
+
+    SECTION("After changing the width")
+    {
+      const auto items = makeItems(40);
+
+      auto expected = makeLayout();
+      addItems(expected, items);
+      expected.setWidth(300.0f);
+      REQUIRE(expected.groups().size() == 1u);
+
+      auto layout = makeLayout();
+      addItems(layout, items);
+      layout.setWidth(300.0f);
+
+      const auto firstItem = layout.truncate(0, 30);
+      addItems(layout, items, firstItem);
+      CHECK(getCells(layout) == getCells(expected));
+      CHECK(layout.height() == expected.height());
+    }
+  }
+}
+
+} // namespace tb::ui
@@ -244,6 +244,73 @@ public:
   }
 };
 
+class SizedCommand : public UndoableCommand
+{
+private:
+  size_t m_memoryUsage;
+
+public:
+  SizedCommand(std::string name, const size_t memoryUsage)
+    : UndoableCommand{std::move(name), false}
+    , m_memoryUsage{memoryUsage}
+  {
+  }
+
+  std::unique_ptr<CommandResult> doPerformDo(MapDocumentCommandFacade&) override
+  {
+    return std::make_unique<CommandResult>(true);
+  }
+
+  std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade&) override
+  {
+    return std::make_unique<CommandResult>(true);
+  }
+
+  size_t memoryUsage() const override { return m_memoryUsage; }
+};
+
+class ResizingCommand : public UndoableCommand
+{
+private:
+  size_t m_doneMemoryUsage;
+  size_t m_undoneMemoryUsage;
+  size_t m_memoryUsage;
+
+public:
+  ResizingCommand(
+    std::string name, const size_t doneMemoryUsage, const size_t undoneMemoryUsage)
+    : UndoableCommand{std::move(name), false}
+    , m_doneMemoryUsage{doneMemoryUsage}
+    , m_undoneMemoryUsage{undoneMemoryUsage}
+    , m_memoryUsage{0}
+  {
+  }
+
+  std::unique_ptr<CommandResult> doPerformDo(MapDocumentCommandFacade&) override
+  {
+    m_memoryUsage = m_doneMemoryUsage;
+    return std::make_unique<CommandResult>(true);
+  }
+
+  std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade&) override
+  {
+    m_memoryUsage = m_undoneMemoryUsage;
+    return std::make_unique<CommandResult>(true);
+  }
+
+  bool doCollateWith(UndoableCommand& command) override
+  {
+    if (auto* other = dynamic_cast<ResizingCommand*>(&command))
+    {
+      m_memoryUsage += other->m_memoryUsage;
+      return true;
+    }
+    return false;
+  }
+
+  size_t memoryUsage() const override { return m_memoryUsage; }
+};
+
 } // namespace
 
 TEST_CASE("CommandProcessorTest.doAndUndoSuccessfulCommand")
@@ -845,4 +912,84 @@ TEST_CASE("CommandProcessorTest.collateTransactions")
   commandProcessor.undo();
 }
 
+TEST_CASE("CommandProcessorTest.memoryBudget")
+{
+  auto taskManager = createTestTaskManager();
+  auto facade = MapDocumentCommandFacade{*taskManager};
+  auto commandProcessor =
+    CommandProcessor{facade, std::chrono::milliseconds{1000}, size_t(250)};
+
+  commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 1", 100));
+  commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 2", 100));
+  CHECK(commandProcessor.memoryUsage() == 200u);
+
+  // the oldest command is removed to stay within the budget
+  commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 3", 100));
+  CHECK(commandProcessor.memoryUsage() == 200u);
+
+  CHECK(commandProcessor.undo()->success());
+  CHECK(commandProcessor.undo()->success());
+  CHECK_FALSE(commandProcessor.canUndo());
+  CHECK(commandProcessor.redoCommandName() == "command 2");
+  CHECK(commandProcessor.memoryUsage() == 200u);
+
+  // the most recent command is kept even if it exceeds the budget on its own
+  commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 4", 300));
+  CHECK_FALSE(commandProcessor.canRedo());
+  CHECK(commandProcessor.undoCommandName() == "command 4");
+  CHECK(commandProcessor.memoryUsage() == 300u);
+}
+
+TEST_CASE("CommandProcessorTest.setMemoryBudget")
+{
+  auto taskManager = createTestTaskManager();
+  auto facade = MapDocumentCommandFacade{*taskManager};
+  auto commandProcessor = CommandProcessor{facade};
+
+  commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 1", 100));
+  commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 2", 100));
+  commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 3", 100));
+  CHECK(commandProcessor.memoryUsage() == 300u);
+
+  // lowering the budget removes the oldest commands immediately
+  commandProcessor.setMemoryBudget(size_t(150));
+  CHECK(commandProcessor.memoryUsage() == 100u);
+  CHECK(commandProcessor.undoCommandName() == "command 3");
+
+  commandProcessor.setMemoryBudget(std::nullopt);
+  commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 4", 100));
+  CHECK(commandProcessor.memoryUsage() == 200u);
+}
+
+TEST_CASE("CommandProcessorTest.memoryUsageOfResizingCommands")
+{
+  auto taskManager = createTestTaskManager();
+  auto facade = MapDocumentCommandFacade{*taskManager};
+  auto commandProcessor = CommandProcessor{facade};
+
+  commandProcessor.executeAndStore(
+    std::make_unique<ResizingCommand>("command 1", 100, 50));
+  CHECK(commandProcessor.memoryUsage() == 100u);
+
+  // the memory usage of a command is updated when it is moved between the stacks
+  CHECK(commandProcessor.undo()->success());
+  CHECK(commandProcessor.memoryUsage() == 50u);
+
+  CHECK(commandProcessor.redo()->success());
+  CHECK(commandProcessor.memoryUsage() == 100u);
+
+  // and when another command is collated into it
+  commandProcessor.executeAndStore(
+    std::make_unique<ResizingCommand>("command 2", 20, 10));
+  CHECK(commandProcessor.undoCommandName() == "command 1");
+  CHECK(commandProcessor.memoryUsage() == 120u);
+
+  CHECK(commandProcessor.undo()->success());
+  CHECK(commandProcessor.memoryUsage() == 50u);
+
+  // storing a new command clears the redo stack
+  commandProcessor.executeAndStore(std::make_unique<SizedCommand>("command 3", 30));
+  CHECK(commandProcessor.memoryUsage() == 30u);
+}
+
 } // namespace tb::ui
@@ -19,6 +19,7 @@
 
 #include "TestUtils.h"
 #include "mdl/BrushNode.h"
+#include "mdl/CompactNodeContents.h"
 #include "mdl/EntityNode.h"
 #include "mdl/GroupNode.h"
 #include "mdl/LayerNode.h"
@@ -66,6 +67,22 @@ TEST_CASE_METHOD(MapDocumentTest, "RemoveNodesTest.removeNodes")
   }
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "RemoveNodesTest.undoMemoryUsage")
+{
+  auto* brushNode = createBrushNode();
+  document->addNodes({{document->parentForNodes(), {brushNode}}});
+
+  const auto memoryUsage = document->undoMemoryUsage();
+  const auto brushNodeMemoryUsage = mdl::memoryUsage(*brushNode);
+
+  // the command owns the removed node until it is undone
+  document->removeNodes({brushNode});
+  CHECK(document->undoMemoryUsage() >= memoryUsage + brushNodeMemoryUsage);
+
+  document->undoCommand();
+  CHECK(document->undoMemoryUsage() < memoryUsage + brushNodeMemoryUsage);
+}
+
 TEST_CASE_METHOD(MapDocumentTest, "RemoveNodesTest.removeLayer")
 {
   auto* layer = new mdl::LayerNode{mdl::Layer{"Layer 1"}};
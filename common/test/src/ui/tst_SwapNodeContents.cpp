@@ -63,6 +63,41 @@ TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.swapBrushes")
   CHECK(brushNode->brush() == originalBrush);
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.collateSwaps")
+{
+  auto* brushNode = createBrushNode();
+  document->addNodes({{document->parentForNodes(), {brushNode}}});
+
+  const auto originalBrush = brushNode->brush();
+  auto translatedBrush = originalBrush;
+  REQUIRE(translatedBrush
+            .transform(
+              document->worldBounds(), vm::translation_matrix(vm::vec3d(16, 0, 0)), false)
+            .is_success());
+
+  auto modifiedBrush = translatedBrush;
+  auto attributes = modifiedBrush.face(0).attributes();
+  attributes.setXOffset(8.0f);
+  modifiedBrush.face(0).setAttributes(attributes);
+
+  auto nodesToSwap = std::vector<std::pair<mdl::Node*, mdl::NodeContents>>{};
+  nodesToSwap.emplace_back(brushNode, translatedBrush);
+  document->swapNodeContents("Swap Nodes", std::move(nodesToSwap), {});
+
+  nodesToSwap = std::vector<std::pair<mdl::Node*, mdl::NodeContents>>{};
+  nodesToSwap.emplace_back(brushNode, modifiedBrush);
+  document->swapNodeContents("Swap Nodes", std::move(nodesToSwap), {});
+  REQUIRE(brushNode->brush() == modifiedBrush);
+
+  // both swaps were collated into one command
+  document->undoCommand();
+  CHECK(brushNode->brush() == originalBrush);
+  CHECK_FALSE(document->canUndoCommand());
+
+  document->redoCommand();
+  CHECK(brushNode->brush() == modifiedBrush);
+}
+
 TEST_CASE_METHOD(MapDocumentTest, "SwapNodeContentsTest.swapPatches")
 {
   auto* patchNode = createPatchNode();
@@ -20,66 +20,174 @@
 
 #include "kdl/task_manager.h"
 
-#include "kdl/range_to_vector.h"
-
+#include <atomic>
 #include <condition_variable>
-#include <functional>
-#include <future>
+#include <cstddef>
 #include <mutex>
-#include <queue>
-#include <ranges>
+#include <optional>
 #include <thread>
 #include <vector>
 
 namespace kdl
 {
+namespace
+{
+
+constexpr auto no_worker = static_cast<std::size_t>(-1);
+
+// identifies the worker running on the current thread, if any
+thread_local const task_manager* current_task_manager = nullptr;
+thread_local std::size_t current_worker_index = no_worker;
 
-std::function<void()> task_manager::make_worker_func()
+} // namespace
+
+void task_manager::worker_func(const std::size_t worker_index)
 {
-  return [&] {
-    while (true)
+  current_task_manager = this;
+  current_worker_index = worker_index;
+
+  while (m_running)
+  {
+    if (!run_pending_task(worker_index))
     {
-      auto lock = std::unique_lock{m_pending_tasks_mutex};
-      m_pending_tasks_cv.wait(
-        lock, [&] { return !m_running || !m_pending_tasks.empty(); });
+      auto lock = std::unique_lock{m_idle_mutex};
+      m_idle_cv.wait(lock, [&] { return !m_running || m_pending_task_count > 0; });
+    }
+  }
+}
 
-      if (!m_running)
-      {
-        break;
-      }
+void task_manager::push_task(pending_task task)
+{
+  const auto queue_index = current_task_manager == this
+                             ? current_worker_index
+                             : m_next_queue++ % m_queues.size();
+  auto& queue = *m_queues[queue_index];
 
-      if (!m_pending_tasks.empty())
-      {
-        auto task = std::move(m_pending_tasks.front());
-        m_pending_tasks.pop();
-        lock.unlock();
+  {
+    // count the task under the queue lock so that it cannot be taken before it was
+    // counted
+    auto lock = std::lock_guard{queue.mutex};
+    queue.tasks.push_back(std::move(task));
+    ++queue.size;
+    ++m_pending_task_count;
+  }
+
+  {
+    // prevent a worker from missing the notification between checking for pending tasks
+    // and going to sleep
+    auto lock = std::lock_guard{m_idle_mutex};
+  }
+  m_idle_cv.notify_one();
+}
+
+void task_manager::push_tasks(std::vector<pending_task> tasks)
+{
+  const auto task_count = tasks.size();
+  const auto queue_index = current_task_manager == this
+                             ? current_worker_index
+                             : m_next_queue++ % m_queues.size();
+  auto& queue = *m_queues[queue_index];
+
+  // the whole batch goes into one queue, idle workers will steal from it
+  {
+    auto lock = std::lock_guard{queue.mutex};
+    for (auto& task : tasks)
+    {
+      queue.tasks.push_back(std::move(task));
+    }
+    queue.size += task_count;
+    m_pending_task_count += task_count;
+  }
 
-        task();
+  {
+    auto lock = std::lock_guard{m_idle_mutex};
+  }
+
+  if (task_count == 1)
+  {
+    m_idle_cv.notify_one();
+  }
+  else
+  {
+    m_idle_cv.notify_all();
+  }
+}
+
+bool task_manager::run_pending_task(const std::size_t worker_index)
+{
+  const auto take_task = [&](task_queue& queue, const bool from_back) {
+    auto result = std::optional<pending_task>{};
+    if (queue.size > 0)
+    {
+      auto lock = std::lock_guard{queue.mutex};
+      if (!queue.tasks.empty())
+      {
+        if (from_back)
+        {
+          result = std::move(queue.tasks.back());
+          queue.tasks.pop_back();
+        }
+        else
+        {
+          result = std::move(queue.tasks.front());
+          queue.tasks.pop_front();
+        }
+        --queue.size;
+        --m_pending_task_count;
       }
     }
+    return result;
   };
+
+  auto task = take_task(*m_queues[worker_index], true);
+
+  // steal from the other queues, starting at a different queue for every worker
+  const auto queue_count = m_queues.size();
+  for (std::size_t i = 1; !task && i < queue_count; ++i)
+  {
+    task = take_task(*m_queues[(worker_index + i) % queue_count], false);
+  }
+
+  if (task)
+  {
+    // the task might already have been run by the thread waiting for its batch
+    task->try_run();
+    return true;
+  }
+
+  return false;
 }
 
 task_manager::task_manager(const std::size_t max_concurrent_tasks)
 {
-  for (size_t i = 0; i < max_concurrent_tasks; ++i)
+  for (std::size_t i = 0; i < max_concurrent_tasks; ++i)
   {
-    m_workers.emplace_back(make_worker_func());
+    m_queues.push_back(std::make_unique<task_queue>());
+  }
+
+  for (std::size_t i = 0; i < max_concurrent_tasks; ++i)
+  {
+    m_workers.emplace_back([&, i] { worker_func(i); });
   }
 }
 
 task_manager::~task_manager()
 {
   {
-    auto lock = std::lock_guard{m_pending_tasks_mutex};
+    auto lock = std::lock_guard{m_idle_mutex};
     m_running = false;
   }
 
-  m_pending_tasks_cv.notify_all();
+  m_idle_cv.notify_all();
   for (auto& worker : m_workers)
   {
     worker.join();
   }
 }
 
+std::size_t task_manager::worker_count() const
+{
+  return m_workers.size();
+}
+
 } // namespace kdl
@@ -20,33 +20,202 @@
 
 #pragma once
 
-#include "kdl/range_to_vector.h"
-
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <ranges>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace kdl
 {
 
+/**
+ * Runs tasks on a fixed pool of worker threads.
+ *
+ * Every worker owns a task queue. A worker takes tasks from the back of its own queue and
+ * steals from the front of the other workers' queues when its own queue is empty. Tasks
+ * submitted by a worker are added to that worker's queue, and tasks submitted by any
+ * other thread are distributed over the workers' queues.
+ *
+ * A thread that waits for a batch of tasks by calling `run_tasks_and_wait` or
+ * `parallel_for` runs those tasks of the batch that no worker has taken yet, and then
+ * blocks until the workers have finished the remaining tasks of the batch. The waiting
+ * thread never runs tasks from other batches, so waiting doesn't block it for the
+ * duration of unrelated tasks. It is safe to call these functions from within a task.
+ *
+ * If the task manager has no workers, all tasks are run immediately on the calling
+ * thread.
+ */
 class task_manager
 {
 private:
-  using pending_task = std::function<void()>;
+  /**
+   * A task that is run at most once, either by a worker that takes it from a queue or by
+   * the thread that waits for the task's batch. Copies refer to the same task.
+   */
+  class pending_task
+  {
+  private:
+    struct state_base
+    {
+      std::atomic<bool> claimed = false;
+
+      virtual ~state_base() = default;
+      virtual void run() = 0;
+    };
+
+    template <typename F>
+    struct state : state_base
+    {
+      F func;
 
+      explicit state(F func_)
+        : func{std::move(func_)}
+      {
+      }
+
+      void run() override { func(); }
+    };
+
+    std::shared_ptr<state_base> m_state;
+
+  public:
+    template <typename F>
+    explicit pending_task(F func)
+      : m_state{std::make_shared<state<F>>(std::move(func))}
+    {
+    }
+
+    /**
+     * Runs the task unless another thread has already claimed it.
+     */
+    void try_run()
+    {
+      if (!m_state->claimed.exchange(true))
+      {
+        m_state->run();
+      }
+    }
+  };
+
+  struct task_queue
+  {
+    std::mutex mutex;
+    std::deque<pending_task> tasks;
+    std::atomic<std::size_t> size = 0;
+  };
+
+  std::vector<std::unique_ptr<task_queue>> m_queues;
   std::vector<std::thread> m_workers;
+  std::atomic<std::size_t> m_next_queue = 0;
+  std::atomic<std::size_t> m_pending_task_count = 0;
+
+  std::mutex m_idle_mutex;
+  std::condition_variable m_idle_cv;
+  std::atomic<bool> m_running = true;
+
+  template <typename F, typename R>
+  static void fulfill(F& task, std::promise<R>& promise)
+  {
+    try
+    {
+      if constexpr (std::is_void_v<R>)
+      {
+        task();
+        promise.set_value();
+      }
+      else
+      {
+        promise.set_value(task());
+      }
+    }
+    catch (...)
+    {
+      promise.set_exception(std::current_exception());
+    }
+  }
+
+  template <typename F>
+  static auto make_pending_task(F task)
+  {
+    using task_result = std::invoke_result_t<F&>;
+
+    auto promise = std::promise<task_result>{};
+    auto future = promise.get_future();
+    auto pending =
+      pending_task{[task_ = std::move(task), promise_ = std::move(promise)]() mutable {
+        fulfill(task_, promise_);
+      }};
+
+    return std::pair{std::move(pending), std::move(future)};
+  }
+
+  void worker_func(std::size_t worker_index);
+
+  void push_task(pending_task task);
+  void push_tasks(std::vector<pending_task> tasks);
 
-  std::mutex m_pending_tasks_mutex;
-  std::condition_variable m_pending_tasks_cv;
-  std::queue<pending_task> m_pending_tasks;
-  bool m_running = true;
+  /**
+   * Removes a pending task from the given worker's queue, or steals one from another
+   * worker's queue if necessary, and runs it unless it was already claimed.
+   *
+   * Returns true if a task was removed and false if no pending task was found.
+   */
+  bool run_pending_task(std::size_t worker_index);
 
-  std::function<void()> make_worker_func();
+  /**
+   * Submits the given tasks in a single batch and returns a future for each of them.
+   *
+   * The calling thread runs those tasks of the batch that no worker has taken yet, but no
+   * other tasks. When this function returns, every task of the batch has either finished
+   * or is being run by a worker.
+   */
+  template <std::ranges::range range>
+  auto run_batch(range tasks)
+  {
+    using task_type = std::ranges::range_value_t<range>;
+    using task_result = std::invoke_result_t<task_type&>;
+
+    auto futures = std::vector<std::future<task_result>>{};
+    auto pending_tasks = std::vector<pending_task>{};
+
+    for (auto&& task : tasks)
+    {
+      auto [pending, future] =
+        make_pending_task(task_type{std::forward<decltype(task)>(task)});
+      pending_tasks.push_back(std::move(pending));
+      futures.push_back(std::move(future));
+    }
+
+    if (m_workers.empty() || pending_tasks.size() < 2)
+    {
+      for (auto& pending : pending_tasks)
+      {
+        pending.try_run();
+      }
+    }
+    else
+    {
+      push_tasks(pending_tasks);
+
+      // workers steal tasks from the front of the batch, so start at the back
+      for (auto& pending : pending_tasks | std::views::reverse)
+      {
+        pending.try_run();
+      }
+    }
+
+    return futures;
+  }
 
 public:
   explicit task_manager(
@@ -54,45 +223,155 @@ public:
 
   ~task_manager();
 
-  template <typename task_result>
-  auto run_task(std::function<task_result()> task)
+  /**
+   * Returns the number of worker threads.
+   */
+  std::size_t worker_count() const;
+
+  template <typename F>
+  auto run_task(F task)
   {
+    using task_result = std::invoke_result_t<F&>;
+
     if (m_workers.empty())
     {
       auto promise = std::promise<task_result>{};
-      promise.set_value(task());
+      fulfill(task, promise);
       return promise.get_future();
     }
 
-    auto promise = std::make_shared<std::promise<task_result>>();
-    auto future = promise->get_future();
+    auto [pending, future] = make_pending_task(std::move(task));
+    push_task(std::move(pending));
+    return std::move(future);
+  }
+
+  /**
+   * Submits the given tasks in a single batch and returns a future for each of them.
+   */
+  template <std::ranges::range range>
+  auto run_tasks(range tasks)
+  {
+    using task_type = std::ranges::range_value_t<range>;
+    using task_result = std::invoke_result_t<task_type&>;
 
+    auto futures = std::vector<std::future<task_result>>{};
+    auto pending_tasks = std::vector<pending_task>{};
+
+    for (auto&& task : tasks)
     {
-      auto lock = std::lock_guard{m_pending_tasks_mutex};
-      m_pending_tasks.push([&, task_ = std::move(task), promise_ = std::move(promise)]() {
-        promise_->set_value(task_());
-      });
+      if (m_workers.empty())
+      {
+        futures.push_back(run_task(task_type{std::forward<decltype(task)>(task)}));
+      }
+      else
+      {
+        auto [pending, future] =
+          make_pending_task(task_type{std::forward<decltype(task)>(task)});
+        pending_tasks.push_back(std::move(pending));
+        futures.push_back(std::move(future));
+      }
+    }
+
+    if (!pending_tasks.empty())
+    {
+      push_tasks(std::move(pending_tasks));
     }
-    m_pending_tasks_cv.notify_one();
 
-    return future;
+    return futures;
   }
 
+  /**
+   * Runs the given tasks in a single batch and returns their results once all of them
+   * have finished. The calling thread helps to run the tasks of the batch.
+   */
   template <std::ranges::range range>
-  auto run_tasks(range tasks)
+  auto run_tasks_and_wait(range&& tasks)
   {
-    return tasks | std::views::transform([&](auto&& task) {
-             return run_task(std::forward<decltype(task)>(task));
-           })
-           | to_vector;
+    auto futures = run_batch(std::forward<range>(tasks));
+
+    using task_result = decltype(futures.front().get());
+    if constexpr (std::is_void_v<task_result>)
+    {
+      for (auto& future : futures)
+      {
+        future.get();
+      }
+    }
+    else
+    {
+      auto results = std::vector<task_result>{};
+      results.reserve(futures.size());
+      for (auto& future : futures)
+      {
+        results.push_back(future.get());
+      }
+      return results;
+    }
   }
 
-  template <std::ranges::range range>
-  auto run_tasks_and_wait(range&& tasks)
+  /**
+   * Calls the given function for every index in [0, count) and waits until all calls
+   * have returned.
+   *
+   * The indices are split into chunks of the given grain size, and every chunk is run as
+   * a single task. If the grain size is 0, it is chosen such that every worker receives
+   * a few chunks.
+   *
+   * If any call throws an exception, the first such exception is rethrown after all
+   * chunks have finished.
+   */
+  template <typename F>
+  void parallel_for(const std::size_t count, F&& func, std::size_t grain_size = 0)
   {
-    auto futures = run_tasks(std::forward<range>(tasks));
-    return futures | std::views::transform([](auto& future) { return future.get(); })
-           | to_vector;
+    if (m_workers.empty() || count < 2)
+    {
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        func(i);
+      }
+      return;
+    }
+
+    if (grain_size == 0)
+    {
+      grain_size = std::max(std::size_t(1), count / (m_workers.size() * 4));
+    }
+
+    auto tasks = std::vector<std::function<void()>>{};
+    tasks.reserve((count + grain_size - 1) / grain_size);
+    for (std::size_t first = 0; first < count; first += grain_size)
+    {
+      const auto last = std::min(count, first + grain_size);
+      tasks.emplace_back([&func, first, last]() {
+        for (auto i = first; i < last; ++i)
+        {
+          func(i);
+        }
+      });
+    }
+
+    auto futures = run_batch(std::move(tasks));
+
+    auto exception = std::exception_ptr{};
+    for (auto& future : futures)
+    {
+      try
+      {
+        future.get();
+      }
+      catch (...)
+      {
+        if (!exception)
+        {
+          exception = std::current_exception();
+        }
+      }
+    }
+
+    if (exception)
+    {
+      std::rethrow_exception(exception);
+    }
   }
 };
 
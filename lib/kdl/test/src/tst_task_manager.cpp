@@ -21,7 +21,10 @@
 #include "kdl/range_to_vector.h"
 #include "kdl/task_manager.h"
 
+#include <atomic>
 #include <memory>
+#include <stdexcept>
+#include <thread>
 #include <tuple>
 
 #include "catch2.h"
@@ -121,6 +124,104 @@ TEST_CASE("task_manager")
     CHECK(task_ran2);
     CHECK(task_ran3);
   }
+
+  SECTION("run_tasks_and_wait with void tasks")
+  {
+    auto count = std::atomic<int>{0};
+    auto tasks = std::views::iota(0, 10) | std::views::transform([&](auto) {
+                   return std::function<void()>{[&]() { ++count; }};
+                 });
+
+    tm.run_tasks_and_wait(tasks);
+    CHECK(count == 10);
+  }
+
+  SECTION("nested run_tasks_and_wait")
+  {
+    auto outer_tasks =
+      std::views::iota(0, 8) | std::views::transform([&](int i) {
+        return std::function<int()>{[&, i]() {
+          auto inner_tasks = std::views::iota(0, 8) | std::views::transform([i](int j) {
+                               return std::function<int()>{[i, j]() { return i * j; }};
+                             });
+          auto sum = 0;
+          for (const auto result : tm.run_tasks_and_wait(inner_tasks))
+          {
+            sum += result;
+          }
+          return sum;
+        }};
+      });
+
+    CHECK(
+      tm.run_tasks_and_wait(outer_tasks)
+      == std::vector<int>{0, 28, 56, 84, 112, 140, 168, 196});
+  }
+
+  SECTION("waiting thread runs only tasks of its own batch")
+  {
+    auto unblock = std::promise<void>{};
+    auto blocked = unblock.get_future().share();
+    if (max_concurrent_tasks == 0)
+    {
+      // without workers, tasks are run immediately
+      unblock.set_value();
+    }
+
+    // occupy a worker and queue another task behind it
+    auto blocking_future = tm.run_task([blocked]() { blocked.wait(); });
+    auto other_future = tm.run_task([]() { return std::this_thread::get_id(); });
+
+    const auto batch_thread_ids =
+      tm.run_tasks_and_wait(std::vector<std::function<std::thread::id()>>{
+        []() { return std::this_thread::get_id(); },
+        []() { return std::this_thread::get_id(); }});
+    CHECK(batch_thread_ids.size() == 2u);
+
+    if (max_concurrent_tasks > 0)
+    {
+      unblock.set_value();
+      CHECK(other_future.get() != std::this_thread::get_id());
+    }
+    blocking_future.get();
+  }
+
+  SECTION("exceptions are propagated")
+  {
+    auto tasks = std::vector<std::function<int()>>{
+      []() { return 1; }, []() -> int { throw std::runtime_error{"error"}; }};
+    CHECK_THROWS_AS(tm.run_tasks_and_wait(tasks), std::runtime_error);
+  }
+
+  SECTION("parallel_for")
+  {
+    const auto grain_size = GENERATE(std::size_t(0), std::size_t(1), std::size_t(7));
+    CAPTURE(grain_size);
+
+    auto values = std::vector<int>(100, 0);
+    tm.parallel_for(
+      values.size(), [&](const std::size_t i) { values[i] = int(i); }, grain_size);
+
+    CHECK(values == (std::views::iota(0, 100) | to_vector));
+  }
+
+  SECTION("parallel_for rethrows exceptions")
+  {
+    auto count = std::atomic<int>{0};
+    CHECK_THROWS_AS(
+      tm.parallel_for(
+        10,
+        [&](const std::size_t i) {
+          ++count;
+          if (i == 5)
+          {
+            throw std::runtime_error{"error"};
+          }
+        },
+        1),
+      std::runtime_error);
+    CHECK(count == (max_concurrent_tasks == 0 ? 6 : 10));
+  }
 }
 
 TEST_CASE("task_manager stress test")
@@ -30,8 +30,20 @@
 #include "vm/util.h"
 #include "vm/vec.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <optional>
 
+#if defined(__AVX__)
+#include <immintrin.h>
+#define VM_INTERSECTION_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VM_INTERSECTION_SSE2
+#endif
+
 namespace vm
 {
 
@@ -377,6 +389,69 @@ std::optional<T> intersect_ray_polygon(
   return std::nullopt;
 }
 
+/**
+ * Computes the point of intersection of the given ray and the convex polygon with the
+ * given vertices.
+ *
+ * Since the polygon must be convex, the point of intersection with the polygon's plane
+ * can be tested against each edge independently: it is contained in the polygon if it
+ * lies on the same side of every edge. Points within a distance of almost_zero of an edge
+ * are considered to be contained in the polygon. This is cheaper than the general
+ * crossing test used by intersect_ray_polygon.
+ *
+ * @tparam T the component type
+ * @tparam I the vertex range iterator
+ * @tparam G a transformation function that transforms a range element to a vec<T,3>
+ * @param r the ray
+ * @param p the plane on which all vertices lie
+ * @param cur the vertex range start iterator
+ * @param end the vertex range end iterator
+ * @param get the transformation function
+ * @return the distance from the origin of the ray to the point of intersection or nullopt
+ * if the ray does not intersect the polygon
+ */
+template <typename T, typename I, typename G = identity>
+constexpr std::optional<T> intersect_ray_convex_polygon(
+  const ray<T, 3>& r, const plane<T, 3>& p, I cur, I end, const G& get = G())
+{
+  const auto distance = intersect_ray_plane(r, p);
+  if (!distance || cur == end)
+  {
+    return std::nullopt;
+  }
+
+  const auto axis = find_abs_max_component(p.normal);
+  const auto o = swizzle(point_at_distance(r, *distance), axis);
+  const auto epsilon2 = constants<T>::almost_zero() * constants<T>::almost_zero();
+
+  auto left_of_all_edges = true;
+  auto right_of_all_edges = true;
+  const auto check_edge = [&](const vec<T, 3>& v0, const vec<T, 3>& v1) {
+    const auto ex = v1.x() - v0.x();
+    const auto ey = v1.y() - v0.y();
+    const auto c = ey * v0.x() - ex * v0.y();
+    const auto on_edge = c * c <= epsilon2 * (ex * ex + ey * ey);
+    left_of_all_edges = left_of_all_edges && (c >= T(0) || on_edge);
+    right_of_all_edges = right_of_all_edges && (c <= T(0) || on_edge);
+  };
+
+  const auto first = swizzle(get(*cur++), axis) - o;
+  auto previous = first;
+  while (cur != end)
+  {
+    const auto current = swizzle(get(*cur++), axis) - o;
+    check_edge(previous, current);
+    previous = current;
+  }
+  check_edge(previous, first);
+
+  if (left_of_all_edges || right_of_all_edges)
+  {
+    return *distance;
+  }
+  return std::nullopt;
+}
+
 /**
  * Computes the point of intersection between the given ray and the given bounding box,
  * and returns the distance on the given ray from the ray's origin to that point.
@@ -475,6 +550,192 @@ constexpr std::optional<T> intersect_ray_bbox(const ray<T, S>& r, const bbox<T,
   return distances[bestPlane];
 }
 
+/**
+ * A fixed number of three dimensional bounding boxes stored in structure of arrays
+ * layout, so that they can be tested against a ray at once using
+ * intersect_ray_bbox_packet.
+ *
+ * @tparam T the component type
+ * @tparam N the number of bounding boxes
+ */
+template <typename T, size_t N>
+struct bbox_packet
+{
+  static_assert(N <= 32, "a bbox packet can hold at most 32 boxes");
+
+  std::array<std::array<T, N>, 3> min{};
+  std::array<std::array<T, N>, 3> max{};
+
+  /**
+   * Sets the bounding box at the given index.
+   *
+   * @param i the index of the box to set
+   * @param b the bounding box
+   */
+  constexpr void set(const size_t i, const bbox<T, 3>& b)
+  {
+    for (size_t a = 0; a < 3; ++a)
+    {
+      min[a][i] = b.min[a];
+      max[a][i] = b.max[a];
+    }
+  }
+
+  /**
+   * Returns the bounding box at the given index.
+   *
+   * @param i the index of the box to return
+   * @return the bounding box
+   */
+  constexpr bbox<T, 3> get(const size_t i) const
+  {
+    return bbox<T, 3>{
+      vec<T, 3>{min[0][i], min[1][i], min[2][i]},
+      vec<T, 3>{max[0][i], max[1][i], max[2][i]}};
+  }
+};
+
+namespace detail
+{
+/**
+ * Clips the parameter intervals [t_min, t_max] of a ray against the slabs of one axis
+ * of a range of boxes.
+ *
+ * If the inverse direction component is infinite, the ray is parallel to the slabs and
+ * only hits the boxes whose slabs contain its origin. This case is handled separately
+ * because the origin may lie exactly on a slab plane, which would yield 0 * inf = NaN.
+ *
+ * @param o the ray origin component
+ * @param inv_d the inverse of the ray direction component
+ * @param min the slab minimums
+ * @param max the slab maximums
+ * @param t_min the interval starts to update
+ * @param t_max the interval ends to update
+ * @param count the number of boxes
+ */
+template <typename T>
+void clip_ray_slabs(
+  const T o,
+  const T inv_d,
+  const T* min,
+  const T* max,
+  T* t_min,
+  T* t_max,
+  const size_t count)
+{
+  if (is_inf(inv_d))
+  {
+    // the ray is parallel to the slabs, so it must start between them
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (o < min[i] || o > max[i])
+      {
+        t_max[i] = -std::numeric_limits<T>::infinity();
+      }
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto t1 = (min[i] - o) * inv_d;
+    const auto t2 = (max[i] - o) * inv_d;
+    t_min[i] = std::max(t_min[i], std::min(t1, t2));
+    t_max[i] = std::min(t_max[i], std::max(t1, t2));
+  }
+}
+
+#if defined(VM_INTERSECTION_AVX) || defined(VM_INTERSECTION_SSE2)
+inline void clip_ray_slabs(
+  const double o,
+  const double inv_d,
+  const double* min,
+  const double* max,
+  double* t_min,
+  double* t_max,
+  const size_t count)
+{
+  if (is_inf(inv_d))
+  {
+    clip_ray_slabs<double>(o, inv_d, min, max, t_min, t_max, count);
+    return;
+  }
+
+  auto i = size_t(0);
+#if defined(VM_INTERSECTION_AVX)
+  const auto o4 = _mm256_set1_pd(o);
+  const auto inv_d4 = _mm256_set1_pd(inv_d);
+  for (; i + 4 <= count; i += 4)
+  {
+    const auto t1 = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(min + i), o4), inv_d4);
+    const auto t2 = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(max + i), o4), inv_d4);
+    _mm256_storeu_pd(
+      t_min + i, _mm256_max_pd(_mm256_loadu_pd(t_min + i), _mm256_min_pd(t1, t2)));
+    _mm256_storeu_pd(
+      t_max + i, _mm256_min_pd(_mm256_loadu_pd(t_max + i), _mm256_max_pd(t1, t2)));
+  }
+#else
+  const auto o2 = _mm_set1_pd(o);
+  const auto inv_d2 = _mm_set1_pd(inv_d);
+  for (; i + 2 <= count; i += 2)
+  {
+    const auto t1 = _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(min + i), o2), inv_d2);
+    const auto t2 = _mm_mul_pd(_mm_sub_pd(_mm_loadu_pd(max + i), o2), inv_d2);
+    _mm_storeu_pd(t_min + i, _mm_max_pd(_mm_loadu_pd(t_min + i), _mm_min_pd(t1, t2)));
+    _mm_storeu_pd(t_max + i, _mm_min_pd(_mm_loadu_pd(t_max + i), _mm_max_pd(t1, t2)));
+  }
+#endif
+
+  clip_ray_slabs<double>(o, inv_d, min + i, max + i, t_min + i, t_max + i, count - i);
+}
+#endif
+} // namespace detail
+
+/**
+ * Checks which of the bounding boxes in the given packet are hit by the given ray. A box
+ * is hit if it contains the ray's origin or if the ray intersects it in front of its
+ * origin.
+ *
+ * The boxes are tested using the slab method. For double precision packets, the slabs of
+ * all boxes are clipped using SSE2 or AVX instructions if they are available.
+ *
+ * @tparam T the component type
+ * @tparam N the number of boxes in the packet
+ * @param r the ray
+ * @param p the bounding boxes
+ * @return a bit mask in which bit i is set if the ray hits box i
+ */
+template <typename T, size_t N>
+std::uint32_t intersect_ray_bbox_packet(const ray<T, 3>& r, const bbox_packet<T, N>& p)
+{
+  auto t_min = std::array<T, N>{};
+  auto t_max = std::array<T, N>{};
+  t_max.fill(std::numeric_limits<T>::infinity());
+
+  auto result = N == 32 ? ~std::uint32_t(0) : (std::uint32_t(1) << N) - 1;
+  for (size_t a = 0; a < 3; ++a)
+  {
+    detail::clip_ray_slabs(
+      r.origin[a],
+      T(1) / r.direction[a],
+      p.min[a].data(),
+      p.max[a].data(),
+      t_min.data(),
+      t_max.data(),
+      N);
+  }
+
+  for (size_t i = 0; i < N; ++i)
+  {
+    if (t_min[i] > t_max[i])
+    {
+      result &= ~(std::uint32_t(1) << i);
+    }
+  }
+
+  return result;
+}
+
 /**
  * Computes the point of intersection between the given ray and a sphere centered at the
  * given position and with the given radius.
@@ -28,6 +28,7 @@
 #include "vm/vec_ext.h"
 
 #include <array>
+#include <limits>
 
 #include "catch2.h"
 
@@ -309,6 +310,129 @@ TEST_CASE("intersection.intersect_ray_bbox")
   CHECK(intersect_ray_bbox(ray3f(origin, dir), bounds) == approx(length(diff)));
 }
 
+TEST_CASE("intersection.intersect_ray_convex_polygon")
+{
+  constexpr auto plane = plane3d(vec3d(0, 0, 1), vec3d{0, 0, 1});
+  constexpr auto poly = square() + vec3d(0, 0, 1);
+  constexpr auto reversed = std::array<vec3d, 4>{poly[3], poly[2], poly[1], poly[0]};
+
+  // misses
+  CER_CHECK(
+    intersect_ray_convex_polygon(
+      ray3d(vec3d{0, 0, 0}, vec3d{0, 0, -1}), plane, std::begin(poly), std::end(poly))
+    == std::nullopt);
+  CER_CHECK(
+    intersect_ray_convex_polygon(
+      ray3d(vec3d(2, 2, 0), vec3d{0, 0, 1}), plane, std::begin(poly), std::end(poly))
+    == std::nullopt);
+  CER_CHECK(
+    intersect_ray_convex_polygon(
+      ray3d(vec3d(-2, 0, 1), vec3d{1, 0, 0}), plane, std::begin(poly), std::end(poly))
+    == std::nullopt);
+  CER_CHECK(
+    intersect_ray_convex_polygon(
+      ray3d(vec3d(1.01, 0, 0), vec3d{0, 0, 1}), plane, std::begin(poly), std::end(poly))
+    == std::nullopt);
+
+  // hits the center, a corner and an edge, in both windings
+  for (const auto& origin : {vec3d(0, 0, 0), vec3d(+1, -1, 0), vec3d(-1, 0, 0)})
+  {
+    CHECK(
+      intersect_ray_convex_polygon(
+        ray3d(origin, vec3d{0, 0, 1}), plane, std::begin(poly), std::end(poly))
+      == approx(+1.0));
+    CHECK(
+      intersect_ray_convex_polygon(
+        ray3d(origin, vec3d{0, 0, 1}), plane, std::begin(reversed), std::end(reversed))
+      == approx(+1.0));
+  }
+
+  // hits the polygon from the other side
+  CER_CHECK(
+    intersect_ray_convex_polygon(
+      ray3d(vec3d(0, 0, 2), vec3d{0, 0, -1}), plane, std::begin(poly), std::end(poly))
+    == approx(+1.0));
+
+  // agrees with the general polygon test for a triangle
+  constexpr auto tri = triangle() + vec3d(0, 0, 1);
+  for (const auto& origin :
+       {vec3d(0, 0, 0), vec3d(0.5, 0.5, 0), vec3d(-0.5, -0.5, 0), vec3d(0.1, 0.1, 0)})
+  {
+    const auto ray = ray3d(origin, vec3d{0, 0, 1});
+    CHECK(
+      intersect_ray_convex_polygon(ray, plane, std::begin(tri), std::end(tri))
+      == intersect_ray_polygon(ray, plane, std::begin(tri), std::end(tri)));
+  }
+}
+
+TEST_CASE("intersection.intersect_ray_bbox_packet")
+{
+  auto packet = bbox_packet<double, 4>{};
+  packet.set(0, bbox3d(vec3d(-12, -3, 4), vec3d(8, 9, 8)));
+  packet.set(1, bbox3d(vec3d(-1, -1, -1), vec3d(1, 1, 1)));
+  packet.set(2, bbox3d(vec3d(4, 4, -8), vec3d(6, 6, -4)));
+  packet.set(3, bbox3d(vec3d(0, 0, 10), vec3d(2, 2, 12)));
+
+  CHECK(packet.get(0) == bbox3d(vec3d(-12, -3, 4), vec3d(8, 9, 8)));
+
+  // the origin is contained in box 1, boxes 0 and 3 are in front of it
+  CHECK(
+    intersect_ray_bbox_packet(ray3d(vec3d(0, 0, 0), vec3d(0, 0, 1)), packet) == 0b1011);
+  CHECK(
+    intersect_ray_bbox_packet(ray3d(vec3d(0, 0, 0), vec3d(0, 0, -1)), packet) == 0b0010);
+
+  // the ray starts outside of all boxes
+  CHECK(
+    intersect_ray_bbox_packet(ray3d(vec3d(5, 5, -16), vec3d(0, 0, 1)), packet) == 0b0101);
+  CHECK(
+    intersect_ray_bbox_packet(ray3d(vec3d(5, 5, 16), vec3d(0, 0, 1)), packet) == 0b0000);
+
+  // the ray touches the boundary of box 3 and is parallel to its faces
+  CHECK(
+    intersect_ray_bbox_packet(ray3d(vec3d(2, 2, 0), vec3d(0, 0, 1)), packet) == 0b1001);
+
+  // the ray is almost parallel to the faces of box 3, and the inverse of its direction's
+  // X component is infinite
+  const auto denormal = std::numeric_limits<double>::denorm_min();
+  CHECK(
+    intersect_ray_bbox_packet(ray3d(vec3d(2, 2, 0), vec3d(denormal, 0, 1)), packet)
+    == 0b1001);
+  CHECK(
+    intersect_ray_bbox_packet(ray3d(vec3d(2, 2, 0), vec3d(-denormal, 0, 1)), packet)
+    == 0b1001);
+  CHECK(
+    intersect_ray_bbox_packet(ray3d(vec3d(3, 2, 0), vec3d(denormal, 0, 1)), packet)
+    == 0b0001);
+
+  // the scalar implementation agrees
+  auto packetf = bbox_packet<float, 4>{};
+  for (size_t i = 0; i < 4; ++i)
+  {
+    packetf.set(i, bbox3f(packet.get(i)));
+  }
+  CHECK(
+    intersect_ray_bbox_packet(ray3f(vec3f(2, 2, 0), vec3f(0, 0, 1)), packetf) == 0b1001);
+  CHECK(
+    intersect_ray_bbox_packet(
+      ray3f(vec3f(2, 2, 0), vec3f(std::numeric_limits<float>::denorm_min(), 0, 1)),
+      packetf)
+    == 0b1001);
+
+  // diagonal rays agree with intersect_ray_bbox
+  const auto origin = vec3d(-10, -7, 14);
+  for (const auto& target : {vec3d(-2, 3, 8), vec3d(0, 0, 0), vec3d(5, 5, -6)})
+  {
+    const auto ray = ray3d(origin, normalize(target - origin));
+    const auto mask = intersect_ray_bbox_packet(ray, packet);
+    for (size_t i = 0; i < 4; ++i)
+    {
+      const auto expected = packet.get(i).contains(ray.origin)
+                            || intersect_ray_bbox(ray, packet.get(i)).has_value();
+      CHECK(((mask & (1u << i)) != 0) == expected);
+    }
+  }
+}
+
 TEST_CASE("intersection.intersect_ray_sphere")
 {
   const ray3f ray(vec3f{0, 0, 0}, vec3f{0, 0, 1});